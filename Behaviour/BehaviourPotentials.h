@@ -310,7 +310,42 @@ public:
             return newspeed;
         }
     }
-    
+
+    /*! @brief Returns a vector as close to the original as possible without walking into the obstacles in the obstacle grid
+
+        The path along the desired direction is checked first, and then paths either side of it, further and further away,
+        until a clear one is found. The least costly direction is used if no path is clear. Each check is a walk along the
+        path in the grid, so this does not depend on the number of obstacles.
+        @param speed the desired speed as [trans_speed, trans_direction, rot_speed]
+        @param obstacles the obstacle grid
+        @param lookahead the length of path checked in each direction (cm)
+        @param width the width of the robot's path (cm)
+     */
+    static vector<float> gridAvoidObjects(const vector<float>& speed, const ObstacleGrid& obstacles, float lookahead = 100, float width = 30)
+    {
+        const int numdirections = 6;                    // the number of directions checked either side of the desired one
+        const float spacing = mathGeneral::PI/12;       // the angle between the directions checked
+
+        float bestdirection = speed[1];
+        float bestcost = obstacles.getPathCost(lookahead*cos(bestdirection), lookahead*sin(bestdirection), width);
+        for (int i=1; i<=numdirections and bestcost > 0; i++)
+        {
+            for (int side=-1; side<=1; side+=2)
+            {
+                float direction = speed[1] + side*i*spacing;
+                float cost = obstacles.getPathCost(lookahead*cos(direction), lookahead*sin(direction), width);
+                if (cost < bestcost)
+                {
+                    bestcost = cost;
+                    bestdirection = direction;
+                }
+            }
+        }
+        vector<float> newspeed = speed;
+        newspeed[1] = mathGeneral::normaliseAngle(bestdirection);
+        return newspeed;
+    }
+
     /*! @brief Returns the opponent's goal */
     static StationaryObject& getOpponentGoal(FieldObjects* fieldobjects, GameInformation* gameinfo)
     {
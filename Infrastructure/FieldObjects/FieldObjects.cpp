@@ -16,14 +16,15 @@ FieldObjects::~FieldObjects()
 }
 
 FieldObjects::FieldObjects(const FieldObjects& source): m_timestamp(source.m_timestamp), self(source.self),
-stationaryFieldObjects(source.stationaryFieldObjects), mobileFieldObjects(source.mobileFieldObjects), ambiguousFieldObjects(source.ambiguousFieldObjects)
+stationaryFieldObjects(source.stationaryFieldObjects), mobileFieldObjects(source.mobileFieldObjects), ambiguousFieldObjects(source.ambiguousFieldObjects),
+fieldLinePoints(source.fieldLinePoints), obstacles(source.obstacles)
 {
 }
 
 /*! @brief Preprocesses each field object
     @param timestamp the current timestamp in ms
  
-    This calls preprocess on each object, and clears all of the ambiguous objects
+    This calls preprocess on each object, and clears all of the ambiguous objects and field line points
  */
 void FieldObjects::preProcess(const float timestamp)
 {
@@ -36,6 +37,7 @@ void FieldObjects::preProcess(const float timestamp)
         mobileFieldObjects[i].preProcess(timestamp);
     }
     ambiguousFieldObjects.clear();
+    fieldLinePoints.clear();
 }
 
 /*! @brief Postprocesses each field object
@@ -5,6 +5,7 @@
 #include "Self.h"
 #include "MobileObject.h"
 #include "AmbiguousObject.h"
+#include "ObstacleGrid.h"
 #include "Tools/FileFormats/TimestampedData.h"
 #include <vector>
 
@@ -99,6 +100,8 @@ class FieldObjects: public TimestampedData
             vector<StationaryObject> stationaryFieldObjects;
             vector<MobileObject> mobileFieldObjects;
             vector<AmbiguousObject> ambiguousFieldObjects;
+            vector<Vector2<float> > fieldLinePoints;       //!< The field line points seen this frame relative to the robot (x forward, y left in cm)
+            ObstacleGrid obstacles;                        //!< The obstacles about the robot, kept over many frames
             FieldObjects();
             FieldObjects(const FieldObjects& source);
             ~FieldObjects();
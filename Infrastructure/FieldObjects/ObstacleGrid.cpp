@@ -0,0 +1,356 @@
+/*!
+  @file ObstacleGrid.cpp
+  @brief Implementation of the ObstacleGrid class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ObstacleGrid.h"
+#include "Tools/Math/General.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__MMX__)
+    #include <mmintrin.h>
+#endif
+
+const float ObstacleGrid::DecayRate = 128;
+const unsigned char ObstacleGrid::EchoHit = 48;
+const unsigned char ObstacleGrid::EchoMiss = 32;
+const float ObstacleGrid::EchoMaxDistance = 150;
+const float ObstacleGrid::EchoHalfWidth = 0.5f;
+const float ObstacleGrid::GoalAreaCost = 1;
+
+
+/*! @brief Adds to an occupancy, saturating at 255 */
+static inline void addOccupancy(unsigned char& occupancy, int amount)
+{
+    occupancy = static_cast<unsigned char>(std::min(255, std::max(0, occupancy + amount)));
+}
+
+ObstacleGrid::ObstacleGrid()
+{
+    clear();
+}
+
+ObstacleGrid::~ObstacleGrid()
+{
+}
+
+/*! @brief Forgets every obstacle, and starts the grid again aligned with the robot */
+void ObstacleGrid::clear()
+{
+    memset(m_cells, 0, sizeof(m_cells));
+    m_origin_i = 0;
+    m_origin_j = 0;
+    m_heading = 0;
+    m_offset = Vector2<float>(0, 0);
+    m_decay_remainder = 0;
+    m_goal_area_valid = false;
+}
+
+/*! @brief Moves the robot within the grid
+    @param forward the distance the robot moved forward (cm)
+    @param left the distance the robot moved left (cm)
+    @param turn the angle the robot turned anticlockwise (rad)
+ */
+void ObstacleGrid::move(float forward, float left, float turn)
+{
+    float heading = m_heading + turn/2;
+    m_offset.x += forward*cos(heading) - left*sin(heading);
+    m_offset.y += forward*sin(heading) + left*cos(heading);
+    m_heading = mathGeneral::normaliseAngle(m_heading + turn);
+
+    int di = static_cast<int>(floor(m_offset.x/CellSize + 0.5f));
+    int dj = static_cast<int>(floor(m_offset.y/CellSize + 0.5f));
+    if (di != 0 or dj != 0)
+    {
+        m_offset.x -= di*CellSize;
+        m_offset.y -= dj*CellSize;
+        scroll(di, dj);
+    }
+}
+
+/*! @brief Moves the robot's cell by whole cells, and clears the cells that have come into range
+    @param di the number of cells the robot moved along the grid's x axis
+    @param dj the number of cells the robot moved along the grid's y axis
+ */
+void ObstacleGrid::scroll(int di, int dj)
+{
+    if (abs(di) >= Size or abs(dj) >= Size)
+    {
+        memset(m_cells, 0, sizeof(m_cells));
+        m_origin_i = 0;
+        m_origin_j = 0;
+        return;
+    }
+    m_origin_i = (m_origin_i + di) & (Size - 1);
+    m_origin_j = (m_origin_j + dj) & (Size - 1);
+
+    // the columns and rows that were behind the robot now wrap around to be in front of it
+    int first = di > 0 ? Size/2 - di : -Size/2;
+    int last = di > 0 ? Size/2 : -Size/2 - di;
+    for (int i = first; i < last; i++)
+        for (int j = -Size/2; j < Size/2; j++)
+            cell(i, j) = 0;
+    first = dj > 0 ? Size/2 - dj : -Size/2;
+    last = dj > 0 ? Size/2 : -Size/2 - dj;
+    for (int j = first; j < last; j++)
+        memset(&m_cells[((m_origin_j + j) & (Size - 1))*Size], 0, Size);
+}
+
+/*! @brief Decays every cell
+    @param seconds the time since the last decay (s)
+ */
+void ObstacleGrid::decay(float seconds)
+{
+    m_decay_remainder += DecayRate*seconds;
+    if (m_decay_remainder < 1)
+        return;
+    const unsigned char amount = static_cast<unsigned char>(std::min(255.0f, m_decay_remainder));
+    m_decay_remainder = amount < 255 ? m_decay_remainder - amount : 0;
+
+    int k = 0;
+    #if defined(__SSE2__)
+        const __m128i decrement = _mm_set1_epi8(static_cast<char>(amount));
+        for (; k + 16 <= Size*Size; k += 16)
+        {
+            __m128i* cells = reinterpret_cast<__m128i*>(m_cells + k);
+            _mm_storeu_si128(cells, _mm_subs_epu8(_mm_loadu_si128(cells), decrement));
+        }
+    #elif defined(__MMX__)
+        const __m64 decrement = _mm_set1_pi8(static_cast<char>(amount));
+        for (; k + 8 <= Size*Size; k += 8)
+        {
+            __m64* cells = reinterpret_cast<__m64*>(m_cells + k);
+            *cells = _mm_subs_pu8(*cells, decrement);
+        }
+        _mm_empty();
+    #endif
+    for (; k < Size*Size; k++)
+        m_cells[k] = m_cells[k] > amount ? m_cells[k] - amount : 0;
+}
+
+/*! @brief Adds a round obstacle to the grid
+    @param x the distance forward to the centre of the obstacle (cm)
+    @param y the distance left to the centre of the obstacle (cm)
+    @param radius the radius of the obstacle (cm)
+    @param amount the amount to add to each cell the obstacle covers
+ */
+void ObstacleGrid::addObstacle(float x, float y, float radius, unsigned char amount)
+{
+    Vector2<float> centre = toGrid(x, y);
+    int ci, cj;
+    if (toCell(centre, ci, cj))
+        addOccupancy(cell(ci, cj), amount);
+
+    int first_i = std::max(-Size/2, static_cast<int>(ceil((centre.x - radius)/CellSize)));
+    int last_i = std::min(Size/2 - 1, static_cast<int>(floor((centre.x + radius)/CellSize)));
+    int first_j = std::max(-Size/2, static_cast<int>(ceil((centre.y - radius)/CellSize)));
+    int last_j = std::min(Size/2 - 1, static_cast<int>(floor((centre.y + radius)/CellSize)));
+    for (int i = first_i; i <= last_i; i++)
+    {
+        for (int j = first_j; j <= last_j; j++)
+        {
+            float dx = i*CellSize - centre.x;
+            float dy = j*CellSize - centre.y;
+            if (dx*dx + dy*dy <= radius*radius and (i != ci or j != cj))
+                addOccupancy(cell(i, j), amount);
+        }
+    }
+}
+
+/*! @brief Adds an ultrasonic reading to the grid. The cells in the sensor's cone before the echo are cleared, and the
+           cells at the echo are added to.
+    @param bearing the direction the sensor faces relative to the robot (rad)
+    @param distance the distance to the nearest echo (cm)
+ */
+void ObstacleGrid::addEcho(float bearing, float distance)
+{
+    if (distance <= 0)
+        return;
+    const int rays = 5;
+    const bool hit = distance < EchoMaxDistance;
+    const float clear = std::min(distance, EchoMaxDistance) - CellSize;
+    for (int r = 0; r < rays; r++)
+    {
+        float angle = bearing - EchoHalfWidth + 2*EchoHalfWidth*r/(rays - 1);
+        float c = cos(angle);
+        float s = sin(angle);
+        int previous_i = Size, previous_j = Size;
+        int i, j;
+        for (float d = CellSize; d < clear; d += CellSize/2.0f)
+        {
+            if (toCell(toGrid(d*c, d*s), i, j) and (i != previous_i or j != previous_j))
+                addOccupancy(cell(i, j), -EchoMiss);
+            previous_i = i;
+            previous_j = j;
+        }
+        if (hit and toCell(toGrid(distance*c, distance*s), i, j))
+            addOccupancy(cell(i, j), EchoHit);
+    }
+}
+
+/*! @brief Sets the goal area the robot should stay out of
+    @param corner a corner of the goal area relative to the robot (cm)
+    @param length the side of the goal area from the corner along the field (cm)
+    @param width the side of the goal area from the corner across the field (cm)
+ */
+void ObstacleGrid::setGoalArea(const Vector2<float>& corner, const Vector2<float>& length, const Vector2<float>& width)
+{
+    m_goal_area_valid = true;
+    m_goal_corner = corner;
+    m_goal_length = length;
+    m_goal_width = width;
+}
+
+/*! @brief Stops avoiding the goal area */
+void ObstacleGrid::clearGoalArea()
+{
+    m_goal_area_valid = false;
+}
+
+/*! @brief Returns true if the goal area is being avoided */
+bool ObstacleGrid::hasGoalArea() const
+{
+    return m_goal_area_valid;
+}
+
+/*! @brief Returns how sure we are that there is an obstacle at a point (0 to 1). Points off the grid are 0.
+    @param x the distance forward to the point (cm)
+    @param y the distance left to the point (cm)
+ */
+float ObstacleGrid::getOccupancy(float x, float y) const
+{
+    int i, j;
+    if (toCell(toGrid(x, y), i, j))
+        return cell(i, j)/255.0f;
+    else
+        return 0;
+}
+
+/*! @brief Returns true if a point is in the goal area the robot should stay out of
+    @param x the distance forward to the point (cm)
+    @param y the distance left to the point (cm)
+ */
+bool ObstacleGrid::isInGoalArea(float x, float y) const
+{
+    if (not m_goal_area_valid)
+        return false;
+    float dx = x - m_goal_corner.x;
+    float dy = y - m_goal_corner.y;
+    float a = (dx*m_goal_length.x + dy*m_goal_length.y)/(m_goal_length.x*m_goal_length.x + m_goal_length.y*m_goal_length.y);
+    float b = (dx*m_goal_width.x + dy*m_goal_width.y)/(m_goal_width.x*m_goal_width.x + m_goal_width.y*m_goal_width.y);
+    return a >= 0 and a <= 1 and b >= 0 and b <= 1;
+}
+
+/*! @brief Returns the cost of being at a point; the occupancy, or GoalAreaCost if the point is in the goal area
+    @param x the distance forward to the point (cm)
+    @param y the distance left to the point (cm)
+ */
+float ObstacleGrid::getCost(float x, float y) const
+{
+    float cost = getOccupancy(x, y);
+    if (cost < GoalAreaCost and isInGoalArea(x, y))
+        cost = GoalAreaCost;
+    return cost;
+}
+
+/*! @brief Returns the cost of walking straight from the robot to a point. See getPathCost(x0, y0, x1, y1, width).
+    @param x the distance forward to the point (cm)
+    @param y the distance left to the point (cm)
+    @param width the width of the path (cm)
+ */
+float ObstacleGrid::getPathCost(float x, float y, float width) const
+{
+    return getPathCost(0, 0, x, y, width);
+}
+
+/*! @brief Returns the cost of walking straight from one point to another.
+
+    The path is sampled every half a cell along its length, at its centre and both its edges, and the cost is the
+    sum of the highest cost across the path at each sample times the distance between samples. So the cost is
+    roughly the distance (cm) along the path that is blocked, and a clear path costs nothing.
+
+    @param x0 the distance forward to the start of the path (cm)
+    @param y0 the distance left to the start of the path (cm)
+    @param x1 the distance forward to the end of the path (cm)
+    @param y1 the distance left to the end of the path (cm)
+    @param width the width of the path (cm)
+ */
+float ObstacleGrid::getPathCost(float x0, float y0, float x1, float y1, float width) const
+{
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = sqrt(dx*dx + dy*dy);
+    if (length <= 0)
+        return 0;
+    int steps = static_cast<int>(ceil(2*length/CellSize));
+    float step = length/steps;
+    float sidex = -dy/length*width/2;
+    float sidey = dx/length*width/2;
+
+    float cost = 0;
+    for (int k = 1; k <= steps; k++)
+    {
+        float x = x0 + dx*k/steps;
+        float y = y0 + dy*k/steps;
+        float highest = getCost(x, y);
+        if (width > 0)
+            highest = std::max(highest, std::max(getCost(x + sidex, y + sidey), getCost(x - sidex, y - sidey)));
+        cost += highest*step;
+    }
+    return cost;
+}
+
+/*! @brief Returns a position relative to the robot in the grid's axes, relative to the centre of the robot's cell (cm) */
+Vector2<float> ObstacleGrid::toGrid(float x, float y) const
+{
+    float c = cos(m_heading);
+    float s = sin(m_heading);
+    return Vector2<float>(x*c - y*s + m_offset.x, x*s + y*c + m_offset.y);
+}
+
+/*! @brief Finds the cell a position from toGrid is in
+    @param position the position in the grid's axes, relative to the centre of the robot's cell (cm)
+    @param i the cell's column relative to the robot's cell
+    @param j the cell's row relative to the robot's cell
+    @return false if the position is off the grid
+ */
+bool ObstacleGrid::toCell(const Vector2<float>& position, int& i, int& j) const
+{
+    i = static_cast<int>(floor(position.x/CellSize + 0.5f));
+    j = static_cast<int>(floor(position.y/CellSize + 0.5f));
+    return i >= -Size/2 and i < Size/2 and j >= -Size/2 and j < Size/2;
+}
+
+/*! @brief Returns the cell at a column and row relative to the robot's cell */
+unsigned char& ObstacleGrid::cell(int i, int j)
+{
+    return m_cells[((m_origin_j + j) & (Size - 1))*Size + ((m_origin_i + i) & (Size - 1))];
+}
+
+/*! @brief Returns the cell at a column and row relative to the robot's cell */
+const unsigned char& ObstacleGrid::cell(int i, int j) const
+{
+    return m_cells[((m_origin_j + j) & (Size - 1))*Size + ((m_origin_i + i) & (Size - 1))];
+}
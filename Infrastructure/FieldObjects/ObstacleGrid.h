@@ -0,0 +1,96 @@
+/*!
+  @file ObstacleGrid.h
+  @brief Declaration of the ObstacleGrid class.
+
+  @class ObstacleGrid
+  @brief An occupancy grid of the obstacles about the robot, which decays over time.
+
+  The grid is a fixed Size x Size array of CellSize cm cells centred on the robot. It does not turn with the robot;
+  it stays aligned with the direction the robot faced when the grid was started, and the robot's odometry is used
+  to keep track of the robot's heading and position within it. When the robot moves more than half a cell from the
+  centre the grid is scrolled by whole cells, by moving the origin of the (circular) storage and clearing the cells
+  that come into range, so nothing is resampled.
+
+  Each cell holds how sure we are that it is occupied (0 to 255). Obstacles and ultrasonic echoes add to the cells
+  they fall in, and ultrasonic readings clear the cells between the robot and the echo. The grid only stores and
+  answers queries; the sensors and field objects are fused into it each frame by ObstacleFusion in the see->think thread. Every cell decays
+  by DecayRate per second, using SSE2 or MMX if they are available. The robot's own goal area is kept as a rectangle
+  rather than in the cells, as it does not decay; it is only used when the robot is localised and is not the goalie.
+
+  All positions and paths passed to, and returned by, the queries are relative to the robot (x forward, y left in cm).
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OBSTACLEGRID_H
+#define OBSTACLEGRID_H
+
+#include "Tools/Math/Vector2.h"
+
+class ObstacleGrid
+{
+public:
+    static const int Size = 64;                 //!< The number of cells along each side of the grid (must be a power of two)
+    static const int CellSize = 10;             //!< The length of each side of a cell (cm)
+
+    ObstacleGrid();
+    ~ObstacleGrid();
+
+    void clear();
+
+    void move(float forward, float left, float turn);
+    void decay(float seconds);
+    void addObstacle(float x, float y, float radius, unsigned char amount);
+    void addEcho(float bearing, float distance);
+    void setGoalArea(const Vector2<float>& corner, const Vector2<float>& length, const Vector2<float>& width);
+    void clearGoalArea();
+
+    float getOccupancy(float x, float y) const;
+    bool isInGoalArea(float x, float y) const;
+    float getCost(float x, float y) const;
+    float getPathCost(float x, float y, float width) const;
+    float getPathCost(float x0, float y0, float x1, float y1, float width) const;
+    bool hasGoalArea() const;
+private:
+    Vector2<float> toGrid(float x, float y) const;
+    bool toCell(const Vector2<float>& position, int& i, int& j) const;
+    unsigned char& cell(int i, int j);
+    const unsigned char& cell(int i, int j) const;
+    void scroll(int di, int dj);
+
+    static const float DecayRate;               //!< The amount each cell decays each second (cells are 0 to 255)
+    static const unsigned char EchoHit;         //!< The amount an ultrasonic echo adds to the cells it falls in
+    static const unsigned char EchoMiss;        //!< The amount an ultrasonic reading takes from the cells in front of the echo
+    static const float EchoMaxDistance;         //!< Ultrasonic echos further away than this are treated as nothing there (cm)
+    static const float EchoHalfWidth;           //!< The half width of each ultrasonic sensor's cone (rad)
+    static const float GoalAreaCost;            //!< The cost of a point in the goal area, the same as a fully occupied cell
+
+    unsigned char m_cells[Size*Size];           //!< The occupancy of each cell, stored circularly from m_origin
+    int m_origin_i;                             //!< The storage column of the robot's cell
+    int m_origin_j;                             //!< The storage row of the robot's cell
+    float m_heading;                            //!< The robot's heading relative to the grid (rad)
+    Vector2<float> m_offset;                    //!< The robot's position relative to the centre of its cell (cm, grid axes)
+    float m_decay_remainder;                    //!< The part of a unit of decay not yet taken from the cells
+
+    bool m_goal_area_valid;                     //!< True if the goal area should be avoided
+    Vector2<float> m_goal_corner;               //!< A corner of the goal area relative to the robot (cm)
+    Vector2<float> m_goal_length;               //!< The side of the goal area along the field from m_goal_corner (cm)
+    Vector2<float> m_goal_width;                //!< The side of the goal area across the field from m_goal_corner (cm)
+};
+
+#endif
@@ -25,6 +25,7 @@ AmbiguousObject.cpp
 FieldObjects.cpp
 MobileObject.cpp
 Object.cpp
+ObstacleGrid.cpp
 Self.cpp
 StationaryObject.cpp
 )
@@ -1,6 +1,5 @@
 #include "GameInformation.h"
 
-#include "Infrastructure/NUSensorsData/NUSensorsData.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
 #include "Infrastructure/NUBlackboard.h"
 #include "NUPlatform/NUIO/GameControllerPort.h"
@@ -12,9 +11,9 @@
 
 GameInformation::GameInformation(int playerNumber, int teamNumber): TimestampedData()
 {
-    m_data = Blackboard->Sensors;
     m_actions = Blackboard->Actions;
     m_port = 0;
+    m_timestamp = 0;
     
     m_player_number = playerNumber;
     m_team_number = teamNumber;
@@ -67,13 +66,10 @@ GameInformation::RobotState GameInformation::getCurrentState() const
     return m_state;
 }
 
-/*! @brief Returns true if the game controller is working */
+/*! @brief Returns true if a game controller packet has been received in the last 10 seconds of sensor time */
 bool GameInformation::gameControllerWorking() const
 {
-    if (m_data)
-        return (m_data->CurrentTime - m_last_packet_time) < 10000;
-    else
-        return (memcmp(m_currentControlData->header, GAMECONTROLLER_STRUCT_HEADER, sizeof(m_currentControlData->header)) == 0);
+    return (m_timestamp - m_last_packet_time) < 10000;
 }
 
 /*! @brief Returns the number of players per team */
@@ -295,8 +291,7 @@ void GameInformation::process(RoboCupGameControlData* data)
     {
         if (data->teams[0].teamNumber == m_team_number || data->teams[1].teamNumber == m_team_number)
         {
-            if (m_data)
-                m_last_packet_time = m_data->CurrentTime;
+            m_last_packet_time = Platform->getTime();          // this is run by the network thread, so we can't look at the SeeThinkThread's sensors
             memcpy(m_currentControlData, data, sizeof(RoboCupGameControlData));
             doGameControllerUpdate();
             Platform->toggle(NUPlatform::Led2, m_actions->CurrentTime, m_led_red);
@@ -33,7 +33,6 @@
 #include <vector>
 using namespace std;
 
-class NUSensorsData;
 class NUActionatorsData;
 class GameControllerPort;
 #include "Tools/FileFormats/TimestampedData.h"
@@ -119,7 +118,6 @@ private:
 
     void doGameControllerUpdate();
 
-    NUSensorsData* m_data;          
     NUActionatorsData* m_actions;  //!< local copy of pointer to actions 
     // My information
     int m_player_number;           //!< Player number
@@ -128,7 +126,7 @@ private:
 
     // Game Information
     RoboCupGameControlData* m_currentControlData;        //!< The current game info.
-    double m_timestamp;
+    double m_timestamp;                                  //!< The time of the SeeThinkThread's pinned sensor snapshot
     double m_last_packet_time;                           //!< The time the last game controller packet was received
     GameControllerPort* m_port;
     RoboCupGameControlReturnData* m_currentReturnData;   //!< The current return packet
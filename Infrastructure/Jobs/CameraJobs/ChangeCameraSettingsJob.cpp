@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool ChangeCameraSettingsJob::m_pool("ChangeCameraSettingsJob", sizeof(ChangeCameraSettingsJob));
+
 /*! @brief Constructs a ChangeCameraSettingsJob
 
     @param saveimages true if you want to start saving images, false if you want to stop saving images
@@ -51,6 +53,20 @@ ChangeCameraSettingsJob::~ChangeCameraSettingsJob()
 {
 }
 
+/*! @brief Returns memory for a ChangeCameraSettingsJob from the pool, rather than the heap
+ */
+void* ChangeCameraSettingsJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted ChangeCameraSettingsJob to the pool
+ */
+void ChangeCameraSettingsJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Gets the camera settings associated with the job
     @param settings this will be updated with a copy of the settings associated with the job
  */
@@ -26,6 +26,7 @@
 #define CHANGECAMERASETTINGSJOB_H
 
 #include "../CameraJob.h"
+#include "../JobPool.h"
 #include "NUPlatform/NUCamera/CameraSettings.h"
 
 class ChangeCameraSettingsJob : public CameraJob
@@ -35,6 +36,9 @@ public:
     ChangeCameraSettingsJob(istream& input);
     virtual ~ChangeCameraSettingsJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     CameraSettings& getSettings();
     void setSettings(const CameraSettings& newsettings);
     
@@ -47,6 +51,8 @@ protected:
     virtual void toStream(ostream& output) const;
 private:
     CameraSettings m_camera_settings;         //!< the camera settings to apply
+    
+    static JobPool m_pool;              //!< the memory for every ChangeCameraSettingsJob
 };
 
 #endif
@@ -0,0 +1,173 @@
+/*! @file IntrusiveJobList.cpp
+    @brief Implementation of a fixed capacity list of jobs
+
+    @author agent
+ 
+  Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "IntrusiveJobList.h"
+#include "Job.h"
+
+#include "debug.h"
+#include "debugverbosityjobs.h"
+
+/*! @brief Constructs an empty list
+    @param capacity the maximum number of jobs in the list
+ */
+IntrusiveJobList::IntrusiveJobList(unsigned int capacity) : m_capacity(capacity)
+{
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+}
+
+/*! @brief Destroys the list. The jobs still in the list are removed from it, but not deleted. */
+IntrusiveJobList::~IntrusiveJobList()
+{
+    clear();
+}
+
+/*! @brief Adds a job to the end of the list
+    @param job the job to add. It must not be in another list.
+    @return false if the job could not be added because the list is full or the job is already in a list
+ */
+bool IntrusiveJobList::push_back(Job* job)
+{
+    if (job == 0)
+        return false;
+    if (job->m_owner != 0)
+    {
+        errorlog << "IntrusiveJobList::push_back(). The job is already in a list. It will not be added." << endl;
+        return false;
+    }
+    if (m_size >= m_capacity)
+    {
+        errorlog << "IntrusiveJobList::push_back(). The list is full (" << m_capacity << " jobs). The job will not be added." << endl;
+        return false;
+    }
+    
+    job->m_owner = this;
+    job->m_previous = m_tail;
+    job->m_next = 0;
+    if (m_tail != 0)
+        m_tail->m_next = job;
+    else
+        m_head = job;
+    m_tail = job;
+    m_size++;
+    return true;
+}
+
+/*! @brief Removes the job at iter from the list. The job is not deleted.
+    @return an iterator to the job after the removed job
+ */
+IntrusiveJobList::iterator IntrusiveJobList::erase(iterator iter)
+{
+    Job* job = iter.m_job;
+    if (job == 0)
+        return iter;
+    iterator next(job->m_next);
+    remove(job);
+    return next;
+}
+
+/*! @brief Removes the job from the list. The job is not deleted. */
+void IntrusiveJobList::remove(Job* job)
+{
+    if (job == 0 or job->m_owner != this)
+        return;
+    
+    if (job->m_previous != 0)
+        job->m_previous->m_next = job->m_next;
+    else
+        m_head = job->m_next;
+    if (job->m_next != 0)
+        job->m_next->m_previous = job->m_previous;
+    else
+        m_tail = job->m_previous;
+    
+    job->m_next = 0;
+    job->m_previous = 0;
+    job->m_owner = 0;
+    m_size--;
+}
+
+/*! @brief Removes every job from the list. The jobs are not deleted. */
+void IntrusiveJobList::clear()
+{
+    while (m_head != 0)
+        remove(m_head);
+}
+
+/*! @brief Returns an iterator at the first job in the list */
+IntrusiveJobList::iterator IntrusiveJobList::begin() const
+{
+    return iterator(m_head);
+}
+
+/*! @brief Returns an iterator past the last job in the list */
+IntrusiveJobList::iterator IntrusiveJobList::end() const
+{
+    return iterator();
+}
+
+/*! @brief Returns the first job in the list, or NULL if the list is empty */
+Job* IntrusiveJobList::front() const
+{
+    return m_head;
+}
+
+/*! @brief Returns true if there are no jobs in the list */
+bool IntrusiveJobList::empty() const
+{
+    return m_size == 0;
+}
+
+/*! @brief Returns true if no more jobs can be added to the list */
+bool IntrusiveJobList::full() const
+{
+    return m_size >= m_capacity;
+}
+
+/*! @brief Returns the number of jobs in the list */
+unsigned int IntrusiveJobList::size() const
+{
+    return m_size;
+}
+
+/*! @brief Returns the maximum number of jobs in the list */
+unsigned int IntrusiveJobList::capacity() const
+{
+    return m_capacity;
+}
+
+/*! @brief Moves the iterator to the next job in the list */
+IntrusiveJobList::iterator& IntrusiveJobList::iterator::operator++()
+{
+    if (m_job != 0)
+        m_job = m_job->m_next;
+    return *this;
+}
+
+/*! @brief Moves the iterator to the next job in the list, returning its previous position */
+IntrusiveJobList::iterator IntrusiveJobList::iterator::operator++(int)
+{
+    iterator previous(*this);
+    ++(*this);
+    return previous;
+}
+
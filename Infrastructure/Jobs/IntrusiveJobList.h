@@ -0,0 +1,86 @@
+/*! @file IntrusiveJobList.h
+    @brief Declaration of a fixed capacity list of jobs
+ 
+    @class IntrusiveJobList
+    @brief A fixed capacity list of jobs, where the links are stored in the jobs themselves
+ 
+    Adding a job to a std::list allocates a node, and removing it frees the node. Every job passes through
+    a list on its way to the module that processes it, so this was a couple of allocations per job, per cycle.
+    Here each Job carries its own links, so adding and removing jobs never allocates.
+ 
+    A job can only be in one list at a time, and a job that is deleted while it is in a list removes itself.
+    The list does not own its jobs; removing a job from the list does not delete it.
+ 
+    The list has a fixed capacity so that a module that stops consuming its jobs cannot grow the list without bound.
+
+    @author agent
+ 
+  Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTRUSIVEJOBLIST_H
+#define INTRUSIVEJOBLIST_H
+
+class Job;
+
+class IntrusiveJobList
+{
+public:
+    /*! @brief An iterator over the jobs in an IntrusiveJobList */
+    class iterator
+    {
+    public:
+        iterator() : m_job(0) {};
+        explicit iterator(Job* job) : m_job(job) {};
+        iterator& operator++();
+        iterator operator++(int);
+        Job* operator*() const {return m_job;};
+        bool operator==(const iterator& rhs) const {return m_job == rhs.m_job;};
+        bool operator!=(const iterator& rhs) const {return m_job != rhs.m_job;};
+    private:
+        friend class IntrusiveJobList;
+        Job* m_job;             //!< the current job, NULL at the end of the list
+    };
+    static const unsigned int DefaultCapacity = 64;     //!< the default maximum number of jobs in a list
+    
+    IntrusiveJobList(unsigned int capacity = DefaultCapacity);
+    ~IntrusiveJobList();
+    
+    bool push_back(Job* job);
+    iterator erase(iterator iter);
+    void remove(Job* job);
+    void clear();
+    
+    iterator begin() const;
+    iterator end() const;
+    Job* front() const;
+    
+    bool empty() const;
+    bool full() const;
+    unsigned int size() const;
+    unsigned int capacity() const;
+private:
+    IntrusiveJobList(const IntrusiveJobList& other);
+    IntrusiveJobList& operator=(const IntrusiveJobList& other);
+private:
+    Job* m_head;                    //!< the first job in the list
+    Job* m_tail;                    //!< the last job in the list
+    unsigned int m_size;            //!< the number of jobs in the list
+    const unsigned int m_capacity;  //!< the maximum number of jobs in the list
+};
+
+#endif
+
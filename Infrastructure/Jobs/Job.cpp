@@ -28,6 +28,19 @@
  */
 Job::Job(job_type_t jobtype, job_id_t jobid) : m_job_type(jobtype), m_job_id(jobid)
 {
+    m_next = 0;
+    m_previous = 0;
+    m_owner = 0;
+}
+
+/*! @brief Job copy constructor. The copy is not in any list.
+ */
+Job::Job(const Job& other) : m_job_type(other.m_job_type), m_job_id(other.m_job_id)
+{
+    m_job_time = other.m_job_time;
+    m_next = 0;
+    m_previous = 0;
+    m_owner = 0;
 }
 
 /*! @brief Job destructor
@@ -35,6 +48,8 @@ Job::Job(job_type_t jobtype, job_id_t jobid) : m_job_type(jobtype), m_job_id(job
 Job::~Job()
 {
     // I think everything will cleaning delete itself.
+    if (m_owner != 0)
+        m_owner->remove(this);
 }
 
 /*! @brief Get the job's type
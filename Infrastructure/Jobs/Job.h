@@ -27,6 +27,8 @@
 #ifndef JOB_H
 #define JOB_H
 
+#include "IntrusiveJobList.h"
+
 #include <vector>
 #include <iostream>
 using namespace std;
@@ -83,6 +85,7 @@ public:
     
 public:
     Job(job_type_t jobtype, job_id_t jobid);
+    Job(const Job& other);
     virtual ~Job();
     
     job_type_t getType();
@@ -103,6 +106,13 @@ protected:
     const job_type_t m_job_type;              //!< The type of job (use this to decide which module to send the job to)
     const job_id_t m_job_id;                  //!< The job's id (use this to decide which specialised Job class to cast a Job to)
     double m_job_time;                        //!< The time the job is to be completed (milliseconds)
+private:
+    friend class IntrusiveJobList;
+    friend class IntrusiveJobList::iterator;
+    // The links for the IntrusiveJobList the job is in
+    Job* m_next;                              //!< the next job in the list
+    Job* m_previous;                          //!< the previous job in the list
+    IntrusiveJobList* m_owner;                //!< the list the job is in, NULL if it is not in a list
 };
 
 #endif
@@ -41,11 +41,16 @@ JobList::JobList()
 JobList::~JobList()
 {
     debug << "JobList::~JobList()" << endl;
-    for (JobListIterator it = begin(); it != end(); ++it)
+    list<IntrusiveJobList*>::iterator it;
+    for (it = m_job_lists.begin(); it != m_job_lists.end(); ++it)
     {
-        debug << "deleting something" << endl;
-        if (*it != NULL)
-            delete *it;
+        while (not (*it)->empty())
+        {
+            debug << "deleting something" << endl;
+            Job* job = (*it)->front();
+            (*it)->remove(job);
+            delete job;
+        }
     }
 }
 
@@ -135,8 +140,14 @@ void JobList::addOtherJob(Job* job)
     @param job the job to be added to joblist
     @param joblist the list to which job is added
  */
-void JobList::addJob(Job* job, list<Job*>& joblist)
+void JobList::addJob(Job* job, IntrusiveJobList& joblist)
 {
+    if (joblist.full())
+    {   // nothing is consuming these jobs, so they are dropped rather than let the list grow
+        errorlog << "JobList::addJob. The list is full (" << joblist.capacity() << " jobs). Your job will be deleted." << endl;
+        delete job;
+        return;
+    }
     joblist.push_back(job);
 }
 
@@ -144,7 +155,7 @@ void JobList::addJob(Job* job, list<Job*>& joblist)
     @param iter the position of the job you want to remove
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeJob(IntrusiveJobList::iterator iter)
 {
     Job* job = *iter;
     if (job == NULL)
@@ -175,7 +186,7 @@ list<Job*>::iterator JobList::removeJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeVisionJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeVisionJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_vision_jobs, iter);
 }
@@ -184,7 +195,7 @@ list<Job*>::iterator JobList::removeVisionJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeLocalisationJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeLocalisationJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_localisation_jobs, iter);
 }
@@ -193,7 +204,7 @@ list<Job*>::iterator JobList::removeLocalisationJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeBehaviourJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeBehaviourJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_behaviour_jobs, iter);
 }
@@ -202,23 +213,28 @@ list<Job*>::iterator JobList::removeBehaviourJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeMotionJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeMotionJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_motion_jobs, iter);
 }
 
-/*! @brief Removes all motion jobs from the list
+/*! @brief Removes all motion jobs from the list, and deletes them
  */
 void JobList::clearMotionJobs()
 {
-    m_motion_jobs.clear();
+    while (not m_motion_jobs.empty())
+    {
+        Job* job = m_motion_jobs.front();
+        m_motion_jobs.remove(job);
+        delete job;
+    }
 }
 
 /*! @brief Remove a camera job from the list
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeCameraJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeCameraJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_camera_jobs, iter);
 }
@@ -227,7 +243,7 @@ list<Job*>::iterator JobList::removeCameraJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeSystemJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeSystemJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_system_jobs, iter);
 }
@@ -236,7 +252,7 @@ list<Job*>::iterator JobList::removeSystemJob(list<Job*>::iterator iter)
     @param iter the position of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeOtherJob(list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeOtherJob(IntrusiveJobList::iterator iter)
 {
     return removeJob(m_other_jobs, iter);
 }
@@ -246,10 +262,12 @@ list<Job*>::iterator JobList::removeOtherJob(list<Job*>::iterator iter)
     @param iter the position in the list of the job to be removed
     @return the new iterator position post job-removal
  */
-list<Job*>::iterator JobList::removeJob(list<Job*>& joblist, list<Job*>::iterator iter)
+IntrusiveJobList::iterator JobList::removeJob(IntrusiveJobList& joblist, IntrusiveJobList::iterator iter)
 {
-    delete *iter;
-    return joblist.erase(iter);
+    Job* job = *iter;
+    iter = joblist.erase(iter);
+    delete job;
+    return iter;
 }
 
 /*! @brief Returns an iterator at the beginning of the job list. This iterator goes over the
@@ -278,107 +296,107 @@ JobList::iterator JobList::end()
 
 /*! @brief Returns an iterator at the beginning of the vision jobs.
  */
-list<Job*>::iterator JobList::vision_begin()
+IntrusiveJobList::iterator JobList::vision_begin()
 {
     return m_vision_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the vision jobs.
  */
-list<Job*>::iterator JobList::vision_end()
+IntrusiveJobList::iterator JobList::vision_end()
 {
     return m_vision_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the localisation jobs.
  */
-list<Job*>::iterator JobList::localisation_begin()
+IntrusiveJobList::iterator JobList::localisation_begin()
 {
     return m_localisation_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the localisation jobs.
  */
-list<Job*>::iterator JobList::localisation_end()
+IntrusiveJobList::iterator JobList::localisation_end()
 {
     return m_localisation_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the behaviour jobs.
  */
-list<Job*>::iterator JobList::behaviour_begin()
+IntrusiveJobList::iterator JobList::behaviour_begin()
 {
     return m_behaviour_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the behaviour jobs.
  */
-list<Job*>::iterator JobList::behaviour_end()
+IntrusiveJobList::iterator JobList::behaviour_end()
 {
     return m_behaviour_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the motion jobs.
  */
-list<Job*>::iterator JobList::motion_begin()
+IntrusiveJobList::iterator JobList::motion_begin()
 {
     return m_motion_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the motion jobs.
  */
-list<Job*>::iterator JobList::motion_end()
+IntrusiveJobList::iterator JobList::motion_end()
 {
     return m_motion_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the camera jobs.
  */
-list<Job*>::iterator JobList::camera_begin()
+IntrusiveJobList::iterator JobList::camera_begin()
 {
     return m_camera_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the camera jobs.
  */
-list<Job*>::iterator JobList::camera_end()
+IntrusiveJobList::iterator JobList::camera_end()
 {
     return m_camera_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the system jobs.
  */
-list<Job*>::iterator JobList::system_begin()
+IntrusiveJobList::iterator JobList::system_begin()
 {
     return m_system_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the system jobs.
  */
-list<Job*>::iterator JobList::system_end()
+IntrusiveJobList::iterator JobList::system_end()
 {
     return m_system_jobs.end();
 }
 
 /*! @brief Returns an iterator at the beginning of the other jobs.
  */
-list<Job*>::iterator JobList::other_begin()
+IntrusiveJobList::iterator JobList::other_begin()
 {
     return m_other_jobs.begin();
 }
 
 /*! @brief Returns an iterator at the end of the other jobs.
  */
-list<Job*>::iterator JobList::other_end()
+IntrusiveJobList::iterator JobList::other_end()
 {
     return m_other_jobs.end();
 }
 
-/*! @brief Clears the contents of the job list
+/*! @brief Clears the contents of the job list. The jobs are not deleted.
  */
 void JobList::clear()
 {
-    list<list<Job*>*>::iterator it;
+    list<IntrusiveJobList*>::iterator it;
     for (it = m_job_lists.begin(); it != m_job_lists.end(); it++)
         (*it)->clear();
 }
@@ -387,7 +405,7 @@ void JobList::clear()
  */
 bool JobList::empty()
 {
-    list<list<Job*>*>::iterator it;
+    list<IntrusiveJobList*>::iterator it;
     for (it = m_job_lists.begin(); it != m_job_lists.end(); it++)
     {
         if (not (*it)->empty())
@@ -402,7 +420,7 @@ bool JobList::empty()
 unsigned int JobList::size()
 {
     unsigned int size = 0;
-    list<list<Job*>*>::iterator it;
+    list<IntrusiveJobList*>::iterator it;
     for (it = m_job_lists.begin(); it != m_job_lists.end(); it++)
         size += (*it)->size();
     return size;
@@ -480,10 +498,11 @@ JobListIterator::JobListIterator()
 JobListIterator::JobListIterator(JobList* joblist, bool end)
 {
     m_joblist = joblist;
+    m_job = NULL;
 #if DEBUG_JOBS_VERBOSITY > 5
     debug << "JobListIterator::JobListIterator. Contents of JobList:" << endl;
-    list<list<Job*>*>::iterator it;
-    list<Job*>::iterator sit;
+    list<IntrusiveJobList*>::iterator it;
+    IntrusiveJobList::iterator sit;
     for (it = m_joblist->m_job_lists.begin(); it != m_joblist->m_job_lists.end(); ++it)
     {
         for (sit = (*it)->begin(); sit!=(*it)->end(); ++sit)
@@ -492,43 +511,20 @@ JobListIterator::JobListIterator(JobList* joblist, bool end)
     debug << endl;
 #endif
     
-    if (m_joblist->empty())
-    {
-        m_list_iterator = (*m_joblist->m_job_lists.begin())->begin();
-        m_job = *m_list_iterator;
-    }
-    else
-    {
-        if (end == false)
-        {   // make the iterator point to the beginning of the JobList
-            // find the first non-empty list, but iterating over joblist->m_job_lists
-            for (m_job_lists_iterator = m_joblist->m_job_lists.begin(); m_job_lists_iterator!=m_joblist->m_job_lists.end(); ++m_job_lists_iterator)
-            {
-                if (!(*m_job_lists_iterator)->empty())
-                {
-                    m_list_iterator = (*m_job_lists_iterator)->begin();
-                    m_job = *m_list_iterator;
-                    break;
-                }
-            }
-        }
-        else
-        {   // make the iterator point to the end of the JobList
-            // find the last non-empty list, by iterating over joblist->m_job_lists backwards
-            list<list<Job*>*>::reverse_iterator reverseit;
-            for (reverseit = joblist->m_job_lists.rbegin(); reverseit != joblist->m_job_lists.rend(); ++reverseit)
+    m_job_lists_iterator = m_joblist->m_job_lists.end();
+    if (end == false)
+    {   // make the iterator point to the first job in the first non-empty list
+        for (m_job_lists_iterator = m_joblist->m_job_lists.begin(); m_job_lists_iterator!=m_joblist->m_job_lists.end(); ++m_job_lists_iterator)
+        {
+            if (!(*m_job_lists_iterator)->empty())
             {
-                if (!(*reverseit)->empty())
-                {
-                    m_list_iterator = (*reverseit)->end();
-                    m_job = *m_list_iterator;
-                    break;
-                }
+                m_list_iterator = (*m_job_lists_iterator)->begin();
+                m_job = *m_list_iterator;
+                break;
             }
         }
     }
-    
-    // this should leave m_job_lists_iterator at the current m_*_jobs and m_list_iterator at the current m_job
+    // the end of the JobList is past the end of every list, where m_job is NULL
 }
 
 /*! @brief Increments the iterator to reference the next job. If there are no more jobs the iterator will be in the .end() state
@@ -549,14 +545,7 @@ JobListIterator& JobListIterator::operator++()
  */
 JobListIterator& JobListIterator::operator++(int) 
 {
-    if (m_job == NULL)
-        return *this;
-    
-    ++m_list_iterator;      // Note. end() refers to past the end, so we increment and then check if we are past the end
-    if (m_list_iterator == (*m_job_lists_iterator)->end())
-        moveToNextList();
-    m_job = *(m_list_iterator);
-    return *this;
+    return ++(*this);
 }
 
 /*! @brief Returns true if the two iterators reference the same job
@@ -580,10 +569,11 @@ Job* JobListIterator::operator*()
     return m_job;
 };
 
-/*! @brief Move to the next non-empty job list in JobList
+/*! @brief Move to the next non-empty job list in JobList. If there are no more jobs m_list_iterator is left at the end.
  */
 void JobListIterator::moveToNextList()
 {
+    m_list_iterator = IntrusiveJobList::iterator();
     for(m_job_lists_iterator++; m_job_lists_iterator!=m_joblist->m_job_lists.end(); ++m_job_lists_iterator)
     {
         if (!(*m_job_lists_iterator)->empty())
@@ -27,6 +27,7 @@
 #define JOBLIST_H
 
 #include "Job.h"
+#include "IntrusiveJobList.h"
 
 #include <list>
 #include <iterator>
@@ -54,33 +55,33 @@ public:
     void addOtherJob(Job* job);
     
     // Remove job interface
-    list<Job*>::iterator removeJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeVisionJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeLocalisationJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeBehaviourJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeMotionJob(list<Job*>::iterator iter);
+    IntrusiveJobList::iterator removeJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeVisionJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeLocalisationJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeBehaviourJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeMotionJob(IntrusiveJobList::iterator iter);
     void clearMotionJobs();
-    list<Job*>::iterator removeCameraJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeSystemJob(list<Job*>::iterator iter);
-    list<Job*>::iterator removeOtherJob(list<Job*>::iterator iter);
+    IntrusiveJobList::iterator removeCameraJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeSystemJob(IntrusiveJobList::iterator iter);
+    IntrusiveJobList::iterator removeOtherJob(IntrusiveJobList::iterator iter);
     
     // Iterators over the jobs
     iterator begin();
     iterator end();
-    list<Job*>::iterator vision_begin();
-    list<Job*>::iterator vision_end();
-    list<Job*>::iterator localisation_begin();
-    list<Job*>::iterator localisation_end();
-    list<Job*>::iterator behaviour_begin();
-    list<Job*>::iterator behaviour_end();
-    list<Job*>::iterator motion_begin();
-    list<Job*>::iterator motion_end();
-    list<Job*>::iterator camera_begin();
-    list<Job*>::iterator camera_end();
-    list<Job*>::iterator system_begin();
-    list<Job*>::iterator system_end();
-    list<Job*>::iterator other_begin();
-    list<Job*>::iterator other_end();
+    IntrusiveJobList::iterator vision_begin();
+    IntrusiveJobList::iterator vision_end();
+    IntrusiveJobList::iterator localisation_begin();
+    IntrusiveJobList::iterator localisation_end();
+    IntrusiveJobList::iterator behaviour_begin();
+    IntrusiveJobList::iterator behaviour_end();
+    IntrusiveJobList::iterator motion_begin();
+    IntrusiveJobList::iterator motion_end();
+    IntrusiveJobList::iterator camera_begin();
+    IntrusiveJobList::iterator camera_end();
+    IntrusiveJobList::iterator system_begin();
+    IntrusiveJobList::iterator system_end();
+    IntrusiveJobList::iterator other_begin();
+    IntrusiveJobList::iterator other_end();
     
     void clear();
     bool empty();
@@ -93,18 +94,18 @@ public:
     friend istream& operator>>(istream& input, JobList& joblist);
     
 private:
-    void addJob(Job* job, list<Job*>& joblist);
-    list<Job*>::iterator removeJob(list<Job*>& joblist, list<Job*>::iterator iter);
+    void addJob(Job* job, IntrusiveJobList& joblist);
+    IntrusiveJobList::iterator removeJob(IntrusiveJobList& joblist, IntrusiveJobList::iterator iter);
 
 private:
-    list<Job*> m_vision_jobs;               //!< a list of all the current vision jobs
-    list<Job*> m_localisation_jobs;         //!< a list of all the current localisation jobs
-    list<Job*> m_behaviour_jobs;            //!< a list of all the behaviour jobs
-    list<Job*> m_motion_jobs;               //!< a list of all the current motion jobs
-    list<Job*> m_camera_jobs;               //!< a list of all the current camera jobs
-    list<Job*> m_system_jobs;               //!< a list of all the current system/os jobs
-    list<Job*> m_other_jobs;                //!< a list of all other jobs
-    list<list<Job*>*> m_job_lists;          //!< a list of all the lists of jobs
+    IntrusiveJobList m_vision_jobs;         //!< a list of all the current vision jobs
+    IntrusiveJobList m_localisation_jobs;   //!< a list of all the current localisation jobs
+    IntrusiveJobList m_behaviour_jobs;      //!< a list of all the behaviour jobs
+    IntrusiveJobList m_motion_jobs;         //!< a list of all the current motion jobs
+    IntrusiveJobList m_camera_jobs;         //!< a list of all the current camera jobs
+    IntrusiveJobList m_system_jobs;         //!< a list of all the current system/os jobs
+    IntrusiveJobList m_other_jobs;          //!< a list of all other jobs
+    list<IntrusiveJobList*> m_job_lists;    //!< a list of all the lists of jobs
 };
 
 
@@ -126,8 +127,8 @@ private:
 private:
     JobList* m_joblist;
     Job* m_job;                                                 //!< the current job
-    list<Job*>::iterator m_list_iterator;                       //!< an iterator over the current lists in m_job_lists
-    list<list<Job*>*>::iterator m_job_lists_iterator;           //!< an iterator over the lists in m_job_lists
+    IntrusiveJobList::iterator m_list_iterator;                 //!< an iterator over the current list in m_job_lists
+    list<IntrusiveJobList*>::iterator m_job_lists_iterator;     //!< an iterator over the lists in m_job_lists
 };
 
 #endif
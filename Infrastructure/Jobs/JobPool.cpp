@@ -0,0 +1,164 @@
+/*! @file JobPool.cpp
+    @brief Implementation of the job object pool
+
+    @author agent
+ 
+  Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "JobPool.h"
+
+#include "debug.h"
+#include "debugverbosityjobs.h"
+
+#include <new>
+
+/*! @brief Constructs an empty pool. No memory is allocated until the first job is
+    @param name the name of the pool (used for debug purposes). This must be a string literal.
+    @param objectsize the size of the job class in bytes
+    @param chunksize the number of jobs to allocate room for each time the pool grows
+ */
+JobPool::JobPool(const char* name, size_t objectsize, unsigned int chunksize)
+{
+    const size_t alignment = sizeof(double) > sizeof(void*) ? sizeof(double) : sizeof(void*);
+    if (objectsize < sizeof(FreeNode))
+        objectsize = sizeof(FreeNode);
+    m_name = name;
+    m_object_size = alignment*((objectsize + alignment - 1)/alignment);
+    m_chunk_size = chunksize > 0 ? chunksize : 1;
+    m_free = 0;
+    m_num_in_use = 0;
+    m_num_allocations = 0;
+    pthread_mutex_init(&m_mutex, NULL);
+}
+
+/*! @brief Destroys the pool and frees all of its memory.
+ 
+    The pools are static, so they can be destroyed before the last of their jobs. If there are jobs
+    still in use the memory is left to be reclaimed when the program exits.
+ */
+JobPool::~JobPool()
+{
+    if (m_num_in_use == 0)
+    {
+        for (size_t i=0; i<m_chunks.size(); i++)
+            ::operator delete(m_chunks[i]);
+        m_chunks.clear();
+    }
+    pthread_mutex_destroy(&m_mutex);
+}
+
+/*! @brief Returns memory for a job. This only allocates if every job in the pool is in use.
+    @param size the size of the job. If it is larger than the pool's jobs (ie. it is a derived class) the memory is taken from the heap.
+ */
+void* JobPool::allocate(size_t size)
+{
+    if (size > m_object_size)
+    {
+        pthread_mutex_lock(&m_mutex);
+        m_num_allocations++;
+        pthread_mutex_unlock(&m_mutex);
+        return ::operator new(size);
+    }
+    
+    pthread_mutex_lock(&m_mutex);
+    if (m_free == 0)
+        grow();
+    FreeNode* node = m_free;
+    m_free = node->Next;
+    m_num_in_use++;
+    pthread_mutex_unlock(&m_mutex);
+    return node;
+}
+
+/*! @brief Returns the memory of a job, from allocate(), to the pool */
+void JobPool::release(void* object)
+{
+    if (object == 0)
+        return;
+    pthread_mutex_lock(&m_mutex);
+    if (contains(object))
+    {
+        FreeNode* node = reinterpret_cast<FreeNode*>(object);
+        node->Next = m_free;
+        m_free = node;
+        m_num_in_use--;
+        pthread_mutex_unlock(&m_mutex);
+    }
+    else
+    {
+        pthread_mutex_unlock(&m_mutex);
+        ::operator delete(object);
+    }
+}
+
+/*! @brief Returns the number of times the pool has taken memory from the heap */
+unsigned long JobPool::getNumAllocations()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_allocations;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of jobs currently allocated from the pool */
+unsigned int JobPool::getNumInUse()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned int value = m_num_in_use;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of jobs the pool can hold without growing */
+unsigned int JobPool::getCapacity()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned int value = m_chunks.size()*m_chunk_size;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Adds another chunk to the pool. The mutex must be held. */
+void JobPool::grow()
+{
+    char* chunk = reinterpret_cast<char*>(::operator new(m_object_size*m_chunk_size));
+    m_chunks.push_back(chunk);
+    m_num_allocations++;
+    for (unsigned int i=m_chunk_size; i>0; i--)
+    {
+        FreeNode* node = reinterpret_cast<FreeNode*>(chunk + (i-1)*m_object_size);
+        node->Next = m_free;
+        m_free = node;
+    }
+    #if DEBUG_JOBS_VERBOSITY > 0
+        debug << "JobPool::grow(). " << m_name << " now has room for " << m_chunks.size()*m_chunk_size << " jobs" << endl;
+    #endif
+}
+
+/*! @brief Returns true if the object is in one of the pool's chunks. The mutex must be held. */
+bool JobPool::contains(void* object)
+{
+    char* p = reinterpret_cast<char*>(object);
+    size_t chunkbytes = m_object_size*m_chunk_size;
+    for (size_t i=0; i<m_chunks.size(); i++)
+    {
+        if (p >= m_chunks[i] and p < m_chunks[i] + chunkbytes)
+            return true;
+    }
+    return false;
+}
+
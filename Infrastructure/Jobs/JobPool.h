@@ -0,0 +1,74 @@
+/*! @file JobPool.h
+    @brief Declaration of the job object pool
+ 
+    @class JobPool
+    @brief A pool of memory for the jobs of a single class, so that creating and deleting jobs every cycle does not allocate
+ 
+    Each pooled job class has a static JobPool, and overrides operator new and delete to use it:
+        @code
+        void* WalkJob::operator new(size_t size) {return m_pool.allocate(size);}
+        void WalkJob::operator delete(void* job) {m_pool.release(job);}
+        @endcode
+    so the existing new WalkJob(...) and delete job work unchanged. The pool grows a chunk at a time, and never
+    shrinks, so once the pool has grown to the number of jobs alive at once there are no more allocations.
+ 
+    Jobs are created in one thread and deleted in another, so the pool is protected by a mutex.
+
+    @author agent
+ 
+  Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JOBPOOL_H
+#define JOBPOOL_H
+
+#include <pthread.h>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+class JobPool
+{
+public:
+    JobPool(const char* name, size_t objectsize, unsigned int chunksize = 16);
+    ~JobPool();
+    
+    void* allocate(size_t size);
+    void release(void* object);
+    
+    unsigned long getNumAllocations();
+    unsigned int getNumInUse();
+    unsigned int getCapacity();
+private:
+    void grow();
+    bool contains(void* object);
+private:
+    struct FreeNode
+    {
+        FreeNode* Next;
+    };
+    const char* m_name;                 //!< the name of the pool (used for debug purposes)
+    size_t m_object_size;               //!< the size of each object in bytes, rounded up to a multiple of the alignment
+    unsigned int m_chunk_size;          //!< the number of objects in each chunk
+    vector<char*> m_chunks;             //!< the blocks of memory owned by the pool
+    FreeNode* m_free;                   //!< the free objects
+    unsigned int m_num_in_use;          //!< the number of objects allocated from the pool and not yet released
+    unsigned long m_num_allocations;    //!< the number of times memory was taken from the heap
+    pthread_mutex_t m_mutex;            //!< lock for the free list and the chunks
+};
+
+#endif
+
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool BlockJob::m_pool("BlockJob", sizeof(BlockJob));
+
 /*! @brief Constructs a BlockJob at the given position and time
     @param time the time in ms to perform the save
     @param position the position at which to perform the block
@@ -65,6 +67,20 @@ BlockJob::~BlockJob()
     m_block_position.clear();
 }
 
+/*! @brief Returns memory for a BlockJob from the pool, rather than the heap
+ */
+void* BlockJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted BlockJob to the pool
+ */
+void BlockJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the position for the block to point
  
     You should only need to use this function if you are recycling the one job 
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool HeadJob::m_pool("HeadJob", sizeof(HeadJob));
+
 /*! @brief Constructs a HeadJob at the given position and time
     @param time the time in ms to perform the move
     @param position the head will move to this position
@@ -85,6 +87,20 @@ HeadJob::~HeadJob()
     m_head_positions.clear();
 }
 
+/*! @brief Returns memory for a HeadJob from the pool, rather than the heap
+ */
+void* HeadJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted HeadJob to the pool
+ */
+void HeadJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the position for the head to point
     @param newposition the new position for the head job [roll, pitch, yaw]
  
@@ -27,6 +27,7 @@
 #define HEADJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -38,6 +39,9 @@ public:
     HeadJob(double time, istream& input);
     ~HeadJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void setPosition(double time, const vector<float>& newposition);
     void setPositions(const vector<double>& times, const vector<vector<float> >& positions);
     void getPositions(vector<double>& times, vector<vector<float> >& positions);
@@ -54,6 +58,8 @@ private:
     vector<vector<float> > m_head_positions;                //!< the head position [[roll0, pitch0, yaw0], [roll1, pitch1, yaw1], ... ,[rollN, pitchN, yawN]]
     unsigned int m_size;
     unsigned int m_width;
+    
+    static JobPool m_pool;              //!< the memory for every HeadJob
 };
 
 #endif
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool HeadNodJob::m_pool("HeadNodJob", sizeof(HeadNodJob));
+
 /*! @brief Constructs a HeadNodJob
  
     @param period the new nod period in milliseconds
@@ -70,6 +72,20 @@ HeadNodJob::~HeadNodJob()
 {
 }
 
+/*! @brief Returns memory for a HeadNodJob from the pool, rather than the heap
+ */
+void* HeadNodJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted HeadNodJob to the pool
+ */
+void HeadNodJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Returns the type of nod
  */
 HeadNodJob::head_nod_t HeadNodJob::getNodType()
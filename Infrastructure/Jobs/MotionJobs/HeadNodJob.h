@@ -31,6 +31,7 @@
 #define NODHEADJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -48,6 +49,9 @@ public:
     HeadNodJob(istream& input);
     ~HeadNodJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     head_nod_t getNodType();
     float getCentreAngle();
     
@@ -61,6 +65,8 @@ protected:
 private:
     head_nod_t m_nod_type;
     float m_centre_angle;
+    
+    static JobPool m_pool;              //!< the memory for every HeadNodJob
 };
 
 #endif
@@ -25,6 +25,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool HeadPanJob::m_pool("HeadPanJob", sizeof(HeadPanJob));
+
 /*! @brief Constructs a HeadPanJob
     @param pantype the type of pan (Ball, BallAndLocalisation, Localisation)
  */
@@ -116,6 +118,20 @@ HeadPanJob::~HeadPanJob()
     #endif
 }
 
+/*! @brief Returns memory for a HeadPanJob from the pool, rather than the heap
+ */
+void* HeadPanJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted HeadPanJob to the pool
+ */
+void HeadPanJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Returns the type of pan
  */
 HeadPanJob::head_pan_t HeadPanJob::getPanType()
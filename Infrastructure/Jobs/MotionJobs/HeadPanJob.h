@@ -32,6 +32,7 @@
 #define PANHEADJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 class MobileObject;
 
 #include <vector>
@@ -53,6 +54,9 @@ public:
     HeadPanJob(istream& input);
     ~HeadPanJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     head_pan_t getPanType();
     bool useDefaultValues();
     void getX(float& xmin, float& xmax);
@@ -72,6 +76,8 @@ private:
     float m_x_max;                      //!< the maximum x distance to include in the pan (cm)
     float m_yaw_min;                    //!< the minimum (right) yaw angle to include in the pan (rad)
     float m_yaw_max;                    //!< the maximum (left) yaw angle to include in the pan (rad)
+    
+    static JobPool m_pool;              //!< the memory for every HeadPanJob
 };
 
 #endif
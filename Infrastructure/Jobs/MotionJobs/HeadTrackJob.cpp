@@ -25,6 +25,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool HeadTrackJob::m_pool("HeadTrackJob", sizeof(HeadTrackJob));
+
 /*! @brief Constructs a track visual object job
     @param object the object to be tracked
     @param centreelevation the target elevation in the image for the object to be
@@ -86,6 +88,20 @@ HeadTrackJob::~HeadTrackJob()
 {
 }
 
+/*! @brief Returns memory for a HeadTrackJob from the pool, rather than the heap
+ */
+void* HeadTrackJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted HeadTrackJob to the pool
+ */
+void HeadTrackJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Gets the data associated with the job
     @param elevation
     @param bearing
@@ -26,6 +26,7 @@
 #define HEADTRACKJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 
 class Object;
 
@@ -40,6 +41,9 @@ public:
     HeadTrackJob(istream& input);
     ~HeadTrackJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void getData(float& elevation, float& bearing, float& centreelevation, float& centrebearing);
     
     virtual void summaryTo(ostream& output);
@@ -54,6 +58,8 @@ private:
     float m_bearing;
     float m_centre_elevation;
     float m_centre_bearing;
+    
+    static JobPool m_pool;              //!< the memory for every HeadTrackJob
 };
 
 #endif
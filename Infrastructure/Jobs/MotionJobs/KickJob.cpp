@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool KickJob::m_pool("KickJob", sizeof(KickJob));
+
 /*! @brief Constructs a KickJob
     @param time the time you want to kick
     @param kickposition the point you want to kick (hopefully the position of the ball) [x(cm), y(cm)]
@@ -80,6 +82,20 @@ KickJob::~KickJob()
     m_kick_target.clear();
 }
 
+/*! @brief Returns memory for a KickJob from the pool, rather than the heap
+ */
+void* KickJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted KickJob to the pool
+ */
+void KickJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the kick time, position and target
     @param time the time you want to kick
     @param kickposition the point you want to kick (hopefully the position of the ball) [x(cm), y(cm)]
@@ -26,6 +26,7 @@
 #define KICKJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -36,6 +37,9 @@ public:
     KickJob(double time, istream& input);
     ~KickJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void setKick(double time, const vector<float>& kickposition, const vector<float>& kicktarget);
     void setKickPosition(double time, const vector<float>& kickposition);
     void setKickTarget(const vector<float>& kicktarget);
@@ -53,6 +57,8 @@ protected:
 private:
     vector<float> m_kick_position;                 //!< the kick position [x(cm), y(cm)]
     vector<float> m_kick_target;                   //!< the kick target relative from the *current* position [x(cm) y(cm)]
+    
+    static JobPool m_pool;              //!< the memory for every KickJob
 };
 
 #endif
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool MotionFreezeJob::m_pool("MotionFreezeJob", sizeof(MotionFreezeJob));
+
 /*! @brief Constructs a MotionFreezeJob to be executed immediately
  */
 MotionFreezeJob::MotionFreezeJob() : MotionJob(Job::MOTION_FREEZE)
@@ -35,6 +37,20 @@ MotionFreezeJob::~MotionFreezeJob()
 {
 }
 
+/*! @brief Returns memory for a MotionFreezeJob from the pool, rather than the heap
+ */
+void* MotionFreezeJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted MotionFreezeJob to the pool
+ */
+void MotionFreezeJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Prints a human-readable summary to the stream
     @param output the stream to be written to
  */
@@ -27,6 +27,7 @@
 #define MOTIONFREEZEJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -36,6 +37,9 @@ public:
     MotionFreezeJob();
     ~MotionFreezeJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     virtual void summaryTo(ostream& output);
     virtual void csvTo(ostream& output);
     
@@ -43,6 +47,8 @@ public:
     friend ostream& operator<<(ostream& output, const MotionFreezeJob* job);
 protected:
     virtual void toStream(ostream& output) const;
+private:
+    static JobPool m_pool;              //!< the memory for every MotionFreezeJob
 };
 
 #endif
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool MotionKillJob::m_pool("MotionKillJob", sizeof(MotionKillJob));
+
 /*! @brief Constructs a MotionKillJob to be executed immediately
  */
 MotionKillJob::MotionKillJob() : MotionJob(Job::MOTION_KILL)
@@ -35,6 +37,20 @@ MotionKillJob::~MotionKillJob()
 {
 }
 
+/*! @brief Returns memory for a MotionKillJob from the pool, rather than the heap
+ */
+void* MotionKillJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted MotionKillJob to the pool
+ */
+void MotionKillJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Prints a human-readable summary to the stream
     @param output the stream to be written to
  */
@@ -28,6 +28,7 @@
 #define MOTIONKILLJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -37,6 +38,9 @@ public:
     MotionKillJob();
     ~MotionKillJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     virtual void summaryTo(ostream& output);
     virtual void csvTo(ostream& output);
     
@@ -44,6 +48,8 @@ public:
     friend ostream& operator<<(ostream& output, const MotionKillJob* job);
 protected:
     virtual void toStream(ostream& output) const;
+private:
+    static JobPool m_pool;              //!< the memory for every MotionKillJob
 };
 
 #endif
@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool SaveJob::m_pool("SaveJob", sizeof(SaveJob));
+
 /*! @brief Constructs a SaveJob at the given position and time
     @param time the time in ms to perform the save
     @param position the position at which to perform the save
@@ -66,6 +68,20 @@ SaveJob::~SaveJob()
     m_save_position.clear();
 }
 
+/*! @brief Returns memory for a SaveJob from the pool, rather than the heap
+ */
+void* SaveJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted SaveJob to the pool
+ */
+void SaveJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the position for the save to point
  
     You should only need to use this function if you are recycling the one job 
@@ -26,6 +26,7 @@
 #define SAVEJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -36,6 +37,9 @@ public:
     SaveJob(double time, istream& input);
     ~SaveJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void setPosition(double time, const vector<float>& newposition);
     void getPosition(double& time, vector<float>& position);
     
@@ -48,6 +52,8 @@ protected:
     virtual void toStream(ostream& output) const;
 private:
     vector<float> m_save_position;                 //!< the save position [x (cm), y (cm), theta (rad)]
+    
+    static JobPool m_pool;              //!< the memory for every SaveJob
 };
 
 #endif
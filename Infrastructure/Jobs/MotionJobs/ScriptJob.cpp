@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool ScriptJob::m_pool("ScriptJob", sizeof(ScriptJob));
+
 /*! @brief Constructs a ScriptJob at the given position and time
     @param time the time in ms to perform the save
     @param position the position at which to perform the save
@@ -52,6 +54,20 @@ ScriptJob::~ScriptJob()
 {
 }
 
+/*! @brief Returns memory for a ScriptJob from the pool, rather than the heap
+ */
+void* ScriptJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted ScriptJob to the pool
+ */
+void ScriptJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Gets the script associated with the script job
     @param time will be updated with the time to play the script
     @param script the motion script to be played
@@ -26,6 +26,7 @@
 #define SCRIPTJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include "Motion/Tools/MotionScript.h"
 #include <vector>
 #include <string>
@@ -39,6 +40,9 @@ public:
     ScriptJob(double time, istream& input);
     ~ScriptJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void getScript(double& time, MotionScript& position);
     string& getName();
     
@@ -52,6 +56,8 @@ protected:
 private:
     string m_name;
     MotionScript m_script;                  // the motion script attached to the job
+    
+    static JobPool m_pool;              //!< the memory for every ScriptJob
 };
 
 #endif
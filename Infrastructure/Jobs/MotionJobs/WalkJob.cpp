@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool WalkJob::m_pool("WalkJob", sizeof(WalkJob));
+
 /*! @brief Constructs a WalkJob
     @param trans_speed the translational fraction
     @param trans_direction the translational direction in radians
@@ -57,6 +59,20 @@ WalkJob::~WalkJob()
 {
 }
 
+/*! @brief Returns memory for a WalkJob from the pool, rather than the heap
+ */
+void* WalkJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted WalkJob to the pool
+ */
+void WalkJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Returns the translation speed fraction (-1 to 1)
     @return the fraction of maximum translation speed
  */
@@ -26,6 +26,7 @@
 #define WALKJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -36,6 +37,9 @@ public:
     WalkJob(istream& input);
     ~WalkJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     float getTranslationSpeed();
     float getDirection();
     float getRotationSpeed();
@@ -51,6 +55,8 @@ private:
     float m_translation_speed;          //!< the translational speed between 0 and 1
     float m_direction;                  //!< the translational direction of the walk    
     float m_rotation_speed;             //!< the rotational speed in rad/s
+    
+    static JobPool m_pool;              //!< the memory for every WalkJob
 };
 
 #endif
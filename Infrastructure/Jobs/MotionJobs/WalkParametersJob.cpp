@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool WalkParametersJob::m_pool("WalkParametersJob", sizeof(WalkParametersJob));
+
 /*! @brief Constructs a WalkParametersJob
     @param walkparameters the walk parameters associated with the job
  */
@@ -50,6 +52,20 @@ WalkParametersJob::~WalkParametersJob()
     #endif
 }
 
+/*! @brief Returns memory for a WalkParametersJob from the pool, rather than the heap
+ */
+void* WalkParametersJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted WalkParametersJob to the pool
+ */
+void WalkParametersJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the walk parameters of the job.
  
     You should only need to use this function if you are recycling the one job 
@@ -26,6 +26,7 @@
 #define WALKPARAMETERJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include "Motion/Walks/WalkParameters.h"
 
 #include <vector>
@@ -38,6 +39,9 @@ public:
     WalkParametersJob(istream& input);
     ~WalkParametersJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void setWalkParameters(const WalkParameters& walkparameters);
     void getWalkParameters(WalkParameters& walkparameters);
     
@@ -50,6 +54,8 @@ protected:
     virtual void toStream(ostream& output) const;
 private:
     WalkParameters m_walk_parameters;               //!< the walk parameters to give to the walk engine
+    
+    static JobPool m_pool;              //!< the memory for every WalkParametersJob
 };
 
 #endif
@@ -24,6 +24,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool WalkPerturbationJob::m_pool("WalkPerturbationJob", sizeof(WalkPerturbationJob));
+
 /*! @brief Constructs a WalkPerturbationJob
     @param magnitude the magnitude of the perturbation (0 to 100)
     @param direction the direction of the perturbation in radians with 0 being forward, and positive to the left.
@@ -56,6 +58,20 @@ WalkPerturbationJob::~WalkPerturbationJob()
     #endif
 }
 
+/*! @brief Returns memory for a WalkPerturbationJob from the pool, rather than the heap
+ */
+void* WalkPerturbationJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted WalkPerturbationJob to the pool
+ */
+void WalkPerturbationJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Gets the walk parameters of the job
     @return returns the magnitude
  */
@@ -26,6 +26,7 @@
 #define WALK_PERTURBATION_JOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 
 #include <vector>
 using namespace std;
@@ -37,6 +38,9 @@ public:
     WalkPerturbationJob(istream& input);
     ~WalkPerturbationJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     float getMagnitude();
     float getDirection();
     
@@ -50,6 +54,8 @@ protected:
 private:
     float m_magnitude;                  //!< the magnitude of the perturbation (0 to 100)
     float m_direction;                  //!< the direction to perturbed the robot in radians
+    
+    static JobPool m_pool;              //!< the memory for every WalkPerturbationJob
 };
 
 #endif
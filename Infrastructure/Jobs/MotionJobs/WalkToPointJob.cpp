@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool WalkToPointJob::m_pool("WalkToPointJob", sizeof(WalkToPointJob));
+
 /*! @brief Constructs a WalkToPointJob
     @param time the time in ms to reach the position
     @param position the position for the walk job [x(cm), y(cm), theta(rad)]
@@ -65,6 +67,20 @@ WalkToPointJob::~WalkToPointJob()
     m_walk_position.clear();
 }
 
+/*! @brief Returns memory for a WalkToPointJob from the pool, rather than the heap
+ */
+void* WalkToPointJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted WalkToPointJob to the pool
+ */
+void WalkToPointJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Sets the position for the walk to point
  
     You should only need to use this function if you are recycling the one job 
@@ -26,6 +26,7 @@
 #define WALKTOPOINTJOB_H
 
 #include "../MotionJob.h"
+#include "../JobPool.h"
 #include <vector>
 using namespace std;
 
@@ -36,6 +37,9 @@ public:
     WalkToPointJob(double time, istream& input);
     ~WalkToPointJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     void setPosition(double time, const vector<float>& newposition);
     void getPosition(double& time, vector<float>& position);
     
@@ -48,6 +52,8 @@ protected:
     virtual void toStream(ostream& output) const;
 private:
     vector<float> m_walk_position;                 //!< the walk position x (cm), y (cm) and theta (rad)
+    
+    static JobPool m_pool;              //!< the memory for every WalkToPointJob
 };
 
 #endif
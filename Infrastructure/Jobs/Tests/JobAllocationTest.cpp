@@ -0,0 +1,130 @@
+/*! @file JobAllocationTest.cpp
+    @brief Counts the heap allocations made by creating, streaming and consuming jobs each cycle.
+
+    Each cycle does what the threads do with the jobs: the behaviour creates motion, head and vision
+    jobs and adds them to a JobList; the list is streamed out and decoded into a second list, as
+    the job port and the log replay do; then motion takes the motion jobs and vision takes the vision
+    jobs, and both delete them. After a few cycles to let the pools grow, every cycle should make no
+    allocations at all. Only jobs without vector members are used, as the vectors still allocate.
+
+    This is not part of the nubot build. It needs the objects of a nubot build for the job classes
+    and what they depend on, so build a target (eg. Replay in Build/Replay) and then:
+        ar rcs libnubot.a $(find Build/Replay/CMakeFiles/nubot.dir -name '*.o' ! -name main.cpp.o)
+        g++ -O2 -pthread -I. -INUView/NUViewConfig Infrastructure/Jobs/Tests/JobAllocationTest.cpp libnubot.a -o joballocationtest
+    It exits with 0 if no cycle after the warm up allocated.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Infrastructure/Jobs/Jobs.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <new>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+static volatile unsigned long NumAllocations = 0;
+
+void* operator new(size_t size)
+{
+    __sync_fetch_and_add(&NumAllocations, 1);
+    void* p = malloc(size > 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p)
+{
+    free(p);
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void* p)
+{
+    free(p);
+}
+
+static const int NumWarmUpCycles = 10;
+static const int NumCycles = 1000;
+
+/*! @brief The behaviour; adds this cycle's jobs to the list */
+static void createJobs(JobList& jobs, int cycle)
+{
+    jobs.addJob(new WalkJob(0.5f*(cycle%3), 0.1f, -0.2f));
+    jobs.addJob(new HeadPanJob(HeadPanJob::BallAndLocalisation));
+    jobs.addJob(new HeadNodJob(HeadNodJob::Ball, 0.1f));
+    jobs.addJob(new HeadTrackJob(0.2f, -0.3f));
+    if (cycle%10 == 0)
+    {
+        jobs.addJob(new MotionFreezeJob());
+        jobs.addJob(new MotionKillJob());
+        jobs.addJob(new SaveImagesJob(true, false, true));
+    }
+}
+
+/*! @brief Motion and vision; take the jobs out of the list and delete them */
+static void consumeJobs(JobList& jobs)
+{
+    jobs.clearMotionJobs();
+    IntrusiveJobList::iterator it = jobs.vision_begin();
+    while (it != jobs.vision_end())
+        it = jobs.removeVisionJob(it);
+}
+
+int main()
+{
+    JobList jobs;
+    JobList decoded;
+    std::stringstream stream;
+    unsigned long allocated = 0;
+    int cyclesallocating = 0;
+    for (int cycle = 0; cycle < NumWarmUpCycles + NumCycles; cycle++)
+    {
+        unsigned long before = NumAllocations;
+        createJobs(jobs, cycle);
+
+        stream.clear();
+        stream.seekp(0);
+        stream << jobs;
+        stream.seekg(0);
+        stream >> decoded;
+
+        consumeJobs(jobs);
+        consumeJobs(decoded);
+        if (cycle >= NumWarmUpCycles)
+        {
+            unsigned long count = NumAllocations - before;
+            allocated += count;
+            if (count > 0)
+                cyclesallocating++;
+        }
+    }
+
+    bool passed = allocated == 0 and jobs.empty() and decoded.empty();
+    printf("%d cycles after %d warm up: %lu allocations in %d cycles: %s\n", NumCycles, NumWarmUpCycles, allocated, cyclesallocating, passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -23,32 +23,56 @@
 #include "debug.h"
 #include "debugverbosityjobs.h"
 
+JobPool SaveImagesJob::m_pool("SaveImagesJob", sizeof(SaveImagesJob));
+const char SaveImagesJob::m_version = 2;
+
 /*! @brief Constructs a SaveImagesJob
 
     @param saveimages true if you want to start saving images, false if you want to stop saving images
+    @param varycamerasettings true if you want to rotate the camera settings while saving images
+    @param pretrigger true if you want to keep the recent images in memory, and only save those around a fall or a goal
  */
-SaveImagesJob::SaveImagesJob(bool saveimages, bool varycamerasettings) : VisionJob(Job::VISION_SAVE_IMAGES)
+SaveImagesJob::SaveImagesJob(bool saveimages, bool varycamerasettings, bool pretrigger) : VisionJob(Job::VISION_SAVE_IMAGES)
 {
     m_save_images = saveimages;
     m_vary_settings = varycamerasettings;
+    m_pre_trigger = pretrigger;
 }
 
 /*! @brief Constructs a SaveImagesJob from stream data
     @param input the stream from which to make a SaveImagesJob
  
     Remember that only members introduced at this level are read at this level.
+ 
+    The first version of the job had no version field, and started with the m_save_images bool.
+    Later versions start with a version number greater than 1, so a first byte of 0 or 1 is read as
+    the first version, which is m_save_images and m_vary_settings only.
  */
 SaveImagesJob::SaveImagesJob(istream& input) : VisionJob(Job::VISION_SAVE_IMAGES)
 {
     m_job_time = 0;
     // Temporary read buffers
     bool boolbuffer;
+    char version;
 
-    // read in the m_save_images bool
-    input.read(reinterpret_cast<char*>(&boolbuffer), sizeof(boolbuffer));
-    m_save_images = boolbuffer;
+    input.read(&version, sizeof(version));
+    if (version <= 1)
+    {   // the first version; the byte was the m_save_images bool
+        m_save_images = version;
+    }
+    else
+    {   // read in the m_save_images bool
+        input.read(reinterpret_cast<char*>(&boolbuffer), sizeof(boolbuffer));
+        m_save_images = boolbuffer;
+    }
     input.read(reinterpret_cast<char*>(&boolbuffer), sizeof(boolbuffer));
     m_vary_settings = boolbuffer;
+    m_pre_trigger = false;
+    if (version >= 2)
+    {
+        input.read(reinterpret_cast<char*>(&boolbuffer), sizeof(boolbuffer));
+        m_pre_trigger = boolbuffer;
+    }
 }
 
 /*! @brief SaveImagesJob destructor
@@ -57,6 +81,20 @@ SaveImagesJob::~SaveImagesJob()
 {
 }
 
+/*! @brief Returns memory for a SaveImagesJob from the pool, rather than the heap
+ */
+void* SaveImagesJob::operator new(size_t size)
+{
+    return m_pool.allocate(size);
+}
+
+/*! @brief Returns the memory of a deleted SaveImagesJob to the pool
+ */
+void SaveImagesJob::operator delete(void* job)
+{
+    m_pool.release(job);
+}
+
 /*! @brief Returns true if the job is to start saving, false if the job is to stop saving
  */
 bool SaveImagesJob::saving()
@@ -71,6 +109,13 @@ bool SaveImagesJob::varyCameraSettings()
     return m_vary_settings;
 }
 
+/*! @brief Returns true if the job is to only save the images around a trigger, rather than every image
+ */
+bool SaveImagesJob::preTrigger()
+{
+    return m_pre_trigger;
+}
+
 /*! @brief Prints a human-readable summary to the stream
  @param output the stream to be written to
  */
@@ -85,6 +130,10 @@ void SaveImagesJob::summaryTo(ostream& output)
         output << "true";
     else
         output << "false";
+    if (m_pre_trigger == true)
+        output << "true";
+    else
+        output << "false";
     output << endl;
 }
 
@@ -102,6 +151,10 @@ void SaveImagesJob::csvTo(ostream& output)
         output << "true, ";
     else
         output << "false, ";
+    if (m_pre_trigger == true)
+        output << "true, ";
+    else
+        output << "false, ";
     output << endl;
 }
 
@@ -117,8 +170,10 @@ void SaveImagesJob::toStream(ostream& output) const
     Job::toStream(output);                  // This writes data introduced at the base level
     VisionJob::toStream(output);            // This writes data introduced at the vision level
                                             // Then we write SaveImagesJob specific data
+    output.write(&m_version, sizeof(m_version));
     output.write((char*) &m_save_images, sizeof(m_save_images));
     output.write((char*) &m_vary_settings, sizeof(m_vary_settings));
+    output.write((char*) &m_pre_trigger, sizeof(m_pre_trigger));
 }
 
 /*! @relates SaveImagesJob
@@ -26,16 +26,21 @@
 #define SAVEIMAGESJOB_H
 
 #include "../VisionJob.h"
+#include "../JobPool.h"
 
 class SaveImagesJob : public VisionJob
 {
 public:
-    SaveImagesJob(bool saveimages, bool varycamerasettings = false);
+    SaveImagesJob(bool saveimages, bool varycamerasettings = false, bool pretrigger = false);
     SaveImagesJob(istream& input);
     virtual ~SaveImagesJob();
     
+    static void* operator new(size_t size);
+    static void operator delete(void* job);
+    
     bool saving();
     bool varyCameraSettings();
+    bool preTrigger();
     
     virtual void summaryTo(ostream& output);
     virtual void csvTo(ostream& output);
@@ -47,6 +52,10 @@ protected:
 private:
     bool m_save_images;         //!< true if the job is to start saving images, false if the job is to stop saving images
     bool m_vary_settings;       //!< true if the job is to saving images with varying camera settings
+    bool m_pre_trigger;         //!< true if the job is to only save the images around a trigger (a fall or a goal)
+    
+    static const char m_version;        //!< the version of the stream format; 1 had no version field and no m_pre_trigger
+    static JobPool m_pool;              //!< the memory for every SaveImagesJob
 };
 
 #endif
@@ -22,6 +22,8 @@ ENDIF()
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  JobList.cpp JobList.h
 		Job.cpp Job.h
+		JobPool.cpp JobPool.h
+		IntrusiveJobList.cpp IntrusiveJobList.h
 		VisionJob.h
 		VisionJobs/SaveImagesJob.h VisionJobs/SaveImagesJob.cpp
 		LocalisationJob.h
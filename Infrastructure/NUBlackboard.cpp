@@ -71,6 +71,8 @@ void NUBlackboard::add(NUSensorsData* sensorsdata)
     NUSensorsData* oldsensors = Sensors;
     Sensors = sensorsdata;
     delete oldsensors;
+    if (Sensors != 0)
+        m_sensors_snapshots.initialise(*Sensors);
 }
 
 /*! @brief Adds a NUActionatorsData object to the blackboard. Note that ownership of the object is now with the Blackboard. 
@@ -133,4 +135,57 @@ void NUBlackboard::add(TeamInformation* teaminfo)
     delete oldteam;
 }
 
+/*! @brief Publishes a snapshot of the current sensor data for the SeeThinkThread. This should only be called by 
+           the SenseMoveThread, once the sensor data for the cycle is complete. This never blocks.
+    @return the version number of the published snapshot
+ */
+unsigned long NUBlackboard::publishSensors()
+{
+    m_sensors_snapshots.getWriteBuffer() = *Sensors;
+    return m_sensors_snapshots.publish();
+}
+
+/*! @brief Returns the most recently published snapshot of the sensor data. This should only be called by 
+           the SeeThinkThread, at the start of each cycle. The snapshot will not change until the next call to pinSensors(). 
+ 
+           If the SenseMoveThread has not published anything since the last call, the same snapshot is returned again.
+ 
+           The SenseMoveThread accumulates the odometry, and only the snapshots are reset when it is read, so the
+           odometry in a new snapshot is replaced with the difference from the previously pinned one.
+    @return a pointer to the pinned snapshot
+ */
+NUSensorsData* NUBlackboard::pinSensors()
+{
+    // a snapshot published between hasNewData() and acquire() would be missed, so the versions are compared instead
+    unsigned long previous = m_sensors_snapshots.getReadVersion();
+    NUSensorsData* snapshot = &m_sensors_snapshots.acquire();
+    bool isnew = m_sensors_snapshots.getReadVersion() != previous;
+    vector<float> odometry;
+    if (isnew and snapshot->get(NUSensorsData::Odometry, odometry))
+    {
+        m_pinned_odometry.resize(odometry.size(), 0);
+        vector<float> delta(odometry.size());
+        for (size_t i = 0; i < odometry.size(); i++)
+            delta[i] = odometry[i] - m_pinned_odometry[i];
+        m_pinned_odometry = odometry;
+        snapshot->set(NUSensorsData::Odometry, snapshot->CurrentTime, delta);
+    }
+    return snapshot;
+}
+
+/*! @brief Returns the snapshot returned by the last call to pinSensors(), without looking for a newer one. 
+           Use this in code run by the SeeThinkThread that does not have the snapshot passed to it.
+ */
+NUSensorsData* NUBlackboard::getPinnedSensors()
+{
+    return &m_sensors_snapshots.getReadBuffer();
+}
+
+/*! @brief Returns the version number of the snapshot returned by the last call to pinSensors(). 
+           Zero means the SenseMoveThread has not published any sensor data yet.
+ */
+unsigned long NUBlackboard::getPinnedSensorsVersion() const
+{
+    return m_sensors_snapshots.getReadVersion();
+}
 
@@ -11,6 +11,13 @@
                 - GameInfo; which contains all of the information about the state of the 'game'
                 - TeamInfo; which contains all of the information about the team mates' state
  
+           The SenseMoveThread owns Sensors. At the end of each of its cycles it publishes a copy of
+           the sensor data with publishSensors(). The SeeThinkThread calls pinSensors() at the start
+           of each of its cycles to get the latest published copy, and it uses that same copy for the
+           whole cycle. Publishing and pinning are lock-free, and the pinned copy never changes underneath
+           vision, localisation or behaviour. The odometry in a pinned snapshot is the odometry since the previous
+           pinned snapshot.
+ 
     @note Adding a new type of object to the Blackboard is considered a major change, and should be avoided.
  
     @author Jason Kulk
@@ -34,7 +41,9 @@
 #ifndef NUBLACKBOARD_H
 #define NUBLACKBOARD_H
 
-class NUSensorsData;
+#include "Tools/Threading/TripleBuffer.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+
 class NUActionatorsData;
 class NUImage;
 class FieldObjects;
@@ -57,6 +66,11 @@ public:
     void add(GameInformation* gameinfo);
     void add(TeamInformation* teaminfo);
     
+    unsigned long publishSensors();
+    NUSensorsData* pinSensors();
+    NUSensorsData* getPinnedSensors();
+    unsigned long getPinnedSensorsVersion() const;
+    
 public:
     NUSensorsData* Sensors;
     NUActionatorsData* Actions;
@@ -65,6 +79,9 @@ public:
     JobList* Jobs;
     GameInformation* GameInfo;
     TeamInformation* TeamInfo;
+private:
+    TripleBuffer<NUSensorsData> m_sensors_snapshots;    //!< the snapshots of the sensor data passed from the SenseMoveThread to the SeeThinkThread
+    std::vector<float> m_pinned_odometry;               //!< the odometry accumulated by the SenseMoveThread when the last snapshot was pinned
 };
 
 extern NUBlackboard* Blackboard;
@@ -0,0 +1,425 @@
+/*! @file ImageStreamCodec.cpp
+    @brief Implementation of the image encodings used by the vision debug stream
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImageStreamCodec.h"
+#include "Tools/FileFormats/LUTTools.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+
+ImageStreamCodec::ImageStreamCodec()
+{
+    m_sequence = 0;
+    m_reference_sequence = 0;
+    m_reference_width = 0;
+    m_reference_height = 0;
+}
+
+ImageStreamCodec::~ImageStreamCodec()
+{
+}
+
+/*! @brief Encodes an image
+    @param encoding the requested encoding
+    @param image the image to encode
+    @param lut the colour lookup table used for ClassifiedRLE. If it is NULL a Raw frame is sent instead.
+    @param reference the sequence number of the client's Delta reference frame, 0 if it has none
+    @param body will be updated with the encoded image
+    @return the description of the encoded frame. The EncodeTime is left for the caller to fill in.
+ */
+ImageStreamCodec::FrameInfo ImageStreamCodec::encode(Encoding encoding, const NUImage& image, const unsigned char* lut, unsigned int reference, vector<char>& body)
+{
+    FrameInfo info;
+    m_sequence++;
+    if (m_sequence == 0)
+        m_sequence = 1;                 // 0 is reserved for 'no reference'
+    info.Sequence = m_sequence;
+    info.Reference = 0;
+    info.EncodeTime = 0;
+    info.Encoding = encoding;
+
+    if (encoding == SubsampledY)
+        encodeSubsampledY(image, body);
+    else if (encoding == ClassifiedRLE and lut != NULL)
+        encodeClassifiedRLE(image, lut, body);
+    else if (encoding == Delta)
+    {
+        bool haveReference = reference != 0 and reference == m_reference_sequence and image.getWidth() == m_reference_width and image.getHeight() == m_reference_height;
+        if (haveReference and encodeDelta(image, body))
+            info.Reference = reference;
+        else
+        {   // key frame
+            encodeRaw(image, body);
+            setReference(image);
+        }
+        m_reference_sequence = m_sequence;
+    }
+    else
+    {
+        info.Encoding = Raw;
+        encodeRaw(image, body);
+    }
+    info.BodySize = body.size();
+    return info;
+}
+
+/*! @brief Decodes a frame. The image is available from getImage(), or getClassifiedImage() for ClassifiedRLE
+    @param info the description of the frame
+    @param width the width of the image on the robot
+    @param height the height of the image on the robot
+    @param timestamp the time the image was captured
+    @param body the encoded image, info.BodySize bytes
+    @return true if the frame was decoded, false if it was corrupt or relative to a reference frame this decoder does not have
+ */
+bool ImageStreamCodec::decode(const FrameInfo& info, int width, int height, double timestamp, const char* body)
+{
+    if (width <= 0 or height <= 0 or info.BodySize < 0)
+        return false;
+
+    bool ok = false;
+    if (info.Encoding == Raw)
+    {
+        ok = decodeRaw(width, height, body, info.BodySize, m_pixels);
+        if (ok)
+            m_image.MapBufferToImage(&m_pixels[0], width, height);
+    }
+    else if (info.Encoding == SubsampledY)
+        ok = decodeSubsampledY(width, height, body, info.BodySize);
+    else if (info.Encoding == ClassifiedRLE)
+        ok = decodeClassifiedRLE(width, height, body, info.BodySize);
+    else if (info.Encoding == Delta)
+    {
+        if (info.Reference == 0)
+            ok = decodeRaw(width, height, body, info.BodySize, m_reference);
+        else if (info.Reference == m_reference_sequence and width == m_reference_width and height == m_reference_height)
+            ok = decodeDelta(width, height, body, info.BodySize);
+
+        if (ok)
+        {
+            m_reference_sequence = info.Sequence;
+            m_reference_width = width;
+            m_reference_height = height;
+            m_image.MapBufferToImage(&m_reference[0], width, height);
+        }
+        else
+            m_reference_sequence = 0;           // ask for a key frame
+    }
+
+    if (ok)
+    {
+        m_sequence = info.Sequence;
+        m_image.m_timestamp = timestamp;
+    }
+    return ok;
+}
+
+/*! @brief Returns the last decoded image */
+const NUImage* ImageStreamCodec::getImage() const
+{
+    return &m_image;
+}
+
+/*! @brief Returns the last decoded classified image */
+ClassifiedImage* ImageStreamCodec::getClassifiedImage()
+{
+    return &m_classified;
+}
+
+/*! @brief Returns the sequence number of the decoder's Delta reference frame, to be sent with the next request */
+unsigned int ImageStreamCodec::getReference() const
+{
+    return m_reference_sequence;
+}
+
+/*! @brief Returns the request a client sends to ask for a frame with the given encoding
+    @param encoding the encoding to ask for
+    @param reference the client's Delta reference frame (see getReference())
+ */
+string ImageStreamCodec::makeRequest(Encoding encoding, unsigned int reference)
+{
+    stringstream request;
+    request << RequestPrefix << " " << static_cast<int>(encoding) << " " << reference;
+    return request.str();
+}
+
+/*! @brief Parses a request made with makeRequest()
+    @param data the received request
+    @param size the number of bytes in data
+    @param encoding will be updated with the requested encoding
+    @param reference will be updated with the client's Delta reference frame
+    @return false if data is not a request for an encoded frame, for example the "1" sent by older clients for a raw frame
+ */
+bool ImageStreamCodec::parseRequest(const char* data, int size, Encoding& encoding, unsigned int& reference)
+{
+    if (data == NULL or size < 1 or data[0] != RequestPrefix)
+        return false;
+
+    char buffer[64];
+    int length = size < static_cast<int>(sizeof(buffer)) - 1 ? size : sizeof(buffer) - 1;
+    memcpy(buffer, data, length);
+    buffer[length] = '\0';
+
+    int requested = Raw;
+    unsigned int requestedreference = 0;
+    if (sscanf(buffer + 1, "%d %u", &requested, &requestedreference) < 1 or requested < 0 or requested >= NumEncodings)
+        return false;
+    encoding = static_cast<Encoding>(requested);
+    reference = requestedreference;
+    return true;
+}
+
+/*! @brief Returns the name of the encoding */
+string ImageStreamCodec::getName(int encoding)
+{
+    switch (encoding)
+    {
+        case Raw: return "Raw";
+        case SubsampledY: return "Subsampled Y";
+        case ClassifiedRLE: return "Classified RLE";
+        case Delta: return "Delta";
+        default: return "Unknown";
+    }
+}
+
+/*! @brief Packs the rows of the image into the body */
+void ImageStreamCodec::encodeRaw(const NUImage& image, vector<char>& body)
+{
+    int width = image.getWidth();
+    int height = image.getHeight();
+    size_t rowsize = sizeof(Pixel)*width;
+    body.resize(rowsize*height);
+    for (int y=0; y<height; y++)
+        memcpy(&body[y*rowsize], &image.m_image[y][0], rowsize);
+}
+
+/*! @brief Puts the Y channel of every SubsampleFactor-th pixel of every SubsampleFactor-th row into the body */
+void ImageStreamCodec::encodeSubsampledY(const NUImage& image, vector<char>& body)
+{
+    int width = image.getWidth()/SubsampleFactor;
+    int height = image.getHeight()/SubsampleFactor;
+    body.resize(width*height);
+    char* out = body.empty() ? 0 : &body[0];
+    for (int y=0; y<height; y++)
+    {
+        const Pixel* row = image.m_image[y*SubsampleFactor];
+        for (int x=0; x<width; x++)
+            *out++ = row[x*SubsampleFactor].y;
+    }
+}
+
+/*! @brief Classifies the image with the lut, and puts the runs of each colour into the body as [colour, length] pairs.
+           Runs continue from one row to the next, and are at most 255 pixels long.
+ */
+void ImageStreamCodec::encodeClassifiedRLE(const NUImage& image, const unsigned char* lut, vector<char>& body)
+{
+    int width = image.getWidth();
+    int height = image.getHeight();
+    body.resize(2*width*height);
+    size_t used = 0;
+    unsigned char colour = 0;
+    unsigned int length = 0;
+    for (int y=0; y<height; y++)
+    {
+        const Pixel* row = image.m_image[y];
+        for (int x=0; x<width; x++)
+        {
+            unsigned char c = lut[LUTTools::getLUTIndex(row[x])];
+            if (length > 0 and (c != colour or length == 255))
+            {
+                body[used++] = colour;
+                body[used++] = length;
+                length = 0;
+            }
+            colour = c;
+            length++;
+        }
+    }
+    if (length > 0)
+    {
+        body[used++] = colour;
+        body[used++] = length;
+    }
+    body.resize(used);
+}
+
+/*! @brief Puts the pixels that differ from the reference into the body, and updates the reference.
+
+    The body is a sequence of blocks of [unsigned short unchanged, unsigned short changed, changed pixels].
+    @return false if the delta would be larger than a key frame, in which case the body and the reference are unusable
+ */
+bool ImageStreamCodec::encodeDelta(const NUImage& image, vector<char>& body)
+{
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int total = width*height;
+    size_t limit = sizeof(Pixel)*total;
+    body.resize(limit);
+
+    size_t used = 0;
+    int i = 0, x = 0, y = 0;
+    const Pixel* row = image.m_image[0];
+    while (i < total)
+    {
+        unsigned short unchanged = 0;
+        unsigned short changed = 0;
+        if (used + 2*sizeof(unsigned short) > limit)
+            return false;
+        size_t block = used;
+        used += 2*sizeof(unsigned short);
+        while (i < total and unchanged < 0xFFFF and not isChanged(row[x], m_reference[i]))
+        {
+            unchanged++;
+            i++;
+            if (++x == width and ++y < height)
+            {
+                x = 0;
+                row = image.m_image[y];
+            }
+        }
+        while (i < total and changed < 0xFFFF and isChanged(row[x], m_reference[i]))
+        {
+            if (used + sizeof(Pixel) > limit)
+                return false;
+            m_reference[i] = row[x];
+            memcpy(&body[used], &row[x], sizeof(Pixel));
+            used += sizeof(Pixel);
+            changed++;
+            i++;
+            if (++x == width and ++y < height)
+            {
+                x = 0;
+                row = image.m_image[y];
+            }
+        }
+        memcpy(&body[block], &unchanged, sizeof(unchanged));
+        memcpy(&body[block + sizeof(unchanged)], &changed, sizeof(changed));
+    }
+    body.resize(used);
+    return true;
+}
+
+/*! @brief Copies the image into the Delta reference */
+void ImageStreamCodec::setReference(const NUImage& image)
+{
+    m_reference_width = image.getWidth();
+    m_reference_height = image.getHeight();
+    m_reference.resize(m_reference_width*m_reference_height);
+    for (int y=0; y<m_reference_height; y++)
+        memcpy(&m_reference[y*m_reference_width], &image.m_image[y][0], sizeof(Pixel)*m_reference_width);
+}
+
+/*! @brief Copies the packed rows in the body into pixels */
+bool ImageStreamCodec::decodeRaw(int width, int height, const char* body, int size, vector<Pixel>& pixels)
+{
+    if (size != static_cast<int>(sizeof(Pixel))*width*height)
+        return false;
+    pixels.resize(width*height);
+    memcpy(&pixels[0], body, size);
+    return true;
+}
+
+/*! @brief Expands the subsampled Y channel back to a full size grey image */
+bool ImageStreamCodec::decodeSubsampledY(int width, int height, const char* body, int size)
+{
+    int subwidth = width/SubsampleFactor;
+    int subheight = height/SubsampleFactor;
+    if (size != subwidth*subheight)
+        return false;
+
+    m_pixels.resize(width*height);
+    Pixel grey;
+    grey.color = 0;
+    grey.cb = 128;
+    grey.cr = 128;
+    for (int y=0; y<height; y++)
+    {
+        int sy = y/SubsampleFactor < subheight ? y/SubsampleFactor : subheight - 1;
+        const unsigned char* row = reinterpret_cast<const unsigned char*>(body) + sy*subwidth;
+        Pixel* out = &m_pixels[y*width];
+        for (int x=0; x<width; x++)
+        {
+            int sx = x/SubsampleFactor < subwidth ? x/SubsampleFactor : subwidth - 1;
+            grey.y = subwidth > 0 and subheight > 0 ? row[sx] : 0;
+            out[x] = grey;
+        }
+    }
+    m_image.MapBufferToImage(&m_pixels[0], width, height);
+    return true;
+}
+
+/*! @brief Expands the runs into the classified image */
+bool ImageStreamCodec::decodeClassifiedRLE(int width, int height, const char* body, int size)
+{
+    if (size % 2 != 0)
+        return false;
+    if (m_classified.width() != width or m_classified.height() != height)
+    {
+        m_classified.useInternalBuffer(true);
+        m_classified.setImageDimensions(width, height);
+    }
+
+    int total = width*height;
+    int position = 0;
+    const unsigned char* run = reinterpret_cast<const unsigned char*>(body);
+    for (int i=0; i<size; i+=2)
+    {
+        unsigned char colour = run[i];
+        int length = run[i+1];
+        if (position + length > total)
+            return false;
+        for (int j=0; j<length; j++, position++)
+            m_classified.image[position/width][position%width] = colour;
+    }
+    return position == total;
+}
+
+/*! @brief Applies the changed pixels in the body to the reference */
+bool ImageStreamCodec::decodeDelta(int width, int height, const char* body, int size)
+{
+    size_t total = width*height;
+    size_t position = 0;
+    int used = 0;
+    unsigned short unchanged, changed;
+    while (used < size)
+    {
+        if (used + static_cast<int>(2*sizeof(unsigned short)) > size)
+            return false;
+        memcpy(&unchanged, body + used, sizeof(unchanged));
+        memcpy(&changed, body + used + sizeof(unchanged), sizeof(changed));
+        used += 2*sizeof(unsigned short);
+        position += unchanged;
+        if (position + changed > total or used + changed*static_cast<int>(sizeof(Pixel)) > size)
+            return false;
+        memcpy(&m_reference[position], body + used, changed*sizeof(Pixel));
+        position += changed;
+        used += changed*sizeof(Pixel);
+    }
+    return position <= total;
+}
+
+/*! @brief Returns true if any of the channels of a and b differ by more than DeltaThreshold */
+bool ImageStreamCodec::isChanged(const Pixel& a, const Pixel& b)
+{
+    return abs(a.y - b.y) > DeltaThreshold or abs(a.cb - b.cb) > DeltaThreshold or abs(a.cr - b.cr) > DeltaThreshold;
+}
+
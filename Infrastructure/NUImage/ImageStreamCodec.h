@@ -0,0 +1,112 @@
+/*! @file ImageStreamCodec.h
+    @brief Declaration of the image encodings used by the vision debug stream
+
+    @class ImageStreamCodec
+    @brief Encodes and decodes the images sent over the vision debug stream to NUView
+
+    A raw image is 4 bytes per pixel, which saturates the robot's wireless link at a few frames a second.
+    The client picks one of the encodings when it requests a frame:
+        - Raw the packed pixels, exactly as the original stream
+        - SubsampledY only the Y channel of every SubsampleFactor-th pixel and row
+        - ClassifiedRLE the image classified with the robot's lookup table, run length encoded
+        - Delta only the pixels that changed by more than DeltaThreshold since the client's reference frame
+
+    A Delta frame is only sent relative to the reference frame the client says it has (see makeRequest()).
+    If the client's reference is not the encoder's reference, for instance because the last frame was dropped,
+    a key frame is sent instead; a key frame is a Delta frame with a Reference of 0 and a raw body. The encoder
+    updates its reference exactly as the decoder will, so unchanged pixels never drift by more than DeltaThreshold.
+
+    Each side of the link uses its own codec; the robot calls encode(), and NUView calls decode().
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGESTREAMCODEC_H
+#define IMAGESTREAMCODEC_H
+
+#include "NUImage.h"
+#include "ClassifiedImage.h"
+
+#include <vector>
+#include <string>
+using namespace std;
+
+class ImageStreamCodec
+{
+public:
+    enum Encoding
+    {
+        Raw = 0,
+        SubsampledY = 1,
+        ClassifiedRLE = 2,
+        Delta = 3,
+        NumEncodings = 4
+    };
+    /*! @brief The description of an encoded frame. It is sent after the [sensors size, width, height, timestamp] header */
+    struct FrameInfo
+    {
+        int Encoding;               //!< the encoding of the body, this can differ from the requested encoding
+        int BodySize;               //!< the number of bytes in the encoded body
+        unsigned int Sequence;      //!< the frame's sequence number, never 0
+        unsigned int Reference;     //!< the sequence number of the frame a Delta frame is relative to, 0 for a key frame
+        int EncodeTime;             //!< the time taken to encode the frame on the robot in microseconds
+    };
+    static const int SubsampleFactor = 2;       //!< the spacing of the pixels and rows kept in SubsampledY
+    static const int DeltaThreshold = 6;        //!< the largest change in a channel for which a pixel is considered unchanged in Delta
+    static const char RequestPrefix = 'S';      //!< the first byte of a request for an encoded frame
+
+    ImageStreamCodec();
+    ~ImageStreamCodec();
+
+    FrameInfo encode(Encoding encoding, const NUImage& image, const unsigned char* lut, unsigned int reference, vector<char>& body);
+    bool decode(const FrameInfo& info, int width, int height, double timestamp, const char* body);
+
+    const NUImage* getImage() const;
+    ClassifiedImage* getClassifiedImage();
+    unsigned int getReference() const;
+
+    static string makeRequest(Encoding encoding, unsigned int reference);
+    static bool parseRequest(const char* data, int size, Encoding& encoding, unsigned int& reference);
+    static string getName(int encoding);
+private:
+    void encodeRaw(const NUImage& image, vector<char>& body);
+    void encodeSubsampledY(const NUImage& image, vector<char>& body);
+    void encodeClassifiedRLE(const NUImage& image, const unsigned char* lut, vector<char>& body);
+    bool encodeDelta(const NUImage& image, vector<char>& body);
+    void setReference(const NUImage& image);
+
+    bool decodeRaw(int width, int height, const char* body, int size, vector<Pixel>& pixels);
+    bool decodeSubsampledY(int width, int height, const char* body, int size);
+    bool decodeClassifiedRLE(int width, int height, const char* body, int size);
+    bool decodeDelta(int width, int height, const char* body, int size);
+
+    static bool isChanged(const Pixel& a, const Pixel& b);
+private:
+    unsigned int m_sequence;            //!< the sequence number of the last frame encoded
+    unsigned int m_reference_sequence;  //!< the sequence number of m_reference, 0 if there is no reference
+    int m_reference_width;              //!< the width of m_reference
+    int m_reference_height;             //!< the height of m_reference
+    vector<Pixel> m_reference;          //!< the reference frame for Delta, identical on the encoder and the decoder
+
+    vector<Pixel> m_pixels;             //!< the decoded Raw and SubsampledY pixels
+    NUImage m_image;                    //!< the last decoded image, mapped onto m_pixels or m_reference
+    ClassifiedImage m_classified;       //!< the last decoded classified image
+};
+
+#endif
+
@@ -23,6 +23,7 @@ ENDIF()
 SET (YOUR_SRCS
 BresenhamLine.cpp
 ClassifiedImage.cpp
+ImageStreamCodec.cpp
 NUImage.cpp
 #JpegSaver.cpp  
 )
@@ -1090,8 +1090,10 @@ ostream& operator<< (ostream& output, const NUSensorsData& p_data)
  */
 istream& operator>> (istream& input, NUSensorsData& p_data)
 {
-    input >> p_data.m_common_ids;
-    input >> p_data.m_ids_copy;
+    // the ids are compiled in, and m_common_ids is shared by every NUData, so the ids in the stream are only read past
+    vector<string> ids;
+    input >> ids;
+    input >> ids;
     input >> p_data.m_id_to_indices;
     input >> p_data.m_available_ids;
     p_data.m_sensors.clear();
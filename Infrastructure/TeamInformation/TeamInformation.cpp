@@ -29,6 +29,7 @@
 #include "Tools/FileFormats/FileFormatException.h"
 
 #include <memory.h>
+#include <math.h>
 
 #include "debug.h"
 #include "debugverbositynetwork.h"
@@ -37,11 +38,12 @@ TeamInformation::TeamInformation(int playernum, int teamnum) : TimestampedData()
 {
     m_player_number = playernum;
     m_team_number = teamnum;
-    m_data = Blackboard->Sensors;
+    m_timestamp = 0;
     m_actions = Blackboard->Actions;
     m_objects = Blackboard->Objects;
     
     initTeamPacket();
+    m_packets.initialise(m_packet);
     m_received_packets = PacketBufferArray(13, boost::circular_buffer<TeamPacket>(3));
     
     m_led_red = vector<float>(3,0);
@@ -61,7 +63,7 @@ bool TeamInformation::amIClosestToBall()
     {
         if (not m_received_packets[i].empty())
         {
-            if ((m_data->CurrentTime - m_received_packets[i].back().ReceivedTime < m_TIMEOUT) and (m_packet.TimeToBall > m_received_packets[i].back().TimeToBall))
+            if ((m_timestamp - m_received_packets[i].back().ReceivedTime < m_TIMEOUT) and (m_packet.TimeToBall > m_received_packets[i].back().TimeToBall))
                 return false;
         }
     }
@@ -76,7 +78,7 @@ vector<TeamPacket::SharedBall> TeamInformation::getSharedBalls() const
     sharedballs.reserve(m_received_packets.size());
     for (size_t i=0; i<m_received_packets.size(); i++)
     {
-        if (not m_received_packets[i].empty() and (m_data->CurrentTime - m_received_packets[i].back().ReceivedTime < m_TIMEOUT))
+        if (not m_received_packets[i].empty() and (m_timestamp - m_received_packets[i].back().ReceivedTime < m_TIMEOUT))
         {   // if there is a received packet that is not too old grab the shared ball
             sharedballs.push_back(m_received_packets[i].back().Ball);
         }
@@ -95,17 +97,27 @@ void TeamInformation::initTeamPacket()
     m_packet.TeamNumber = static_cast<char>(m_team_number);
 }
 
-/*! @brief Updates my team packet with the latest information
+/*! @brief Updates my team packet from the pinned sensor snapshot and the field objects, and publishes it for the network thread.
+           This should only be called by the SeeThinkThread, once each cycle.
+    @param sensors the SeeThinkThread's pinned sensor snapshot
  */
-void TeamInformation::updateTeamPacket()
+void TeamInformation::update(NUSensorsData* sensors)
 {
-    if (m_data == NULL or m_objects == NULL)
+    if (sensors == NULL or m_objects == NULL)
         return;
+    m_timestamp = sensors->CurrentTime;
+    updateTeamPacket(sensors);
+    m_packets.getWriteBuffer() = m_packet;
+    m_packets.publish();
+}
 
+/*! @brief Updates my team packet with the latest information
+ */
+void TeamInformation::updateTeamPacket(NUSensorsData* sensors)
+{
     m_packet.ID = m_packet.ID + 1;
-    m_packet.SentTime = m_data->CurrentTime;
-    m_timestamp = m_data->CurrentTime;
-    m_packet.TimeToBall = getTimeToBall();
+    m_packet.SentTime = sensors->CurrentTime;
+    m_packet.TimeToBall = getTimeToBall(sensors);
     
     // ------------------------------ Update shared localisation information
     // update shared ball
@@ -127,7 +139,7 @@ void TeamInformation::updateTeamPacket()
     m_packet.Self.SDHeading = self.sdHeading();
 }
 
-float TeamInformation::getTimeToBall()
+float TeamInformation::getTimeToBall(NUSensorsData* sensors)
 {
     float time = 600;
     
@@ -136,15 +148,15 @@ float TeamInformation::getTimeToBall()
     float balldistance = ball.estimatedDistance();
     float ballbearing = ball.estimatedBearing();
     
-    if (m_data->isIncapacitated())                                   // if we are incapacitated then we can't chase a ball
+    if (sensors->isIncapacitated())                                   // if we are incapacitated then we can't chase a ball
         return time;
     else if (m_player_number == 1 and balldistance > 150)            // goal keeper is a special case, don't chase balls too far away
         return time;
     else if (m_objects->mobileFieldObjects[FieldObjects::FO_BALL].TimeSeen() > 0)
     {   // if neither the ball or self are lost or if we can see the ball then we can chase.
         vector<float> walkspeed, maxspeed;
-        m_data->get(NUSensorsData::MotionWalkSpeed, walkspeed);
-        m_data->get(NUSensorsData::MotionWalkMaxSpeed, maxspeed);
+        sensors->get(NUSensorsData::MotionWalkSpeed, walkspeed);
+        sensors->get(NUSensorsData::MotionWalkMaxSpeed, maxspeed);
         
         // Add time for the movement to the ball
         time = balldistance/maxspeed[0] + fabs(ballbearing)/maxspeed[2];
@@ -193,6 +205,153 @@ istream& TeamPacket::fromFile(istream& input)
     return input;
 }
 
+const float TeamPacket::BallThreshold = 10;
+const float TeamPacket::SelfThreshold = 10;
+const float TeamPacket::HeadingThreshold = 0.1;
+const float TeamPacket::TimeToBallThreshold = 0.5;
+
+/*! @brief Writes value to buffer in little endian order, and advances buffer */
+static void writeLittleEndian(char*& buffer, unsigned int value)
+{
+    for (unsigned int i=0; i<4; i++)
+        *buffer++ = static_cast<char>((value >> (8*i)) & 0xFF);
+}
+
+/*! @brief Writes value to buffer in little endian order, and advances buffer */
+static void writeLittleEndian(char*& buffer, float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeLittleEndian(buffer, bits);
+}
+
+/*! @brief Writes value to buffer in little endian order, and advances buffer */
+static void writeLittleEndian(char*& buffer, double value)
+{
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeLittleEndian(buffer, static_cast<unsigned int>(bits & 0xFFFFFFFF));
+    writeLittleEndian(buffer, static_cast<unsigned int>(bits >> 32));
+}
+
+/*! @brief Reads a little endian value from buffer, and advances buffer */
+static void readLittleEndian(const char*& buffer, unsigned int& value)
+{
+    value = 0;
+    for (unsigned int i=0; i<4; i++)
+        value |= static_cast<unsigned int>(static_cast<unsigned char>(*buffer++)) << (8*i);
+}
+
+/*! @brief Reads a little endian value from buffer, and advances buffer */
+static void readLittleEndian(const char*& buffer, float& value)
+{
+    unsigned int bits;
+    readLittleEndian(buffer, bits);
+    memcpy(&value, &bits, sizeof(value));
+}
+
+/*! @brief Reads a little endian value from buffer, and advances buffer */
+static void readLittleEndian(const char*& buffer, double& value)
+{
+    unsigned int low, high;
+    readLittleEndian(buffer, low);
+    readLittleEndian(buffer, high);
+    unsigned long long bits = (static_cast<unsigned long long>(high) << 32) | low;
+    memcpy(&value, &bits, sizeof(value));
+}
+
+/*! @brief Encodes the packet in the wire layout
+    @param packet the packet to encode
+    @param buffer the buffer to encode the packet into
+    @param size the size of the buffer, it must be at least WireSize
+    @return the number of bytes written, or 0 if the buffer is too small
+ */
+unsigned int TeamPacket::encode(const TeamPacket& packet, char* buffer, unsigned int size)
+{
+    if (buffer == NULL or size < WireSize)
+        return 0;
+    char* p = buffer;
+    memcpy(p, TEAM_PACKET_STRUCT_HEADER, 4);
+    p += 4;
+    *p++ = static_cast<char>(WireVersion);
+    *p++ = packet.PlayerNumber;
+    *p++ = packet.TeamNumber;
+    *p++ = 0;
+    writeLittleEndian(p, static_cast<unsigned int>(packet.ID));
+    writeLittleEndian(p, packet.SentTime);
+    writeLittleEndian(p, packet.TimeToBall);
+
+    writeLittleEndian(p, packet.Ball.TimeSinceLastSeen);
+    writeLittleEndian(p, packet.Ball.X);
+    writeLittleEndian(p, packet.Ball.Y);
+    writeLittleEndian(p, packet.Ball.SRXX);
+    writeLittleEndian(p, packet.Ball.SRXY);
+    writeLittleEndian(p, packet.Ball.SRYY);
+
+    writeLittleEndian(p, packet.Self.X);
+    writeLittleEndian(p, packet.Self.Y);
+    writeLittleEndian(p, packet.Self.Heading);
+    writeLittleEndian(p, packet.Self.SDX);
+    writeLittleEndian(p, packet.Self.SDY);
+    writeLittleEndian(p, packet.Self.SDHeading);
+    return p - buffer;
+}
+
+/*! @brief Decodes a packet in the wire layout
+    @param buffer the received data
+    @param size the number of bytes received
+    @param packet will be updated with the received packet. The ReceivedTime is not changed.
+    @return false if the data is not a team packet of the current version
+ */
+bool TeamPacket::decode(const char* buffer, unsigned int size, TeamPacket& packet)
+{
+    if (buffer == NULL or size != WireSize or memcmp(buffer, TEAM_PACKET_STRUCT_HEADER, 4) != 0 or static_cast<unsigned char>(buffer[4]) != WireVersion)
+        return false;
+    const char* p = buffer;
+    memcpy(packet.Header, p, 4);
+    p += 5;
+    packet.PlayerNumber = *p++;
+    packet.TeamNumber = *p++;
+    p++;
+    unsigned int id;
+    readLittleEndian(p, id);
+    packet.ID = id;
+    readLittleEndian(p, packet.SentTime);
+    readLittleEndian(p, packet.TimeToBall);
+
+    readLittleEndian(p, packet.Ball.TimeSinceLastSeen);
+    readLittleEndian(p, packet.Ball.X);
+    readLittleEndian(p, packet.Ball.Y);
+    readLittleEndian(p, packet.Ball.SRXX);
+    readLittleEndian(p, packet.Ball.SRXY);
+    readLittleEndian(p, packet.Ball.SRYY);
+
+    readLittleEndian(p, packet.Self.X);
+    readLittleEndian(p, packet.Self.Y);
+    readLittleEndian(p, packet.Self.Heading);
+    readLittleEndian(p, packet.Self.SDX);
+    readLittleEndian(p, packet.Self.SDY);
+    readLittleEndian(p, packet.Self.SDHeading);
+    return true;
+}
+
+/*! @brief Returns true if this packet is different enough from the previous packet to be worth sending.
+
+    A packet is worth sending if the shared ball or self estimates have moved, if the time to ball has changed, or if the ball has just been seen again.
+ */
+bool TeamPacket::hasChangedFrom(const TeamPacket& previous) const
+{
+    if (fabs(Ball.X - previous.Ball.X) > BallThreshold or fabs(Ball.Y - previous.Ball.Y) > BallThreshold)
+        return true;
+    if (Ball.TimeSinceLastSeen < previous.Ball.TimeSinceLastSeen)
+        return true;
+    if (fabs(Self.X - previous.Self.X) > SelfThreshold or fabs(Self.Y - previous.Self.Y) > SelfThreshold or fabs(Self.Heading - previous.Self.Heading) > HeadingThreshold)
+        return true;
+    if (fabs(TimeToBall - previous.TimeToBall) > TimeToBallThreshold)
+        return true;
+    return false;
+}
+
 std::string TeamPacket::toString() const
 {
     std::stringstream result;
@@ -209,20 +368,16 @@ void TeamPacket::summaryTo(ostream& output) const
     output << endl;
 }
 
+/*! @brief Returns the team packet most recently published by update(). This should only be called by the network thread.
+ */
 TeamPacket TeamInformation::generateTeamTransmissionPacket()
 {
-    updateTeamPacket();
-    return m_packet;
+    return m_packets.acquire();
 }
 
 void TeamInformation::addReceivedTeamPacket(TeamPacket& receivedPacket)
 {
-    double timenow;
-    if (m_data != NULL)
-        timenow = m_data->CurrentTime;
-    else
-        timenow = Platform->getTime();
-    receivedPacket.ReceivedTime = timenow;
+    receivedPacket.ReceivedTime = Platform->getTime();      // this is run by the network thread, so we can't look at the SeeThinkThread's sensors
 
     if (receivedPacket.PlayerNumber > 0 and (unsigned) receivedPacket.PlayerNumber < m_received_packets.size() and receivedPacket.PlayerNumber != m_player_number and receivedPacket.TeamNumber == m_team_number)
     {   // only accept packets from valid player numbers
@@ -235,7 +390,7 @@ void TeamInformation::addReceivedTeamPacket(TeamPacket& receivedPacket)
         else
         {
             TeamPacket lastpacket = m_received_packets[receivedPacket.PlayerNumber].back();
-            if (timenow - lastpacket.ReceivedTime > 2000)
+            if (receivedPacket.ReceivedTime - lastpacket.ReceivedTime > 2000)
             {   // if there have been no packets recently from this player always accept the packet
                 m_received_packets[receivedPacket.PlayerNumber].push_back(receivedPacket);
             }
@@ -397,12 +552,7 @@ istream& operator>> (istream& input, TeamInformation& info)
 {
     TeamPacket temp;
     input >> temp;
-    double timenow;
-    if (info.m_data != NULL)
-        timenow = info.m_data->CurrentTime;
-    else
-        timenow = Platform->getTime();
-    temp.ReceivedTime = timenow;
+    temp.ReceivedTime = Platform->getTime();
     
     if (temp.PlayerNumber > 0 and (unsigned) temp.PlayerNumber < info.m_received_packets.size() and temp.PlayerNumber != info.m_player_number and temp.TeamNumber == info.m_team_number)
     {   // only accept packets from valid player numbers
@@ -414,7 +564,7 @@ istream& operator>> (istream& input, TeamInformation& info)
         else
         {
             TeamPacket lastpacket = info.m_received_packets[temp.PlayerNumber].back();
-            if (timenow - lastpacket.ReceivedTime > 2000)
+            if (temp.ReceivedTime - lastpacket.ReceivedTime > 2000)
             {   // if there have been no packets recently from this player always accept the packet
                 info.m_received_packets[temp.PlayerNumber].push_back(temp);
             }
@@ -33,10 +33,18 @@ class FieldObjects;
 #include <vector>
 #include <iostream>
 #include "Tools/FileFormats/TimestampedData.h"
+#include "Tools/Threading/TripleBuffer.h"
 using namespace std;
 
 #define TEAM_PACKET_STRUCT_HEADER "NUtm"
 
+/*! @brief The packet shared between team mates.
+
+    On the network the packet is sent in a fixed, versioned, little endian layout of WireSize bytes
+    [header, version, player, team, reserved, id, sent time, time to ball, ball, self] written with encode() and read
+    with decode(). Neither allocates, so a packet can be encoded into, and decoded from, a buffer on the stack.
+    The ReceivedTime is local to each robot and is not sent.
+ */
 class TeamPacket
 {
 public:
@@ -68,6 +76,17 @@ public:
     SharedBall Ball;
     SharedSelf Self;
 
+    static const unsigned char WireVersion = 1;         //!< the version of the wire layout, increment this when the layout changes
+    static const unsigned int WireSize = 72;            //!< the size in bytes of an encoded packet
+    static const float BallThreshold;                   //!< the change in the shared ball position (cm) that is worth sending
+    static const float SelfThreshold;                   //!< the change in the shared self position (cm) that is worth sending
+    static const float HeadingThreshold;                //!< the change in the shared self heading (rad) that is worth sending
+    static const float TimeToBallThreshold;             //!< the change in the time to ball (s) that is worth sending
+
+    static unsigned int encode(const TeamPacket& packet, char* buffer, unsigned int size);
+    static bool decode(const char* buffer, unsigned int size, TeamPacket& packet);
+    bool hasChangedFrom(const TeamPacket& previous) const;
+
     std::string toString() const;
     ostream& toFile(ostream& output) const;
     istream& fromFile(istream& input);
@@ -91,6 +110,7 @@ public:
     
     vector<TeamPacket::SharedBall> getSharedBalls() const;
     
+    void update(NUSensorsData* sensors);
     void UpdateTime(double newTime) {m_timestamp=newTime;};
     double GetTimestamp() const{return m_timestamp;};
     std::string toString() const;
@@ -104,19 +124,19 @@ public:
     void addReceivedTeamPacket(TeamPacket& receivedPacket);
 private:
     void initTeamPacket();
-    void updateTeamPacket();
-    float getTimeToBall();
+    void updateTeamPacket(NUSensorsData* sensors);
+    float getTimeToBall(NUSensorsData* sensors);
 private:
     const float m_TIMEOUT;
     int m_player_number;
     int m_team_number;
     double m_timestamp;
 
-    NUSensorsData* m_data;
     NUActionatorsData* m_actions;
     FieldObjects* m_objects;
     
     TeamPacket m_packet;                                                //!< team packet to send
+    TripleBuffer<TeamPacket> m_packets;                                 //!< the team packets passed from the SeeThinkThread to the network thread
 
     PacketBufferArray m_received_packets;     //!< team packets received from other robots
     
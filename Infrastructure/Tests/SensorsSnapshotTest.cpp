@@ -0,0 +1,151 @@
+/*! @file SensorsSnapshotTest.cpp
+    @brief Runs a SenseMoveThread-like publisher against a SeeThinkThread-like reader of the Blackboard's sensor snapshots.
+
+    The publisher owns Blackboard->Sensors, a real NUSensorsData. Each cycle it writes the cycle number into
+    several sensors and the timestamp, adds to the accumulated odometry as NUSensors does, and then calls
+    publishSensors(). The reader calls pinSensors() as fast as it can, and checks that every pinned snapshot
+    is whole (all of its sensors are from the same cycle), that the version matches the cycle and never goes
+    backwards, and that the odometry in each new snapshot is exactly the odometry since the previously pinned
+    one. A snapshot pinned again without a new one keeps its odometry. At the end the odometry deltas must add
+    up to the publisher's accumulated odometry, so that no movement is lost or counted twice.
+
+    This is not part of the nubot build. It needs the objects of a nubot build for the blackboard and the sensor
+    data, so build a target (eg. Replay in Build/Replay) and then:
+        ar rcs libnubot.a $(find Build/Replay/CMakeFiles/nubot.dir -name '*.o' ! -name main.cpp.o)
+        g++ -O2 -pthread -I. -INUView/NUViewConfig Infrastructure/Tests/SensorsSnapshotTest.cpp libnubot.a -o sensorssnapshottest
+    To check for data races, configure the target with -fsanitize=thread -g added to CMAKE_CXX_FLAGS, and add the
+    same flags to the line above. It exits with 0 if every check passed.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Infrastructure/NUBlackboard.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <pthread.h>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+static const unsigned long NumCycles = 100000;
+static const float OdometryStep[] = {1, 2, 3};      // the x, y and heading moved each cycle; integers so the sums are exact
+static volatile int PublisherDone = 0;
+
+/*! The SenseMoveThread's part: fill in the sensors for the cycle, and publish them */
+static void* publish(void*)
+{
+    NUSensorsData* sensors = Blackboard->Sensors;
+    std::vector<float> odometry(3, 0);
+    for (unsigned long n = 1; n <= NumCycles; n++)
+    {
+        float value = n;
+        sensors->CurrentTime = 10.0*n;
+        sensors->set(NUSensorsData::Accelerometer, sensors->CurrentTime, std::vector<float>(3, value));
+        sensors->set(NUSensorsData::Gyro, sensors->CurrentTime, std::vector<float>(3, value));
+        sensors->set(NUSensorsData::Compass, sensors->CurrentTime, value);
+        for (size_t i = 0; i < odometry.size(); i++)
+            odometry[i] += OdometryStep[i];
+        sensors->set(NUSensorsData::Odometry, sensors->CurrentTime, odometry);
+        Blackboard->publishSensors();
+    }
+    __sync_fetch_and_add(&PublisherDone, 1);
+    return NULL;
+}
+
+/*! @brief Returns true if every value of the sensor is the same as the cycle number */
+static bool isFromCycle(NUSensorsData* snapshot, const NUSensorsData::id_t& id, float cycle)
+{
+    std::vector<float> values;
+    if (not snapshot->get(id, values) or values.empty())
+        return false;
+    for (size_t i = 0; i < values.size(); i++)
+        if (values[i] != cycle)
+            return false;
+    return true;
+}
+
+int main()
+{
+    new NUBlackboard();
+    NUSensorsData* sensors = new NUSensorsData();
+    sensors->addSensors(std::vector<std::string>());
+    Blackboard->add(sensors);
+
+    pthread_t publisher;
+    pthread_create(&publisher, NULL, publish, NULL);
+
+    unsigned long pinned = 0, fresh = 0, torn = 0, mismatched = 0, backwards = 0, wrongodometry = 0;
+    unsigned long lastcycle = 0;
+    std::vector<float> lastdelta(3, 0), total(3, 0);
+    bool done = false;
+    while (not done)
+    {
+        done = __sync_fetch_and_add(&PublisherDone, 0) > 0;      // check before pinning, so the last snapshot is always seen
+        unsigned long previousversion = Blackboard->getPinnedSensorsVersion();
+        NUSensorsData* snapshot = Blackboard->pinSensors();
+        unsigned long version = Blackboard->getPinnedSensorsVersion();
+        pinned++;
+        if (version == 0)
+            continue;                                           // nothing has been published yet
+        if (version < previousversion)
+            backwards++;
+
+        float compass;
+        unsigned long cycle = static_cast<unsigned long>(snapshot->CurrentTime/10.0);
+        if (not isFromCycle(snapshot, NUSensorsData::Accelerometer, cycle) or not isFromCycle(snapshot, NUSensorsData::Gyro, cycle)
+            or not snapshot->get(NUSensorsData::Compass, compass) or compass != cycle)
+            torn++;
+        if (cycle != version)
+            mismatched++;
+
+        std::vector<float> delta;
+        snapshot->get(NUSensorsData::Odometry, delta);
+        bool isnew = version != previousversion;
+        for (size_t i = 0; i < lastdelta.size(); i++)
+        {
+            float expected = isnew ? (cycle - lastcycle)*OdometryStep[i] : lastdelta[i];
+            if (delta.size() != lastdelta.size() or delta[i] != expected)
+            {
+                wrongodometry++;
+                break;
+            }
+        }
+        if (isnew and delta.size() == total.size())
+        {
+            fresh++;
+            for (size_t i = 0; i < total.size(); i++)
+                total[i] += delta[i];
+            lastdelta = delta;
+            lastcycle = cycle;
+        }
+    }
+    pthread_join(publisher, NULL);
+
+    bool complete = lastcycle == NumCycles;
+    for (size_t i = 0; i < total.size(); i++)
+        complete = complete and total[i] == NumCycles*OdometryStep[i];
+
+    bool passed = complete and torn == 0 and mismatched == 0 and backwards == 0 and wrongodometry == 0;
+    printf("%lu snapshots pinned, %lu new: %lu torn, %lu with the wrong version, %lu went backwards, %lu with the wrong odometry\n", pinned, fresh, torn, mismatched, backwards, wrongodometry);
+    printf("Total odometry (%.0f, %.0f, %.0f) of (%.0f, %.0f, %.0f) published: %s\n", total[0], total[1], total[2], NumCycles*OdometryStep[0], NumCycles*OdometryStep[1], NumCycles*OdometryStep[2], passed ? "PASSED" : "FAILED");
+    delete Blackboard;
+    return passed ? 0 : 1;
+}
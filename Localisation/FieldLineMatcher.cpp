@@ -0,0 +1,272 @@
+/*!
+  @file FieldLineMatcher.cpp
+  @brief Implementation of the FieldLineMatcher class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "FieldLineMatcher.h"
+
+#include <cmath>
+#include <algorithm>
+
+const float FieldLineMatcher::CellSize = 5.0f;
+const float FieldLineMatcher::Border = 70.0f;
+const float FieldLineMatcher::MaxDistance = 100.0f;
+const float FieldLineMatcher::InlierDistance = 40.0f;
+
+// The field dimensions; these match the positions of the corners in FieldObjects
+static const float FieldHalfLength = 300.0f;
+static const float FieldHalfWidth = 200.0f;
+static const float PenaltyBoxX = 237.5f;
+static const float PenaltyBoxHalfWidth = 150.0f;
+static const float CentreCircleRadius = 60.0f;
+
+// The largest step in position (cm) and heading (rad) taken by one Gauss-Newton iteration
+static const float MaxPositionStep = 20.0f;
+static const float MaxHeadingStep = 0.2f;
+
+/*! @brief Returns the matcher. The distance grid is built the first time this is called. */
+const FieldLineMatcher& FieldLineMatcher::getInstance()
+{
+    static FieldLineMatcher matcher;
+    return matcher;
+}
+
+FieldLineMatcher::FieldLineMatcher()
+{
+    // Side lines, goal lines and the centre line
+    addLine(-FieldHalfLength, FieldHalfWidth, FieldHalfLength, FieldHalfWidth);
+    addLine(-FieldHalfLength, -FieldHalfWidth, FieldHalfLength, -FieldHalfWidth);
+    addLine(FieldHalfLength, -FieldHalfWidth, FieldHalfLength, FieldHalfWidth);
+    addLine(-FieldHalfLength, -FieldHalfWidth, -FieldHalfLength, FieldHalfWidth);
+    addLine(0, -FieldHalfWidth, 0, FieldHalfWidth);
+    // Penalty boxes
+    for (int side = -1; side <= 1; side += 2)
+    {
+        addLine(side*PenaltyBoxX, -PenaltyBoxHalfWidth, side*PenaltyBoxX, PenaltyBoxHalfWidth);
+        addLine(side*PenaltyBoxX, PenaltyBoxHalfWidth, side*FieldHalfLength, PenaltyBoxHalfWidth);
+        addLine(side*PenaltyBoxX, -PenaltyBoxHalfWidth, side*FieldHalfLength, -PenaltyBoxHalfWidth);
+    }
+    build();
+}
+
+void FieldLineMatcher::addLine(float x1, float y1, float x2, float y2)
+{
+    Line line;
+    line.X1 = x1;
+    line.Y1 = y1;
+    line.X2 = x2;
+    line.Y2 = y2;
+    m_lines.push_back(line);
+}
+
+/*! @brief Builds the distance grid from the field lines and the centre circle. The grid points are on the corners of the cells. */
+void FieldLineMatcher::build()
+{
+    m_left = -(FieldHalfLength + Border);
+    m_bottom = -(FieldHalfWidth + Border);
+    m_columns = (int) ceil(2*(FieldHalfLength + Border)/CellSize) + 1;
+    m_rows = (int) ceil(2*(FieldHalfWidth + Border)/CellSize) + 1;
+    m_distances.resize(m_columns*m_rows);
+
+    for (int row = 0; row < m_rows; row++)
+    {
+        float y = m_bottom + row*CellSize;
+        for (int col = 0; col < m_columns; col++)
+        {
+            float x = m_left + col*CellSize;
+            float nearest = fabs(sqrt(x*x + y*y) - CentreCircleRadius);
+            for (size_t i = 0; i < m_lines.size(); i++)
+            {
+                const Line& line = m_lines[i];
+                float dx = line.X2 - line.X1;
+                float dy = line.Y2 - line.Y1;
+                float t = ((x - line.X1)*dx + (y - line.Y1)*dy)/(dx*dx + dy*dy);
+                t = std::max(0.0f, std::min(1.0f, t));
+                float ex = line.X1 + t*dx - x;
+                float ey = line.Y1 + t*dy - y;
+                nearest = std::min(nearest, (float) sqrt(ex*ex + ey*ey));
+            }
+            m_distances[row*m_columns + col] = (unsigned char) (std::min(nearest, MaxDistance) + 0.5f);
+        }
+    }
+}
+
+/*! @brief Returns the distance from a point on the field to the nearest field line (cm), clipped to MaxDistance */
+float FieldLineMatcher::distance(float x, float y) const
+{
+    float gradx, grady;
+    return lookup(x, y, gradx, grady);
+}
+
+/*! @brief Looks up the distance from a point on the field to the nearest field line, interpolating between grid points
+    @param x the x position of the point on the field (cm)
+    @param y the y position of the point on the field (cm)
+    @param gradx the rate of change of the distance with x
+    @param grady the rate of change of the distance with y
+    @return the distance to the nearest line (cm), which is MaxDistance off the grid
+ */
+float FieldLineMatcher::lookup(float x, float y, float& gradx, float& grady) const
+{
+    float u = (x - m_left)/CellSize;
+    float v = (y - m_bottom)/CellSize;
+    int col = (int) floor(u);
+    int row = (int) floor(v);
+    if (col < 0 or row < 0 or col + 1 >= m_columns or row + 1 >= m_rows)
+    {
+        gradx = 0;
+        grady = 0;
+        return MaxDistance;
+    }
+    float fu = u - col;
+    float fv = v - row;
+    const unsigned char* cell = &m_distances[row*m_columns + col];
+    float d00 = cell[0];
+    float d10 = cell[1];
+    float d01 = cell[m_columns];
+    float d11 = cell[m_columns + 1];
+
+    gradx = ((d10 - d00)*(1 - fv) + (d11 - d01)*fv)/CellSize;
+    grady = ((d01 - d00)*(1 - fu) + (d11 - d10)*fu)/CellSize;
+    return (d00*(1 - fu) + d10*fu)*(1 - fv) + (d01*(1 - fu) + d11*fu)*fv;
+}
+
+/*! @brief Returns the mean squared distance from a set of line points to the nearest field lines, from a pose
+    @param x the x position of the robot on the field (cm)
+    @param y the y position of the robot on the field (cm)
+    @param heading the heading of the robot on the field (rad)
+    @param points the line points relative to the robot (x forward, y left in cm)
+    @return the mean squared distance (cm^2); outliers count as InlierDistance, and no points scores InlierDistance^2
+ */
+float FieldLineMatcher::score(float x, float y, float heading, const std::vector<Vector2<float> >& points) const
+{
+    if (points.empty())
+        return InlierDistance*InlierDistance;
+
+    float c = cos(heading);
+    float s = sin(heading);
+    float sum = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        float d = distance(x + c*points[i].x - s*points[i].y, y + s*points[i].x + c*points[i].y);
+        d = std::min(d, InlierDistance);
+        sum += d*d;
+    }
+    return sum/points.size();
+}
+
+/*! @brief Scores a pose, and finds the information and gradient (J'r) of the squared distances at the pose */
+FieldLineMatcher::Match FieldLineMatcher::evaluate(float x, float y, float heading, const std::vector<Vector2<float> >& points, float gradient[3]) const
+{
+    Match result;
+    result.X = x;
+    result.Y = y;
+    result.Heading = heading;
+    result.Error = InlierDistance*InlierDistance;
+    result.Inliers = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        gradient[i] = 0;
+        for (int j = 0; j < 3; j++)
+            result.Information[i][j] = 0;
+    }
+    if (points.empty())
+        return result;
+
+    float c = cos(heading);
+    float s = sin(heading);
+    float sum = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        float px = points[i].x;
+        float py = points[i].y;
+        float gx, gy;
+        float d = lookup(x + c*px - s*py, y + s*px + c*py, gx, gy);
+        if (d >= InlierDistance)
+        {
+            sum += InlierDistance*InlierDistance;
+            continue;
+        }
+        sum += d*d;
+        result.Inliers++;
+
+        float J[3] = {gx, gy, gx*(-s*px - c*py) + gy*(c*px - s*py)};
+        for (int r = 0; r < 3; r++)
+        {
+            gradient[r] += J[r]*d;
+            for (int k = 0; k < 3; k++)
+                result.Information[r][k] += J[r]*J[k];
+        }
+    }
+    result.Error = sum/points.size();
+    return result;
+}
+
+/*! @brief Refines a pose so that a set of line points lie on the field lines
+    @param x the x position of the robot on the field to start from (cm)
+    @param y the y position of the robot on the field to start from (cm)
+    @param heading the heading of the robot on the field to start from (rad)
+    @param points the line points relative to the robot (x forward, y left in cm)
+    @return the refined pose, its error, and the information the points give about it
+ */
+FieldLineMatcher::Match FieldLineMatcher::match(float x, float y, float heading, const std::vector<Vector2<float> >& points) const
+{
+    float gradient[3];
+    Match result = evaluate(x, y, heading, points, gradient);
+    for (int iteration = 0; iteration < MaxIterations and result.Inliers >= 3; iteration++)
+    {
+        // Solve (J'J + damping) step = -J'r by Cramer's rule; the damping keeps directions the points say nothing about still
+        float a[3][3];
+        for (int r = 0; r < 3; r++)
+            for (int k = 0; k < 3; k++)
+                a[r][k] = result.Information[r][k];
+        a[0][0] += 1e-3f*a[0][0] + 1e-2f;
+        a[1][1] += 1e-3f*a[1][1] + 1e-2f;
+        a[2][2] += 1e-3f*a[2][2] + 1e2f;
+        float det = a[0][0]*(a[1][1]*a[2][2] - a[1][2]*a[2][1])
+                  - a[0][1]*(a[1][0]*a[2][2] - a[1][2]*a[2][0])
+                  + a[0][2]*(a[1][0]*a[2][1] - a[1][1]*a[2][0]);
+        if (det == 0)
+            break;
+        float b[3] = {-gradient[0], -gradient[1], -gradient[2]};
+        float step[3];
+        for (int col = 0; col < 3; col++)
+        {
+            float m[3][3];
+            for (int r = 0; r < 3; r++)
+                for (int k = 0; k < 3; k++)
+                    m[r][k] = (k == col) ? b[r] : a[r][k];
+            step[col] = (m[0][0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1])
+                       - m[0][1]*(m[1][0]*m[2][2] - m[1][2]*m[2][0])
+                       + m[0][2]*(m[1][0]*m[2][1] - m[1][1]*m[2][0]))/det;
+        }
+        step[0] = std::max(-MaxPositionStep, std::min(MaxPositionStep, step[0]));
+        step[1] = std::max(-MaxPositionStep, std::min(MaxPositionStep, step[1]));
+        step[2] = std::max(-MaxHeadingStep, std::min(MaxHeadingStep, step[2]));
+
+        float candidategradient[3];
+        Match candidate = evaluate(result.X + step[0], result.Y + step[1], result.Heading + step[2], points, candidategradient);
+        if (candidate.Error >= result.Error)
+            break;
+        result = candidate;
+        for (int r = 0; r < 3; r++)
+            gradient[r] = candidategradient[r];
+    }
+    return result;
+}
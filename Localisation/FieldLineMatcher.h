@@ -0,0 +1,88 @@
+/*!
+  @file FieldLineMatcher.h
+  @brief Declaration of the FieldLineMatcher class.
+
+  @class FieldLineMatcher
+  @brief Scores and refines robot poses by matching the field line points seen by vision against a model of the field.
+
+  The distance from every point on the field to the nearest field line is precomputed once, on a grid over the
+  field and its border. A pose is scored by moving each line point from robot coordinates into field coordinates,
+  and looking up its distance to the nearest line; the cost is one table lookup per point, so whole sets of points
+  can be matched against many pose hypotheses each frame.
+
+  A pose is refined by a few Gauss-Newton steps on the looked up distances. The information (J'J) of the final step
+  says how well the points pin down the pose; a single straight line, for example, says nothing about where the robot
+  is along it. Points further than InlierDistance from every line are treated as outliers.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIELDLINEMATCHER_H
+#define FIELDLINEMATCHER_H
+
+#include "Tools/Math/Vector2.h"
+
+#include <vector>
+
+class FieldLineMatcher
+{
+public:
+    //! The result of matching a set of line points from a pose
+    struct Match
+    {
+        float X;                    //!< The x position of the matched pose (cm)
+        float Y;                    //!< The y position of the matched pose (cm)
+        float Heading;              //!< The heading of the matched pose (rad)
+        float Error;                //!< The mean squared distance from each point to the nearest line (cm^2), outliers count as InlierDistance
+        int Inliers;                //!< The number of points within InlierDistance of a line
+        float Information[3][3];    //!< The sum of J'J over the inliers, where J is the gradient of the distance with respect to (x, y, heading)
+    };
+
+    static const float CellSize;            //!< The size of each cell in the distance grid (cm)
+    static const float Border;              //!< The distance the grid extends past the outside field lines (cm)
+    static const float MaxDistance;         //!< The distance at which the grid is clipped (cm)
+    static const float InlierDistance;      //!< The distance from a line beyond which a point is an outlier (cm)
+    static const int MaxIterations = 5;     //!< The number of Gauss-Newton steps used to refine a pose
+
+    static const FieldLineMatcher& getInstance();
+
+    float distance(float x, float y) const;
+    float score(float x, float y, float heading, const std::vector<Vector2<float> >& points) const;
+    Match match(float x, float y, float heading, const std::vector<Vector2<float> >& points) const;
+private:
+    FieldLineMatcher();
+    void addLine(float x1, float y1, float x2, float y2);
+    void build();
+    float lookup(float x, float y, float& gradx, float& grady) const;
+    Match evaluate(float x, float y, float heading, const std::vector<Vector2<float> >& points, float gradient[3]) const;
+
+    //! A straight field line
+    struct Line
+    {
+        float X1, Y1, X2, Y2;
+    };
+
+    std::vector<Line> m_lines;              //!< The straight field lines, in field coordinates
+    float m_left;                           //!< The x of the left edge of the grid (cm)
+    float m_bottom;                         //!< The y of the bottom edge of the grid (cm)
+    int m_columns;                          //!< The number of grid points along x
+    int m_rows;                             //!< The number of grid points along y
+    std::vector<unsigned char> m_distances; //!< The distance from each grid point to the nearest line (cm), a row at a time
+};
+
+#endif
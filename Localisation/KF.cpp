@@ -564,6 +564,40 @@ void KF::linear2MeasurementUpdate(double Y1,double Y2, double SR11, double SR12,
   stateEstimates = stateEstimates - K * (yBar - y);
   return;
 }
+//
+// A KF update where the robot's pose [x;y;heading] is measured directly, for example by matching field lines,
+// with the Square Root of Covariance (SR) of the measurement, R = SR * SR'.
+// This is linear2MeasurementUpdate with three measurements, and the heading innovation wrapped to [-pi, pi].
+//
+KfUpdateResult KF::poseMeasurementUpdate(double x, double y, double heading, const Matrix& SR)
+{
+  Matrix R = SR * SR.transp();
+
+  Matrix CS = Matrix(3, 7, false);
+  CS.setRow(0, stateStandardDeviations.getRow(selfX));
+  CS.setRow(1, stateStandardDeviations.getRow(selfY));
+  CS.setRow(2, stateStandardDeviations.getRow(selfTheta));
+
+  Matrix Py = CS * CS.transp();
+  Matrix Pxy = stateStandardDeviations * CS.transp();
+  Matrix innovationVariance = InverseMatrix(Py + R);
+
+  Matrix K = Pxy * innovationVariance;
+
+  Matrix innovation = Matrix(3, 1, false); // yBar - y
+  innovation[0][0] = stateEstimates[selfX][0] - x;
+  innovation[1][0] = stateEstimates[selfY][0] - y;
+  innovation[2][0] = normaliseAngle(stateEstimates[selfTheta][0] - heading);
+
+  double innovation2 = convDble(innovation.transp() * innovationVariance * innovation);
+  if (innovation2 > c_threshold2)
+    return KF_OUTLIER;
+
+  stateStandardDeviations = HT(horzcat(stateStandardDeviations - K * CS, K * SR));
+  stateEstimates = stateEstimates - K * innovation;
+  return KF_OK;
+}
+
 //======================================================================================================
 //
 // RHM: 26/6/08 New Pseudo code for ball information to send over wireless
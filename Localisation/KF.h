@@ -39,6 +39,7 @@ class KF {
         KfUpdateResult ballmeas(double Ballmeas, double theta_Ballmeas);
         KfUpdateResult fieldObjectmeas(double distance, double bearing,double objX,double objY, double distanceErrorOffset, double distanceErrorRelative, double bearingError);
         void linear2MeasurementUpdate(double Y1,double Y2, double SR11, double SR12, double SR22, int index1, int index2);
+        KfUpdateResult poseMeasurementUpdate(double x, double y, double heading, const Matrix& SR);
         KfUpdateResult updateAngleBetween(double angle, double x1, double y1, double x2, double y2, double sd_angle);
         static unsigned int GenerateId();
         void setAlpha(double new_alpha);
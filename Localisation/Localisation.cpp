@@ -1,4 +1,5 @@
 #include "Localisation.h"
+#include "FieldLineMatcher.h"
 
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
@@ -18,6 +19,7 @@
 #define AMBIGUOUS_CORNERS_ON 0
 #define SHARED_BALL_ON 1
 #define TWO_OBJECT_UPDATE_ON 1
+#define FIELD_LINE_UPDATE_ON 1
 
 //#define debug_out cout
 #if DEBUG_LOCALISATION_VERBOSITY > 0
@@ -54,6 +56,12 @@ const float Localisation::centreCircleBearingError = (float)(deg2rad(20)*deg2rad
 
 const float Localisation::sdTwoObjectAngle = (float) 0.02; //Small! error in angle difference is normally very small
 
+// Field line measurement constants
+const int Localisation::c_MinFieldLinePoints = 8;           // the fewest line points matched before they are used
+const float Localisation::sdFieldLinePoint = 10.0f;         // the error in the position of each line point (cm)
+const float Localisation::sdFieldLinePositionPrior = 300.0f;   // the error in position the lines add nothing to (cm)
+const float Localisation::sdFieldLineHeadingPrior = 3.0f;       // the error in heading the lines add nothing to (rad)
+
 Localisation::Localisation(int playerNumber): m_timestamp(0)
 {
     
@@ -267,6 +275,14 @@ void Localisation::ProcessObjects(FieldObjects* fobs, const vector<TeamPacket::S
         }
 #endif
 
+#if FIELD_LINE_UPDATE_ON
+    if(doFieldLineMeasurementUpdate(fobs->fieldLinePoints) > 0)
+    {
+        numUpdates++;
+        usefulObjectCount++;
+    }
+#endif
+
 
     // Proccess the Moving Known Field Objects
     MobileObjectsIt currMob(fobs->mobileFieldObjects.begin());
@@ -974,6 +990,58 @@ int Localisation::doSharedBallUpdate(const TeamPacket::SharedBall& sharedBall)
     return numSuccessfulUpdates;
 }
 
+/*! @brief Updates each model with the pose that best fits the field line points seen this frame
+
+    Each model's pose is refined by matching the line points against the field lines. The models are weighted by how
+    well the points fit from their refined pose, and the refined pose is used as a measurement, with an error from
+    how well the points pin down each part of the pose.
+
+    @param linePoints the field line points relative to the robot (x forward, y left in cm)
+    @return the number of models updated
+ */
+int Localisation::doFieldLineMeasurementUpdate(const vector<Vector2<float> >& linePoints)
+{
+    if((int)linePoints.size() < c_MinFieldLinePoints)
+        return 0;
+
+    #if DEBUG_LOCALISATION_VERBOSITY > 2
+        debug_out  << "[" << m_timestamp << "]: Doing Field Line Update. Points = " << linePoints.size() << endl;
+    #endif
+
+    const FieldLineMatcher& matcher = FieldLineMatcher::getInstance();
+    int kf_return;
+    int numSuccessfulUpdates = 0;
+    for(int modelID = 0; modelID < c_MAX_MODELS; modelID++){
+        if(m_models[modelID].isActive == false) continue; // Skip Inactive models.
+        FieldLineMatcher::Match match = matcher.match(m_models[modelID].state(KF::selfX),
+                                                      m_models[modelID].state(KF::selfY),
+                                                      m_models[modelID].state(KF::selfTheta),
+                                                      linePoints);
+        float pointVariance = sdFieldLinePoint*sdFieldLinePoint;
+        m_models[modelID].setAlpha(m_models[modelID].alpha() / (1 + match.Error/pointVariance));
+        if(match.Inliers < c_MinFieldLinePoints) continue;
+
+        // R = (J'J/sd^2 + prior^-1)^-1
+        Matrix information(3,3,false);
+        for(int i = 0; i < 3; i++)
+            for(int j = 0; j < 3; j++)
+                information[i][j] = match.Information[i][j]/pointVariance;
+        information[0][0] += 1/(sdFieldLinePositionPrior*sdFieldLinePositionPrior);
+        information[1][1] += 1/(sdFieldLinePositionPrior*sdFieldLinePositionPrior);
+        information[2][2] += 1/(sdFieldLineHeadingPrior*sdFieldLineHeadingPrior);
+        Matrix SR = cholesky(InverseMatrix(information));
+
+        kf_return = m_models[modelID].poseMeasurementUpdate(match.X, match.Y, normaliseAngle(match.Heading), SR);
+        #if DEBUG_LOCALISATION_VERBOSITY > 2
+            debug_out  << "[" << m_timestamp << "]: Model[" << modelID << "] Field Lines: (" << match.X << "," << match.Y << "," << match.Heading
+                       << ") Error = " << match.Error << " Inliers = " << match.Inliers << (kf_return == KF_OK ? "" : " OUTLIER") << endl;
+        #endif
+        if(kf_return == KF_OK) numSuccessfulUpdates++;
+    }
+    NormaliseAlphas();
+    return numSuccessfulUpdates;
+}
+
 int Localisation::doBallMeasurementUpdate(MobileObject &ball)
 {
     int kf_return;
@@ -49,6 +49,7 @@ class Localisation: public TimestampedData
         int doBallMeasurementUpdate(MobileObject &ball);
         int doAmbiguousLandmarkMeasurementUpdate(AmbiguousObject &ambigousObject, const vector<StationaryObject>& possibleObjects);
         int doTwoObjectUpdate(StationaryObject &landmark1, StationaryObject &landmark2);
+        int doFieldLineMeasurementUpdate(const vector<Vector2<float> >& linePoints);
         int getNumActiveModels();
         int getNumFreeModels();
         void ClearAllModels();
@@ -140,6 +141,12 @@ class Localisation: public TimestampedData
         static const float R_obj_range_relative;
         static const float centreCircleBearingError;
         static const float sdTwoObjectAngle;
+
+        // Field line measurement constants -- Values assigned in Localisation.cpp
+        static const int c_MinFieldLinePoints;
+        static const float sdFieldLinePoint;
+        static const float sdFieldLinePositionPrior;
+        static const float sdFieldLineHeadingPrior;
 };
 
 #endif
@@ -25,6 +25,7 @@ SET (YOUR_SRCS  pose2d.h
                odometryMotionModel.cpp odometryMotionModel.h
                KF.cpp KF.h
                Localisation.cpp Localisation.h
+               FieldLineMatcher.cpp FieldLineMatcher.h
 		LocWmFrame
 )
 ####################################################################################
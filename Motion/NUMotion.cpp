@@ -430,7 +430,7 @@ void NUMotion::process(JobList* jobs)
     if (jobs == NULL or m_data == NULL or m_actions == NULL or m_current_time < m_last_kill_time + 2000)
         return;
     
-    list<Job*>::iterator it = jobs->motion_begin();     // the iterator over the motion jobs
+    IntrusiveJobList::iterator it = jobs->motion_begin();     // the iterator over the motion jobs
     while (it != jobs->motion_end())
     {
         m_killed = false;
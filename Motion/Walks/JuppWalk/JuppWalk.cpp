@@ -27,6 +27,7 @@
 #include "debugverbositynumotion.h"
 
 #include <math.h>
+#include <algorithm>
 #include <boost/circular_buffer.hpp>
 using namespace std;
 
@@ -56,6 +57,10 @@ JuppWalk::JuppWalk(NUSensorsData* data, NUActionatorsData* actions) : NUWalk(dat
     m_swing_amplitude_pitch = 0;
     m_swing_amplitude_yaw = 0;
     
+    m_gyro_foot_pitch = 0;
+    m_gyro_foot_roll = 0;
+    m_gyro_leg_pitch = 0;
+    
     // Initialise the leg values
     //! @todo Get the lengths of these angles and gains from m_actions
     m_left_leg_angles = vector<float> (6, 0);
@@ -75,6 +80,10 @@ JuppWalk::JuppWalk(NUSensorsData* data, NUActionatorsData* actions) : NUWalk(dat
     m_left_arm_gains = vector<float> (4, 0);
     m_right_arm_angles = m_initial_rarm;
     m_right_arm_gains = vector<float> (4, 0);
+    
+    m_gait_version = 0;
+    m_gait_table = NULL;
+    updateGaitTable();
 }
 
 void JuppWalk::initWalkParameters()
@@ -182,15 +191,14 @@ void JuppWalk::doWalk()
     #if DEBUG_NUMOTION_VERBOSITY > 4
         debug << "JuppWalk::doWalk()" << endl;
     #endif
-    getParameters();
-    // Convert speed vector into swing leg amplitudes (ar, ap, ay)
-    m_swing_amplitude_roll = asin(-m_speed_y/(2*m_step_frequency*m_leg_length));
-    m_swing_amplitude_pitch = asin(m_speed_x/(2*m_step_frequency*m_leg_length));
-    m_swing_amplitude_yaw = m_speed_yaw/(2*m_step_frequency);
+    const JuppWalkGaitTable& table = m_gait_tables.acquire();
+    if (table.isBuiltFor(__sync_fetch_and_add(&m_gait_version, 0)))
+        m_gait_table = &table;
+    else
+        m_gait_table = NULL;            // the parameters have changed, and their table is still being built
     
+    calculateSwingAmplitudes();
     calculateGaitPhase();
-    m_left_leg_phase = NORMALISE(m_gait_phase + M_PI/2);
-    m_right_leg_phase = NORMALISE(m_gait_phase - M_PI/2);
     
     calculateGyroFeedback();
     calculateLeftLeg();
@@ -206,12 +214,71 @@ void JuppWalk::doWalk()
     #endif
 }
 
+/*! @brief Sets the walk parameters, and updates the gait table to match them
+    @param walkparameters the new walk parameters
+ */
+void JuppWalk::setWalkParameters(const WalkParameters& walkparameters)
+{
+    NUWalk::setWalkParameters(walkparameters);
+    updateGaitTable();
+}
+
+/*! @brief Copies the current walk parameters into m_param_*, and makes a gait table for them.
+ 
+    The table is loaded from a previously saved table, or if there isn't one it is built and saved. Building and checking
+    the table costs a few thousand evaluations of the walk, and loading and saving it is file I/O, so this is done by the
+    thread that constructs the walk or sets its parameters, and never by doWalk(). The new table is published to the
+    motion thread through m_gait_tables. Until it arrives the motion thread sees that the table's version does not match
+    m_gait_version, and uses the analytic phase functions.
+ */
+void JuppWalk::updateGaitTable()
+{
+    unsigned long version = __sync_add_and_fetch(&m_gait_version, 1);
+    getParameters();
+    
+    vector<float> key;
+    vector<Parameter>& parameters = m_walk_parameters.getParameters();
+    for (size_t i=0; i<parameters.size(); i++)
+        key.push_back(parameters[i].get());
+    vector<float>& maxspeeds = m_walk_parameters.getMaxSpeeds();
+    key.insert(key.end(), maxspeeds.begin(), maxspeeds.end());
+    
+    if (maxspeeds.size() < 3)
+        return;
+    
+    JuppWalkGaitTable& table = m_gait_tables.getWriteBuffer();
+    string name = m_walk_parameters.getName();
+    if (not table.load(name, key, version))
+    {
+        // the swing amplitudes for the max speeds (see doWalk()), the table is checked over this range
+        float maxroll = asin(min(1.0f, maxspeeds[1]/(2*m_step_frequency*m_leg_length)));
+        float maxpitch = asin(min(1.0f, maxspeeds[0]/(2*m_step_frequency*m_leg_length)));
+        float maxyaw = maxspeeds[2]/(2*m_step_frequency);
+        table.build(this, key, version, maxroll, maxpitch, maxyaw);
+        table.save(name);
+    }
+    m_gait_tables.publish();
+}
+
+/*! @brief Converts the current speed into the swing leg amplitudes (ar, ap, ay)
+ */
+void JuppWalk::calculateSwingAmplitudes()
+{
+    m_swing_amplitude_roll = asin(-m_speed_y/(2*m_step_frequency*m_leg_length));
+    m_swing_amplitude_pitch = asin(m_speed_x/(2*m_step_frequency*m_leg_length));
+    m_swing_amplitude_yaw = m_speed_yaw/(2*m_step_frequency);
+}
+
+/*! @brief Advances the gait phase to m_current_time, and calculates the phase of each leg
+ */
 void JuppWalk::calculateGaitPhase()
 {
     #if DEBUG_NUMOTION_VERBOSITY > 4
         debug << "JuppWalk::calculateGaitPhase()" << endl;
     #endif
     m_gait_phase = NORMALISE(m_gait_phase + 2*M_PI*m_step_frequency*(m_current_time - m_previous_time)/1000.0);
+    m_left_leg_phase = NORMALISE(m_gait_phase + M_PI/2);
+    m_right_leg_phase = NORMALISE(m_gait_phase - M_PI/2);
 }
 
 /*! @brief Calculates the angles and gains for the left leg
@@ -237,6 +304,8 @@ void JuppWalk::calculateRightLeg()
 }
 
 /*! @brief Calculates leg angles based on the given legphase, and legsign
+    
+    The phase functions of the walk are taken from the gait table when possible, otherwise they are calculated.
     @param legphase the phase of the leg you want angles for (+/- M_PI)
     @param legsign 1 for the right leg, -1 for the left leg
  */
@@ -245,41 +314,55 @@ void JuppWalk::calculateLegAngles(float legphase, float legsign, vector<float>&
     #if DEBUG_NUMOTION_VERBOSITY > 4
         debug << "JuppWalk::calculateLegAngles()" << endl;
     #endif
+    float shapes[JuppWalkGaitTable::NumShapes];
+    if (m_gait_table == NULL or not m_gait_table->lookup(legphase, shapes))
+        calculatePhaseShapes(legphase, shapes);
+    
+    float state[6];
+    calculateLegState(legsign, m_swing_amplitude_roll, m_swing_amplitude_pitch, m_swing_amplitude_yaw, shapes, state);
+    
+    // Apply gyro feedback
+    float swing_phase = m_param_swing_v*(legphase + M_PI/2.0 - m_param_phase_offset);
+    if (fabs(swing_phase) < M_PI/2.0)      // if we are in the swing phase don't apply the foot_gyro_* offsets
+    {
+        m_gyro_foot_pitch = 0;
+        m_gyro_foot_roll = 0;
+        m_gyro_leg_pitch = 0;
+    }
+    state[1] += m_gyro_leg_pitch;
+    state[4] += m_gyro_foot_pitch;
+    state[5] += m_gyro_foot_roll;
+    
+    calculateLegKinematics(state, &angles[0]);
+}
+
+/*! @brief Calculates the phase functions of the walk. These depend only on the leg phase and the walk parameters,
+           the speed only scales them (see calculateLegState()). The JuppWalkGaitTable is built by sampling this function.
+    @param legphase the phase of the leg (+/- M_PI)
+    @param shapes will be updated with [shift, shortening, loading, swing, swing yaw, sagittal sway]
+ */
+void JuppWalk::calculatePhaseShapes(float legphase, float* shapes) const
+{
     /* Jason's guide to this to walk:
      Step 1. Tune shift_amp such that it looks like the weight is being shifted between the feet
      Step 2. Tune the shortening phase shift. Too late and the robot will fall, too early and the feet wont come off the ground!
      Step 3. Tune the swinging phase shift. You only want to swing when the foot is in the air (this will probably be the same as the shortening phase)
      */
     
-    
     // Shifting
-    float shift_amp = m_param_shift_c + 0.08*sqrt(pow(m_swing_amplitude_roll, 2) + pow(m_swing_amplitude_pitch, 2)) + 1.0*fabs(m_swing_amplitude_roll);
-    float shift = shift_amp*sin(legphase);   
-    float shift_leg_roll = -legsign*shift;
-    float shift_foot_roll = legsign*m_param_ankle_shift*shift;
-
+    float shift = sin(legphase);
+    
     // Shortening
     float short_phase = m_param_short_v*(legphase + M_PI/2.0 - m_param_phase_offset);
-    float short_amp = m_param_short_c + 2*sqrt(pow(m_swing_amplitude_roll, 2) + pow(m_swing_amplitude_pitch, 2));
-    if ((legsign > 0 && m_swing_amplitude_roll > 0) || (legsign < 0 && m_swing_amplitude_roll < 0))
-    {   // shorten the inside leg a bit more when walking sidewards
-        short_amp += 2*(1 - cos(m_swing_amplitude_roll));
-    }
-
-    float short_leg_length = 0;
-    float short_foot_pitch = 0;
+    float shortening = 0;
     if (fabs(short_phase) < M_PI)
-    {
-        short_leg_length = -short_amp*0.5*(cos(short_phase) + 1);
-        short_foot_pitch = fabs(m_swing_amplitude_pitch)*0.125*(cos(short_phase) + 1);       // this works really well when walking backwards!
-    }
+        shortening = 0.5*(cos(short_phase) + 1);
     
     // Loading
     float load_phase = m_param_load_v*NORMALISE(legphase + M_PI/2.0 - M_PI/m_param_short_v - m_param_phase_offset) - M_PI;
-    float load_amp = m_param_load_c + 0.5*(1 - cos(fabs(m_swing_amplitude_pitch)));
-    float load_leg_length = 0;
+    float loading = 0;
     if (fabs(load_phase) < M_PI)
-        load_leg_length = -load_amp*0.5*(cos(load_phase) + 1);
+        loading = 0.5*(cos(load_phase) + 1);
     
     // Swinging
     float swing_phase = m_param_swing_v*(legphase + M_PI/2.0 - m_param_phase_offset);
@@ -293,52 +376,102 @@ void JuppWalk::calculateLegAngles(float legphase, float legsign, vector<float>&
     else
         swing = b*(swing_phase + M_PI/2) - 1;
     
-    float swing_leg_roll = m_swing_amplitude_roll*swing;      // you always want the swing leg to go outwards
-    float swing_leg_pitch = m_swing_amplitude_pitch*swing;
-    float swing_foot_roll = -0.125*legsign*m_swing_amplitude_roll*swing;
-    float swing_foot_pitch = 0.25*m_swing_amplitude_pitch*swing;
-    
-    
-    float swing_leg_yaw = 0;
+    float swing_yaw = 0;
     if (fabs(swing_phase) < M_PI/2.0)
     {   // if we are swinging this leg
-        swing_leg_yaw = legsign*m_swing_amplitude_yaw*sin(swing_phase) - fabs(m_swing_amplitude_yaw);
+        swing_yaw = sin(swing_phase);
     }
     else if (fabs(other_swing_phase) < M_PI/2.0)
     {   // if we are swinging the other leg
-        swing_leg_yaw = -legsign*m_swing_amplitude_yaw*sin(other_swing_phase) - fabs(m_swing_amplitude_yaw);
+        swing_yaw = -sin(other_swing_phase);
     }            
     else if (swing_phase > M_PI/2.0 && swing_phase < 3*M_PI/2.0)
     {
-        swing_leg_yaw = legsign*m_swing_amplitude_yaw - fabs(m_swing_amplitude_yaw);
+        swing_yaw = 1;
     }
     else
     {
-        swing_leg_yaw = -legsign*m_swing_amplitude_yaw - fabs(m_swing_amplitude_yaw);
+        swing_yaw = -1;
     }
     
     // Balance
-    float balance_foot_roll = 0;//-2*legsign*m_swing_amplitude_roll*cos(legphase + 0.35);
-    float balance_foot_pitch = m_param_balance_orientation + 0.05*m_swing_amplitude_pitch - m_param_balance_sagittal_sway*m_swing_amplitude_pitch*cos(2*(legphase - m_param_phase_offset));
-    // leans in the sideward walk direction + term to keep the feet apart + term to keep the feet apart
-    float balance_leg_roll = -m_swing_amplitude_roll + legsign*fabs(m_swing_amplitude_roll) + 0.2*legsign*fabs(m_swing_amplitude_yaw);
+    float sway = cos(2*(legphase - m_param_phase_offset));
+    
+    shapes[0] = shift;
+    shapes[1] = shortening;
+    shapes[2] = loading;
+    shapes[3] = swing;
+    shapes[4] = swing_yaw;
+    shapes[5] = sway;
+}
+
+/*! @brief Calculates the leg's state, without the gyro feedback, by scaling the phase functions with the swing amplitudes
+    @param legsign 1 for the right leg, -1 for the left leg
+    @param roll the roll swing amplitude
+    @param pitch the pitch swing amplitude
+    @param yaw the yaw swing amplitude
+    @param shapes the phase functions from calculatePhaseShapes()
+    @param state will be updated with [leg_yaw, leg_pitch, leg_roll, leg_length, foot_pitch, foot_roll]
+ */
+void JuppWalk::calculateLegState(float legsign, float roll, float pitch, float yaw, const float* shapes, float* state) const
+{
+    float swing_amplitude = sqrt(pow(roll, 2) + pow(pitch, 2));
     
-    // Apply gyro feedback
-    if (fabs(swing_phase) < M_PI/2.0)      // if we are in the swing phase don't apply the foot_gyro_* offsets
-    {
-        m_gyro_foot_pitch = 0;
-        m_gyro_foot_roll = 0;
-        m_gyro_leg_pitch = 0;
+    // Shifting
+    float shift_amp = m_param_shift_c + 0.08*swing_amplitude + 1.0*fabs(roll);
+    float shift = shift_amp*shapes[0];
+    float shift_leg_roll = -legsign*shift;
+    float shift_foot_roll = legsign*m_param_ankle_shift*shift;
+    
+    // Shortening
+    float short_amp = m_param_short_c + 2*swing_amplitude;
+    if ((legsign > 0 && roll > 0) || (legsign < 0 && roll < 0))
+    {   // shorten the inside leg a bit more when walking sidewards
+        short_amp += 2*(1 - cos(roll));
     }
+    float short_leg_length = -short_amp*shapes[1];
+    float short_foot_pitch = fabs(pitch)*0.25*shapes[1];       // this works really well when walking backwards!
+    
+    // Loading
+    float load_amp = m_param_load_c + 0.5*(1 - cos(fabs(pitch)));
+    float load_leg_length = -load_amp*shapes[2];
+    
+    // Swinging
+    float swing = shapes[3];
+    float swing_leg_roll = roll*swing;      // you always want the swing leg to go outwards
+    float swing_leg_pitch = pitch*swing;
+    float swing_foot_roll = -0.125*legsign*roll*swing;
+    float swing_foot_pitch = 0.25*pitch*swing;
+    float swing_leg_yaw = legsign*yaw*shapes[4] - fabs(yaw);
+    
+    // Balance
+    float balance_foot_roll = 0;//-2*legsign*m_swing_amplitude_roll*cos(legphase + 0.35);
+    float balance_foot_pitch = m_param_balance_orientation + 0.05*pitch - m_param_balance_sagittal_sway*pitch*shapes[5];
+    // leans in the sideward walk direction + term to keep the feet apart + term to keep the feet apart
+    float balance_leg_roll = -roll + legsign*fabs(roll) + 0.2*legsign*fabs(yaw);
     
     // Now we can calculate the leg's state
-    float leg_yaw = swing_leg_yaw;
-    float leg_pitch = swing_leg_pitch + m_gyro_leg_pitch;
-    float leg_roll = swing_leg_roll + shift_leg_roll + balance_leg_roll;
-    float leg_length = short_leg_length + load_leg_length;
+    state[0] = swing_leg_yaw;
+    state[1] = swing_leg_pitch;
+    state[2] = swing_leg_roll + shift_leg_roll + balance_leg_roll;
+    state[3] = short_leg_length + load_leg_length;
     
-    float foot_pitch = swing_foot_pitch + short_foot_pitch + balance_foot_pitch + m_gyro_foot_pitch;
-    float foot_roll = swing_foot_roll + shift_foot_roll + balance_foot_roll + m_gyro_foot_roll;
+    state[4] = swing_foot_pitch + short_foot_pitch + balance_foot_pitch;
+    state[5] = swing_foot_roll + shift_foot_roll + balance_foot_roll;
+}
+
+/*! @brief Calculates the joint angles from the leg's state
+    @param state the leg's [leg_yaw, leg_pitch, leg_roll, leg_length, foot_pitch, foot_roll]
+    @param angles will be updated with the six leg angles
+ */
+void JuppWalk::calculateLegKinematics(const float* state, float* angles)
+{
+    float leg_yaw = state[0];
+    float leg_pitch = state[1];
+    float leg_roll = state[2];
+    float leg_length = state[3];
+    float foot_pitch = state[4];
+    float foot_roll = state[5];
     
     // do the kinematics, and calculate the joint angles
     float knee_pitch = -2*acos(1 + 0.15*leg_length);
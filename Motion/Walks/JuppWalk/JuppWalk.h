@@ -31,27 +31,38 @@
 #include "Motion/NUWalk.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
+#include "JuppWalkGaitTable.h"
+#include "Tools/Threading/TripleBuffer.h"
 
 #include <fstream>
 using namespace std;
 
 class JuppWalk : public NUWalk
 {
+    friend class JuppWalkGaitTable;
+    friend class JuppWalkModel;
 public:
     JuppWalk(NUSensorsData* data, NUActionatorsData* actions);
     ~JuppWalk();
+    
+    void setWalkParameters(const WalkParameters& walkparameters);
 protected:
     void doWalk();
 private:
     void initWalkParameters();
     void getParameters();
     
+    void calculateSwingAmplitudes();
     void calculateGaitPhase();
     void calculateGyroFeedback();
     
     void calculateLeftLeg();
     void calculateRightLeg();
     void calculateLegAngles(float legphase, float legsign, vector<float>& angles);
+    void calculatePhaseShapes(float legphase, float* shapes) const;
+    void calculateLegState(float legsign, float roll, float pitch, float yaw, const float* shapes, float* state) const;
+    static void calculateLegKinematics(const float* state, float* angles);
+    void updateGaitTable();
     void calculateLegGains(float legphase, vector<float>& gains);
     
     void calculateLeftArm();
@@ -95,6 +106,11 @@ private:
     float m_gyro_foot_roll;
     float m_gyro_leg_pitch;
     
+    // Precomputed phase functions
+    volatile unsigned long m_gait_version;                  //!< the version number of the walk parameters in m_param_*, incremented each time they are set
+    TripleBuffer<JuppWalkGaitTable> m_gait_tables;          //!< the gait tables passed from the thread setting the walk parameters to the motion thread
+    const JuppWalkGaitTable* m_gait_table;                  //!< the gait table used by the motion thread this cycle, or NULL if there is no table for the current parameters
+    
     // Legs
     vector<float> m_left_leg_angles;
     vector<float> m_left_leg_gains;
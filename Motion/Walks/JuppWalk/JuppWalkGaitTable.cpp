@@ -0,0 +1,227 @@
+/*! @file JuppWalkGaitTable.cpp
+    @brief Implementation of a precomputed table of the JuppWalk phase functions
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "JuppWalkGaitTable.h"
+#include "JuppWalk.h"
+
+#include "debug.h"
+#include "debugverbositynumotion.h"
+#include "nubotdataconfig.h"
+
+#include <math.h>
+#include <fstream>
+
+#ifndef M_PI
+    #define M_PI 3.1415926535
+#endif
+
+const float JuppWalkGaitTable::ErrorTolerance = 0.01;
+
+/*! @brief Constructs an empty gait table. Lookups will fail until the table has been built or loaded */
+JuppWalkGaitTable::JuppWalkGaitTable()
+{
+    m_version = 0;
+    m_enabled = false;
+    m_max_error = 0;
+}
+
+JuppWalkGaitTable::~JuppWalkGaitTable()
+{
+}
+
+/*! @brief Builds the table by sampling the walk's phase functions, and then checks the table against the walk.
+    @param walk the walk engine whose current parameters will be used to build the table
+    @param key the walk parameters, saved with the table so that it is only loaded for the same parameters
+    @param version the walk's version number of its current parameters
+    @param maxroll the largest roll swing amplitude the walk will use
+    @param maxpitch the largest pitch swing amplitude the walk will use
+    @param maxyaw the largest yaw swing amplitude the walk will use
+ */
+void JuppWalkGaitTable::build(const JuppWalk* walk, const vector<float>& key, unsigned long version, float maxroll, float maxpitch, float maxyaw)
+{
+    m_key = key;
+    m_version = version;
+    m_table.assign((NumPhaseCells + 1)*NumShapes, 0);
+
+    const float phasestep = 2*M_PI/NumPhaseCells;
+    for (unsigned int i=0; i<=NumPhaseCells; i++)
+        walk->calculatePhaseShapes(-M_PI + i*phasestep, &m_table[i*NumShapes]);
+
+    m_enabled = true;
+    m_max_error = check(walk, maxroll, maxpitch, maxyaw);
+    if (m_max_error > ErrorTolerance)
+    {
+        m_enabled = false;
+        errorlog << "JuppWalkGaitTable::build(). The table differs from the walk by " << m_max_error << " rad. The table will not be used." << endl;
+    }
+    #if DEBUG_NUMOTION_VERBOSITY > 0
+        debug << "JuppWalkGaitTable::build(). Built a table of " << m_table.size()*sizeof(float) << " bytes. The max error is " << m_max_error << " rad." << endl;
+    #endif
+}
+
+/*! @brief Returns true if the table was built or loaded for the walk parameters with the given version number */
+bool JuppWalkGaitTable::isBuiltFor(unsigned long version) const
+{
+    return not m_table.empty() and version == m_version;
+}
+
+/*! @brief Returns true if the table can be used */
+bool JuppWalkGaitTable::isEnabled() const
+{
+    return m_enabled;
+}
+
+/*! @brief Returns the largest difference between the joint angles from the table and the analytic joint angles found when the table was checked */
+float JuppWalkGaitTable::getMaxError() const
+{
+    return m_max_error;
+}
+
+/*! @brief Gets the phase functions from the table
+    @param legphase the phase of the leg (+/- M_PI)
+    @param shapes will be updated with the NumShapes phase functions
+    @return true if the phase functions were found, false if the table is disabled or the phase is out of range
+ */
+bool JuppWalkGaitTable::lookup(float legphase, float* shapes) const
+{
+    if (not m_enabled)
+        return false;
+
+    float x = (legphase + M_PI)*(NumPhaseCells/(2*M_PI));
+    if (x < 0 or x > NumPhaseCells)
+        return false;
+    unsigned int i = static_cast<unsigned int>(x);
+    if (i >= NumPhaseCells)
+        i = NumPhaseCells - 1;
+    float t = x - i;
+
+    const float* left = &m_table[i*NumShapes];
+    const float* right = left + NumShapes;
+    for (unsigned int j=0; j<NumShapes; j++)
+        shapes[j] = left[j] + t*(right[j] - left[j]);
+    return true;
+}
+
+/*! @brief Saves the table so that it does not need to be built next time
+    @param name the table is saved to name.gait in the walk config directory
+    @return true if the table was saved
+ */
+bool JuppWalkGaitTable::save(const string& name) const
+{
+    if (m_table.empty())
+        return false;
+    string filepath = CONFIG_DIR + string("Motion/Walks/") + name + ".gait";
+    ofstream file(filepath.c_str(), ios_base::binary);
+    if (not file.is_open())
+    {
+        debug << "JuppWalkGaitTable::save(): Failed to open file " << filepath << endl;
+        return false;
+    }
+
+    unsigned int dims[] = {NumShapes, NumPhaseCells, static_cast<unsigned int>(m_key.size())};
+    file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    file.write(reinterpret_cast<const char*>(&m_key[0]), m_key.size()*sizeof(float));
+    file.write(reinterpret_cast<const char*>(&m_max_error), sizeof(m_max_error));
+    file.write(reinterpret_cast<const char*>(&m_table[0]), m_table.size()*sizeof(float));
+    file.close();
+    return true;
+}
+
+/*! @brief Loads a table saved with save(). The table will only be loaded if it was built for the walk parameters in key
+    @param name the name of the table
+    @param key the current walk parameters
+    @param version the walk's version number of its current parameters
+    @return true if the table was loaded
+ */
+bool JuppWalkGaitTable::load(const string& name, const vector<float>& key, unsigned long version)
+{
+    string filepath = CONFIG_DIR + string("Motion/Walks/") + name + ".gait";
+    ifstream file(filepath.c_str(), ios_base::binary);
+    if (not file.is_open())
+        return false;
+
+    unsigned int dims[3];
+    file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    if (not file.good() or dims[0] != NumShapes or dims[1] != NumPhaseCells or dims[2] != key.size())
+        return false;
+
+    vector<float> filekey(key.size(), 0);
+    file.read(reinterpret_cast<char*>(&filekey[0]), filekey.size()*sizeof(float));
+    if (not file.good() or filekey != key)
+        return false;
+
+    float maxerror = 0;
+    vector<float> table((NumPhaseCells + 1)*NumShapes, 0);
+    file.read(reinterpret_cast<char*>(&maxerror), sizeof(maxerror));
+    file.read(reinterpret_cast<char*>(&table[0]), table.size()*sizeof(float));
+    if (not file.good())
+    {
+        debug << "JuppWalkGaitTable::load(): " << filepath << " is truncated" << endl;
+        return false;
+    }
+
+    m_key = key;
+    m_version = version;
+    m_table = table;
+    m_max_error = maxerror;
+    m_enabled = m_max_error <= ErrorTolerance;
+    return true;
+}
+
+/*! @brief Returns the largest difference between the joint angles from the table and the analytic joint angles.
+
+    The walk is compared at the centre of every cell, for both legs, at zero speed and at each corner of the speed range.
+ */
+float JuppWalkGaitTable::check(const JuppWalk* walk, float maxroll, float maxpitch, float maxyaw) const
+{
+    const float phasestep = 2*M_PI/NumPhaseCells;
+    float maxerror = 0;
+    float expectedshapes[NumShapes], actualshapes[NumShapes];
+    float expectedstate[6], actualstate[6];
+    float expected[6], actual[6];
+    for (unsigned int i=0; i<NumPhaseCells; i++)
+    {
+        float legphase = -M_PI + (i + 0.5)*phasestep;
+        walk->calculatePhaseShapes(legphase, expectedshapes);
+        if (not lookup(legphase, actualshapes))
+            return 2*M_PI;
+
+        for (unsigned int c=0; c<17; c++)
+        {   // c = 16 is zero speed, otherwise bit 0 is the leg, and bits 1, 2 and 3 are the signs of the amplitudes
+            float legsign = (c & 1) ? 1 : -1;
+            float roll = c == 16 ? 0 : ((c & 2) ? maxroll : -maxroll);
+            float pitch = c == 16 ? 0 : ((c & 4) ? maxpitch : -maxpitch);
+            float yaw = c == 16 ? 0 : ((c & 8) ? maxyaw : -maxyaw);
+            walk->calculateLegState(legsign, roll, pitch, yaw, expectedshapes, expectedstate);
+            walk->calculateLegState(legsign, roll, pitch, yaw, actualshapes, actualstate);
+            JuppWalk::calculateLegKinematics(expectedstate, expected);
+            JuppWalk::calculateLegKinematics(actualstate, actual);
+            for (unsigned int j=0; j<6; j++)
+            {
+                float error = fabs(expected[j] - actual[j]);
+                if (error > maxerror)
+                    maxerror = error;
+            }
+        }
+    }
+    return maxerror;
+}
+
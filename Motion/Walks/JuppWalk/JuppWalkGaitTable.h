@@ -0,0 +1,83 @@
+/*! @file JuppWalkGaitTable.h
+    @brief Declaration of a precomputed table of the JuppWalk phase functions
+
+    @class JuppWalkGaitTable
+    @brief A table of the JuppWalk phase functions, sampled over the leg phase
+
+    The JuppWalk leg trajectories are built from a set of trigonometric phase functions (the shift,
+    shortening, loading, swing, swing yaw and sagittal sway). Every motion cycle these cost around a
+    dozen calls to sin/cos/atan2 per leg. The forward, sideward and turn speeds only scale the phase
+    functions (see JuppWalk::calculateLegState()), so the phase functions can be sampled once, and
+    each cycle recovered with a linear interpolation of the table. Because the speeds are applied
+    after the lookup the table is exact over the whole (forward, sideward, turn) range, and is small
+    enough to stay in the cache.
+
+    Once the table is built it is checked against the analytic walk at the centre of every cell, for
+    the corners of the walk's speed range, by comparing the resulting joint angles. If the largest
+    error is more than ErrorTolerance the table is disabled and the walk continues to use the analytic path.
+
+    A table is only valid for the walk parameters it was built with. Each table carries a key of those
+    parameters, so that a saved table is only loaded for the same parameters, and the version number
+    the walk gave those parameters, so that the motion thread can tell with a single comparison whether
+    the table matches the parameters it is using. The tables can be saved and loaded to avoid building
+    them at startup.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JUPPWALKGAITTABLE_H
+#define JUPPWALKGAITTABLE_H
+
+class JuppWalk;
+
+#include <vector>
+#include <string>
+using namespace std;
+
+class JuppWalkGaitTable
+{
+public:
+    static const unsigned int NumShapes = 6;            //!< the number of phase functions
+    static const unsigned int NumPhaseCells = 256;      //!< the number of cells over the leg phase [-pi, pi]
+    static const float ErrorTolerance;                  //!< the largest acceptable difference between the joint angles from the table and the analytic joint angles (rad)
+
+    JuppWalkGaitTable();
+    ~JuppWalkGaitTable();
+
+    void build(const JuppWalk* walk, const vector<float>& key, unsigned long version, float maxroll, float maxpitch, float maxyaw);
+    bool isBuiltFor(unsigned long version) const;
+    bool isEnabled() const;
+    float getMaxError() const;
+
+    bool lookup(float legphase, float* shapes) const;
+
+    bool save(const string& name) const;
+    bool load(const string& name, const vector<float>& key, unsigned long version);
+private:
+    float check(const JuppWalk* walk, float maxroll, float maxpitch, float maxyaw) const;
+private:
+    vector<float> m_key;                //!< the walk parameters the table was built for
+    unsigned long m_version;            //!< the walk's version number of the parameters the table was built for
+    bool m_enabled;                     //!< true if the table has been built and passed the error check
+    float m_max_error;                  //!< the largest error found when the table was checked
+
+    vector<float> m_table;              //!< the sampled phase functions laid out as [phase][shape]
+};
+
+#endif
+
@@ -0,0 +1,247 @@
+/*! @file JuppWalkModel.cpp
+    @brief Implementation of the kinematic model of the JuppWalk
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "JuppWalkModel.h"
+#include "JuppWalk.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "debug.h"
+#include "debugverbositynumotion.h"
+
+const float JuppWalkModel::TimeStep = 10;
+const float JuppWalkModel::FallTime = 300;
+const float JuppWalkModel::DoubleSupportHeight = 0.5;
+const float JuppWalkModel::StallTorque = 1.5;
+
+/*! @brief Constructs a model of the JuppWalk with its default parameters
+    @param duration the length of each evaluation in seconds
+ */
+JuppWalkModel::JuppWalkModel(float duration)
+{
+    m_duration = duration;
+    m_walk = new JuppWalk(NULL, NULL);
+    m_initial_parameters = m_walk->m_walk_parameters;
+    m_kinematics.LoadModel();
+}
+
+/*! @brief Constructs a model with its own JuppWalk, and the same parameters and duration as other */
+JuppWalkModel::JuppWalkModel(const JuppWalkModel& other) : FitnessFunction()
+{
+    m_duration = other.m_duration;
+    m_walk = new JuppWalk(NULL, NULL);
+    m_initial_parameters = other.m_initial_parameters;
+    m_kinematics = other.m_kinematics;
+}
+
+JuppWalkModel::~JuppWalkModel()
+{
+    delete m_walk;
+}
+
+/*! @brief Returns the walk's default parameters, with their ranges, in the order evaluate() expects them */
+vector<Parameter> JuppWalkModel::getInitialParameters()
+{
+    return m_initial_parameters.getAsParameters();
+}
+
+/*! @brief Returns the number of objectives; the speed and the cost of transport */
+unsigned int JuppWalkModel::getNumObjectives() const
+{
+    return 2;
+}
+
+FitnessFunction* JuppWalkModel::clone() const
+{
+    return new JuppWalkModel(*this);
+}
+
+/*! @brief Walks the model forwards for m_duration with the given parameters, and returns their fitness
+    @param parameters the walk parameters, in the WalkParameters::getAsVector() order
+    @return [speed, 180/(4 + cost)], as the WalkOptimisationProvider calculates them
+ */
+vector<float> JuppWalkModel::evaluate(const vector<float>& parameters)
+{
+    reset(parameters);
+    JuppWalk& walk = *m_walk;
+    float maxspeed = walk.m_walk_parameters.getMaxSpeeds()[0];
+    float maxacceleration = walk.m_walk_parameters.getMaxAccelerations()[0];
+
+    float distance = 0;
+    float energy = 0;
+    float unsupportedtime = 0;
+    bool fallen = false;
+    bool leftsupport = false, rightsupport = false;
+    vector<float> previousleft, previousright;
+    vector<float> previouslangles, previousrangles;
+    while (walk.m_current_time < 1000*m_duration)
+    {
+        walk.m_previous_time = walk.m_current_time;
+        walk.m_current_time += TimeStep;
+        walk.m_speed_x = min(maxspeed, walk.m_speed_x + maxacceleration*TimeStep/1000);
+
+        walk.calculateSwingAmplitudes();
+        walk.calculateGaitPhase();
+        walk.calculateLeftLeg();
+        walk.calculateRightLeg();
+
+        vector<float> left = Kinematics::PositionFromTransform(m_kinematics.CalculateTransform(Kinematics::leftFoot, walk.m_left_leg_angles));
+        vector<float> right = Kinematics::PositionFromTransform(m_kinematics.CalculateTransform(Kinematics::rightFoot, walk.m_right_leg_angles));
+        if (left[0] != left[0] or left[2] != left[2] or right[0] != right[0] or right[2] != right[2])
+        {   // the walk can not make the speed with these parameters
+            fallen = true;
+            break;
+        }
+
+        // the lower foot is on the ground, both are if they are at about the same height
+        bool previousleftsupport = leftsupport, previousrightsupport = rightsupport;
+        leftsupport = left[2] < right[2] + DoubleSupportHeight;
+        rightsupport = right[2] < left[2] + DoubleSupportHeight;
+
+        if (not previousleft.empty())
+        {   // the torso moves forwards as the foot on the ground is moved backwards
+            if (leftsupport and previousleftsupport)
+                distance -= left[0] - previousleft[0];
+            else if (rightsupport and previousrightsupport)
+                distance -= right[0] - previousright[0];
+
+            for (size_t i=0; i<walk.m_left_leg_angles.size(); i++)
+                energy += 2*fabs(StallTorque*walk.m_left_leg_gains[i]/100*(walk.m_left_leg_angles[i] - previouslangles[i]));
+            for (size_t i=0; i<walk.m_right_leg_angles.size(); i++)
+                energy += 2*fabs(StallTorque*walk.m_right_leg_gains[i]/100*(walk.m_right_leg_angles[i] - previousrangles[i]));
+            energy += 21.0*TimeStep/1000;
+        }
+
+        if (isSupported(left, right, leftsupport, rightsupport))
+            unsupportedtime = 0;
+        else
+            unsupportedtime += TimeStep;
+        if (unsupportedtime > FallTime)
+        {
+            fallen = true;
+            break;
+        }
+
+        previousleft = left;
+        previousright = right;
+        previouslangles = walk.m_left_leg_angles;
+        previousrangles = walk.m_right_leg_angles;
+    }
+
+    float duration = walk.m_current_time;
+    float speed, cost;
+    if (fallen)
+    {
+        distance = max(10.0f, distance);
+        duration = max(300.0f, duration);
+        energy = max(20.0f, energy);
+        speed = 1000*distance/duration;
+        cost = 100*energy/(9.81*4.6*distance);
+
+        // penalise for falling
+        speed *= 0.5*distance/333.0;
+        cost /= 0.5*distance/333.0;
+    }
+    else
+    {
+        distance = max(1.0f, distance);
+        speed = 1000*distance/duration;
+        cost = 100*energy/(9.81*4.6*distance);
+    }
+
+    #if DEBUG_NUMOTION_VERBOSITY > 2
+        debug << "JuppWalkModel::evaluate(). distance: " << distance << " duration: " << duration << " energy: " << energy << " fallen: " << fallen << endl;
+    #endif
+    vector<float> fitness(2, 0);
+    fitness[0] = speed;
+    fitness[1] = 180/(4 + cost);
+    return fitness;
+}
+
+/*! @brief Puts the walk at the start of an evaluation, standing still with the given parameters
+    @param parameters the walk parameters, in the WalkParameters::getAsVector() order
+ */
+void JuppWalkModel::reset(const vector<float>& parameters)
+{
+    JuppWalk& walk = *m_walk;
+    walk.m_walk_parameters = m_initial_parameters;
+    walk.m_walk_parameters.set(parameters);
+    walk.getParameters();
+
+    walk.m_current_time = 0;
+    walk.m_previous_time = 0;
+    walk.m_gait_phase = 0;
+    walk.m_speed_x = 0;
+    walk.m_speed_y = 0;
+    walk.m_speed_yaw = 0;
+    walk.m_gyro_foot_pitch = 0;
+    walk.m_gyro_foot_roll = 0;
+    walk.m_gyro_leg_pitch = 0;
+}
+
+/*! @brief Returns true if the centre of mass is above the support polygon of the feet on the ground
+
+    Each foot is a rectangle, and the yaw of the feet is ignored. Both rectangles are the same size, so the support
+    polygon of both feet is a rectangle swept along the line between their centres, and the centre of mass is above it
+    if there is a point on that line from which the centre of mass is inside the rectangle.
+    @param left the position of the left foot relative to the torso
+    @param right the position of the right foot relative to the torso
+    @param leftsupport true if the left foot is on the ground
+    @param rightsupport true if the right foot is on the ground
+ */
+bool JuppWalkModel::isSupported(const vector<float>& left, const vector<float>& right, bool leftsupport, bool rightsupport)
+{
+    // the feet are not symmetric about their origins, so use the centre of each foot
+    float forward = m_kinematics.getFootForwardLength();
+    float backward = m_kinematics.getFootBackwardLength();
+    float halfwidth = (m_kinematics.getFootInnerWidth() + m_kinematics.getFootOuterWidth())/2;
+    float outwards = (m_kinematics.getFootOuterWidth() - m_kinematics.getFootInnerWidth())/2;
+    float start[2] = {left[0], left[1] + outwards};
+    float end[2] = {right[0], right[1] - outwards};
+    if (not leftsupport)
+        copy(end, end + 2, start);
+    else if (not rightsupport)
+        copy(start, start + 2, end);
+
+    // the centre of mass is at the torso origin; find the part of the line from start to end from which it is inside the foot
+    float low[2] = {-forward, -halfwidth};
+    float high[2] = {backward, halfwidth};
+    float tmin = 0, tmax = 1;
+    for (int i=0; i<2; i++)
+    {
+        float delta = end[i] - start[i];
+        if (fabs(delta) < 1e-6)
+        {
+            if (-start[i] < low[i] or -start[i] > high[i])
+                return false;
+        }
+        else
+        {   // low <= -(start + t*delta) <= high
+            float t1 = -(start[i] + low[i])/delta;
+            float t2 = -(start[i] + high[i])/delta;
+            tmin = max(tmin, min(t1, t2));
+            tmax = min(tmax, max(t1, t2));
+        }
+    }
+    return tmin <= tmax;
+}
+
@@ -0,0 +1,82 @@
+/*! @file JuppWalkModel.h
+    @brief Declaration of a kinematic model of the JuppWalk, for evaluating walk parameters without a robot
+
+    @class JuppWalkModel
+    @brief A FitnessFunction that walks the JuppWalk forwards on a kinematic model of the NAO.
+
+    The gait is the JuppWalk's own: each step of the model sets the walk's speed and time, and calls the same
+    functions as JuppWalk::doWalk() to get the leg angles. The walk's sensors, actionators and the Blackboard are
+    not used (so there is no gyro feedback), and each model has its own JuppWalk, so several models can be run at
+    once, one per thread, by the ParallelEvaluator.
+
+    The leg angles are put through the Kinematics model of the NAO to get the position of each foot relative to the
+    torso. The lower foot is on the ground and does not slip, so the torso moves by the opposite of that foot's
+    movement. The centre of mass is taken to be above the torso origin, and the robot falls if it stays outside the
+    support polygon of the feet for longer than FallTime. The walk accelerates to its maximum forward speed at its
+    maximum forward acceleration, as NUWalk::calculateCurrentSpeed() does.
+
+    The fitness mirrors the WalkOptimisationProvider's: [speed, 180/(4 + cost)], and a fall is penalised the same
+    way. The energy for the cost of transport is estimated like WalkOptimisationState::updateEnergy() does from
+    joint torques, with the torque of each joint taken to be its stiffness times StallTorque.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JUPPWALKMODEL_H
+#define JUPPWALKMODEL_H
+
+#include "Tools/Optimisation/FitnessFunction.h"
+#include "Tools/Optimisation/Parameter.h"
+#include "Motion/Walks/WalkParameters.h"
+#include "Kinematics/Kinematics.h"
+
+class JuppWalk;
+
+#include <vector>
+using namespace std;
+
+class JuppWalkModel : public FitnessFunction
+{
+public:
+    JuppWalkModel(float duration = 10);
+    JuppWalkModel(const JuppWalkModel& other);
+    ~JuppWalkModel();
+
+    vector<Parameter> getInitialParameters();
+
+    vector<float> evaluate(const vector<float>& parameters);
+    unsigned int getNumObjectives() const;
+    FitnessFunction* clone() const;
+
+    static const float TimeStep;                //!< the time between steps of the model (ms)
+    static const float FallTime;                //!< the time the centre of mass can be unsupported before the robot falls (ms)
+    static const float DoubleSupportHeight;     //!< both feet are on the ground if their heights are within this (cm)
+    static const float StallTorque;             //!< the torque of a joint at full stiffness (Nm), used to estimate the energy
+private:
+    JuppWalkModel& operator=(const JuppWalkModel&);
+    void reset(const vector<float>& parameters);
+    bool isSupported(const vector<float>& left, const vector<float>& right, bool leftsupport, bool rightsupport);
+private:
+    float m_duration;                           //!< the length of each evaluation (s)
+    JuppWalk* m_walk;                           //!< the walk engine, only its gait is used
+    WalkParameters m_initial_parameters;        //!< the walk's default parameters, each candidate is applied to a copy of these
+    Kinematics m_kinematics;                    //!< the kinematic model of the robot
+};
+
+#endif
+
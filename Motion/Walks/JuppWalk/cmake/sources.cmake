@@ -21,6 +21,8 @@ ENDIF()
 
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  JuppWalk.cpp JuppWalk.h
+                JuppWalkGaitTable.cpp JuppWalkGaitTable.h
+                JuppWalkModel.cpp JuppWalkModel.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
@@ -26,7 +26,7 @@
 
 namespace MotionConstants {
 
-    #if defined(TARGET_IS_NAO)
+    #if defined(TARGET_IS_NAO) or defined(TARGET_IS_REPLAY)
         const static float MOTION_FRAME_LENGTH_S = 0.01f;
     #elif defined(TARGET_IS_NAOWEBOTS)
         const static float MOTION_FRAME_LENGTH_S = 0.04f;
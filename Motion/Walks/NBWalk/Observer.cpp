@@ -18,12 +18,10 @@
 // and the GNU Lesser Public License along with Man.  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <cstdio>
 #include "Observer.h"
-using std::list;
 
-using namespace NBMath;
-
-#if defined(TARGET_IS_NAO)
+#if defined(TARGET_IS_NAO) or defined(TARGET_IS_REPLAY)
     // generated by octave for the NAO (10ms motion frame period)
     const float Observer::weights[NUM_AVAIL_PREVIEW_FRAMES] = 
     {59.398850, 94.740387, 103.828147, 102.692560, 98.255666, 92.929737, 87.528720, 82.317724,
@@ -80,30 +78,10 @@ using namespace NBMath;
 #endif
 
 Observer::Observer()
-    : WalkController(), stateVector(ufvector3(3)),
-      A(ufmatrix3(3,3)), b(ufvector3(3)), c(ufrowVector3(1,3)),
-      L(ufvector3(3)),trackingError(0.0f)
+    : WalkController(), trackingError(0.0f)
       {
-    // instantiate the ublas matrices with their respective values
-    // TODO: there might be a better way to do this.
-    for (int i=0; i < 3; i++)
-        stateVector(i) = 0.0f;
-
-    for (int i=0; i < 3; i++)
-        A(0, i) = A_values[i];
     for (int i=0; i < 3; i++)
-        A(1, i) = A_values[3+i];
-    for (int i=0; i < 3; i++)
-        A(2, i) = A_values[6+i];
-
-    for (int i=0; i < 3; i++)
-        b(i) = b_values[i];
-
-    for (int i=0; i < 3; i++)
-        c(0,i) = c_values[i];
-
-    for (int i=0; i < 3; i++)
-        L(i) = L_values[i];
+        stateVector[i] = 0.0f;
 
 #ifdef DEBUG_CONTROLLER_GAINS
     FILE * gains_log;
@@ -124,26 +102,26 @@ Observer::Observer()
  * Tick calculates the next state vector for the robot, given the zmp_ref
  *
  */
-const float Observer::tick(const list<float> *zmp_ref,
+const float Observer::tick(const ZmpRefQueue *zmp_ref,
                            const float cur_zmp_ref,
                            const float sensor_zmp) {
-    float preview_control = 0.0f;
-    unsigned int counter = 0;
+    const float preview_control = zmp_ref->dot(weights, NUM_PREVIEW_FRAMES);
 
-    for (list<float>::const_iterator i = zmp_ref->begin();
-         counter < NUM_PREVIEW_FRAMES; ++counter, ++i) {
-        preview_control += weights[counter]* (*i);
-    }
-
-    trackingError += prod(c,stateVector)(0) - cur_zmp_ref;
+    const float c_state = c_values[0]*stateVector[0] +
+        c_values[1]*stateVector[1] + c_values[2]*stateVector[2];
+    trackingError += c_state - cur_zmp_ref;
 
     const float control = -Gi * trackingError - preview_control;
-    const float psensor = sensor_zmp;
+    const float innovation = sensor_zmp - c_state;
 
-    ufvector3 temp(prod(A, stateVector)
-                   - L*(psensor - prod(c,stateVector)(0)) * 1.0f
-                   + b*control);
-    stateVector.assign(temp);
+    // stateVector = A*stateVector - L*innovation + b*control
+    float temp[3];
+    for (int i=0; i < 3; i++)
+        temp[i] = A_values[3*i]*stateVector[0] + A_values[3*i+1]*stateVector[1]
+            + A_values[3*i+2]*stateVector[2]
+            - L_values[i]*innovation + b_values[i]*control;
+    for (int i=0; i < 3; i++)
+        stateVector[i] = temp[i];
 
     return getPosition();
 }
@@ -153,8 +131,8 @@ const float Observer::tick(const list<float> *zmp_ref,
  * We also assume we are starting off without any tracking error.
  */
 void Observer::initState(float x, float v, float p){
-    stateVector(0) = x;
-    stateVector(1) = v;
-    stateVector(2) = p;
+    stateVector[0] = x;
+    stateVector[1] = v;
+    stateVector[2] = p;
     trackingError = 0.0f;
 }
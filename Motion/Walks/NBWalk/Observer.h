@@ -27,6 +27,8 @@
  * The weights and the time invariant system matrix A (see constructor, etc)
  * are pre-calculated in Octave (see observer.m and setupobserver.m). The
  * theory is described in Czarnetzki and Kajita and Katayama.
+ * The system is only 3x3, so tick() does the state update with plain float
+ * arithmetic on the constant arrays rather than going through uBLAS.
  *
  * @author George Slavov
  * @author Johannes Strom
@@ -37,12 +39,6 @@
 #ifndef _Observer_h_DEFINED
 #define _Observer_h_DEFINED
 
-#include <boost/numeric/ublas/matrix.hpp>
-#include <boost/numeric/ublas/vector.hpp>
-
-#include <list>
-
-#include "NBInclude/NBMatrixMath.h"
 #include "WalkController.h"
 
 #include "targetconfig.h"
@@ -51,18 +47,18 @@ class Observer : public WalkController {
 public:
     Observer();
     virtual ~Observer(){};
-    virtual const float tick(const std::list<float> *zmp_ref,
+    virtual const float tick(const ZmpRefQueue *zmp_ref,
                              const float cur_zmp_ref,
                              const float sensor_zmp);
-    virtual const float getPosition() const { return stateVector(0); }
-    virtual const float getZMP() const {return stateVector(2);}
+    virtual const float getPosition() const { return stateVector[0]; }
+    virtual const float getZMP() const {return stateVector[2];}
 
     virtual void initState(float x, float v, float p);
 private:
-    NBMath::ufvector3 stateVector;
+    float stateVector[3];
 
 public: //Constants
-    #if defined(TARGET_IS_NAO)
+    #if defined(TARGET_IS_NAO) or defined(TARGET_IS_REPLAY)
         static const unsigned int NUM_PREVIEW_FRAMES = 70;
         static const unsigned int NUM_AVAIL_PREVIEW_FRAMES = 120;
     #elif defined(TARGET_IS_NAOWEBOTS)
@@ -80,11 +76,6 @@ private:
     static const float L_values[3];
     static const float Gi;
 
-    NBMath::ufmatrix3 A;
-    NBMath::ufvector3 b;
-    NBMath::ufrowVector3 c;
-    NBMath::ufvector3 L;
-
     float trackingError;
 };
 
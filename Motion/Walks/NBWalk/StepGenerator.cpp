@@ -18,6 +18,7 @@
 // <http://www.gnu.org/licenses/>.
 
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 #include <boost/shared_ptr.hpp>
@@ -47,9 +48,10 @@ StepGenerator::StepGenerator(shared_ptr<Sensors> s, const MetaGait * _gait)
     joints_com_i(CoordFrame3D::vector3D(0.0f,0.0f)),
     com_f(CoordFrame3D::vector3D(0.0f,0.0f)),
     est_zmp_i(CoordFrame3D::vector3D(0.0f,0.0f)),
-    zmp_ref_x(list<float>()),zmp_ref_y(list<float>()),
+    zmp_ref_x(),zmp_ref_y(),
     futureSteps(),
     currentZMPDSteps(),
+    nextZmpPlan(0),
     si_Transform(CoordFrame3D::identity3D()),
     last_zmp_end_s(CoordFrame3D::vector3D(0.0f,0.0f)),
     if_Transform(CoordFrame3D::identity3D()),
@@ -88,7 +90,8 @@ StepGenerator::StepGenerator(shared_ptr<Sensors> s, const MetaGait * _gait)
 #ifdef DEBUG_ZMP_REF
     zmp_ref_log = fopen("/tmp/zmp_ref_log.xls","w");
 #endif
-
+    for (unsigned int i = 0; i < ZMP_PLAN_CACHE_SIZE; i++)
+        zmpPlanCache[i].valid = false;
 }
 
 StepGenerator::~StepGenerator()
@@ -146,15 +149,14 @@ zmp_xy_tuple StepGenerator::generate_zmp_ref() {
         }
 #ifdef DEBUG_ZMP
         cout << "generate_zmp_ref()\n";
-        list<float>::iterator it;
         cout << "zmp_ref_x: " << zmp_ref_x.size();
-        for (it=zmp_ref_x.begin(); it!=zmp_ref_x.end(); ++it)
-            cout << " " << *it;
+        for (unsigned int i=0; i<zmp_ref_x.size(); ++i)
+            cout << " " << zmp_ref_x[i];
         cout << "\n";
 
         cout << " zmp_ref_y: " << zmp_ref_y.size();
-        for (it=zmp_ref_y.begin(); it!=zmp_ref_y.end(); ++it)
-            cout << " " << *it;
+        for (unsigned int i=0; i<zmp_ref_y.size(); ++i)
+            cout << " " << zmp_ref_y[i];
         cout << "\n";
 #endif
     }
@@ -381,10 +383,10 @@ void StepGenerator::swapSupportLegs(){
         //there are at least three elements in the list, pop the obsolete one
         //(currently use last step to determine when to stop, hackish-ish)
         //and the first step is the support one now, the second the swing
-        lastStep_s = *currentZMPDSteps.begin();
+        lastStep_s = currentZMPDSteps.front();
         currentZMPDSteps.pop_front();
-        swingingStep_s  = *(++currentZMPDSteps.begin());
-        supportStep_s   =  *currentZMPDSteps.begin();
+        swingingStep_s  = currentZMPDSteps[1];
+        supportStep_s   = currentZMPDSteps.front();
 
         supportFoot = (supportStep_s->foot == LEFT_FOOT ?
                        LEFT_SUPPORT : RIGHT_SUPPORT);
@@ -429,14 +431,14 @@ void StepGenerator::swapSupportLegs(){
         //in the F coordinate frames, we express Steps representing
         // the three footholds from above
         supportStep_f =
-            shared_ptr<Step>(new Step(supp_pos_f(0),supp_pos_f(1),
-                                      0.0f,*supportStep_s));
+            StepPool::create(supp_pos_f(0),supp_pos_f(1),
+                             0.0f,*supportStep_s);
         swingingStep_f =
-            shared_ptr<Step>(new Step(swing_pos_f(0),swing_pos_f(1),
-                                      swing_dest_angle,*swingingStep_s));
+            StepPool::create(swing_pos_f(0),swing_pos_f(1),
+                             swing_dest_angle,*swingingStep_s);
         swingingStepSource_f  =
-            shared_ptr<Step>(new Step(swing_src_f(0),swing_src_f(1),
-                                      swing_src_angle,*lastStep_s));
+            StepPool::create(swing_src_f(0),swing_src_f(1),
+                             swing_src_angle,*lastStep_s);
 
 }
 
@@ -468,9 +470,105 @@ void StepGenerator::fillZMP(const shared_ptr<Step> newSupportStep ){
  * Generates the ZMP reference pattern for a normal step
  */
 void StepGenerator::fillZMPRegular(const shared_ptr<Step> newSupportStep ){
-    //update the lastZMPD Step
-    const float sign = (newSupportStep->foot == LEFT_FOOT ? 1.0f : -1.0f);
-    const float last_sign = -sign;
+    const ZmpStepPlan& plan = getZmpStepPlan(newSupportStep);
+
+    const ufvector3 start_i = prod(si_Transform,last_zmp_end_s);
+    const ufvector3 mid_i = prod(si_Transform,plan.mid_s);
+    const ufvector3 end_i = prod(si_Transform,plan.end_s);
+
+    const float start_x = start_i(0), start_y = start_i(1);
+    const float mid_x = mid_i(0), mid_y = mid_i(1);
+    const float end_x = end_i(0), end_y = end_i(1);
+
+    //Now, we interpolate between the three points. The line between
+    //start and mid is double support, and the line between mid and end
+    //is double support
+
+    //double support - consists of 3 phases:
+    //  1) a static portion at start_i
+    //  2) a moving (diagonal) portion between start_i and mid_i
+    //  3) a static portion at start_i
+    //The time is split between these phases according to
+    //the constant gait->dblSupInactivePercentage
+
+    //Phase 1) - stay at start_i
+    for(int i = 0; i< plan.halfNumDSChops; i++){
+        zmp_ref_x.push_back(start_x);
+        zmp_ref_y.push_back(start_y);
+    }
+
+    //phase 2) - move from start_i to
+    for(int i = 0; i< plan.numDMChops; i++){
+        const float t = static_cast<float>(i)/
+            static_cast<float>(plan.numDMChops);
+        zmp_ref_x.push_back(start_x + t*(mid_x - start_x));
+        zmp_ref_y.push_back(start_y + t*(mid_y - start_y));
+    }
+
+    //phase 3) - stay at mid_i
+    for(int i = 0; i< plan.halfNumDSChops; i++){
+        zmp_ref_x.push_back(mid_x);
+        zmp_ref_y.push_back(mid_y);
+    }
+
+    //single support -  we want to stay over the new step
+    for(int i = 0; i< plan.numSChops; i++){
+        const float t = static_cast<float>(i)/
+            static_cast<float>(plan.numSChops);
+        zmp_ref_x.push_back(mid_x + t*(end_x - mid_x));
+        zmp_ref_y.push_back(mid_y + t*(end_y - mid_y));
+    }
+
+    //update our reference frame for the next time this method is called
+    si_Transform = prod(si_Transform,plan.s_sprime);
+    //store the end of the zmp in the next s frame:
+    last_zmp_end_s = plan.next_start_s;
+}
+
+/**
+ * Returns the ZMP plan for a regular step, reusing a cached plan if we have
+ * recently zmpd an identical step (which is always the case when walking
+ * with a constant speed command).
+ */
+const ZmpStepPlan& StepGenerator::getZmpStepPlan(const shared_ptr<Step> step){
+    for (unsigned int i = 0; i < ZMP_PLAN_CACHE_SIZE; i++){
+        const ZmpStepPlan& plan = zmpPlanCache[i];
+        if (plan.valid && plan.foot == step->foot &&
+            plan.x == step->x && plan.y == step->y &&
+            plan.theta == step->theta &&
+            plan.bodyOffX == gait->stance[WP::BODY_OFF_X] &&
+            plan.doubleSupportFrames == step->doubleSupportFrames &&
+            plan.singleSupportFrames == step->singleSupportFrames &&
+            std::equal(step->zmpConfig, step->zmpConfig + WP::LEN_ZMP_CONFIG,
+                       plan.zmpConfig))
+            return plan;
+    }
+
+    ZmpStepPlan& plan = zmpPlanCache[nextZmpPlan];
+    nextZmpPlan = (nextZmpPlan + 1) % ZMP_PLAN_CACHE_SIZE;
+    makeZmpStepPlan(step, plan);
+    return plan;
+}
+
+/**
+ * Calculates the key points of the ZMP pattern for a regular step in the
+ * s frame, the number of frames in each phase, and the transforms to the
+ * next s frame.
+ */
+void StepGenerator::makeZmpStepPlan(const shared_ptr<Step> step,
+                                    ZmpStepPlan& plan) const {
+    plan.valid = true;
+    plan.foot = step->foot;
+    plan.x = step->x;
+    plan.y = step->y;
+    plan.theta = step->theta;
+    plan.bodyOffX = gait->stance[WP::BODY_OFF_X];
+    plan.doubleSupportFrames = step->doubleSupportFrames;
+    plan.singleSupportFrames = step->singleSupportFrames;
+    std::copy(step->zmpConfig, step->zmpConfig + WP::LEN_ZMP_CONFIG,
+              plan.zmpConfig);
+
+    const float sign = (step->foot == LEFT_FOOT ? 1.0f : -1.0f);
 
     //The intent of this constant is to be approximately the length of the foot
     //and corresponds to the distance we would like the ZMP to move along the
@@ -493,107 +591,53 @@ void StepGenerator::fillZMPRegular(const shared_ptr<Step> newSupportStep ){
     // foot back is bad. We need to swing more toward the opening step in
     // order to not fall inward.
     const float HACK_AMOUNT_PER_PI_OF_TURN =
-        newSupportStep->zmpConfig[WP::TURN_ZMP_OFF];
+        step->zmpConfig[WP::TURN_ZMP_OFF];
     const float HACK_AMOUNT_PER_1_OF_LATERAL =
-        newSupportStep->zmpConfig[WP::STRAFE_ZMP_OFF];
+        step->zmpConfig[WP::STRAFE_ZMP_OFF];
 
-    float adjustment = ((newSupportStep->theta / M_PI_FLOAT)
+    float adjustment = ((step->theta / M_PI_FLOAT)
                         * HACK_AMOUNT_PER_PI_OF_TURN);
-    adjustment += (newSupportStep->y - (sign*HIP_OFFSET_Y))
+    adjustment += (step->y - (sign*HIP_OFFSET_Y))
         * HACK_AMOUNT_PER_1_OF_LATERAL;
 
     //Another HACK (ie. zmp is not perfect)
     //This moves the zmp reference to the outside of the foot
-    float Y_ZMP_OFFSET = (newSupportStep->foot == LEFT_FOOT ?
-                          newSupportStep->zmpConfig[WP::L_ZMP_OFF_Y]:
-                          newSupportStep->zmpConfig[WP::R_ZMP_OFF_Y]);
+    float Y_ZMP_OFFSET = (step->foot == LEFT_FOOT ?
+                          step->zmpConfig[WP::L_ZMP_OFF_Y]:
+                          step->zmpConfig[WP::R_ZMP_OFF_Y]);
 
     Y_ZMP_OFFSET += adjustment;
 
     // When we turn, the ZMP offset needs to be corrected for the rotation of
-    // newSupportStep. A picture would be very useful here. Someday...
-    float y_zmp_offset_x = -sin(std::abs(newSupportStep->theta)) * Y_ZMP_OFFSET;
-    float y_zmp_offset_y = cos(newSupportStep->theta) * Y_ZMP_OFFSET;
+    // step. A picture would be very useful here. Someday...
+    float y_zmp_offset_x = -sin(std::abs(step->theta)) * Y_ZMP_OFFSET;
+    float y_zmp_offset_y = cos(step->theta) * Y_ZMP_OFFSET;
 
     //lets define the key points in the s frame. See diagram in paper
     //to use bezier curves, we would need also directions for each point
-    const ufvector3 start_s = last_zmp_end_s;
-    const ufvector3 end_s =
-        CoordFrame3D::vector3D(newSupportStep->x +
+    //(the start point is where the last step's ZMP ended)
+    plan.end_s =
+        CoordFrame3D::vector3D(step->x +
                                gait->stance[WP::BODY_OFF_X] +
                                y_zmp_offset_x,
-                               newSupportStep->y + sign*y_zmp_offset_y);
-    const ufvector3 mid_s =
-        CoordFrame3D::vector3D(newSupportStep->x +
+                               step->y + sign*y_zmp_offset_y);
+    plan.mid_s =
+        CoordFrame3D::vector3D(step->x +
                                gait->stance[WP::BODY_OFF_X] +
                                y_zmp_offset_x - X_ZMP_FOOT_LENGTH,
-                               newSupportStep->y + sign*y_zmp_offset_y);
-
-    const ufvector3 start_i = prod(si_Transform,start_s);
-    const ufvector3 mid_i = prod(si_Transform,mid_s);
-    const ufvector3 end_i = prod(si_Transform,end_s);
-
-    //Now, we interpolate between the three points. The line between
-    //start and mid is double support, and the line between mid and end
-    //is double support
-
-    //double support - consists of 3 phases:
-    //  1) a static portion at start_i
-    //  2) a moving (diagonal) portion between start_i and mid_i
-    //  3) a static portion at start_i
-    //The time is split between these phases according to
-    //the constant gait->dblSupInactivePercentage
+                               step->y + sign*y_zmp_offset_y);
 
     //First, split up the frames:
-    const int halfNumDSChops = //DS - DoubleStaticChops
-       static_cast<int>(static_cast<float>(newSupportStep->doubleSupportFrames)*
-                        newSupportStep->zmpConfig[WP::DBL_SUP_STATIC_P]/2.0f);
-    const int numDMChops = //DM - DoubleMovingChops
-        newSupportStep->doubleSupportFrames - halfNumDSChops*2;
+    plan.halfNumDSChops = //DS - DoubleStaticChops
+       static_cast<int>(static_cast<float>(step->doubleSupportFrames)*
+                        step->zmpConfig[WP::DBL_SUP_STATIC_P]/2.0f);
+    plan.numDMChops = //DM - DoubleMovingChops
+        step->doubleSupportFrames - plan.halfNumDSChops*2;
 
-    //Phase 1) - stay at start_i
-    for(int i = 0; i< halfNumDSChops; i++){
-        zmp_ref_x.push_back(start_i(0));
-        zmp_ref_y.push_back(start_i(1));
-    }
+    plan.numSChops = step->singleSupportFrames;
 
-    //phase 2) - move from start_i to
-    for(int i = 0; i< numDMChops; i++){
-        ufvector3 new_i = start_i +
-            (static_cast<float>(i)/
-             static_cast<float>(numDMChops) ) *
-            (mid_i-start_i);
-
-        zmp_ref_x.push_back(new_i(0));
-        zmp_ref_y.push_back(new_i(1));
-    }
-
-    //phase 3) - stay at mid_i
-    for(int i = 0; i< halfNumDSChops; i++){
-        zmp_ref_x.push_back(mid_i(0));
-        zmp_ref_y.push_back(mid_i(1));
-    }
-
-
-    //single support -  we want to stay over the new step
-    const int numSChops = newSupportStep->singleSupportFrames;
-    for(int i = 0; i< numSChops; i++){
-//    const int numSChops = gait->stepDurationFrames;
-//    for(int i = 0; i< gait->stepDurationFrames; i++){
-
-        ufvector3 new_i = mid_i +
-            (static_cast<float>(i) /
-             static_cast<float>(numSChops) ) *
-            (end_i-mid_i);
-
-        zmp_ref_x.push_back(new_i(0));
-        zmp_ref_y.push_back(new_i(1));
-    }
-
-    //update our reference frame for the next time this method is called
-    si_Transform = prod(si_Transform,get_s_sprime(newSupportStep));
-    //store the end of the zmp in the next s frame:
-    last_zmp_end_s = prod(get_sprime_s(newSupportStep),end_s);
+    plan.s_sprime = get_s_sprime(step);
+    plan.next_start_s = prod(get_sprime_s(step),plan.end_s);
 }
 
 /**
@@ -801,13 +845,13 @@ void StepGenerator::resetSteps(const bool startLeft){
     //Support step is END Type, but the first swing step, generated
     //in generateStep, is REGULAR type.
     shared_ptr<Step> firstSupportStep =
-      shared_ptr<Step>(new Step(ZERO_WALKVECTOR,
-                                  *gait,
-                                  firstSupportFoot,ZERO_WALKVECTOR,END_STEP));
+      StepPool::create(ZERO_WALKVECTOR,
+                       *gait,
+                       firstSupportFoot,ZERO_WALKVECTOR,END_STEP);
     shared_ptr<Step> dummyStep =
-        shared_ptr<Step>(new Step(ZERO_WALKVECTOR,
-                                  *gait,
-                                  dummyFoot));
+        StepPool::create(ZERO_WALKVECTOR,
+                         *gait,
+                         dummyFoot);
     //need to indicate what the current support foot is:
     currentZMPDSteps.push_back(dummyStep);//right gets popped right away
     fillZMP(firstSupportStep);
@@ -891,12 +935,12 @@ void StepGenerator::generateStep( float _x,
 
     const WalkVector new_walk = {_x,_y,_theta};
 
-    shared_ptr<Step> step(new Step(new_walk,
+    shared_ptr<Step> step = StepPool::create(new_walk,
                                    *gait,
                                    (nextStepIsLeft ?
                                     LEFT_FOOT : RIGHT_FOOT),
                    lastQueuedStep->walkVector,
-                                   type));
+                                   type);
 
 #ifdef DEBUG_STEPGENERATOR
     cout << "Generated a new step: "<<*step<<endl;
@@ -94,6 +94,8 @@
 #include "NBInclude/NBMatrixMath.h"
 #include "ZmpEKF.h"
 #include "ZmpAccExp.h"
+#include "ZmpRefQueue.h"
+#include "StepPool.h"
 
 //Debugging flags:
 //#ifdef WALK_DEBUG
@@ -104,8 +106,8 @@
 // ZMP Preview Queue Debugging
 #define DEBUG_ZMP_REF
 
-typedef boost::tuple<const std::list<float>*,
-                     const std::list<float>*> zmp_xy_tuple;
+typedef boost::tuple<const ZmpRefQueue*,
+                     const ZmpRefQueue*> zmp_xy_tuple;
 typedef boost::tuple<LegJointStiffTuple,
                       LegJointStiffTuple> WalkLegsTuple;
 typedef boost::tuple<ArmJointStiffTuple,
@@ -114,6 +116,29 @@ typedef boost::tuple<ArmJointStiffTuple,
 static unsigned int MIN_NUM_ENQUEUED_STEPS = 3; //At any given time, we need at least 3
                                      //steps stored in future, current lists
 
+/**
+ * The part of a regular step's ZMP reference pattern which depends only on
+ * the step itself (and the gait), and not on where the walk currently is.
+ * Walking with a constant (x, y, theta) command produces the same left and
+ * right steps over and over, so these are cached by the StepGenerator and
+ * only the transform into the i frame is done for each step.
+ */
+struct ZmpStepPlan {
+    // the key
+    bool valid;
+    Foot foot;
+    float x, y, theta;
+    float bodyOffX;
+    unsigned int doubleSupportFrames, singleSupportFrames;
+    float zmpConfig[WP::LEN_ZMP_CONFIG];
+
+    // the plan
+    NBMath::ufvector3 mid_s, end_s;     // key points of the ZMP in the s frame
+    NBMath::ufvector3 next_start_s;     // end_s expressed in the next s frame
+    NBMath::ufmatrix3 s_sprime;         // see get_s_sprime
+    int halfNumDSChops, numDMChops, numSChops;
+};
+
 class StepGenerator {
 public:
     StepGenerator(boost::shared_ptr<Sensors> s, const MetaGait * _gait);
@@ -154,6 +179,8 @@ private: // Helper methods
     void fillZMP(const boost::shared_ptr<Step> newStep );
     void fillZMPRegular(const boost::shared_ptr<Step> newStep );
     void fillZMPEnd(const boost::shared_ptr<Step> newStep);
+    const ZmpStepPlan& getZmpStepPlan(const boost::shared_ptr<Step> step);
+    void makeZmpStepPlan(const boost::shared_ptr<Step> step, ZmpStepPlan& plan) const;
 
     void resetSteps(const bool startLeft);
 
@@ -188,12 +215,17 @@ private:
     NBMath::ufvector3 com_i,joints_com_i,last_com_c,com_f,est_zmp_i;
     //boost::numeric::ublas::vector<float> com_f;
     // need to store future zmp_ref values (points in xy)
-    std::list<float> zmp_ref_x, zmp_ref_y;
-    std::list<boost::shared_ptr<Step> > futureSteps; //stores steps not yet zmpd
+    ZmpRefQueue zmp_ref_x, zmp_ref_y;
+    StepRing futureSteps; //stores steps not yet zmpd
     //Stores currently relevant steps that are zmpd but not yet completed.
     //A step is consider completed (obsolete/irrelevant) as soon as the foot
     //enters into double support (perisistant)
-    std::list<boost::shared_ptr<Step> > currentZMPDSteps;
+    StepRing currentZMPDSteps;
+
+    //Cache of the ZMP plans of recent regular steps, replaced round robin
+    static const unsigned int ZMP_PLAN_CACHE_SIZE = 8;
+    ZmpStepPlan zmpPlanCache[ZMP_PLAN_CACHE_SIZE];
+    unsigned int nextZmpPlan;
     boost::shared_ptr<Step> lastQueuedStep;
 
     //Reference Frames for ZMPing steps
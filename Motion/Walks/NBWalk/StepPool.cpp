@@ -0,0 +1,85 @@
+// This file is part of Man, a robotic perception, locomotion, and
+// team strategy application created by the Northern Bites RoboCup
+// team of Bowdoin College in Brunswick, Maine, for the Aldebaran
+// Nao robot.
+//
+// Copyright (c) 2026 agent
+//
+// Man is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Man is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// and the GNU Lesser Public License along with Man.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "StepPool.h"
+
+StepPool::Slot StepPool::slots[StepPool::NUM_SLOTS];
+StepPool::Slot* StepPool::freeList = 0;
+bool StepPool::initialised = false;
+unsigned int StepPool::numHeapAllocations = 0;
+
+/**
+ * Returns a block of at least 'bytes' from the pool. Requests which do not
+ * fit in a slot, or which arrive when the pool is empty, go to the heap.
+ */
+void* StepPool::allocate(const std::size_t bytes){
+    if (!initialised){
+        for (unsigned int i = 0; i < NUM_SLOTS - 1; i++)
+            slots[i].next = &slots[i+1];
+        slots[NUM_SLOTS - 1].next = 0;
+        freeList = &slots[0];
+        initialised = true;
+    }
+
+    if (bytes > SLOT_SIZE || freeList == 0){
+        numHeapAllocations++;
+        return ::operator new(bytes);
+    }
+
+    Slot* slot = freeList;
+    freeList = slot->next;
+    return slot;
+}
+
+/**
+ * Returns a block to the pool, or to the heap if that is where it came from
+ */
+void StepPool::deallocate(void* p, const std::size_t bytes){
+    Slot* slot = static_cast<Slot*>(p);
+    if (slot >= &slots[0] && slot < &slots[NUM_SLOTS]){
+        slot->next = freeList;
+        freeList = slot;
+    }
+    else
+        ::operator delete(p);
+}
+
+/**
+ * Creates a new Step (see the Step constructors) in the pool
+ */
+boost::shared_ptr<Step> StepPool::create(const WalkVector &target,
+                                         const AbstractGait &gait,
+                                         const Foot _foot,
+                                         const WalkVector &last,
+                                         const StepType _type){
+    return boost::allocate_shared<Step>(StepAllocator<Step>(),
+                                        target, gait, _foot, last, _type);
+}
+
+/**
+ * Creates a copy of 'other' in a new reference frame, in the pool
+ */
+boost::shared_ptr<Step> StepPool::create(const float new_x, const float new_y,
+                                         const float new_theta,
+                                         const Step &other){
+    return boost::allocate_shared<Step>(StepAllocator<Step>(),
+                                        new_x, new_y, new_theta, other);
+}
@@ -0,0 +1,172 @@
+// This file is part of Man, a robotic perception, locomotion, and
+// team strategy application created by the Northern Bites RoboCup
+// team of Bowdoin College in Brunswick, Maine, for the Aldebaran
+// Nao robot.
+//
+// Copyright (c) 2026 agent
+//
+// Man is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Man is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// and the GNU Lesser Public License along with Man.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ * Fixed-capacity storage for Steps.
+ *
+ * The StepGenerator creates around four Steps every step (one in
+ * generateStep and three in swapSupportLegs), and moves them between the
+ * futureSteps and currentZMPDSteps queues. To keep the walk tick free of heap
+ * allocations:
+ *
+ *  - StepPool is a free list of preallocated slots. Steps are created with
+ *    StepPool::create(...), which uses boost::allocate_shared with a
+ *    StepAllocator so that the Step and its shared_ptr control block live in
+ *    a single slot. If the pool is ever exhausted we fall back to the heap,
+ *    and count it so that NUM_SLOTS can be increased.
+ *
+ *  - StepRing is a fixed-capacity ring of shared_ptr<Step> used in place of
+ *    std::list for the step queues.
+ *
+ * Steps are only created and destroyed by the motion thread, so the pool is
+ * not thread safe.
+ *
+ * @author agent
+ * @date October 2026
+ */
+
+#ifndef _StepPool_h_DEFINED
+#define _StepPool_h_DEFINED
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Step.h"
+
+class StepPool {
+public:
+    static const unsigned int NUM_SLOTS = 64;
+    static const std::size_t SLOT_SIZE = sizeof(Step) + 64;
+
+    static void* allocate(const std::size_t bytes);
+    static void deallocate(void* p, const std::size_t bytes);
+
+    static unsigned int getNumHeapAllocations() { return numHeapAllocations; }
+
+    static boost::shared_ptr<Step> create(const WalkVector &target,
+                                          const AbstractGait &gait,
+                                          const Foot _foot,
+                                          const WalkVector &last = ZERO_WALKVECTOR,
+                                          const StepType _type = REGULAR_STEP);
+    static boost::shared_ptr<Step> create(const float new_x, const float new_y,
+                                          const float new_theta,
+                                          const Step &other);
+
+private:
+    union Slot {
+        Slot* next;
+        double align;
+        char storage[SLOT_SIZE];
+    };
+
+    static Slot slots[NUM_SLOTS];
+    static Slot* freeList;
+    static bool initialised;
+    static unsigned int numHeapAllocations;
+};
+
+/**
+ * A standard allocator which takes its memory from the StepPool.
+ */
+template <typename T>
+class StepAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U> struct rebind { typedef StepAllocator<U> other; };
+
+    StepAllocator() { }
+    template <typename U> StepAllocator(const StepAllocator<U>&) { }
+
+    pointer address(reference r) const { return &r; }
+    const_pointer address(const_reference r) const { return &r; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        return static_cast<pointer>(StepPool::allocate(n*sizeof(T)));
+    }
+    void deallocate(pointer p, size_type n) {
+        StepPool::deallocate(p, n*sizeof(T));
+    }
+    size_type max_size() const { return StepPool::SLOT_SIZE/sizeof(T); }
+
+    void construct(pointer p, const T& value) { new(p) T(value); }
+    void destroy(pointer p) { p->~T(); }
+
+    template <typename U> bool operator==(const StepAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const StepAllocator<U>&) const { return false; }
+};
+
+/**
+ * A fixed-capacity FIFO of steps. Pushing onto a full ring throws a
+ * std::overflow_error, so that it reaches the motion thread's exception
+ * handler instead of terminating the process.
+ */
+class StepRing {
+public:
+    static const unsigned int CAPACITY = 16;
+
+    StepRing() : head(0), count(0) { }
+
+    void push_back(const boost::shared_ptr<Step> &step) {
+        if (count >= CAPACITY)
+            throw std::overflow_error("StepRing overflow");
+        steps[(head + count) % CAPACITY] = step;
+        count++;
+    }
+    void pop_front() {
+        if (count == 0)
+            return;
+        steps[head].reset();
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+    const boost::shared_ptr<Step>& front() const { return steps[head]; }
+    const boost::shared_ptr<Step>& back() const {
+        return steps[(head + count - 1) % CAPACITY];
+    }
+    const boost::shared_ptr<Step>& operator[](const unsigned int i) const {
+        return steps[(head + i) % CAPACITY];
+    }
+
+    unsigned int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() {
+        while (count > 0)
+            pop_front();
+        head = 0;
+    }
+
+private:
+    boost::shared_ptr<Step> steps[CAPACITY];
+    unsigned int head;
+    unsigned int count;
+};
+
+#endif
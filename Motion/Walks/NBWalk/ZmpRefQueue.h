@@ -0,0 +1,92 @@
+// This file is part of Man, a robotic perception, locomotion, and
+// team strategy application created by the Northern Bites RoboCup
+// team of Bowdoin College in Brunswick, Maine, for the Aldebaran
+// Nao robot.
+//
+// Copyright (c) 2026 agent
+//
+// Man is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Man is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// and the GNU Lesser Public License along with Man.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ * A fixed-capacity ring of ZMP reference values for one dimension.
+ *
+ * The StepGenerator pushes the ZMP reference pattern for each step onto the
+ * back, and pops one value off the front each motion frame. Unlike a
+ * std::list the ring never allocates after construction, and the preview
+ * controller's sum over the next 70-120 values runs over (at most two)
+ * contiguous arrays instead of chasing list nodes.
+ *
+ * @author agent
+ * @date October 2026
+ */
+
+#ifndef _ZmpRefQueue_h_DEFINED
+#define _ZmpRefQueue_h_DEFINED
+
+#include <stdexcept>
+
+class ZmpRefQueue {
+public:
+    // Must be a power of two, and larger than the preview window plus the
+    // ZMP frames of MIN_NUM_ENQUEUED_STEPS of the longest step
+    static const unsigned int CAPACITY = 1024;
+
+    ZmpRefQueue() : head(0), count(0) { }
+
+    void push_back(const float value) {
+        if (count >= CAPACITY)
+            throw std::overflow_error("ZmpRefQueue overflow");
+        values[(head + count) & (CAPACITY - 1)] = value;
+        count++;
+    }
+
+    void pop_front() {
+        if (count == 0)
+            return;
+        head = (head + 1) & (CAPACITY - 1);
+        count--;
+    }
+
+    float front() const { return values[head]; }
+    float operator[](const unsigned int i) const {
+        return values[(head + i) & (CAPACITY - 1)];
+    }
+
+    unsigned int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { head = 0; count = 0; }
+
+    /**
+     * Returns the sum of weights[i]*(*this)[i] for the first n values.
+     * The caller must ensure that there are at least n values in the queue.
+     */
+    float dot(const float* weights, const unsigned int n) const {
+        float sum = 0.0f;
+        const unsigned int first = (head + n <= CAPACITY ? n : CAPACITY - head);
+        const float* v = &values[head];
+        for (unsigned int i = 0; i < first; i++)
+            sum += weights[i]*v[i];
+        for (unsigned int i = first; i < n; i++)
+            sum += weights[i]*values[i - first];
+        return sum;
+    }
+
+private:
+    float values[CAPACITY];
+    unsigned int head;
+    unsigned int count;
+};
+
+#endif
@@ -28,6 +28,8 @@ SET (YOUR_SRCS  NBWalk.cpp NBWalk.h
 		WalkProvider.cpp WalkProvider.h
 		Step.cpp Step.h
 		StepGenerator.cpp StepGenerator.h
+		StepPool.cpp StepPool.h
+		ZmpRefQueue.h
 		Gait.cpp Gait.h
 		AbstractGait.cpp AbstractGait.h
 		MetaGait.cpp MetaGait.h
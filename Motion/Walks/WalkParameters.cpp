@@ -296,7 +296,7 @@ void WalkParameters::setTorsoGains(const vector<vector<float> >& torsogains)
  */
 void WalkParameters::setLegGains(const vector<vector<float> >& leggains)
 {
-    setGains(m_leg_gains, m_num_torso_gains, leggains);
+    setGains(m_leg_gains, m_num_leg_gains, leggains);
 }
 
 /*! @brief Sets the gains with the new gains being careful to clip to 0 and 100.
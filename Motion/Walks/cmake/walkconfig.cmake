@@ -45,8 +45,8 @@ ELSE()
          "Set to ON to use nbwalk, set to OFF use something else")
 ENDIF()
 
-####### Cycloid
-IF (${TARGET_ROBOT} STREQUAL CYCLOID)
+####### Cycloid and Replay
+IF (${TARGET_ROBOT} STREQUAL CYCLOID OR ${TARGET_ROBOT} STREQUAL REPLAY)
     SET( NUBOT_USE_MOTION_WALK_JUPPWALK
          ON
          CACHE BOOL
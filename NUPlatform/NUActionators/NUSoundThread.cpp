@@ -67,13 +67,18 @@ void NUSoundThread::run()
     #endif
     
     int err = 0;
+    vector<string> soundfiles;
     while (err == 0 && errno != EINTR)
     {
         waitForCondition();
         // ------------------------------------------------------------------------------------------------------------------------------------------
-        debug << "NUSoundThread Processing: " << m_player_command + m_sound_dir + m_queue.front() << endl;
-        err = system((m_player_command + m_sound_dir + m_queue.front()).c_str());
-        m_queue.pop_front();
+        soundfiles.clear();
+        drain(soundfiles);
+        for (size_t i = 0; err == 0 && i < soundfiles.size(); i++)
+        {
+            debug << "NUSoundThread Processing: " << m_player_command + m_sound_dir + soundfiles[i] << endl;
+            err = system((m_player_command + m_sound_dir + soundfiles[i]).c_str());
+        }
         // ------------------------------------------------------------------------------------------------------------------------------------------
     } 
     errorlog << "NUSoundThread is exiting. err: " << err << " errno: " << errno << endl;
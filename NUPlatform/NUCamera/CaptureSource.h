@@ -0,0 +1,53 @@
+/*! @file CaptureSource.h
+    @brief Declaration of the abstract CaptureSource class
+
+    @class CaptureSource
+    @brief A source of camera frames for the CaptureThread, ie. a camera or a FakeCaptureSource.
+
+    The frames are usually held in buffers owned by the source (for example the memory mapped V4L2 buffers),
+    and the images reference that memory rather than copying it. Each Frame remembers which buffer its image is in,
+    and the buffer stays with the frame until the frame is passed to capture() again; only then may the source reuse it.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTURESOURCE_H
+#define CAPTURESOURCE_H
+
+#include "Infrastructure/NUImage/NUImage.h"
+
+class CaptureSource
+{
+public:
+    struct Frame
+    {
+        Frame() : Buffer(-1) {};
+        NUImage Image;              //!< the image, its timestamp is the time it was captured
+        int Buffer;                 //!< the index of the source's buffer holding the image, or -1 if it does not hold one
+    };
+public:
+    virtual ~CaptureSource() {};
+
+    /*! @brief Blocks until the next frame arrives, and puts it in frame.
+        @param frame the frame to fill. Its previous image is no longer in use, so its buffer is given back to the source first.
+     */
+    virtual void capture(Frame& frame) = 0;
+};
+
+#endif
+
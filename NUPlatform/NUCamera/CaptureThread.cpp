@@ -0,0 +1,177 @@
+/*! @file CaptureThread.cpp
+    @brief Implementation of the camera capture thread
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CaptureThread.h"
+#include "NUPlatform/NUPlatform.h"
+
+#include "debug.h"
+#include "debugverbositynucamera.h"
+
+#include <algorithm>
+
+const double CaptureThread::MinBackoff = 10;
+const double CaptureThread::MaxBackoff = 1000;
+
+/*! @brief Creates and starts a capture thread. The source must already be streaming.
+    @param source the source of the frames, it must outlive the thread
+    @param priority the priority of the thread. This should be non-zero so that frames are dequeued as soon as they arrive
+ */
+CaptureThread::CaptureThread(CaptureSource* source, unsigned char priority) : Thread("CaptureThread", priority), m_source(source)
+{
+    #if DEBUG_NUCAMERA_VERBOSITY > 4
+        debug << "CaptureThread::CaptureThread(" << source << ") with priority " << static_cast<int>(m_priority) << endl;
+    #endif
+    m_num_captured = 0;
+    m_num_processed = 0;
+    m_num_dropped = 0;
+    m_latency = 0;
+    m_total_latency = 0;
+
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_condition, NULL);
+
+    start();
+}
+
+/*! @brief Stops the capture thread. The frames' buffers are not given back to the source.
+ */
+CaptureThread::~CaptureThread()
+{
+    #if DEBUG_NUCAMERA_VERBOSITY > 4
+        debug << "CaptureThread::~CaptureThread()" << endl;
+    #endif
+    stop();
+    join();
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+/*! @brief Returns the newest frame that has not already been returned, blocking until there is one.
+
+    The image remains valid until the next call. This must only be called from one thread (ie. the vision thread).
+ */
+NUImage* CaptureThread::getNewImage()
+{
+    pthread_mutex_lock(&m_mutex);
+    pthread_cleanup_push(unlockMutex, &m_mutex);            // the vision thread may be stopped while it is waiting here
+    while (not m_frames.hasNewData())
+        pthread_cond_wait(&m_condition, &m_mutex);
+    pthread_cleanup_pop(0);
+
+    unsigned long previous = m_frames.getReadVersion();
+    CaptureSource::Frame& frame = m_frames.acquire();
+    m_num_dropped += m_frames.getReadVersion() - previous - 1;
+    m_num_processed++;
+    m_latency = Platform->getTime() - frame.Image.m_timestamp;
+    m_total_latency += m_latency;
+    #if DEBUG_NUCAMERA_VERBOSITY > 2
+        debug << "CaptureThread::getNewImage(). Frame " << m_frames.getReadVersion() << " latency: " << m_latency << "ms dropped: " << m_num_dropped << endl;
+    #endif
+    pthread_mutex_unlock(&m_mutex);
+    return &frame.Image;
+}
+
+/*! @brief Returns the number of frames that have been captured */
+unsigned long CaptureThread::getNumCaptured()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_captured;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of frames that have been given to vision */
+unsigned long CaptureThread::getNumProcessed()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_processed;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of frames that were overwritten by a newer frame before vision took them */
+unsigned long CaptureThread::getNumDropped()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_dropped;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the time between the last frame given to vision being captured and it being given to vision (ms) */
+double CaptureThread::getLatency()
+{
+    pthread_mutex_lock(&m_mutex);
+    double value = m_latency;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the average time between a frame being captured and it being given to vision (ms) */
+double CaptureThread::getAverageLatency()
+{
+    pthread_mutex_lock(&m_mutex);
+    double value = m_num_processed > 0 ? m_total_latency/m_num_processed : 0;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief The capture thread's main loop. Waits for a frame from the source, and then publishes it.
+
+    When the source throws, the thread waits before trying again, twice as long after each consecutive failure up to
+    MaxBackoff, so that a source that keeps failing neither spins nor floods the errorlog. The wait is a cancellation point.
+ */
+void CaptureThread::run()
+{
+    #if DEBUG_NUCAMERA_VERBOSITY > 4
+        debug << "CaptureThread::run(). Starting " << m_name << "'s mainloop" << endl;
+    #endif
+    double backoff = 0;
+    while (1)
+    {
+        try
+        {
+            m_source->capture(m_frames.getWriteBuffer());
+        }
+        catch (std::exception& e)
+        {
+            backoff = backoff > 0 ? std::min(2*backoff, MaxBackoff) : MinBackoff;
+            errorlog << "CaptureThread::run(). Unhandled exception: " << e.what() << ". Retrying in " << backoff << "ms" << endl;
+            pthread_testcancel();
+            Platform->msleep(backoff);
+            continue;
+        }
+        backoff = 0;
+        pthread_testcancel();
+        m_frames.publish();
+
+        pthread_mutex_lock(&m_mutex);
+        m_num_captured++;
+        pthread_cond_signal(&m_condition);
+        pthread_mutex_unlock(&m_mutex);
+    }
+}
+
+void CaptureThread::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
+
@@ -0,0 +1,79 @@
+/*! @file CaptureThread.h
+    @brief Declaration of the camera capture thread
+
+    @class CaptureThread
+    @brief A thread that takes frames from a CaptureSource as soon as they arrive, and hands the newest one to vision.
+
+    The capture thread blocks in CaptureSource::capture(), so each frame is dequeued and timestamped the moment the
+    camera has finished it, rather than when vision next gets around to asking for one. The frames are passed to vision
+    through a TripleBuffer, so neither thread ever waits for the other to finish with a frame; when vision is slower
+    than the camera, the frames it did not get to are overwritten by newer ones (latest wins).
+
+    The frames are not copied. There are three, one being captured into, one waiting for vision and one being
+    processed by vision, and the source only gets a frame's buffer back when the capture thread reuses that frame.
+
+    getNewImage() returns each frame at most once, and counts the frames that were overwritten before vision took
+    them, and the time between each frame being captured and vision taking it.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTURETHREAD_H
+#define CAPTURETHREAD_H
+
+#include "Tools/Threading/Thread.h"
+#include "Tools/Threading/TripleBuffer.h"
+#include "CaptureSource.h"
+
+#include <pthread.h>
+
+class CaptureThread : public Thread
+{
+public:
+    CaptureThread(CaptureSource* source, unsigned char priority);
+    ~CaptureThread();
+
+    NUImage* getNewImage();
+
+    unsigned long getNumCaptured();
+    unsigned long getNumProcessed();
+    unsigned long getNumDropped();
+    double getLatency();
+    double getAverageLatency();
+
+    static const double MinBackoff;             //!< the wait before retrying a source that has just failed (ms)
+    static const double MaxBackoff;             //!< the longest wait before retrying a source that keeps failing (ms)
+private:
+    void run();
+    static void unlockMutex(void* mutex);
+private:
+    CaptureSource* m_source;                    //!< where the frames come from
+    TripleBuffer<CaptureSource::Frame> m_frames;//!< the frame being captured, the newest frame, and the frame vision has
+
+    pthread_mutex_t m_mutex;                    //!< lock for the counters
+    pthread_cond_t m_condition;                 //!< signalled when a frame is published
+
+    unsigned long m_num_captured;               //!< the number of frames captured
+    unsigned long m_num_processed;              //!< the number of frames given to vision
+    unsigned long m_num_dropped;                //!< the number of frames overwritten before vision took them
+    double m_latency;                           //!< the time between the capture of the last frame given to vision and it being given (ms)
+    double m_total_latency;                     //!< the sum of the latencies of all of the frames given to vision (ms)
+};
+
+#endif
+
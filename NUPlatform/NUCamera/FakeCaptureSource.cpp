@@ -0,0 +1,96 @@
+/*! @file FakeCaptureSource.cpp
+    @brief Implementation of the FakeCaptureSource class
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FakeCaptureSource.h"
+#include "NUPlatform/NUPlatform.h"
+
+#include "debug.h"
+#include "debugverbositynucamera.h"
+
+#include <stdexcept>
+
+/*! @brief Creates a fake capture source
+    @param width the width of the raw YUV422 frames; the NUImages are half this
+    @param height the height of the raw YUV422 frames; the NUImages are half this
+    @param period the time between frames (ms)
+    @param numbuffers the number of frame buffers. The CaptureThread holds three, so there must be at least four
+ */
+FakeCaptureSource::FakeCaptureSource(int width, int height, double period, int numbuffers) : m_width(width), m_height(height), m_period(period)
+{
+    #if DEBUG_NUCAMERA_VERBOSITY > 4
+        debug << "FakeCaptureSource::FakeCaptureSource(" << width << ", " << height << ", " << period << ", " << numbuffers << ")" << endl;
+    #endif
+    m_buffers.resize(numbuffers, std::vector<unsigned char>(2*width*height));
+    for (int i=numbuffers-1; i>=0; i--)
+        m_free.push_back(i);
+    m_next_time = Platform->getTime() + m_period;
+    m_num_frames = 0;
+}
+
+FakeCaptureSource::~FakeCaptureSource()
+{
+}
+
+/*! @brief Waits until the next frame is due, and then fills a free buffer with a test pattern
+    @param frame the frame to fill, its buffer is given back first
+ */
+void FakeCaptureSource::capture(Frame& frame)
+{
+    if (frame.Buffer >= 0)
+        m_free.push_back(frame.Buffer);
+    frame.Buffer = -1;
+    if (m_free.empty())
+        throw std::runtime_error("FakeCaptureSource::capture(). There are no free buffers; a frame was not given back");
+
+    double sleeptime = m_next_time - Platform->getTime();
+    if (sleeptime > 0)
+        Platform->msleep(sleeptime);
+    m_next_time += m_period;
+
+    frame.Buffer = m_free.back();
+    m_free.pop_back();
+    fill(m_buffers[frame.Buffer]);
+    frame.Image.MapYUV422BufferToImage(&m_buffers[frame.Buffer][0], m_width, m_height);
+    frame.Image.m_timestamp = Platform->getTime();
+    m_num_frames++;
+}
+
+/*! @brief Returns the number of frames made up so far */
+unsigned long FakeCaptureSource::getNumFrames()
+{
+    return m_num_frames;
+}
+
+/*! @brief Fills a buffer with a diagonal ramp, which moves by one pixel each frame */
+void FakeCaptureSource::fill(std::vector<unsigned char>& buffer)
+{
+    int rowlength = 2*m_width;
+    for (int y=0; y<m_height; y++)
+    {
+        unsigned char* row = &buffer[y*rowlength];
+        for (int x=0; x<rowlength; x+=2)
+        {
+            row[x] = static_cast<unsigned char>(x/2 + y + m_num_frames);        // luma
+            row[x+1] = static_cast<unsigned char>(128 + (x & 2 ? 32 : -32));     // alternately u and v
+        }
+    }
+}
+
@@ -0,0 +1,58 @@
+/*! @file FakeCaptureSource.h
+    @brief Declaration of the FakeCaptureSource class
+
+    @class FakeCaptureSource
+    @brief A CaptureSource that makes up frames at a fixed rate, so that the CaptureThread can be run without a camera.
+
+    The frames are YUV422 test patterns which change with each frame. Like a V4L2 camera the source owns a fixed
+    number of buffers, and a buffer is only refilled once the frame holding it has been given back; running out of
+    buffers means a frame was not given back, and is reported as an error. The number of frames the source made up
+    can be compared with the CaptureThread's counts.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FAKECAPTURESOURCE_H
+#define FAKECAPTURESOURCE_H
+
+#include "CaptureSource.h"
+
+#include <vector>
+
+class FakeCaptureSource : public CaptureSource
+{
+public:
+    FakeCaptureSource(int width, int height, double period, int numbuffers = 4);
+    ~FakeCaptureSource();
+
+    void capture(Frame& frame);
+    unsigned long getNumFrames();
+private:
+    void fill(std::vector<unsigned char>& buffer);
+private:
+    const int m_width;                                  //!< the width of the raw YUV422 frames
+    const int m_height;                                 //!< the height of the raw YUV422 frames
+    const double m_period;                              //!< the time between frames (ms)
+    std::vector<std::vector<unsigned char> > m_buffers; //!< the frame buffers
+    std::vector<int> m_free;                            //!< the indices of the buffers not held by a frame
+    double m_next_time;                                 //!< the time the next frame is due (ms)
+    volatile unsigned long m_num_frames;                //!< the number of frames made up
+};
+
+#endif
+
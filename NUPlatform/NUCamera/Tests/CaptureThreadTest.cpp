@@ -0,0 +1,134 @@
+/*! @file CaptureThreadTest.cpp
+    @brief Runs the CaptureThread on a FakeCaptureSource against a consumer that is slower than the camera.
+
+    The source makes up a fixed number of frames every 5 ms and then stops, like a camera that has been unplugged.
+    The consumer takes frames with getNewImage() and spends 12 ms on each, so most frames are overwritten before
+    they are taken. It checks that the timestamps of the frames it is given strictly increase, and that the captured
+    frames are always the processed ones, plus the dropped ones, plus those still in flight (published, but not yet
+    taken or overwritten). Once the consumer has taken the last frame there are none in flight, and the counts must
+    add up exactly.
+
+    A second source throws on every capture. The capture thread must back off rather than spin, so it may only try
+    a handful of times in half a second. Both capture threads must then stop when they are deleted; an alarm fails the
+    test if either does not.
+
+    This is not part of the nubot build. It needs the objects of a nubot build for the platform and the image, so
+    build a target (eg. Replay in Build/Replay) and then:
+        ar rcs libnubot.a $(find Build/Replay/CMakeFiles/nubot.dir -name '*.o' ! -name main.cpp.o)
+        g++ -O2 -pthread -I. -INUView/NUViewConfig NUPlatform/NUCamera/Tests/CaptureThreadTest.cpp libnubot.a -o capturethreadtest
+    It exits with 0 if every check passed.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NUPlatform/NUPlatform.h"
+#include "NUPlatform/NUCamera/CaptureThread.h"
+#include "NUPlatform/NUCamera/FakeCaptureSource.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <signal.h>
+#include <unistd.h>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+static const unsigned long NumFrames = 200;
+static const double CapturePeriod = 5;          // ms
+static const double ProcessTime = 12;           // ms
+
+/*! A FakeCaptureSource that makes up NumFrames frames, and then never has another */
+class FiniteCaptureSource : public FakeCaptureSource
+{
+public:
+    FiniteCaptureSource() : FakeCaptureSource(320, 240, CapturePeriod) {};
+    void capture(Frame& frame)
+    {
+        while (getNumFrames() >= NumFrames)
+            Platform->msleep(10);               // a cancellation point, so the thread can still be stopped
+        FakeCaptureSource::capture(frame);
+    }
+};
+
+/*! A source that always fails */
+class BrokenCaptureSource : public CaptureSource
+{
+public:
+    BrokenCaptureSource() : Attempts(0) {};
+    void capture(Frame&)
+    {
+        __sync_fetch_and_add(&Attempts, 1);
+        throw std::runtime_error("BrokenCaptureSource::capture(). No camera");
+    }
+    volatile unsigned long Attempts;
+};
+
+static void timeout(int)
+{
+    printf("The capture thread did not stop: FAILED\n");
+    _exit(1);
+}
+
+int main()
+{
+    Platform = new NUPlatform();
+    signal(SIGALRM, timeout);
+    alarm(30);
+
+    FiniteCaptureSource source;
+    CaptureThread* capture = new CaptureThread(&source, 0);
+    unsigned long processed = 0, backwards = 0, miscounted = 0;
+    double lasttimestamp = -1;
+    while (capture->getNumProcessed() + capture->getNumDropped() < NumFrames)
+    {
+        NUImage* image = capture->getNewImage();
+        processed++;
+        if (image->m_timestamp <= lasttimestamp)
+            backwards++;
+        lasttimestamp = image->m_timestamp;
+        // the counters are read in this order so that a frame captured in between can only add to the frames in flight
+        unsigned long accounted = capture->getNumProcessed() + capture->getNumDropped();
+        unsigned long captured = capture->getNumCaptured();
+        if (captured < accounted)
+            miscounted++;
+        Platform->msleep(ProcessTime);
+    }
+    unsigned long captured = capture->getNumCaptured();
+    unsigned long dropped = capture->getNumDropped();
+    double latency = capture->getAverageLatency();
+    delete capture;
+
+    bool exact = captured == NumFrames and source.getNumFrames() == NumFrames;
+    exact = exact and processed + dropped == captured;
+    printf("Captured %lu frames (source made %lu): %lu processed, %lu dropped, average latency %.2fms\n", captured, source.getNumFrames(), processed, dropped, latency);
+    printf("%lu timestamps went backwards, %lu times there were more frames processed or dropped than captured\n", backwards, miscounted);
+
+    BrokenCaptureSource broken;
+    CaptureThread* failing = new CaptureThread(&broken, 0);
+    Platform->msleep(500);
+    delete failing;
+    unsigned long attempts = broken.Attempts;
+    // backing off 10, 20, 40, 80, 160 and then 320ms, it is tried at 0, 10, 30, 70, 150 and 310ms, and not again before 630ms
+    bool backedoff = attempts > 0 and attempts <= 6;
+    printf("A broken source was tried %lu times in 500ms\n", attempts);
+
+    bool passed = exact and backwards == 0 and miscounted == 0 and dropped > 0 and backedoff;
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -22,6 +22,9 @@ ENDIF(DEBUG)
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  
 CameraSettings.cpp
+CaptureSource.h
+CaptureThread.cpp CaptureThread.h
+FakeCaptureSource.cpp FakeCaptureSource.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
@@ -37,6 +37,9 @@
 #include "Infrastructure/Jobs/Jobs.h"
 #include "Infrastructure/GameInformation/GameInformation.h"
 #include "Infrastructure/NUImage/NUImage.h"
+#ifdef USE_VISION
+    #include "Vision/Vision.h"
+#endif
 
 #include <sstream>
 #include <string>
@@ -58,6 +61,14 @@ NUIO::NUIO(NUbot* nubot)
     
     m_nubot = nubot;            // we need the nubot so that we can access the public store
     
+    // ports that are not used in this configuration are left NULL, so that they are not deleted or used
+    m_gamecontroller_port = NULL;
+    m_team_port = NULL;
+    m_vision_port = NULL;
+    m_jobs_port = NULL;
+    m_localisation_port = NULL;
+    m_ssl_vision_port = NULL;
+
     #ifdef USE_NETWORK_GAMECONTROLLER
         m_gamecontroller_port = new GameControllerPort(Blackboard->GameInfo);
         Blackboard->GameInfo->addNetworkPort(m_gamecontroller_port);
@@ -89,6 +100,13 @@ NUIO::NUIO(GameInformation* gameinfo, TeamInformation* teaminfo, JobList* jobs)
     debug << "NUIO::NUIO(" << static_cast<void*>(gameinfo) << ", " << static_cast<void*>(teaminfo) << ", " << static_cast<void*>(jobs) << ")" << endl;
 #endif
     m_nubot = NULL;
+    // ports that are not used in this configuration are left NULL, so that they are not deleted or used
+    m_gamecontroller_port = NULL;
+    m_team_port = NULL;
+    m_vision_port = NULL;
+    m_jobs_port = NULL;
+    m_localisation_port = NULL;
+    m_ssl_vision_port = NULL;
     #ifdef USE_NETWORK_GAMECONTROLLER
         m_gamecontroller_port = new GameControllerPort(gameinfo);
     #endif
@@ -183,8 +201,12 @@ NUIO& operator<<(NUIO& io, NUbot& p_nubot)
         network_data_t netdata = io.m_vision_port->receiveData();
         if(netdata.size > 0)
         {
-	   
-            io.m_vision_port->sendData(*(Blackboard->Image), *(Blackboard->Sensors));
+            const unsigned char* lut = 0;
+            #ifdef USE_VISION
+                if (p_nubot.GetVision())
+                    lut = p_nubot.GetVision()->getLUT();
+            #endif
+            io.m_vision_port->sendData(*(Blackboard->Image), *(Blackboard->getPinnedSensors()), lut);
         }
         if(io.m_localisation_port)
         {
@@ -200,6 +222,16 @@ NUIO& operator<<(NUIO& io, NUbot& p_nubot)
     return io;
 }
 
+/*! @brief Waits until the image stream has finished with the current image and pinned sensors, so that they can be replaced
+ */
+void NUIO::releaseImage()
+{
+    #ifdef USE_NETWORK_DEBUGSTREAM
+        if (m_vision_port != NULL)
+            m_vision_port->releaseImage();
+    #endif
+}
+
 /*! @brief Stream insertion operator for a pointer to NUImage
     @param io the nuio stream object
     @param sensors the pointer to the NUImage data to put in the stream
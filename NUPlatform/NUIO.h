@@ -58,6 +58,7 @@ public:
     // Raw Image streaming 
     friend NUIO& operator<<(NUIO& io, NUbot& p_nubot);
     friend NUIO& operator<<(NUIO& io, NUbot* p_nubot);
+    void releaseImage();
     
 protected:
     NUbot* m_nubot;
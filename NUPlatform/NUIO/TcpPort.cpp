@@ -20,7 +20,10 @@
  */
 
 #include "TcpPort.h"
+#include "TcpStreamSender.h"
+#include "NUPlatform/NUPlatform.h"
 #include "Infrastructure/NUImage/NUImage.h"
+#include "Infrastructure/NUImage/ImageStreamCodec.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
 #include "debug.h"
 #include "debugverbositynetwork.h"
@@ -83,7 +86,11 @@ TcpPort::TcpPort(int portnumber): Thread(string("Tcp Thread"), 0)
     m_message_size = 0;
     m_has_data = false;
     m_clientSockfd = -1;
+    m_client_encoding = -1;
+    m_client_reference = 0;
     pthread_mutex_init(&m_socket_mutex, NULL);
+    m_sender = new TcpStreamSender(string("Tcp Sender Thread"));
+    m_codec = new ImageStreamCodec();
     
     start();
 }
@@ -99,6 +106,8 @@ TcpPort::~TcpPort()
 #ifndef WIN32
     close(m_sockfd);
 #endif
+    delete m_sender;
+    delete m_codec;
     pthread_mutex_destroy(&m_socket_mutex);
 }
 
@@ -120,13 +129,31 @@ void TcpPort::run()
 
     while(1)
     {
-        m_clientSockfd = accept(m_sockfd, (struct sockaddr *)&local_their_addr, &local_addr_len);
+        int client = accept(m_sockfd, (struct sockaddr *)&local_their_addr, &local_addr_len);
         #ifdef WIN32
-            localnumBytes = recv(m_clientSockfd, localdata, sizeof(localdata),0);
+            localnumBytes = recv(client, localdata, sizeof(localdata),0);
         #endif
         #ifndef WIN32
-            localnumBytes = read(m_clientSockfd, localdata,sizeof(localdata));
+            localnumBytes = read(client, localdata,sizeof(localdata));
         #endif
+        
+        // the client is only published once its request has been read, so that its frames are sent in the encoding it asked for
+        ImageStreamCodec::Encoding encoding;
+        unsigned int reference = 0;
+        bool encoded = ImageStreamCodec::parseRequest(localdata, localnumBytes, encoding, reference);
+        pthread_mutex_lock(&m_socket_mutex);
+        if (m_clientSockfd != -1)
+        {   // the previous client was never sent anything
+            #ifdef WIN32
+                closesocket(m_clientSockfd);
+            #else
+                close(m_clientSockfd);
+            #endif
+        }
+        m_clientSockfd = client;
+        m_client_encoding = encoded ? static_cast<int>(encoding) : -1;
+        m_client_reference = reference;
+        pthread_mutex_unlock(&m_socket_mutex);
         if ( localnumBytes != -1 && local_their_addr.sin_addr.s_addr != m_address.sin_addr.s_addr && local_their_addr.sin_addr.s_addr != m_broadcast_address.sin_addr.s_addr)
         {   //!< @todo TODO: This doesn't work. You need to discard packets that you have sent yourself
             #if DEBUG_NETWORK_VERBOSITY > 3
@@ -185,6 +212,7 @@ void TcpPort::sendData(network_data_t netdata)
         #if DEBUG_NETWORK_VERBOSITY > 4
         debug << "TcpPort::sendData(). No connected client "<< endl;
         #endif
+        pthread_mutex_unlock(&m_socket_mutex);
         return;
     }
     #if DEBUG_NETWORK_VERBOSITY > 4
@@ -206,62 +234,142 @@ void TcpPort::sendData(network_data_t netdata)
     return;
 }
 
-void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors)
+/*! @brief Takes the connected client, so that it can be handed to the sender thread
+    @return the client's socket, or -1 if there is no client. The caller is responsible for closing the socket
+ */
+int TcpPort::takeClient()
 {
-    network_data_t netdata;
-    stringstream buffer;
-    network_data_t sensordata;
-    stringstream sensorsbuffer;
-    sensorsbuffer << p_sensors;
-    string sensorsString = sensorsbuffer.str();
-    sensordata.data = (char*) sensorsString.c_str();
-    sensordata.size = sensorsString.size();
-    
-    int sensorsSize = sensordata.size;
-    int imagewidth = p_image.getWidth();
-    int imageheight = p_image.getHeight();
-    double timeStamp = p_image.m_timestamp;
-    buffer.write(reinterpret_cast<char*>(&sensorsSize), sizeof(sensorsSize));
-    buffer.write(reinterpret_cast<char*>(&imagewidth), sizeof(imagewidth));
-    buffer.write(reinterpret_cast<char*>(&imageheight), sizeof(imageheight));
-    buffer.write(reinterpret_cast<char*>(&timeStamp), sizeof(timeStamp));
+    pthread_mutex_lock(&m_socket_mutex);
+    int client = m_clientSockfd;
+    m_clientSockfd = -1;
+    pthread_mutex_unlock(&m_socket_mutex);
+    return client;
+}
+
+/*! @brief Takes the connected client and the image encoding it requested
+    @param encoding will be updated with the requested ImageStreamCodec::Encoding, or -1 if the client wants the original raw frame
+    @param reference will be updated with the client's delta reference frame
+    @return the client's socket, or -1 if there is no client. The caller is responsible for closing the socket
+ */
+int TcpPort::takeClient(int& encoding, unsigned int& reference)
+{
+    pthread_mutex_lock(&m_socket_mutex);
+    int client = m_clientSockfd;
+    encoding = m_client_encoding;
+    reference = m_client_reference;
+    m_clientSockfd = -1;
+    pthread_mutex_unlock(&m_socket_mutex);
+    return client;
+}
+
+/*! @brief Queues the image and sensors to be sent to the connected client
+ 
+    Nothing is copied, encoded or serialised here. The frame references the image and sensors, and the sender thread
+    encodes them (see encode()) and writes the frame, so this never waits on the network or on the encoder. The image and
+    sensors must not change until releaseImage() has been called.
+ 
+    @param p_image the image to send
+    @param p_sensors the sensor data to send with the image
+    @param p_lut the colour lookup table used to classify the image, if the client asks for a classified image
+ */
+void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors, const unsigned char* p_lut)
+{
+    int encoding;
+    unsigned int reference;
+    int client = takeClient(encoding, reference);
+    if (client == -1)
+        return;
     
-    string s = buffer.str();
-    netdata.data = (char*) s.c_str();
-    netdata.size = s.size();
+    TcpStreamSender::Frame* frame = m_sender->acquireFrame();
+    frame->Socket = client;
+    frame->Source = this;
+    frame->Image = &p_image;
+    frame->Sensors = &p_sensors;
+    frame->Lut = p_lut;
+    frame->Encoding = encoding;
+    frame->Reference = reference;
+    m_sender->sendFrame(frame);
+}
+
+/*! @brief Waits until the sender thread is no longer using the image and sensors passed to sendData(). This must be called
+           before they are replaced by the next ones.
+ */
+void TcpPort::releaseImage()
+{
+    m_sender->releaseSources();
+}
+
+/*! @brief Fills in an image frame on the sender thread
+ 
+    The frame is [sensors size, image width, image height, timestamp, image, serialised sensors]. For the original
+    raw request the image is the pixels row by row. When the client asked for an encoding (see ImageStreamCodec)
+    the image is an ImageStreamCodec::FrameInfo followed by the encoded image.
+ 
+    @param frame the frame to fill in, from its Image, Sensors, Lut, Encoding and Reference
+ */
+void TcpPort::encode(TcpStreamSender::Frame* frame)
+{
+    const NUImage& image = *frame->Image;
+    stringstream sensorsbuffer;
+    sensorsbuffer << *frame->Sensors;
+    frame->Trailer = sensorsbuffer.str();
     
-    sendData(netdata);
+    int sensorsSize = frame->Trailer.size();
+    int imagewidth = image.getWidth();
+    int imageheight = image.getHeight();
+    double timeStamp = image.m_timestamp;
+    size_t headersize = 3*sizeof(int) + sizeof(double);
+    frame->Header.resize(frame->Encoding < 0 ? headersize : headersize + sizeof(ImageStreamCodec::FrameInfo));
+    char* header = &frame->Header[0];
+    memcpy(header, &sensorsSize, sizeof(sensorsSize));
+    memcpy(header + sizeof(int), &imagewidth, sizeof(imagewidth));
+    memcpy(header + 2*sizeof(int), &imageheight, sizeof(imageheight));
+    memcpy(header + 3*sizeof(int), &timeStamp, sizeof(timeStamp));
     
-    for(int y = 0; y < imageheight; y++)
+    if (frame->Encoding < 0)
+    {   // the image has to be copied because the camera reuses its buffer once releaseImage() has been called
+        size_t rowsize = sizeof(image.m_image[0][0])*imagewidth;
+        frame->Body.resize(rowsize*imageheight);
+        for (int y = 0; y < imageheight; y++)
+            memcpy(&frame->Body[y*rowsize], &image.m_image[y][0], rowsize);
+    }
+    else
     {
-        network_data_t linedata;
-        linedata.data = (char*) &p_image.m_image[y][0];
-        linedata.size = sizeof(p_image.m_image[y][0])*imagewidth;
-        sendData(linedata);
+        double starttime = Platform->getRealTime();
+        ImageStreamCodec::FrameInfo info = m_codec->encode(static_cast<ImageStreamCodec::Encoding>(frame->Encoding), image, frame->Lut, frame->Reference, frame->Body);
+        info.EncodeTime = static_cast<int>(1000*(Platform->getRealTime() - starttime));
+        memcpy(header + headersize, &info, sizeof(info));
+        #if DEBUG_NETWORK_VERBOSITY > 2
+            debug << "TcpPort::encode(). " << ImageStreamCodec::getName(info.Encoding) << " frame " << info.Sequence << " of " << info.BodySize << " bytes encoded in " << info.EncodeTime << "us" << endl;
+        #endif
     }
-    sendData(sensordata);
-    
 }
 
 #if defined(USE_LOCALISATION)
+    /*! @brief Queues the localisation to be sent to the connected client. The frame is [size, serialised localisation].
+     */
     void TcpPort::sendData(const Localisation& p_locwm, const FieldObjects& p_objects)
     {
         #if DEBUG_NETWORK_VERBOSITY > 4
             debug << "Sending worldmodel packet" << endl;
         #endif
-        network_data_t netdata;
-        network_data_t sizedata;
+        int client = takeClient();
+        if (client == -1)
+            return;
+        
         stringstream buffer;
         buffer << p_locwm;
         //buffer << p_objects;
-        netdata.data = (char*) buffer.str().c_str();
-        netdata.size = buffer.str().size();
-
-        int totalsize = netdata.size;
-        sizedata.data = reinterpret_cast<char*>(&totalsize);
-        sizedata.size = sizeof(totalsize);
-
-        sendData(sizedata);
-        sendData(netdata);
+        
+        TcpStreamSender::Frame* frame = m_sender->acquireFrame();
+        frame->Socket = client;
+        frame->Trailer = buffer.str();
+        frame->Body.clear();
+        
+        int totalsize = frame->Trailer.size();
+        frame->Header.resize(sizeof(totalsize));
+        memcpy(&frame->Header[0], &totalsize, sizeof(totalsize));
+        
+        m_sender->sendFrame(frame);
     }
 #endif
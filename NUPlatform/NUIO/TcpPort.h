@@ -36,6 +36,8 @@
 
 #include "nubotconfig.h"
 #include "Tools/Threading/Thread.h"
+#include "TcpStreamSender.h"
+class ImageStreamCodec;
 class NUImage;
 class NUSensorsData;
 class Localisation;
@@ -54,19 +56,23 @@ struct network_data_t
 };
 #endif
 
-class TcpPort : public Thread
+class TcpPort : public Thread, public TcpStreamSender::Encoder
 {
 public:
     TcpPort(int portnumber);
     virtual ~TcpPort();
     void sendData(network_data_t netData);
-    void sendData(const NUImage& p_image, const NUSensorsData& p_sensors);
+    void sendData(const NUImage& p_image, const NUSensorsData& p_sensors, const unsigned char* p_lut = 0);
+    void releaseImage();
     #if defined(USE_LOCALISATION)
         void sendData(const Localisation& p_locwm, const FieldObjects& p_objects);
     #endif
     network_data_t receiveData();
 private:
     void run();
+    int takeClient();
+    int takeClient(int& encoding, unsigned int& reference);
+    void encode(TcpStreamSender::Frame* frame);
 public:
 private:
     int m_sockfd;                       //!< the socket
@@ -82,6 +88,10 @@ private:
     pthread_mutex_t m_socket_mutex;     //!< lock to prevent simultaneous reading and writing on the same port
 
     int m_clientSockfd;                 //!< Connected Clients socket
+    int m_client_encoding;              //!< the image encoding requested by the client, or -1 for the original raw frame
+    unsigned int m_client_reference;    //!< the client's reference frame for the delta encoding
+    TcpStreamSender* m_sender;          //!< the thread that writes the image and localisation frames to the clients
+    ImageStreamCodec* m_codec;          //!< the encoder for the image frames
 
 };
 
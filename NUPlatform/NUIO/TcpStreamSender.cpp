@@ -0,0 +1,407 @@
+/*! @file TcpStreamSender.cpp
+    @brief Implementation of the tcp debug stream sender thread
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TcpStreamSender.h"
+
+#include "debug.h"
+#include "debugverbositynetwork.h"
+
+#ifdef WIN32
+    #include <winsock.h>
+#else
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+#include <errno.h>
+#include <string.h>
+
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0          // not every platform has it, on those we rely on SIGPIPE being ignored
+#endif
+
+/*! @brief Creates and starts a sender thread
+    @param name the name of the thread
+    @param capacity the maximum number of frames waiting to be sent. When this is exceeded the oldest frame is dropped.
+ */
+TcpStreamSender::TcpStreamSender(const string& name, unsigned int capacity) : Thread(name, 0), m_capacity(capacity > 0 ? capacity : 1)
+{
+    #if DEBUG_NETWORK_VERBOSITY > 4
+        debug << "TcpStreamSender::TcpStreamSender(" << name << ", " << capacity << ")" << endl;
+    #endif
+    for (unsigned int i=0; i<m_capacity + 2; i++)
+    {
+        Frame* frame = new Frame();
+        frame->Socket = -1;
+        clearSources(frame);
+        m_frames.push_back(frame);
+        m_free.push_back(frame);
+    }
+    m_encoding = NULL;
+
+    m_num_sent = 0;
+    m_num_dropped = 0;
+    m_num_failed = 0;
+    m_bytes_sent = 0;
+
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_condition, NULL);
+    pthread_cond_init(&m_encoded, NULL);
+
+    start();
+}
+
+/*! @brief Stops the sender, and closes the sockets of any frames that were not sent
+ */
+TcpStreamSender::~TcpStreamSender()
+{
+    stop();
+    join();
+    for (size_t i=0; i<m_frames.size(); i++)
+    {
+        closeSocket(m_frames[i]->Socket);
+        delete m_frames[i];
+    }
+    pthread_cond_destroy(&m_encoded);
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+/*! @brief Returns an empty frame to be filled and then passed to sendFrame(). Never blocks.
+
+    If every frame is in use the oldest queued frame is dropped and returned.
+ */
+TcpStreamSender::Frame* TcpStreamSender::acquireFrame()
+{
+    Frame* frame = 0;
+    int dropped = -1;
+    pthread_mutex_lock(&m_mutex);
+    if (not m_free.empty())
+    {
+        frame = m_free.back();
+        m_free.pop_back();
+    }
+    else if (not m_queue.empty())
+    {   // with a single producer there is always a queued frame here, because there are m_capacity + 2 frames
+        frame = m_queue.front();
+        m_queue.pop_front();
+        dropped = frame->Socket;
+        m_num_dropped++;
+    }
+    else
+    {   // more than one producer is filling frames
+        frame = new Frame();
+        m_frames.push_back(frame);
+    }
+    pthread_mutex_unlock(&m_mutex);
+
+    closeSocket(dropped);
+    frame->Socket = -1;
+    clearSources(frame);
+    return frame;
+}
+
+/*! @brief Queues a frame, from acquireFrame(), to be sent. The sender now owns the frame and its socket.
+
+    If the queue is full the oldest queued frame is dropped.
+ */
+void TcpStreamSender::sendFrame(Frame* frame)
+{
+    int dropped = -1;
+    pthread_mutex_lock(&m_mutex);
+    if (m_queue.size() >= m_capacity)
+    {
+        Frame* oldest = m_queue.front();
+        m_queue.pop_front();
+        dropped = oldest->Socket;
+        oldest->Socket = -1;
+        clearSources(oldest);
+        m_free.push_back(oldest);
+        m_num_dropped++;
+    }
+    m_queue.push_back(frame);
+    pthread_cond_signal(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+
+    closeSocket(dropped);
+}
+
+/*! @brief Gives the data referenced by the queued frames back to the producer. This must be called before the producer changes
+           the images or sensors it passed to sendFrame().
+
+    If the sender thread is encoding a frame this waits until it has finished. Queued frames that the sender thread has not
+    got to yet are encoded here, so that they are not lost. This never waits for a client.
+ */
+void TcpStreamSender::releaseSources()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (m_encoding != NULL)
+        pthread_cond_wait(&m_encoded, &m_mutex);
+    // the frames are taken out of the queue so that the sender thread can not start on them (or use the encoder) meanwhile
+    deque<Frame*> pending;
+    deque<Frame*>::iterator it = m_queue.begin();
+    while (it != m_queue.end())
+    {
+        if ((*it)->Source != NULL)
+        {
+            pending.push_back(*it);
+            it = m_queue.erase(it);
+        }
+        else
+            ++it;
+    }
+    pthread_mutex_unlock(&m_mutex);
+    
+    if (pending.empty())
+        return;
+    for (size_t i=0; i<pending.size(); i++)
+    {
+        pending[i]->Source->encode(pending[i]);
+        clearSources(pending[i]);
+    }
+    
+    pthread_mutex_lock(&m_mutex);
+    m_queue.insert(m_queue.begin(), pending.begin(), pending.end());
+    pthread_cond_signal(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Returns the number of frames that have been sent completely */
+unsigned long TcpStreamSender::getNumSent()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_sent;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of frames that were dropped because the queue was full */
+unsigned long TcpStreamSender::getNumDropped()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_dropped;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of frames that were abandoned because the client disconnected or was too slow */
+unsigned long TcpStreamSender::getNumFailed()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_failed;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the total number of bytes written to the clients */
+unsigned long long TcpStreamSender::getBytesSent()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long long value = m_bytes_sent;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief The sender's main loop. Waits for a frame, encodes it if it has an Encoder, and then writes it.
+ */
+void TcpStreamSender::run()
+{
+    #if DEBUG_NETWORK_VERBOSITY > 4
+        debug << "TcpStreamSender::run(). Starting " << m_name << "'s mainloop" << endl;
+    #endif
+    while (1)
+    {
+        pthread_mutex_lock(&m_mutex);
+        pthread_cleanup_push(unlockMutex, &m_mutex);        // the thread is stopped by cancelling it, usually while it is waiting here
+        while (m_queue.empty())
+            pthread_cond_wait(&m_condition, &m_mutex);
+        pthread_cleanup_pop(0);
+        Frame* frame = m_queue.front();
+        m_queue.pop_front();
+        if (frame->Source != NULL)
+            m_encoding = frame;                             // releaseSources() waits until this frame no longer needs the producer's data
+        pthread_mutex_unlock(&m_mutex);
+
+        if (frame->Source != NULL)
+        {
+            frame->Source->encode(frame);
+            pthread_mutex_lock(&m_mutex);
+            clearSources(frame);
+            m_encoding = NULL;
+            pthread_cond_broadcast(&m_encoded);
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+        bool sent = write(frame);
+
+        pthread_mutex_lock(&m_mutex);
+        if (sent)
+            m_num_sent++;
+        else
+            m_num_failed++;
+        pthread_mutex_unlock(&m_mutex);
+
+        release(frame);
+    }
+}
+
+/*! @brief Writes the header, body and trailer of the frame to its client without copying them
+    @return true if the whole frame was written, false if the client disconnected or timed out
+ */
+bool TcpStreamSender::write(Frame* frame)
+{
+    if (frame->Socket < 0)
+        return false;
+
+    #ifdef WIN32
+        const char* segments[] = {frame->Header.empty() ? 0 : &frame->Header[0], frame->Body.empty() ? 0 : &frame->Body[0], frame->Trailer.c_str()};
+        size_t lengths[] = {frame->Header.size(), frame->Body.size(), frame->Trailer.size()};
+        for (int i=0; i<3; i++)
+        {
+            size_t offset = 0;
+            while (offset < lengths[i])
+            {
+                int n = send(frame->Socket, segments[i] + offset, lengths[i] - offset, 0);
+                if (n <= 0)
+                    return false;
+                offset += n;
+            }
+        }
+        return true;
+    #else
+        iovec iov[3];
+        int iovcnt = 0;
+        if (not frame->Header.empty())
+        {
+            iov[iovcnt].iov_base = &frame->Header[0];
+            iov[iovcnt].iov_len = frame->Header.size();
+            iovcnt++;
+        }
+        if (not frame->Body.empty())
+        {
+            iov[iovcnt].iov_base = &frame->Body[0];
+            iov[iovcnt].iov_len = frame->Body.size();
+            iovcnt++;
+        }
+        if (not frame->Trailer.empty())
+        {
+            iov[iovcnt].iov_base = const_cast<char*>(frame->Trailer.data());
+            iov[iovcnt].iov_len = frame->Trailer.size();
+            iovcnt++;
+        }
+
+        msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = iov;
+        message.msg_iovlen = iovcnt;
+        while (message.msg_iovlen > 0)
+        {
+            ssize_t n = sendmsg(frame->Socket, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN and errno != EWOULDBLOCK)
+                {
+                    #if DEBUG_NETWORK_VERBOSITY > 0
+                        debug << "TcpStreamSender::write(). " << m_name << " failed to write, errno: " << errno << endl;
+                    #endif
+                    return false;
+                }
+                // the client is not keeping up; wait until it can take more
+                pollfd fd;
+                fd.fd = frame->Socket;
+                fd.events = POLLOUT;
+                fd.revents = 0;
+                int ready = poll(&fd, 1, Timeout);
+                if (ready <= 0 or (fd.revents & (POLLERR | POLLHUP)))
+                {
+                    #if DEBUG_NETWORK_VERBOSITY > 0
+                        debug << "TcpStreamSender::write(). " << m_name << " client is not accepting data. Disconnecting." << endl;
+                    #endif
+                    return false;
+                }
+                continue;
+            }
+
+            pthread_mutex_lock(&m_mutex);
+            m_bytes_sent += n;
+            pthread_mutex_unlock(&m_mutex);
+
+            // skip over the segments that have been written completely, and advance into the partially written one
+            size_t remaining = n;
+            while (message.msg_iovlen > 0 and remaining >= message.msg_iov[0].iov_len)
+            {
+                remaining -= message.msg_iov[0].iov_len;
+                message.msg_iov++;
+                message.msg_iovlen--;
+            }
+            if (message.msg_iovlen > 0)
+            {
+                message.msg_iov[0].iov_base = static_cast<char*>(message.msg_iov[0].iov_base) + remaining;
+                message.msg_iov[0].iov_len -= remaining;
+            }
+        }
+        return true;
+    #endif
+}
+
+/*! @brief Closes the frame's client and returns the frame to the free list */
+void TcpStreamSender::release(Frame* frame)
+{
+    closeSocket(frame->Socket);
+    pthread_mutex_lock(&m_mutex);
+    frame->Socket = -1;
+    m_free.push_back(frame);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Clears the frame's references to the producer's data */
+void TcpStreamSender::clearSources(Frame* frame)
+{
+    frame->Source = NULL;
+    frame->Image = NULL;
+    frame->Sensors = NULL;
+    frame->Lut = NULL;
+    frame->Encoding = -1;
+    frame->Reference = 0;
+}
+
+/*! @brief Unlocks the mutex. Used as a cancellation cleanup handler */
+void TcpStreamSender::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
+
+/*! @brief Closes the socket, if it is valid */
+void TcpStreamSender::closeSocket(int socket)
+{
+    if (socket < 0)
+        return;
+    #ifdef WIN32
+        closesocket(socket);
+    #else
+        close(socket);
+    #endif
+}
+
@@ -0,0 +1,119 @@
+/*! @file TcpStreamSender.h
+    @brief Declaration of the tcp debug stream sender thread
+
+    @class TcpStreamSender
+    @brief A thread that writes frames to the tcp debug clients, so that a slow client never blocks the caller.
+
+    The producer (usually the vision thread through TcpPort::sendData) gets an empty frame with acquireFrame(),
+    and queues it with sendFrame(). The producer can fill in the header, body and trailer itself, or leave them to
+    an Encoder, which fills them in on the sender thread from the image and sensors the frame references. The frames
+    are preallocated and reused, so once their buffers have grown to the size of an image there are no allocations.
+    The queue is bounded; when it is full the oldest queued frame is dropped to make room for the new one.
+
+    A frame with an Encoder references data the producer still owns, so before the producer changes that data it
+    must call releaseSources(). If a frame is being encoded the producer waits for that encoding to finish, and any
+    queued frame the sender thread has not got to yet is encoded by the producer. It never waits for the network.
+
+    The sender thread writes each frame with a single scatter-gather sendmsg() over the header, body and trailer,
+    on a non-blocking socket. Partial writes are continued when the socket is writable again, and a client that
+    does not accept data for Timeout milliseconds is disconnected.
+
+    Each frame carries the socket of the client it is for. The sender owns that socket once the frame is queued,
+    and closes it after the frame has been sent or dropped; the debug stream protocol is one frame per connection.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TCPSTREAMSENDER_H
+#define TCPSTREAMSENDER_H
+
+#include "Tools/Threading/Thread.h"
+
+class NUImage;
+class NUSensorsData;
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include <string>
+using namespace std;
+
+class TcpStreamSender : public Thread
+{
+public:
+    class Encoder;
+    struct Frame
+    {
+        int Socket;                 //!< the client the frame is to be sent to
+        vector<char> Header;        //!< the frame header
+        vector<char> Body;          //!< the body of the frame (ie. the image)
+        string Trailer;             //!< anything to be sent after the body (ie. the serialised sensors)
+
+        Encoder* Source;                //!< fills in the header, body and trailer on the sender thread, or NULL if the producer has filled them in
+        const NUImage* Image;           //!< the image for the Encoder
+        const NUSensorsData* Sensors;   //!< the sensors for the Encoder
+        const unsigned char* Lut;       //!< the colour lookup table for the Encoder, if the client asked for a classified image
+        int Encoding;                   //!< the image encoding the client asked for, or -1 for the original raw frame
+        unsigned int Reference;         //!< the client's delta reference frame
+    };
+    class Encoder
+    {
+    public:
+        virtual ~Encoder() {};
+        /*! @brief Fills in the frame's header, body and trailer from the data it references. Called on the sender thread. */
+        virtual void encode(Frame* frame) = 0;
+    };
+    static const int Timeout = 2000;    //!< the time in milliseconds a client has to accept more data before it is disconnected
+
+    TcpStreamSender(const string& name, unsigned int capacity = 2);
+    ~TcpStreamSender();
+
+    Frame* acquireFrame();
+    void sendFrame(Frame* frame);
+    void releaseSources();
+
+    unsigned long getNumSent();
+    unsigned long getNumDropped();
+    unsigned long getNumFailed();
+    unsigned long long getBytesSent();
+private:
+    void run();
+    bool write(Frame* frame);
+    void release(Frame* frame);
+    void clearSources(Frame* frame);
+    static void unlockMutex(void* mutex);
+    static void closeSocket(int socket);
+private:
+    const unsigned int m_capacity;      //!< the maximum number of frames waiting to be sent
+    vector<Frame*> m_frames;            //!< all of the frames; m_capacity queued, one being filled and one being sent
+    vector<Frame*> m_free;              //!< the frames not in use
+    deque<Frame*> m_queue;              //!< the frames waiting to be sent, oldest first
+
+    pthread_mutex_t m_mutex;            //!< lock for the free list, queue and counters
+    pthread_cond_t m_condition;         //!< signalled when a frame is queued
+    Frame* m_encoding;                  //!< the frame the sender thread is encoding, or NULL
+    pthread_cond_t m_encoded;           //!< signalled when the sender thread has finished encoding a frame
+
+    unsigned long m_num_sent;           //!< the number of frames written completely
+    unsigned long m_num_dropped;        //!< the number of frames dropped because the queue was full
+    unsigned long m_num_failed;         //!< the number of frames abandoned because of a socket error or timeout
+    unsigned long long m_bytes_sent;    //!< the total number of bytes written
+};
+
+#endif
+
@@ -35,7 +35,8 @@
 TeamPort::TeamPort(TeamInformation* nubotteaminformation, int portnumber, bool ignoreself): UdpPort(std::string("TeamPort"), portnumber, ignoreself)
 {
     m_team_information = nubotteaminformation;
-    m_team_transmission_thread = new TeamTransmissionThread(this, 250);
+    m_team_transmission_thread = new TeamTransmissionThread(this, 50);
+    m_team_transmission_thread->setTransmissionRate(250, 1000);
     
     m_team_transmission_thread->start();
 }
@@ -48,22 +49,37 @@ TeamPort::~TeamPort()
     delete m_team_transmission_thread;
 }
 
-/*! @brief Copies the received data into the public nubot joblist
-    @param buffer containing the joblist
-*/
-void TeamPort::handleNewData(std::stringstream& buffer)
+/*! @brief Sets how often team packets are sent. See TeamTransmissionThread::setTransmissionRate()
+    @param minperiod the shortest time in ms between packets, used while the shared information is changing
+    @param maxperiod the longest time in ms between packets, used while the shared information is not changing
+ */
+void TeamPort::setTransmissionRate(int minperiod, int maxperiod)
+{
+    m_team_transmission_thread->setTransmissionRate(minperiod, maxperiod);
+}
+
+/*! @brief Decodes a received team packet in place, and gives it to the team information
+    @param data the received datagram
+    @param size the number of bytes received
+ */
+void TeamPort::handleNewDatagram(const char* data, int size)
 {
     #if DEBUG_NETWORK_VERBOSITY > 0
-        debug << "TeamPort::handleNewData()." << endl;
+        debug << "TeamPort::handleNewDatagram()." << endl;
     #endif
-    string s_buffer = buffer.str();
-    if (s_buffer.size() == sizeof(TeamPacket))
-    {   // discard team packets that are the wrong size
-        TeamPacket temp;
-        buffer >> temp;
+    TeamPacket temp;
+    if (size > 0 and TeamPacket::decode(data, size, temp))
         m_team_information->addReceivedTeamPacket(temp);
-    }
     else
-        debug << "TeamPort::handleNewData(). The received packet does not have the correct length: " << s_buffer.size() << " instead of " << sizeof(TeamPacket) << endl;
+        debug << "TeamPort::handleNewDatagram(). Discarding " << size << " bytes that are not a version " << static_cast<int>(TeamPacket::WireVersion) << " team packet of " << TeamPacket::WireSize << " bytes" << endl;
+}
+
+/*! @brief Copies the received data into the team information
+    @param buffer containing the team packet
+*/
+void TeamPort::handleNewData(std::stringstream& buffer)
+{
+    string s_buffer = buffer.str();
+    handleNewDatagram(s_buffer.data(), s_buffer.size());
 }
 
@@ -34,9 +34,11 @@ class TeamPort : public UdpPort
 public:
     TeamPort(TeamInformation* nubotteaminformation, int portnumber, bool ignoreself = true);
     ~TeamPort();
+    void setTransmissionRate(int minperiod, int maxperiod);
     
 private:
     void handleNewData(std::stringstream& buffer);
+    void handleNewDatagram(const char* data, int size);
 public:
 private:
     TeamInformation* m_team_information;
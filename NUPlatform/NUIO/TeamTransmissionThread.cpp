@@ -22,6 +22,7 @@
 #include "TeamTransmissionThread.h"
 #include "TeamPort.h"
 #include "Infrastructure/TeamInformation/TeamInformation.h"
+#include "NUPlatform/NUPlatform.h"
 
 #include <string>
 using namespace std;
@@ -30,6 +31,13 @@ using namespace std;
 #include "debugverbositynetwork.h"
 
 /*! @brief Constructs the team packet transmission thread
+ 
+    The thread checks every period whether there is a team packet worth sending. A packet is sent when the shared
+    information has changed and at least the minimum period has passed, or when the maximum period has passed so
+    that team mates do not time us out. By default the minimum is the thread period, and the maximum is 1 second.
+ 
+    @param port the port to send the packets on
+    @param period the period of the thread in ms
  */
 
 TeamTransmissionThread::TeamTransmissionThread(TeamPort* port, int period) : PeriodicThread(string("TeamTransmissionThread"), period, 0)
@@ -38,6 +46,11 @@ TeamTransmissionThread::TeamTransmissionThread(TeamPort* port, int period) : Per
         debug << "TeamTransmissionThread::TeamTransmissionThread(" << period << ") with priority " << static_cast<int>(m_priority) << endl;
     #endif
     m_port = port;
+    m_min_period = period;
+    m_max_period = 1000;
+    m_last_sent_time = -1e10;
+    m_num_sent = 0;
+    m_num_suppressed = 0;
 }
 
 TeamTransmissionThread::~TeamTransmissionThread()
@@ -47,12 +60,38 @@ TeamTransmissionThread::~TeamTransmissionThread()
     #endif
 }
 
+/*! @brief Sets how often team packets are sent
+    @param minperiod the shortest time in ms between packets, used while the shared information is changing. Packets can not be sent faster than the thread's period.
+    @param maxperiod the longest time in ms between packets, used while the shared information is not changing
+ */
+void TeamTransmissionThread::setTransmissionRate(int minperiod, int maxperiod)
+{
+    m_min_period = minperiod;
+    m_max_period = maxperiod > minperiod ? maxperiod : minperiod;
+}
+
 void TeamTransmissionThread::periodicFunction()
 {
     if (m_port->m_team_information->getPlayerNumber() > 0)
     {
-        stringstream buffer;
-        buffer << m_port->m_team_information->generateTeamTransmissionPacket();
-        m_port->sendData(buffer);
+        TeamPacket packet = m_port->m_team_information->generateTeamTransmissionPacket();
+        double timenow = Platform->getTime();
+        double elapsed = timenow - m_last_sent_time;
+        double jitter = 0.5*m_period;               // allow for the thread not running exactly on time
+        if (elapsed < m_min_period - jitter or (elapsed < m_max_period - jitter and not packet.hasChangedFrom(m_last_sent)))
+        {
+            m_num_suppressed++;
+            return;
+        }
+        
+        char buffer[TeamPacket::WireSize];
+        unsigned int size = TeamPacket::encode(packet, buffer, sizeof(buffer));
+        m_port->sendData(buffer, size);
+        m_last_sent = packet;
+        m_last_sent_time = timenow;
+        m_num_sent++;
+        #if DEBUG_NETWORK_VERBOSITY > 2
+            debug << "TeamTransmissionThread::periodicFunction(). Sent " << m_num_sent << " packets, suppressed " << m_num_suppressed << endl;
+        #endif
     }
 }
@@ -26,6 +26,7 @@
 #define TEAM_THREAD_H
 
 #include "Tools/Threading/PeriodicThread.h"
+#include "Infrastructure/TeamInformation/TeamInformation.h"
 class TeamPort;
 
 class TeamTransmissionThread : public PeriodicThread
@@ -33,11 +34,18 @@ class TeamTransmissionThread : public PeriodicThread
 public:
     TeamTransmissionThread(TeamPort* port, int period = 500);
     ~TeamTransmissionThread();
+    void setTransmissionRate(int minperiod, int maxperiod);
 private:
     void periodicFunction();
     
 private:
     TeamPort* m_port;
+    volatile int m_min_period;          //!< the shortest time in ms between packets
+    volatile int m_max_period;          //!< the longest time in ms between packets, even if nothing has changed
+    double m_last_sent_time;            //!< the time the last packet was sent
+    TeamPacket m_last_sent;             //!< the last packet sent
+    unsigned long m_num_sent;           //!< the number of packets sent
+    unsigned long m_num_suppressed;     //!< the number of packets not sent because nothing had changed
 };
 
 #endif
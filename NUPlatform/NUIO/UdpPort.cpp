@@ -186,33 +186,49 @@ void UdpPort::run()
             #if DEBUG_NETWORK_VERBOSITY > 0
                 debug << "UdpPort::run()." << m_port_number << " Received " << localnumBytes << " bytes from " << inet_ntoa(local_their_addr.sin_addr) << endl;
             #endif
-            stringstream buffer;
-            buffer.write(reinterpret_cast<char*>(localdata), localnumBytes);
             #if DEBUG_NETWORK_VERBOSITY > 4
-                string s = buffer.str();
-                for (size_t i=0; i<s.size(); i++)
-                    debug << s[i];
+                for (int i=0; i<localnumBytes; i++)
+                    debug << localdata[i];
                 debug << endl;
             #endif
-            handleNewData(buffer);
+            handleNewDatagram(localdata, localnumBytes);
         }
     }
     return;
 }
 
+/*! @brief Handles a received datagram
+ 
+    The default copies the datagram into a stringstream for handleNewData(). Ports that can parse the datagram in place should override this.
+    @param data the received datagram
+    @param size the number of bytes in the datagram
+ */
+void UdpPort::handleNewDatagram(const char* data, int size)
+{
+    stringstream buffer;
+    buffer.write(data, size);
+    handleNewData(buffer);
+}
+
 /*! @brief Sends a string stream over the network
     @param stream the stream containing the information to be sent over the network
  */
 void UdpPort::sendData(const stringstream& stream)
 {
-    char* data;
-    int numbytes;
-    numbytes = stream.str().size();
-    data = (char*) stream.str().c_str();
+    string data = stream.str();
+    sendData(data.c_str(), data.size());
+}
+
+/*! @brief Sends a buffer over the network
+    @param data the data to be sent over the network
+    @param size the number of bytes to send
+ */
+void UdpPort::sendData(const char* data, int size)
+{
     #if DEBUG_NETWORK_VERBOSITY > 4
-        debug << "UdpPort::sendData(). Sending " << numbytes << " bytes to " << inet_ntoa(m_target_address.sin_addr) << endl;
+        debug << "UdpPort::sendData(). Sending " << size << " bytes to " << inet_ntoa(m_target_address.sin_addr) << endl;
     #endif
     pthread_mutex_lock(&m_socket_mutex);
-    sendto(m_sockfd, data, numbytes, 0, (struct sockaddr *)&m_target_address, sizeof(m_target_address));
+    sendto(m_sockfd, data, size, 0, (struct sockaddr *)&m_target_address, sizeof(m_target_address));
     pthread_mutex_unlock(&m_socket_mutex);
 }
@@ -45,7 +45,9 @@ public:
     virtual ~UdpPort();
 protected:
     void sendData(const std::stringstream& stream);
+    void sendData(const char* data, int size);
     virtual void handleNewData(std::stringstream& buffer) = 0;
+    virtual void handleNewDatagram(const char* data, int size);
 private:
     void run();
     
@@ -22,6 +22,7 @@ ENDIF()
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  UdpPort.cpp UdpPort.h
                 TcpPort.cpp TcpPort.h
+                TcpStreamSender.cpp TcpStreamSender.h
                 GameControllerPort.cpp GameControllerPort.h
                 JobPort.cpp JobPort.h
                 TeamPort.cpp TeamPort.h
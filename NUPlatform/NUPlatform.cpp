@@ -374,7 +374,7 @@ void NUPlatform::processActions()
 
 void NUPlatform::process(JobList* jobs, NUIO* m_io)
 {
-    static list<Job*>::iterator it;     // the iterator over the jobs
+    static IntrusiveJobList::iterator it;     // the iterator over the jobs
     for (it = jobs->camera_begin(); it != jobs->camera_end();)
     {
         //debug  << "NUPlatform::Process - Processing Job" << endl;
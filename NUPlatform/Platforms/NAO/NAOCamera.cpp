@@ -21,11 +21,13 @@
 
 #include "NAOCamera.h"
 #include "NUPlatform/NUPlatform.h"
+#include "NUPlatform/NUCamera/CaptureThread.h"
 #include "GTAssert.h"
 
 #include "debug.h"
 #include "debugverbositynucamera.h"
 #include "nubotdataconfig.h"        // for initial camera settings location
+#include "nubotconfig.h"            // for the capture thread priority
 
 #include <cstring>
 #include <sstream>
@@ -145,9 +147,7 @@ std::string controlName(unsigned int id)
 }
 
 NAOCamera::NAOCamera() :
-currentBuf(0),
-timeStamp(0),
-storedTimeStamp(Platform->getTime())
+m_capture_thread(0)
 {
 #if DEBUG_NUCAMERA_VERBOSITY > 4
     debug << "NAOCamera::NAOCamera()" << endl;
@@ -185,6 +185,7 @@ storedTimeStamp(Platform->getTime())
 
     // enable streaming
     setStreaming(true);
+    m_capture_thread = new CaptureThread(this, THREAD_CAPTURE_PRIORITY);
 }
 
 NAOCamera::~NAOCamera()
@@ -192,6 +193,10 @@ NAOCamera::~NAOCamera()
 #if DEBUG_NUCAMERA_VERBOSITY > 4
     debug << "NAOCamera::~NAOCamera()" << endl;
 #endif
+  // stop dequeuing frames
+  delete m_capture_thread;
+  m_capture_thread = 0;
+
   // disable streaming
   setStreaming(false);
 
@@ -318,32 +323,38 @@ void NAOCamera::initialiseCamera()
     }
 }
 
-bool NAOCamera::capturedNew()
+/*! @brief Dequeues the next frame buffer, blocking until the driver has filled one. This is called by the capture thread.
+    @param frame the frame to put the image in. The buffer it held is requeued first, it is no longer in use.
+ */
+void NAOCamera::capture(Frame& frame)
 {
-  // requeue the buffer of the last captured image which is obselete now
-  if(currentBuf) 
-    VERIFY(ioctl(fd, VIDIOC_QBUF, currentBuf) != -1);
-  
-  // dequeue a frame buffer (this call blocks when there is no new image available) */
-  VERIFY(ioctl(fd, VIDIOC_DQBUF, buf) != -1);
+  struct v4l2_buffer buffer;
+  memset(&buffer, 0, sizeof(buffer));
+  buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buffer.memory = V4L2_MEMORY_MMAP;
 
-  ASSERT(buf->bytesused == SIZE);
-  currentBuf = buf;
-  timeStamp = storedTimeStamp + 33.0;
-  storedTimeStamp = Platform->getTime();
-  return true;
-}
+  // requeue the buffer of the frame's old image which is obselete now
+  if(frame.Buffer >= 0)
+  {
+    buffer.index = frame.Buffer;
+    VERIFY(ioctl(fd, VIDIOC_QBUF, &buffer) != -1);
+    frame.Buffer = -1;
+  }
 
-const unsigned char* NAOCamera::getImage() const
-{
-  ASSERT(currentBuf);
-  return static_cast<unsigned char*>(mem[currentBuf->index]);
+  // dequeue a frame buffer (this call blocks when there is no new image available)
+  VERIFY(ioctl(fd, VIDIOC_DQBUF, &buffer) != -1);
+  double capturetime = Platform->getTime();
+
+  ASSERT(buffer.bytesused == SIZE);
+  frame.Buffer = buffer.index;
+  frame.Image.MapYUV422BufferToImage(static_cast<unsigned char*>(mem[buffer.index]), WIDTH, HEIGHT);
+  frame.Image.m_timestamp = capturetime;
 }
 
-double NAOCamera::getTimeStamp() const
+/*! @brief Returns the thread dequeuing the frames, for its frame counts and latencies */
+CaptureThread* NAOCamera::getCaptureThread()
 {
-  ASSERT(currentBuf);
-  return timeStamp;
+    return m_capture_thread;
 }
 
 CameraSettings::Camera NAOCamera::getCurrentCamera()
@@ -351,13 +362,15 @@ CameraSettings::Camera NAOCamera::getCurrentCamera()
     return m_settings.activeCamera;
 }
 
+/*! @brief Returns the newest frame that has not already been returned, blocking until there is one.
+
+    The image is valid until the next call.
+ */
 NUImage* NAOCamera::grabNewImage()
 {
-    while(!capturedNew());
-    currentBufferedImage.MapYUV422BufferToImage(getImage(), WIDTH, HEIGHT);
-    currentBufferedImage.m_timestamp = getTimeStamp();
-    currentBufferedImage.setCameraSettings(m_settings);
-    return &currentBufferedImage;
+    NUImage* image = m_capture_thread->getNewImage();
+    image->setCameraSettings(m_settings);
+    return image;
 }
 
 void NAOCamera::readCameraSettings()
@@ -5,6 +5,9 @@
  
     @class NAOCamera
     @brief A NAO camera
+
+    The frames are dequeued by a CaptureThread as soon as the driver has them, and grabNewImage()
+    returns the newest one that vision has not already had.
  
     @author Jason Kulk
  
@@ -29,9 +32,11 @@
 
 #include "NUPlatform/NUCamera.h"
 #include "NUPlatform/NUCamera/CameraSettings.h"
+#include "NUPlatform/NUCamera/CaptureSource.h"
 #include "Infrastructure/NUImage/NUImage.h"
+class CaptureThread;
 
-class NAOCamera : public NUCamera
+class NAOCamera : public NUCamera, public CaptureSource
 {
 public:
     NAOCamera();
@@ -45,6 +50,9 @@ public:
 
     void forceApplySettings(const CameraSettings& newset);
 
+    void capture(Frame& frame);
+    CaptureThread* getCaptureThread();
+
 private:
     void loadCameraOffset();
 private:
@@ -68,15 +76,9 @@ private:
     void* mem[frameBufferCount]; //!< Frame buffer addresses.
     int memLength[frameBufferCount]; //!< The length of each frame buffer.
     struct v4l2_buffer* buf; //!< Reusable parameter struct for some ioctl calls.
-    struct v4l2_buffer* currentBuf; //!< The last dequeued frame buffer.
-    double timeStamp, //!< Timestamp of the last captured image.
-           storedTimeStamp; //!< Timestamp when the next image recording starts.
-    bool capturedNew();
-    const unsigned char* getImage() const;
-    double getTimeStamp() const;
     CameraSettings::Camera getCurrentCamera();
 
-    NUImage currentBufferedImage;
+    CaptureThread* m_capture_thread; //!< The thread dequeuing the frame buffers.
     CameraSettings m_cameraSettings[CameraSettings::NUM_CAMERAS];
 };
 
@@ -62,23 +62,21 @@ void NAOWebotsNetworkThread::periodicFunction()
             convertToGamePacket((RoboCupGameControlDataWebots*)data);
             (*m_game_info) << m_game_packet;
         }
-        else if (memcmp(data, TEAM_PACKET_STRUCT_HEADER, sizeof(TEAM_PACKET_STRUCT_HEADER)-1) == 0 and m_receiver->getDataSize() == sizeof(TeamPacket))
+        else if (memcmp(data, TEAM_PACKET_STRUCT_HEADER, sizeof(TEAM_PACKET_STRUCT_HEADER)-1) == 0 and m_receiver->getDataSize() == TeamPacket::WireSize)
         {   // if it is a team packet
-            stringstream ss;
-            ss.write((char*) data, sizeof(TeamPacket));
             TeamPacket temp;
-            ss >> temp;
-            m_team_info->addReceivedTeamPacket(temp);
+            if (TeamPacket::decode(data, m_receiver->getDataSize(), temp))
+                m_team_info->addReceivedTeamPacket(temp);
         }
         else
-            cout << "Received " << m_receiver->getDataSize() << " unknown bytes. Want " << sizeof(RoboCupGameControlDataWebots) << " or " << sizeof(TeamPacket) << endl;
+            cout << "Received " << m_receiver->getDataSize() << " unknown bytes. Want " << sizeof(RoboCupGameControlDataWebots) << " or " << TeamPacket::WireSize << endl;
         m_receiver->nextPacket();
     };
     
     // Do transmitting
-    stringstream ss;
-    ss << m_team_info->generateTeamTransmissionPacket();
-    m_emitter->send(ss.str().c_str(), ss.str().size());
+    char buffer[TeamPacket::WireSize];
+    unsigned int size = TeamPacket::encode(m_team_info->generateTeamTransmissionPacket(), buffer, sizeof(buffer));
+    m_emitter->send(buffer, size);
 }
 
 void NAOWebotsNetworkThread::convertToGamePacket(const RoboCupGameControlDataWebots* data)
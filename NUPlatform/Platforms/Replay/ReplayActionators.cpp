@@ -0,0 +1,138 @@
+/*! @file ReplayActionators.cpp
+    @brief Implementation of Replay actionators class
+
+    @author agent
+ 
+ Copyright (c) 2026 agent
+ 
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayActionators.h"
+#include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUBlackboard.h"
+#include "NUPlatform/NUPlatform.h"
+
+#include "debug.h"
+#include "debugverbositynuactionators.h"
+
+// init m_servo_names:
+static string temp_servo_names[] = {string("HeadPitch"), string("HeadYaw"), \
+                                    string("LShoulderRoll"), string("LShoulderPitch"), string("LElbowRoll"), string("LElbowYaw"), \
+                                    string("RShoulderRoll"), string("RShoulderPitch"), string("RElbowRoll"), string("RElbowYaw"), \
+                                    string("LHipRoll"),  string("LHipPitch"), string("LHipYawPitch"), string("LKneePitch"), string("LAnkleRoll"), string("LAnklePitch"), \
+                                    string("RHipRoll"),  string("RHipPitch"), string("RHipYawPitch"), string("RKneePitch"), string("RAnkleRoll"), string("RAnklePitch")};
+vector<string> ReplayActionators::m_servo_names(temp_servo_names, temp_servo_names + sizeof(temp_servo_names)/sizeof(*temp_servo_names));
+
+// init m_led_names:
+static string temp_led_names[] = {string("Ears/Led/Left"), string("Ears/Led/Right"), string("Face/Led/Left"), string("Face/Led/Right"), \
+                                  string("ChestBoard/Led"), \
+                                  string("LFoot/Led"), string("RFoot/Led")};
+vector<string> ReplayActionators::m_led_names(temp_led_names, temp_led_names + sizeof(temp_led_names)/sizeof(*temp_led_names));
+
+// init m_other_names:
+static string temp_other_names[] = {string("Sound")};
+vector<string> ReplayActionators::m_other_names(temp_other_names, temp_other_names + sizeof(temp_other_names)/sizeof(*temp_other_names));
+
+/*! @brief Constructs a nubot actionator class that records the actions
+    @param filename the name of the csv file the actions are recorded in
+ */ 
+ReplayActionators::ReplayActionators(const string& filename)
+{
+#if DEBUG_NUACTIONATORS_VERBOSITY > 4
+    debug << "ReplayActionators::ReplayActionators(" << filename << ")" << endl;
+#endif
+    m_current_time = 0;
+    
+    vector<string> names;
+    names.insert(names.end(), m_servo_names.begin(), m_servo_names.end());
+    names.insert(names.end(), m_led_names.begin(), m_led_names.end());
+    names.insert(names.end(), m_other_names.begin(), m_other_names.end());
+    m_data->addActionators(names);
+    
+    m_file.open(filename.c_str());
+    if (m_file.is_open())
+    {
+        m_file << "Time";
+        for (size_t i=0; i<m_servo_names.size(); i++)
+            m_file << ", " << m_servo_names[i];
+        for (size_t i=0; i<m_servo_names.size(); i++)
+            m_file << ", " << m_servo_names[i] << "Gain";
+        m_file << ", Sounds" << endl;
+    }
+    else
+        errorlog << "ReplayActionators::ReplayActionators(). Unable to open " << filename << endl;
+    
+#if DEBUG_NUACTIONATORS_VERBOSITY > 3
+    debug << "ReplayActionators::ReplayActionators(). Avaliable Actionators: " << endl;
+    m_data->summaryTo(debug);
+#endif
+}
+
+ReplayActionators::~ReplayActionators()
+{
+    m_file.close();
+}
+
+void ReplayActionators::copyToHardwareCommunications()
+{
+#if DEBUG_NUACTIONATORS_VERBOSITY > 3
+    debug << "ReplayActionators::copyToHardwareCommunications()" << endl;
+#endif
+#if DEBUG_NUACTIONATORS_VERBOSITY > 4
+    m_data->summaryTo(debug);
+#endif
+    if (not m_file.is_open())
+        return;
+    m_file << Platform->getTime();
+    copyToServos();
+    copyToSound();
+    m_file << endl;
+}
+
+/*! @brief Records the joint positions and gains. Before the first sensor entry the columns are written empty, so
+           every line has a column for each heading.
+ */
+void ReplayActionators::copyToServos()
+{
+    static vector<float> positions;
+    static vector<float> gains;
+    
+    vector<float> targets;
+    Blackboard->Sensors->getTarget(NUSensorsData::All, targets);
+    if (targets.empty())
+    {   // there are no joints until the first sensor entry has been replayed, so the servo columns are left empty
+        for (size_t i=0; i<2*m_servo_names.size(); i++)
+            m_file << ", ";
+        return;
+    }
+    m_data->getNextServos(positions, gains);
+    for (size_t i=0; i<positions.size(); i++)
+        m_file << ", " << positions[i];
+    for (size_t i=0; i<gains.size(); i++)
+        m_file << ", " << gains[i];
+}
+
+/*! @brief Records the sounds, separated by spaces, instead of playing them
+ */
+void ReplayActionators::copyToSound()
+{
+    vector<string> sounds;
+    m_data->getNextSounds(sounds);
+    m_file << ", ";
+    for (size_t i=0; i<sounds.size(); i++)
+        m_file << sounds[i] << " ";
+}
+
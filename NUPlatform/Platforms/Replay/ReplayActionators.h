@@ -0,0 +1,54 @@
+/*! @file ReplayActionators.h
+    @brief Declaration of Replay actionators class
+
+    @class ReplayActionators
+    @brief An actionators class that records the actions instead of sending them to hardware
+
+    Each cycle the servo targets and gains, and any sounds, are written as a line of a csv file. The actionators
+    are those of the NAO in webots, which are the names the motion module expects.
+
+    @author agent
+ 
+    Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYACTIONATORS_H
+#define REPLAYACTIONATORS_H
+
+#include "NUPlatform/NUActionators.h"
+
+#include <fstream>
+
+class ReplayActionators : public NUActionators
+{
+public:
+    ReplayActionators(const string& filename);
+    ~ReplayActionators();
+    
+private:
+    void copyToHardwareCommunications();
+    void copyToServos();
+    void copyToSound();
+    
+private:
+    static vector<string> m_servo_names;            //!< the names of the available joints (eg HeadYaw, AnklePitch etc)
+    static vector<string> m_led_names;              //!< the names of the available leds
+    static vector<string> m_other_names;            //!< the names of other available actionators
+    ofstream m_file;                                //!< the file the actions are recorded in
+};
+
+#endif
+
@@ -0,0 +1,79 @@
+/*! @file ReplayCamera.cpp
+    @brief Implementation of Replay camera class
+
+    @author agent
+ 
+ Copyright (c) 2026 agent
+ 
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayCamera.h"
+#include "NUPlatform/NUPlatform.h"
+
+#include "debug.h"
+#include "debugverbositynucamera.h"
+
+/*! @brief Constructs a replay camera
+    @param filename the name of the image log
+ */
+ReplayCamera::ReplayCamera(const std::string& filename)
+{
+#if DEBUG_NUCAMERA_VERBOSITY > 0
+    debug << "ReplayCamera::ReplayCamera(" << filename << ")" << endl;
+#endif
+    if (not m_log.open(filename, m_image))
+        errorlog << "ReplayCamera::ReplayCamera(). Unable to open " << filename << endl;
+}
+
+/*! @brief Destroy the ReplayCamera
+ */
+ReplayCamera::~ReplayCamera()
+{
+}
+
+/*! @brief Returns the number of images in the image log */
+size_t ReplayCamera::size() const
+{
+    return m_log.size();
+}
+
+/*! @brief Returns true if there is an image in the log that has not been grabbed, and was taken at or before a time
+    @param time the time (ms)
+ */
+bool ReplayCamera::hasImageBy(double time)
+{
+    return m_log.hasNext() and m_log.nextTime() <= time;
+}
+
+/*! @brief Returns a pointer to the latest image taken by the current time. Older images that have not been grabbed are skipped.
+ */
+NUImage* ReplayCamera::grabNewImage()
+{
+    double time = Platform->getTime();
+    if (hasImageBy(time))
+    {
+        m_log.skipTo(time);
+        if (not m_log.readNext(m_image))
+            errorlog << "ReplayCamera::grabNewImage(). Unable to read the image at " << time << endl;
+    }
+    return &m_image;
+}
+
+/*! @brief The ReplayCamera can not change the recorded images, so this function does nothing
+ */
+void ReplayCamera::setSettings(const CameraSettings&)
+{
+}
+
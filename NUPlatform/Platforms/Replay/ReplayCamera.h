@@ -0,0 +1,49 @@
+/*! @file ReplayCamera.h
+    @brief Declaration of Replay camera class
+
+    @class ReplayCamera
+    @brief A camera whose images are read from an image stream log
+
+    @author agent
+ 
+    Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYCAMERA_H
+#define REPLAYCAMERA_H
+
+#include "NUPlatform/NUCamera.h"
+#include "ReplayLog.h"
+
+#include <string>
+
+class ReplayCamera : public NUCamera
+{
+public:
+    ReplayCamera(const std::string& filename);
+    ~ReplayCamera();
+    
+    size_t size() const;
+    bool hasImageBy(double time);
+    NUImage* grabNewImage();
+    void setSettings(const CameraSettings& newset);
+private:
+    ReplayLog<NUImage> m_log;               //!< the image log
+    NUImage m_image;                        //!< the current image
+};
+
+#endif
+
@@ -0,0 +1,70 @@
+/*! @file ReplayIO.cpp
+    @brief Implementation of ReplayIO input/output class
+
+    @author agent
+ 
+    Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayIO.h"
+#include "ReplayPlatform.h"
+#include "NUbot.h"
+#include "Infrastructure/NUBlackboard.h"
+
+#include "debug.h"
+#include "debugverbositynetwork.h"
+#include "ioconfig.h"
+
+using namespace std;
+
+/*! @brief Construct a ReplayIO object
+    @param nubot a pointer to the NUbot, we need this to gain access to the public store
+    @param platform a pointer to the ReplayPlatform, which knows where the logs are
+ */
+ReplayIO::ReplayIO(NUbot* nubot, ReplayPlatform* platform): NUIO(nubot)
+{
+#if DEBUG_NETWORK_VERBOSITY > 0
+    debug << "ReplayIO::ReplayIO()" << endl;
+#endif
+    m_nubot = nubot;
+    
+    // the logs are indexed into copies, so that the blackboard only ever holds data that is due
+    GameInformation gameinfo(platform->getRobotNumber(), platform->getTeamNumber());
+    TeamInformation teaminfo(platform->getRobotNumber(), platform->getTeamNumber());
+    if (not m_game_log.open(platform->getLogPath("gameinfo"), gameinfo))
+        errorlog << "ReplayIO::ReplayIO(). Unable to open " << platform->getLogPath("gameinfo") << endl;
+    if (not m_team_log.open(platform->getLogPath("teaminfo"), teaminfo))
+        errorlog << "ReplayIO::ReplayIO(). Unable to open " << platform->getLogPath("teaminfo") << endl;
+}
+
+ReplayIO::~ReplayIO()
+{
+#if DEBUG_NETWORK_VERBOSITY > 0
+    debug << "ReplayIO::~ReplayIO()" << endl;
+#endif
+}
+
+/*! @brief Reads the game and team information logged up to a time into the Blackboard
+    @param time the time of the current step (ms)
+ */
+void ReplayIO::update(double time)
+{
+    while (m_game_log.hasNext() and m_game_log.nextTime() <= time)
+        m_game_log.readNext(*Blackboard->GameInfo);
+    while (m_team_log.hasNext() and m_team_log.nextTime() <= time)
+        m_team_log.readNext(*Blackboard->TeamInfo);
+}
+
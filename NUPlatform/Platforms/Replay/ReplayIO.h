@@ -0,0 +1,56 @@
+/*! @file ReplayIO.h
+    @brief Declaration of ReplayIO class.
+ 
+    @class ReplayIO
+    @brief ReplayIO class for input and output on the Replay platform
+
+    The network ports are the same as on the robot, so the replay can be watched in NUview. The game and team
+    information is replayed from their logs; update() is called each step to bring them up to the current time.
+    For the game and team information to come only from the logs, configure the build with
+    NUBOT_USE_NETWORK_GAMECONTROLLER and NUBOT_USE_NETWORK_TEAMINFO OFF.
+
+    @author agent
+ 
+    Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYIO_H
+#define REPLAYIO_H
+
+#include "NUPlatform/NUIO.h"
+#include "Infrastructure/GameInformation/GameInformation.h"
+#include "Infrastructure/TeamInformation/TeamInformation.h"
+#include "ReplayLog.h"
+
+class NUbot;
+class ReplayPlatform;
+
+class ReplayIO: public NUIO
+{
+// Functions:
+public:
+    ReplayIO(NUbot* nubot, ReplayPlatform* platform);
+    ~ReplayIO();
+    
+    void update(double time);
+protected:
+private:
+    ReplayLog<GameInformation> m_game_log;          //!< the game information log
+    ReplayLog<TeamInformation> m_team_log;          //!< the team information log
+};
+
+#endif
+
@@ -0,0 +1,193 @@
+/*! @file ReplayLog.h
+    @brief Declaration and definition of the ReplayLog template class
+
+    @class ReplayLog
+    @brief Reads the entries of a stream log (.strm) in order, for replaying them on the Replay platform.
+
+    The location and timestamp of every entry is known before any of them are read, so the replay
+    can decide when each entry is due without parsing it. They are taken from the log's sidecar index
+    (see LogIndex) if there is one, otherwise the file is scanned once when it is opened; entries written
+    as LogRecords are skipped over using their headers, older entries have to be parsed.
+
+    The class used in the template must be readable from a stream with operator>>, and have a GetTimestamp().
+
+    @author agent
+
+    Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYLOG_H
+#define REPLAYLOG_H
+
+#include "Tools/FileFormats/LogIndex.h"
+#include "Tools/FileFormats/LogRecord.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+template<class T>
+class ReplayLog
+{
+public:
+    ReplayLog()
+    {
+        m_next = 0;
+    }
+
+    ~ReplayLog()
+    {
+        close();
+    }
+
+    /*! @brief Opens a stream log, and finds the location and timestamp of each of its entries
+        @param filename the name of the stream log
+        @param scratch an object the entries are parsed into when the log has neither an index nor record headers
+        @return true if the log was opened
+     */
+    bool open(const std::string& filename, T& scratch)
+    {
+        close();
+        m_file.open(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+        if (not m_file.is_open())
+            return false;
+        if (not LogIndex::Load(filename, m_entries))
+            scan(scratch);
+        return true;
+    }
+
+    /*! @brief Closes the log */
+    void close()
+    {
+        if (m_file.is_open())
+            m_file.close();
+        m_entries.clear();
+        m_next = 0;
+    }
+
+    /*! @brief Returns true if the log is open */
+    bool isOpen() const
+    {
+        return m_file.is_open();
+    }
+
+    /*! @brief Returns the number of entries in the log */
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    /*! @brief Returns true if there are entries left to read */
+    bool hasNext() const
+    {
+        return m_next < m_entries.size();
+    }
+
+    /*! @brief Returns the timestamp of the next entry (ms). Only valid if hasNext() */
+    double nextTime() const
+    {
+        return m_entries[m_next].Timestamp;
+    }
+
+    /*! @brief Reads the next entry
+        @param data the object the entry is read into
+        @return false if there are no entries left, or the entry could not be read
+     */
+    bool readNext(T& data)
+    {
+        if (not hasNext())
+            return false;
+        m_file.clear();
+        m_file.seekg(m_entries[m_next].Offset, std::ios_base::beg);
+        m_next++;
+        try
+        {
+            LogRecord::Read(m_file, data);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /*! @brief Moves past entries without reading them, so that the next entry is the last one at or before a time
+        @param time the time (ms)
+     */
+    void skipTo(double time)
+    {
+        while (m_next + 1 < m_entries.size() and m_entries[m_next + 1].Timestamp <= time)
+            m_next++;
+    }
+
+private:
+    /*! @brief Finds the location and timestamp of each entry by reading through the whole log
+        @param scratch an object entries without record headers are parsed into to find their timestamps
+     */
+    void scan(T& scratch)
+    {
+        m_file.seekg(0, std::ios_base::end);
+        std::streampos end = m_file.tellg();
+        m_file.seekg(0, std::ios_base::beg);
+
+        LogIndex::Entry entry;
+        entry.Sequence = 0;
+        while (m_file.good() and m_file.tellg() < end)
+        {
+            std::streampos start = m_file.tellg();
+            std::streampos stop;
+            LogRecord::Header header;
+            if (LogRecord::ReadHeader(m_file, header))
+            {   // skip over the record without parsing it
+                stop = start + std::streamoff(LogRecord::HeaderSize + header.Length);
+                if (stop > end)
+                    break;
+                m_file.seekg(stop, std::ios_base::beg);
+                entry.Timestamp = header.Timestamp;
+            }
+            else
+            {
+                try
+                {
+                    m_file >> scratch;
+                }
+                catch (...)
+                {
+                    break;
+                }
+                if (m_file.fail())
+                    break;
+                stop = m_file.eof() ? end : m_file.tellg();
+                if (stop == start)
+                    break;
+                entry.Timestamp = scratch.GetTimestamp();
+            }
+            entry.Offset = static_cast<unsigned long long>(start);
+            entry.Length = static_cast<unsigned int>(stop - start);
+            entry.Sequence++;
+            m_entries.push_back(entry);
+        }
+        m_file.clear();
+        m_file.seekg(0, std::ios_base::beg);
+    }
+
+    std::ifstream m_file;                       //!< the stream log
+    std::vector<LogIndex::Entry> m_entries;     //!< the location and timestamp of each entry in the log
+    size_t m_next;                              //!< the index of the next entry to be read
+};
+
+#endif
+
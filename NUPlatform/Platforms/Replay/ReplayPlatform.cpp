@@ -0,0 +1,227 @@
+/*! @file ReplayPlatform.cpp
+    @brief Implementation of ReplayPlatform
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayPlatform.h"
+#include "ReplayCamera.h"
+#include "ReplaySensors.h"
+#include "ReplayActionators.h"
+#include "Infrastructure/Jobs/JobList.h"
+
+#include "debug.h"
+#include "debugverbositynuplatform.h"
+#include "nubotconfig.h"
+#include "nubotdataconfig.h"
+
+#include <dirent.h>
+#include <string.h>
+#include <sstream>
+#include <stdlib.h>
+using namespace std;
+
+const double ReplayPlatform::FramePeriod = 33;
+
+/*! @brief Constructor for the Replay platform
+    @param argc the number of command line arguments
+    @param argv the command line arguments; the log directory followed by the options described in ReplayPlatform.h
+ */
+ReplayPlatform::ReplayPlatform(int argc, const char *argv[])
+{
+    #if DEBUG_NUPLATFORM_VERBOSITY > 1
+        debug << "ReplayPlatform::ReplayPlatform()" << endl;
+    #endif
+    m_time = 0;
+    m_next_frame_time = 0;
+    m_log_start_time = 0;
+    m_real_start_time = 0;
+    m_num_steps = 0;
+    parseArguments(argc, argv);
+    init();
+
+    #ifdef USE_VISION
+        m_replay_camera = new ReplayCamera(getLogPath("image"));
+    #else
+        m_replay_camera = 0;
+    #endif
+    m_camera = m_replay_camera;
+    m_replay_sensors = new ReplaySensors(getLogPath("sensor"));
+    m_sensors = m_replay_sensors;
+    m_actionators = new ReplayActionators(getOutputPath("replay_actionators.csv"));
+
+    m_jobs_file.open(getOutputPath("replay_jobs.csv").c_str());
+    if (not m_jobs_file.is_open())
+        errorlog << "ReplayPlatform::ReplayPlatform(). Unable to open " << getOutputPath("replay_jobs.csv") << endl;
+
+    if (m_replay_sensors->hasNext())
+        m_time = m_replay_sensors->nextTime();
+    m_next_frame_time = m_time;
+    debug << "ReplayPlatform::ReplayPlatform(). Replaying " << m_replay_sensors->size() << " sensor frames from " << m_log_directory << endl;
+}
+
+ReplayPlatform::~ReplayPlatform()
+{
+    #if DEBUG_NUPLATFORM_VERBOSITY > 1
+        debug << "ReplayPlatform::~ReplayPlatform()" << endl;
+    #endif
+    m_jobs_file.close();
+}
+
+/*! @brief Reads the log directory and options from the command line */
+void ReplayPlatform::parseArguments(int argc, const char *argv[])
+{
+    m_log_directory = DATA_DIR + "Replay/";
+    m_output_directory = DATA_DIR;
+    m_player_number = -1;
+    m_realtime = false;
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-realtime") == 0)
+            m_realtime = true;
+        else if (strcmp(argv[i], "-player") == 0 and i+1 < argc)
+            m_player_number = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-output") == 0 and i+1 < argc)
+            m_output_directory = string(argv[++i]) + "/";
+        else
+            m_log_directory = string(argv[i]) + "/";
+    }
+    if (m_player_number < 0)
+        m_player_number = findPlayerNumber();
+}
+
+/*! @brief Returns the player number of the first sensor log in the log directory, or 1 if there is not one */
+int ReplayPlatform::findPlayerNumber()
+{
+    int player = 1;
+    DIR* directory = opendir(m_log_directory.c_str());
+    if (directory == NULL)
+    {
+        errorlog << "ReplayPlatform::findPlayerNumber(). Unable to open " << m_log_directory << endl;
+        return player;
+    }
+    const string suffix = "_sensor.strm";
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        string name(entry->d_name);
+        if (name.size() > suffix.size() and name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            player = atoi(name.c_str());
+            break;
+        }
+    }
+    closedir(directory);
+    return player;
+}
+
+/*! @brief Returns the path to one of the logs being replayed, using the names given by the LogRecorder
+    @param data_name the type of data in the log, ie. "sensor", "image", "gameinfo" or "teaminfo"
+ */
+string ReplayPlatform::getLogPath(const string& data_name)
+{
+    stringstream ss;
+    ss << m_log_directory << m_player_number << "_" << data_name << ".strm";
+    return ss.str();
+}
+
+/*! @brief Returns the path to one of the files the outputs are recorded in */
+string ReplayPlatform::getOutputPath(const string& file_name)
+{
+    return m_output_directory + file_name;
+}
+
+/*! @brief Initialises the NUPlatform's name. The name is replay${playernumber}
+ */
+void ReplayPlatform::initName()
+{
+    stringstream ss;
+    ss << "replay" << m_player_number;
+    m_name = ss.str();
+}
+
+/*! @brief Initialises the NUPlatform's robot number. The player number of the logs is used
+ */
+void ReplayPlatform::initNumber()
+{
+    m_robot_number = m_player_number;
+}
+
+/*! @brief Returns the time of the current step in milliseconds. This is the timestamp of the sensor data being replayed.
+ */
+double ReplayPlatform::getTime()
+{
+    return m_time;
+}
+
+/*! @brief Moves the replay on to the next sensor entry
+
+    When replaying in real time this sleeps until the entry is due, otherwise it returns straight away.
+    @return false when there are no sensor entries left, and the replay is finished
+ */
+bool ReplayPlatform::step()
+{
+    if (not m_replay_sensors->hasNext())
+        return false;
+    double time = m_replay_sensors->nextTime();
+    if (m_num_steps == 0)
+    {
+        m_log_start_time = time;
+        m_real_start_time = getRealTime();
+    }
+    else if (m_realtime)
+    {
+        double sleeptime = (time - m_log_start_time) - (getRealTime() - m_real_start_time);
+        if (sleeptime > 0)
+            msleep(sleeptime);
+    }
+    m_time = time;
+    m_num_steps++;
+    return true;
+}
+
+/*! @brief Returns true if the SeeThinkThread should be run in this step
+
+    When there is an image log this is when an image is due, otherwise it is every FramePeriod.
+ */
+bool ReplayPlatform::isFrameDue()
+{
+    if (m_replay_camera and m_replay_camera->size() > 0)
+        return m_replay_camera->hasImageBy(m_time);
+    if (m_time >= m_next_frame_time)
+    {
+        m_next_frame_time += FramePeriod*(1 + (int) ((m_time - m_next_frame_time)/FramePeriod));
+        return true;
+    }
+    return false;
+}
+
+/*! @brief Records the jobs in the JobList; one line per job, each starting with the time of the current step
+    @param jobs the jobs produced in this SeeThinkThread cycle
+ */
+void ReplayPlatform::recordJobs(JobList* jobs)
+{
+    if (not m_jobs_file.is_open())
+        return;
+    for (JobList::iterator it = jobs->begin(); it != jobs->end(); ++it)
+    {
+        m_jobs_file << m_time << ", ";
+        (*it)->csvTo(m_jobs_file);
+    }
+}
+
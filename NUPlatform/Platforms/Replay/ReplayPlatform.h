@@ -0,0 +1,89 @@
+/*! @file ReplayPlatform.h
+    @brief Declaration of Replay platform class.
+
+    @class ReplayPlatform
+    @brief A platform that replays the stream logs recorded on a robot through the full nubot.
+
+    The camera, sensors and game and team information are read from the logs a robot recorded with the
+    LogRecorder (ie. ${player}_image.strm, ${player}_sensor.strm, ${player}_gameinfo.strm and ${player}_teaminfo.strm),
+    and the SenseMoveThread and SeeThinkThread are run on them in lock step by NUbot::run(). Each sensor entry is one
+    step, and getTime() returns the timestamp of the current step, so every module sees the times that were recorded
+    and a replay of the same logs always produces the same outputs. The servo targets, leds, sounds and jobs that are
+    produced are written to replay_actionators.csv and replay_jobs.csv so that runs can be compared.
+
+    By default the logs are replayed as fast as the modules can process them. The command line arguments are
+    @verbatim
+    nubot logdirectory [-player number] [-output directory] [-realtime]
+    @endverbatim
+    where -realtime replays the logs at the rate they were recorded.
+
+    @author agent
+
+    Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYPLATFORM_H
+#define REPLAYPLATFORM_H
+
+#include "NUPlatform/NUPlatform.h"
+class ReplayCamera;
+class ReplaySensors;
+
+#include <fstream>
+
+class ReplayPlatform : public NUPlatform
+{
+// Functions:
+public:
+    ReplayPlatform(int argc, const char *argv[]);
+    ~ReplayPlatform();
+
+    double getTime();
+
+    bool step();
+    bool isFrameDue();
+    void recordJobs(JobList* jobs);
+
+    std::string getLogPath(const std::string& data_name);
+    std::string getOutputPath(const std::string& file_name);
+protected:
+    void initName();
+    void initNumber();
+private:
+    void parseArguments(int argc, const char *argv[]);
+    int findPlayerNumber();
+
+public:
+    static const double FramePeriod;            //!< the time between SeeThinkThread cycles when there is no image log (ms)
+private:
+    std::string m_log_directory;                //!< the directory containing the logs
+    std::string m_output_directory;             //!< the directory the outputs are recorded in
+    int m_player_number;                        //!< the player number in the names of the logs
+    bool m_realtime;                            //!< true if the logs are replayed at the rate they were recorded
+
+    ReplayCamera* m_replay_camera;              //!< the camera; the same object as m_camera
+    ReplaySensors* m_replay_sensors;            //!< the sensors; the same object as m_sensors
+
+    double m_time;                              //!< the time of the current step (ms)
+    double m_next_frame_time;                   //!< the time of the next SeeThinkThread cycle when there is no image log (ms)
+    double m_log_start_time;                    //!< the time of the first step (ms)
+    double m_real_start_time;                   //!< the real time of the first step (ms)
+    unsigned long m_num_steps;                  //!< the number of steps taken
+    std::ofstream m_jobs_file;                  //!< the file the jobs are recorded in
+};
+
+#endif
+
@@ -0,0 +1,80 @@
+/*! @file ReplaySensors.cpp
+    @brief Implementation of Replay sensors class
+
+    @author agent
+ 
+ Copyright (c) 2026 agent
+ 
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplaySensors.h"
+
+#include "debug.h"
+#include "debugverbositynusensors.h"
+
+using namespace std;
+
+/*! @brief Constructs a nubot sensor class with a sensor log backend
+    @param filename the name of the sensor log
+ */
+ReplaySensors::ReplaySensors(const string& filename)
+{
+    #if DEBUG_NUSENSORS_VERBOSITY > 0
+        debug << "ReplaySensors::ReplaySensors(" << filename << ")" << endl;
+    #endif
+    if (not m_log.open(filename, m_log_data))
+        errorlog << "ReplaySensors::ReplaySensors(). Unable to open " << filename << endl;
+}
+
+/*! @brief Destructor for ReplaySensors
+ */
+ReplaySensors::~ReplaySensors()
+{
+    #if DEBUG_NUSENSORS_VERBOSITY > 0
+        debug << "ReplaySensors::~ReplaySensors()" << endl;
+    #endif
+}
+
+/*! @brief Returns the number of entries in the sensor log */
+size_t ReplaySensors::size() const
+{
+    return m_log.size();
+}
+
+/*! @brief Returns true if there are sensor entries left to replay */
+bool ReplaySensors::hasNext() const
+{
+    return m_log.hasNext();
+}
+
+/*! @brief Returns the timestamp of the next sensor entry (ms) */
+double ReplaySensors::nextTime() const
+{
+    return m_log.nextTime();
+}
+
+/*! @brief Copys the next entry in the sensor log into the NUSensorsData container
+ */
+void ReplaySensors::copyFromHardwareCommunications()
+{
+    // the entry is read into a buffer and then copied over the existing sensors, because reading rebuilds the sensor
+    // vector and other threads (ie. the TeamTransmissionThread) may be using m_data
+    if (m_log.readNext(m_log_data))
+        *m_data = m_log_data;
+    else
+        errorlog << "ReplaySensors::copyFromHardwareCommunications(). Unable to read the sensors at " << m_current_time << endl;
+    m_data->CurrentTime = m_current_time;
+}
+
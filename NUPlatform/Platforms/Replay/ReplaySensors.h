@@ -0,0 +1,54 @@
+/*! @file ReplaySensors.h
+    @brief Declaration of Replay sensors class
+
+    @class ReplaySensors
+    @brief A sensors class whose hardware sensors are read from a sensor stream log
+
+    Each update reads the next entry in the log. The soft sensors (kinematics, orientation, odometry, etc.) are
+    then calculated from the logged hardware sensors, just as they are on the robot.
+
+    @author agent
+ 
+    Copyright (c) 2026 agent
+ 
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYSENSORS_H
+#define REPLAYSENSORS_H
+
+#include "NUPlatform/NUSensors.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "ReplayLog.h"
+
+#include <string>
+
+class ReplaySensors : public NUSensors
+{
+public:
+    ReplaySensors(const std::string& filename);
+    ~ReplaySensors();
+    
+    size_t size() const;
+    bool hasNext() const;
+    double nextTime() const;
+    
+    void copyFromHardwareCommunications();
+private:
+    ReplayLog<NUSensorsData> m_log;         //!< the sensor log
+    NUSensorsData m_log_data;               //!< the entry read from the log, before it is copied into m_data
+};
+
+#endif
+
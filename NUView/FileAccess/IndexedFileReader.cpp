@@ -1,6 +1,17 @@
 #include "IndexedFileReader.h"
+#include "Tools/FileFormats/LogIndex.h"
+#include <QDebug>
 #include <cmath>
-IndexedFileReader::IndexedFileReader(): m_fileEndLocation(0)
+
+#ifndef WIN32
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+IndexedFileReader::IndexedFileReader(): m_fileEndLocation(0), m_mappedData(NULL), m_mappedSize(0)
 {
     m_selectedFrame = m_index.end();
 }
@@ -35,17 +46,124 @@ bool IndexedFileReader::OpenFile(const std::string& filename)
         m_file.seekg(0,std::ios_base::end);
         m_fileEndLocation = m_file.tellg();
         m_filename = filename;
-        IndexFile();
+        MapFile();
+        if(!LoadIndex())
+            IndexFile();
     }
     if(!IsValid()) m_filename.clear();
     return IsValid();
 }
 
+/**
+  *     Load the index of the open file from its sidecar index file, rather than scanning the file.
+  *     Entries past the end of the file (ie. the file was truncated) are ignored.
+  *     @return True if the index was loaded. False if there is no valid sidecar index, in which case the file must be indexed by IndexFile().
+  */
+bool IndexedFileReader::LoadIndex()
+{
+    std::vector<LogIndex::Entry> entries;
+    if(!LogIndex::Load(m_filename, entries) || entries.empty())
+        return false;
+
+    ClearIndex();
+    FrameEntry temp;
+    temp.frameSequenceNumber = 0;
+    const unsigned long long fileEnd = static_cast<unsigned long long>(std::streamoff(m_fileEndLocation));
+    for(std::vector<LogIndex::Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if((*it).Offset + (*it).Length > fileEnd)
+        {   // the index was written after the file was truncated; stop at the last complete entry
+            qDebug("File: %s - Index extends past the end of the file at entry %u", m_filename.c_str(), (*it).Sequence);
+            break;
+        }
+        double timestamp = floor((*it).Timestamp);
+        if(HasTime(timestamp))
+        {
+            qDebug("File: %s - Found duplicate frame time: %f", m_filename.c_str(), timestamp);
+            continue;
+        }
+        temp.frameSequenceNumber++;
+        temp.position = std::streamoff((*it).Offset);
+        m_index.insert(m_index.end(), IndexEntry(timestamp, temp));
+        m_timeIndex.push_back(timestamp);
+    }
+    return !m_index.empty();
+}
+
+/**
+  *     Memory map the open file, so that frames can be parsed without seeking and reading the file,
+  *     and from more than one thread. If the file can not be mapped (for instance a very large log on a
+  *     32 bit machine) the file is read through m_file instead.
+  *     @return True if the file was mapped.
+  */
+bool IndexedFileReader::MapFile()
+{
+    UnmapFile();
+#ifndef WIN32
+    int fd = open(m_filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size <= 0 || static_cast<unsigned long long>(info.st_size) > static_cast<size_t>(-1))
+    {
+        close(fd);
+        return false;
+    }
+    void* mapped = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapped == MAP_FAILED)
+    {
+        qDebug("File: %s - Unable to memory map the file.", m_filename.c_str());
+        return false;
+    }
+    m_mappedData = static_cast<const char*>(mapped);
+    m_mappedSize = info.st_size;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+  *     Unmap the file, if it is mapped.
+  */
+void IndexedFileReader::UnmapFile()
+{
+#ifndef WIN32
+    if(m_mappedData != NULL)
+        munmap(const_cast<char*>(m_mappedData), m_mappedSize);
+#endif
+    m_mappedData = NULL;
+    m_mappedSize = 0;
+}
+
+/**
+  *     Decode the data that is most valid at the given point of time into the prefetch buffers,
+  *     so that a later read of that time does not have to parse the file. This may be called from
+  *     a different thread to the reading functions. Readers that do not prefetch do nothing.
+  *     @param time The time in milliseconds of the data to prefetch.
+  *     @param centreTime The time of the current frame. Buffered data furthest from this time is replaced first.
+  *     @return True if the data is now buffered.
+  */
+bool IndexedFileReader::PrefetchAtTime(double time, double centreTime)
+{
+    return false;
+}
+
+/**
+  *     Discard any prefetched data.
+  */
+void IndexedFileReader::ClearPrefetched()
+{
+}
+
 /**
   *     Closes any currently opened files.
   */
 void IndexedFileReader::CloseFile()
 {
+    ClearPrefetched();
+    UnmapFile();
     m_file.close();
     m_fileEndLocation = 0;
     ClearIndex();
@@ -148,6 +266,21 @@ double IndexedFileReader::TimeAtSequenceNumber(unsigned int sequenceNumber)
     }
 }
 
+/**
+  *     Gives the sequence number of the data that is valid at the given point of time. That is, the last
+  *     data at or before the time.
+  *     @param time The time in milliseconds.
+  *     @return The sequence number of the data, or 0 if there is no data at or before the time.
+  */
+unsigned int IndexedFileReader::SequenceNumberAtTime(double time)
+{
+    IndexIterator pos = m_index.upper_bound(time);
+    if(pos == m_index.begin())
+        return 0;
+    --pos;
+    return (*pos).second.frameSequenceNumber;
+}
+
 /**
   *     Determine if the file contains a value at the exact time given.
   *     @param The time in milliseconds.
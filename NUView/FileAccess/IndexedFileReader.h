@@ -65,6 +65,7 @@ public:
     bool HasTime(double time);
     double FindClosestTime(double time);
     double TimeAtSequenceNumber(unsigned int sequenceNumber);
+    unsigned int SequenceNumberAtTime(double time);
 
     unsigned int CurrentFrameSequenceNumber();
     unsigned int TotalFrames();
@@ -72,8 +73,15 @@ public:
     // Unimplemented virtual functions.
     virtual void IndexFile() = 0;
 
+    // Background prefetching, implemented by readers that support it.
+    virtual bool PrefetchAtTime(double time, double centreTime);
+    virtual void ClearPrefetched();
+
 protected:
     // Protected helper functions
+    bool LoadIndex();
+    bool MapFile();
+    void UnmapFile();
     bool ValidStartingLocation(Position startingLocation);
     bool ValidEntry(IndexIterator entry);
     IndexIterator GetIndexFromTime(double time);
@@ -86,6 +94,8 @@ protected:
     Position m_fileEndLocation;         //!< The end position of the file.
     IndexIterator m_selectedFrame;      //!< Reference to the currently selected frame in the FileIndex.
     std::string m_filename;             //!< The name of the open file.
+    const char* m_mappedData;           //!< The contents of the file when it is memory mapped, NULL if it is not.
+    unsigned long long m_mappedSize;    //!< The number of bytes mapped.
 };
 
 #endif // FILEREADER_H
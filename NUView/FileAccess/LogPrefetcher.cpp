@@ -0,0 +1,126 @@
+/*! @file LogPrefetcher.cpp
+    @brief Implementation of the LogPrefetcher class
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogPrefetcher.h"
+
+/**
+  *     Constructor. Creates and starts the prefetch thread.
+  *     @param syncReader The stream the frame numbers passed to setPosition() refer to.
+  *     @param streams The streams to prefetch.
+  *     @param depth The number of frames to prefetch ahead of the current frame.
+  */
+LogPrefetcher::LogPrefetcher(IndexedFileReader* syncReader, const std::vector<IndexedFileReader*>& streams, unsigned int depth):
+        Thread("LogPrefetcher", 0), m_syncReader(syncReader), m_streams(streams), m_depth(depth)
+{
+    m_frameNumber = 0;
+    m_direction = 1;
+    m_pending = false;
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_condition, NULL);
+    start();
+}
+
+/**
+  *     Destructor. Stops the prefetch thread, waiting for it to finish any frame it is decoding.
+  */
+LogPrefetcher::~LogPrefetcher()
+{
+    stop();
+    join();
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+/**
+  *     Set the current frame. The frames after it, in the direction it moved, are prefetched.
+  *     @param frameNumber The sequence number of the current frame in the sync stream.
+  */
+void LogPrefetcher::setPosition(unsigned int frameNumber)
+{
+    pthread_mutex_lock(&m_mutex);
+    if(frameNumber > m_frameNumber)
+        m_direction = 1;
+    else if(frameNumber < m_frameNumber)
+        m_direction = -1;
+    m_frameNumber = frameNumber;
+    m_pending = true;
+    pthread_cond_signal(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/**
+  *     The prefetcher's main loop. Waits for the position to change, then prefetches the frames after it
+  *     in every stream, nearest first, until the position changes again.
+  */
+void LogPrefetcher::run()
+{
+    // The thread is only cancelled while it is waiting, never part way through decoding a frame.
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    while(true)
+    {
+        pthread_mutex_lock(&m_mutex);
+        pthread_cleanup_push(unlockMutex, &m_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+        while(!m_pending)
+            pthread_cond_wait(&m_condition, &m_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+        pthread_cleanup_pop(0);
+        unsigned int frameNumber = m_frameNumber;
+        int direction = m_direction;
+        m_pending = false;
+        pthread_mutex_unlock(&m_mutex);
+
+        double centreTime = m_syncReader->TimeAtSequenceNumber(frameNumber);
+        if(centreTime < 0.0)
+            continue;
+        for(unsigned int i = 1; i < m_depth && !positionChanged(); i++)
+        {
+            long next = static_cast<long>(frameNumber) + direction*static_cast<long>(i);
+            if(next < 1)
+                break;
+            double time = m_syncReader->TimeAtSequenceNumber(next);
+            if(time < 0.0)
+                break;
+            for(unsigned int j = 0; j < m_streams.size(); j++)
+                m_streams[j]->PrefetchAtTime(time, centreTime);
+        }
+    }
+}
+
+/**
+  *     Determine if the position has changed since it was last read by the prefetch thread.
+  *     @return True if there is a new position.
+  */
+bool LogPrefetcher::positionChanged()
+{
+    pthread_mutex_lock(&m_mutex);
+    bool changed = m_pending;
+    pthread_mutex_unlock(&m_mutex);
+    return changed;
+}
+
+/**
+  *     Unlocks the mutex. Used as a cancellation cleanup handler.
+  */
+void LogPrefetcher::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
@@ -0,0 +1,65 @@
+/*! @file LogPrefetcher.h
+    @brief Declaration of the LogPrefetcher class
+
+    @class LogPrefetcher
+    @brief A thread that decodes the frames around the current playback position before they are needed.
+
+    Each time the current frame changes the prefetcher is told the new frame number. It then asks
+    every stream to prefetch the next frames in the direction of playback, so that stepping through
+    a log (forwards, or backwards when scrubbing) reads frames that have already been decoded.
+    Frames are selected by time from the sync stream, which is the stream used to number the frames.
+
+    Only streams that are memory mapped prefetch. The streams must not be opened or closed while
+    the prefetcher exists.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGPREFETCHER_H
+#define LOGPREFETCHER_H
+#include "Tools/Threading/Thread.h"
+#include "IndexedFileReader.h"
+#include <pthread.h>
+#include <vector>
+
+class LogPrefetcher: public Thread
+{
+public:
+    LogPrefetcher(IndexedFileReader* syncReader, const std::vector<IndexedFileReader*>& streams, unsigned int depth);
+    ~LogPrefetcher();
+
+    void setPosition(unsigned int frameNumber);
+
+protected:
+    void run();
+
+private:
+    bool positionChanged();
+    static void unlockMutex(void* mutex);
+
+    IndexedFileReader* m_syncReader;            //!< The stream the frame numbers refer to.
+    std::vector<IndexedFileReader*> m_streams;  //!< The streams to prefetch.
+    unsigned int m_depth;                       //!< The number of frames to prefetch ahead of the current frame.
+    unsigned int m_frameNumber;                 //!< The current frame.
+    int m_direction;                            //!< The direction of playback, 1 forwards, -1 backwards.
+    bool m_pending;                             //!< True when the current frame has changed since it was last prefetched around.
+    pthread_mutex_t m_mutex;                    //!< Lock for the position.
+    pthread_cond_t m_condition;                 //!< Signalled when the position changes.
+};
+
+#endif // LOGPREFETCHER_H
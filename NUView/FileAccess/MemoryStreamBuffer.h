@@ -0,0 +1,72 @@
+/*! @file MemoryStreamBuffer.h
+    @brief Declaration and definition of the MemoryStreamBuffer class
+
+    @class MemoryStreamBuffer
+    @brief A read only stream buffer over a block of memory.
+
+    Used to parse data straight out of a memory mapped file with the existing stream operators,
+    without copying it. The buffer supports seeking so that tellg() and seekg() work on streams
+    that use it.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEMORYSTREAMBUFFER_H
+#define MEMORYSTREAMBUFFER_H
+#include <streambuf>
+#include <cstddef>
+
+class MemoryStreamBuffer: public std::streambuf
+{
+public:
+    /**
+      *     Constructor. The memory must remain valid for the lifetime of the buffer.
+      *     @param data The start of the memory.
+      *     @param size The number of bytes of memory.
+      */
+    MemoryStreamBuffer(const char* data, std::size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which = std::ios_base::in)
+    {
+        if(!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+        char* target;
+        if(direction == std::ios_base::beg)
+            target = eback() + offset;
+        else if(direction == std::ios_base::cur)
+            target = gptr() + offset;
+        else
+            target = egptr() + offset;
+        if(target < eback() || target > egptr())
+            return pos_type(off_type(-1));
+        setg(eback(), target, egptr());
+        return pos_type(off_type(target - eback()));
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which = std::ios_base::in)
+    {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+};
+
+#endif // MEMORYSTREAMBUFFER_H
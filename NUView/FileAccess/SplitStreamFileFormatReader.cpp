@@ -3,12 +3,14 @@
 
 SplitStreamFileFormatReader::SplitStreamFileFormatReader(QObject *parent): LogFileFormatReader(parent)
 {
+    m_prefetcher = NULL;
     setKnownDataTypes();
     m_fileGood = false;
 }
 
 SplitStreamFileFormatReader::SplitStreamFileFormatReader(const QString& filename, QObject *parent): LogFileFormatReader(parent)
 {
+    m_prefetcher = NULL;
     m_fileGood = false;
     setKnownDataTypes();
     openFile(filename);
@@ -164,6 +166,13 @@ int SplitStreamFileFormatReader::openFile(const QString& filename)
     if(m_totalFrames > 0)
     {
         m_fileGood = true;
+        std::vector<IndexedFileReader*> validReaders;
+        for(unsigned int i=0; i < m_fileReaders.size(); i++)
+        {
+            if(m_fileReaders[i]->IsValid())
+                validReaders.push_back(m_fileReaders[i]);
+        }
+        m_prefetcher = new LogPrefetcher(syncReader(), validReaders, StreamFileReader<NUImage>::PrefetchDepth);
         qDebug("Loading complete %d frames available.", m_totalFrames);
     }
     else
@@ -179,6 +188,9 @@ int SplitStreamFileFormatReader::openFile(const QString& filename)
 
 bool SplitStreamFileFormatReader::closeFile()
 {
+    // the prefetcher must be stopped before the streams it reads are closed
+    delete m_prefetcher;
+    m_prefetcher = NULL;
     m_totalFrames = 0;
     m_currentFrameIndex = 0;
     m_available_data.clear();
@@ -234,42 +246,54 @@ int SplitStreamFileFormatReader::lastFrame()
     return setFrame(m_totalFrames);
 }
 
+IndexedFileReader* SplitStreamFileFormatReader::syncReader()
+{
+    // Prefer the stream the user opened, otherwise the first open stream.
+    int primary = -1;
+    for(int i=0; i < m_knownDataTypes.size(); i++)
+    {
+        if(m_knownDataTypes[i].compare(m_primaryData, Qt::CaseInsensitive) == 0)
+            primary = i;
+    }
+    if(primary >= 0 && m_fileReaders[primary]->IsValid())
+        return m_fileReaders[primary];
+    for(unsigned int i=0; i < m_fileReaders.size(); i++)
+    {
+        if(m_fileReaders[i]->IsValid())
+            return m_fileReaders[i];
+    }
+    return NULL;
+}
+
 int SplitStreamFileFormatReader::setFrame(int frameNumber)
 {
     if(m_dataIsSynced)
     {
+        // The frame number selects a frame in the sync stream; every stream is then read at
+        // that frame's time, which is a binary search of each stream's index.
+        IndexedFileReader* sync = syncReader();
+        if(sync == NULL)
+            return m_currentFrameIndex;
+        double time = sync->TimeAtSequenceNumber(frameNumber);
+        if(time < 0.0)
+            return m_currentFrameIndex;
+
         if(imageReader.IsValid())
-        {
-            emit rawImageChanged(imageReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = imageReader.CurrentFrameSequenceNumber();
-        }
+            emit rawImageChanged(imageReader.ReadFrameAtTime(time));
         if(sensorReader.IsValid())
-        {
-            emit sensorDataChanged(sensorReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = sensorReader.CurrentFrameSequenceNumber();
-        }
+            emit sensorDataChanged(sensorReader.ReadFrameAtTime(time));
         if(locwmReader.IsValid())
-        {
-            emit LocalisationDataChanged(locwmReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = locwmReader.CurrentFrameSequenceNumber();
-        }
+            emit LocalisationDataChanged(locwmReader.ReadFrameAtTime(time));
         if(objectReader.IsValid())
-        {
-            emit ObjectDataChanged(objectReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = objectReader.CurrentFrameSequenceNumber();
-        }
+            emit ObjectDataChanged(objectReader.ReadFrameAtTime(time));
         if(teaminfoReader.IsValid())
-        {
-            emit TeamInfoChanged(teaminfoReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = teaminfoReader.CurrentFrameSequenceNumber();
-        }
+            emit TeamInfoChanged(teaminfoReader.ReadFrameAtTime(time));
         if(gameinfoReader.IsValid())
-        {
-            emit GameInfoChanged(gameinfoReader.ReadFrameNumber(frameNumber));
-            m_currentFrameIndex = gameinfoReader.CurrentFrameSequenceNumber();
-        }
+            emit GameInfoChanged(gameinfoReader.ReadFrameAtTime(time));
+        m_currentFrameIndex = frameNumber;
+        if(m_prefetcher)
+            m_prefetcher->setPosition(m_currentFrameIndex);
         //qDebug() << "Set Frame " << frameNumber << "at" << m_currentFrameIndex;
-        //m_currentFrameIndex = imageReader.CurrentFrameSequenceNumber();
         emit frameChanged(m_currentFrameIndex, m_totalFrames);
     }
     return m_currentFrameIndex;
@@ -2,6 +2,7 @@
 #define SPLITSTREAMFILEFORMATREADER_H
 #include "LogFileFormatReader.h"
 #include "StreamFileReader.h"
+#include "LogPrefetcher.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Localisation/Localisation.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
@@ -54,6 +55,7 @@ public slots:
 protected:
     std::vector<IndexedFileReader*> m_fileReaders;
     void setKnownDataTypes();
+    IndexedFileReader* syncReader();
     StreamFileReader<NUImage> imageReader;
     StreamFileReader<NUSensorsData> sensorReader;
     StreamFileReader<Localisation> locwmReader;
@@ -69,6 +71,7 @@ protected:
     bool m_dataIsSynced;
     QStringList m_available_data;
     std::vector<QFileInfo> m_open_files;
+    LogPrefetcher* m_prefetcher;
 };
 
 #endif // SPLITSTREAMFILEFORMATREADER_H
@@ -13,6 +13,11 @@
     Because it is a templated class, any timestamped data can be read from a stream file
     containing it. However any class used in the template must implement the abstract class
     TimestampedData found in the /Tools/FileFormats/ directory so as to access timestamps.
+    Files written as LogRecords are indexed from the record headers without parsing the data;
+    older files are indexed by parsing every entry.
+    When the file is memory mapped, frames can be decoded ahead of time by another thread (see
+    LogPrefetcher) into a small ring of buffers. Reading a prefetched frame swaps its buffer with
+    the data buffer, so it costs nothing on the reading thread.
 
     @author Steven Nicklin
 
@@ -39,17 +44,25 @@
 #include <cmath>
 #include "IndexedFileReader.h"
 #include "Tools/FileFormats/FileFormatException.h"
+#include "Tools/FileFormats/LogRecord.h"
+#include "MemoryStreamBuffer.h"
+#include <pthread.h>
+#include <vector>
 
 template<class C>
 class StreamFileReader: public IndexedFileReader
 {
 public:
+    static const unsigned int PrefetchDepth = 8;     //!< The number of frames that can be prefetched.
+
     /**
       *     Default constructor. Initialises the StreamFileReader.
+      *     @param prefetchDepth the number of frames that can be prefetched. Readers that are never prefetched should pass 0.
       */
-    StreamFileReader(): IndexedFileReader()
+    explicit StreamFileReader(unsigned int prefetchDepth = PrefetchDepth): IndexedFileReader()
     {
         m_dataBuffer = new C();
+        InitialisePrefetch(prefetchDepth);
     }
 
     /**
@@ -59,6 +72,7 @@ public:
     StreamFileReader(const std::string& filename): IndexedFileReader()
     {
         m_dataBuffer = new C();
+        InitialisePrefetch(PrefetchDepth);
         OpenFile(filename);
         m_selectedFrame = m_index.end();
     }
@@ -67,7 +81,11 @@ public:
       */
     ~StreamFileReader()
     {
+        CloseFile();
         delete m_dataBuffer;
+        for(unsigned int i = 0; i < m_prefetched.size(); i++)
+            delete m_prefetched[i].data;
+        pthread_mutex_destroy(&m_prefetchMutex);
     }
 
     /**
@@ -148,6 +166,89 @@ public:
         return ReadFrame(entry);
     }
 
+    /**
+      *     Decode the data that is most valid at the given time into a prefetch buffer. This is called
+      *     from the prefetch thread, and only reads the memory mapped file, never m_file or m_dataBuffer.
+      *     @param time The time in milliseconds of the data to prefetch.
+      *     @param centreTime The time of the current frame. The buffer furthest from this time is replaced.
+      *     @return True if the data is buffered. False if it could not be, or if every buffer holds data closer to the current frame.
+      */
+    bool PrefetchAtTime(double time, double centreTime)
+    {
+        if(m_mappedData == NULL)
+            return false;
+        IndexIterator entry = GetIndexFromTime(time);
+        if(!ValidEntry(entry))
+            return false;
+        const unsigned int sequence = (*entry).second.frameSequenceNumber;
+        const double entryTime = (*entry).first;
+        const double distance = fabs(entryTime - centreTime);
+
+        pthread_mutex_lock(&m_prefetchMutex);
+        int empty = -1;
+        int furthest = -1;
+        double furthestDistance = -1.0;
+        for(unsigned int i = 0; i < m_prefetched.size(); i++)
+        {
+            PrefetchSlot& slot = m_prefetched[i];
+            if(slot.sequence == sequence)
+            {   // already buffered, or being buffered
+                pthread_mutex_unlock(&m_prefetchMutex);
+                return true;
+            }
+            if(slot.busy || slot.retired)
+                continue;
+            if(slot.sequence == 0)
+            {
+                if(empty < 0)
+                    empty = i;
+                continue;
+            }
+            double slotDistance = fabs(slot.time - centreTime);
+            if(slotDistance > furthestDistance)
+            {
+                furthest = i;
+                furthestDistance = slotDistance;
+            }
+        }
+        int victim = empty;
+        if(victim < 0 && furthestDistance > distance)
+            victim = furthest;
+        if(victim < 0)
+        {   // every buffer holds a frame at least as close to the current frame
+            pthread_mutex_unlock(&m_prefetchMutex);
+            return false;
+        }
+        PrefetchSlot& slot = m_prefetched[victim];
+        slot.busy = true;
+        slot.sequence = sequence;
+        slot.time = entryTime;
+        pthread_mutex_unlock(&m_prefetchMutex);
+
+        bool success = DecodeMapped((*entry).second.position, slot.data);
+
+        pthread_mutex_lock(&m_prefetchMutex);
+        slot.busy = false;
+        if(!success)
+            slot.sequence = 0;
+        pthread_mutex_unlock(&m_prefetchMutex);
+        return success;
+    }
+
+    /**
+      *     Discard every prefetched frame.
+      */
+    void ClearPrefetched()
+    {
+        pthread_mutex_lock(&m_prefetchMutex);
+        for(unsigned int i = 0; i < m_prefetched.size(); i++)
+        {
+            if(!m_prefetched[i].busy)
+                m_prefetched[i].sequence = 0;
+        }
+        pthread_mutex_unlock(&m_prefetchMutex);
+    }
+
 private:
     /**
       *     Read the data described by the given entry into the data buffer.
@@ -158,12 +259,25 @@ private:
     {
         if(ValidEntry(entry))
         {
+            if(TakePrefetched((*entry).second.frameSequenceNumber))
+            {
+                m_selectedFrame = entry;
+                return m_dataBuffer;
+            }
             Position startingLocation = (*entry).second.position;
-            if(m_file.is_open() && ValidStartingLocation(startingLocation))
+            if(m_mappedData != NULL)
+            {
+                if(DecodeMapped(startingLocation, m_dataBuffer))
+                {
+                    m_selectedFrame = entry;
+                    return m_dataBuffer;
+                }
+            }
+            else if(m_file.is_open() && ValidStartingLocation(startingLocation))
             {
                 m_file.seekg(startingLocation,std::ios_base::beg);
                 try{
-                    m_file >> (*m_dataBuffer);
+                    LogRecord::Read(m_file, *m_dataBuffer);
                     m_selectedFrame = entry;
                     return m_dataBuffer;
                 }   catch(...){}
@@ -195,7 +309,19 @@ private:
                 int pos = m_file.tellg();
                 //qDebug("Indexing Frame %d at %d", temp.frameSequenceNumber, pos);
                 temp.position = m_file.tellg();
-                try{
+                LogRecord::Header header;
+                bool isRecord = LogRecord::ReadHeader(m_file, header);
+                if(isRecord)
+                {   // skip over the record without parsing it
+                    Position recordEnd = temp.position + std::streamoff(LogRecord::HeaderSize + header.Length);
+                    if(recordEnd > m_fileEndLocation)
+                    {
+                        qDebug("Truncated record found at %d", pos);
+                        break;
+                    }
+                    m_file.seekg(recordEnd, std::ios_base::beg);
+                }
+                else try{
                     m_file >> (*m_dataBuffer);
                 }
                 catch(FileFormatException& e){
@@ -214,7 +340,10 @@ private:
                     return;
                 }
                 if(eofReached) break;
-                timestamp = (static_cast<TimestampedData*>(m_dataBuffer))->GetTimestamp();
+                if(isRecord)
+                    timestamp = header.Timestamp;
+                else
+                    timestamp = (static_cast<TimestampedData*>(m_dataBuffer))->GetTimestamp();
                 timestamp = floor(timestamp);
                 if(HasTime(timestamp))
                 {
@@ -230,8 +359,94 @@ private:
         }
     }
 
+    /**
+      *     Create the prefetch buffers.
+      *     @param depth the number of buffers; 0 turns prefetching off.
+      */
+    void InitialisePrefetch(unsigned int depth)
+    {
+        pthread_mutex_init(&m_prefetchMutex, NULL);
+        m_prefetched.resize(depth);
+        for(unsigned int i = 0; i < m_prefetched.size(); i++)
+        {
+            m_prefetched[i].data = new C();
+            m_prefetched[i].sequence = 0;
+            m_prefetched[i].time = 0.0;
+            m_prefetched[i].busy = false;
+            m_prefetched[i].retired = false;
+        }
+    }
+
+    /**
+      *     If the frame has been prefetched swap its buffer with the data buffer.
+      *
+      *     The previous data buffer may still be referenced by whoever was given the last frame, so
+      *     it is retired, and not reused for prefetching until the next frame is taken.
+      *     @param sequence The sequence number of the frame.
+      *     @return True if the frame was prefetched, and is now in the data buffer.
+      */
+    bool TakePrefetched(unsigned int sequence)
+    {
+        int found = -1;
+        pthread_mutex_lock(&m_prefetchMutex);
+        for(unsigned int i = 0; i < m_prefetched.size(); i++)
+        {
+            PrefetchSlot& slot = m_prefetched[i];
+            if(slot.sequence == sequence && !slot.busy && !slot.retired)
+                found = i;
+        }
+        if(found >= 0)
+        {
+            for(unsigned int i = 0; i < m_prefetched.size(); i++)
+                m_prefetched[i].retired = false;
+            PrefetchSlot& slot = m_prefetched[found];
+            C* temp = m_dataBuffer;
+            m_dataBuffer = slot.data;
+            slot.data = temp;
+            slot.sequence = 0;
+            slot.retired = true;
+        }
+        pthread_mutex_unlock(&m_prefetchMutex);
+        return found >= 0;
+    }
+
+    /**
+      *     Parse the data at a position in the memory mapped file.
+      *     @param startingLocation The position of the data in the file.
+      *     @param buffer The object into which the data is read.
+      *     @return True if the data was read. False if it could not be.
+      */
+    bool DecodeMapped(Position startingLocation, C* buffer)
+    {
+        std::streamoff offset = startingLocation;
+        if(offset < 0 || static_cast<unsigned long long>(offset) >= m_mappedSize)
+            return false;
+        MemoryStreamBuffer memory(m_mappedData, m_mappedSize);
+        std::istream input(&memory);
+        input.seekg(offset, std::ios_base::beg);
+        try{
+            LogRecord::Read(input, *buffer);
+            return true;
+        }   catch(...){}
+        return false;
+    }
+
+    /*!
+      @brief A buffer for a prefetched frame.
+      */
+    struct PrefetchSlot
+    {
+        C* data;                        //!< The decoded frame.
+        unsigned int sequence;          //!< The sequence number of the frame in data, 0 if empty.
+        double time;                    //!< The time of the frame in data.
+        bool busy;                      //!< True while the frame is being decoded.
+        bool retired;                   //!< True if data was the last frame given out, and may still be in use.
+    };
+
     // Member variables
     C* m_dataBuffer;                    //!< Pointer to data buffer used to store the objects read.
+    std::vector<PrefetchSlot> m_prefetched; //!< The prefetch buffers.
+    pthread_mutex_t m_prefetchMutex;    //!< Lock for the prefetch buffers.
 };
 
 #endif // STREAMFILEREADER_H
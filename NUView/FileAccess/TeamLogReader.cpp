@@ -0,0 +1,513 @@
+/*! @file TeamLogReader.cpp
+    @brief Implementation of the TeamLogReader class
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TeamLogReader.h"
+#include <QDebug>
+#include <QRegExp>
+#include <algorithm>
+#include <map>
+
+/**
+  *     Default constructor. No logs are open.
+  */
+TeamLogReader::TeamLogReader(): m_currentTime(0.0)
+{
+}
+
+/**
+  *     Destructor. Closes every robot's logs.
+  */
+TeamLogReader::~TeamLogReader()
+{
+    Close();
+}
+
+/**
+  *     Find and open the logs of every robot in a directory, and in its immediate subdirectories.
+  *     Files are matched by the names given by LogRecorder::GetLogPath, for instance 2_gameinfo.strm.
+  *     The cursor is placed at the start of the logs.
+  *     @param path The directory.
+  *     @return The number of robots found.
+  */
+unsigned int TeamLogReader::OpenDirectory(const QString& path)
+{
+    Close();
+    QDir directory(path);
+    if(!directory.exists())
+        return 0;
+
+    FindRobots(directory);
+    QStringList subdirectories = directory.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for(QStringList::const_iterator it = subdirectories.constBegin(); it != subdirectories.constEnd(); ++it)
+        FindRobots(QDir(directory.filePath(*it)));
+
+    qDebug("Team log: %d robot(s) found in %s", (int)m_robots.size(), qPrintable(path));
+    Seek(StartTime());
+    return m_robots.size();
+}
+
+/**
+  *     Close every robot's logs.
+  */
+void TeamLogReader::Close()
+{
+    ClearQueue();
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+        delete m_robots[i];
+    m_robots.clear();
+    m_currentTime = 0.0;
+}
+
+/**
+  *     Get the number of robots whose logs are open.
+  */
+unsigned int TeamLogReader::NumRobots() const
+{
+    return m_robots.size();
+}
+
+/**
+  *     Get a robot's player number.
+  *     @param robot The index of the robot.
+  *     @return The player number, or -1 if there is no such robot.
+  */
+int TeamLogReader::PlayerNumber(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return -1;
+    return m_robots[robot]->playerNumber;
+}
+
+/**
+  *     Get the directory containing a robot's logs.
+  *     @param robot The index of the robot.
+  */
+QString TeamLogReader::RobotDirectory(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return QString();
+    return m_robots[robot]->directory;
+}
+
+/**
+  *     Determine if a robot has a log of the given type.
+  *     @param robot The index of the robot.
+  *     @param type The stream.
+  */
+bool TeamLogReader::HasData(unsigned int robot, DataType type) const
+{
+    IndexedFileReader* reader = Reader(robot, type);
+    return reader != NULL && reader->IsValid();
+}
+
+/**
+  *     Estimate the time offset of every robot from the game controller packets in their game information.
+  *
+  *     Every robot receives each game controller packet at nearly the same time, so the first frame in
+  *     which a robot sees a new (half, secsRemaining) is a common event in every robot's log. The offset
+  *     of each robot relative to the reference is the median of the differences over the events both
+  *     saw; the median ignores events one robot missed because of a dropped packet.
+  *     The robot that saw the most events is the reference, and is given an offset of 0. Robots without
+  *     any events in common with the reference keep their current offset.
+  *     @return True if every robot was aligned.
+  */
+bool TeamLogReader::AlignToGameController()
+{
+    std::vector< std::map<int, double> > events(m_robots.size());
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        StreamFileReader<GameInformation>& reader = m_robots[i]->gameInfo;
+        int previous = -1;
+        for(unsigned int sequence = 1; sequence <= reader.TotalFrames(); sequence++)
+        {
+            double time = reader.TimeAtSequenceNumber(sequence);
+            const GameInformation* info = reader.ReadFrameAtTime(time);
+            if(info == NULL)
+                continue;
+            int key = (info->isFirstHalf() ? 0 : 10000) + info->secondsRemaining();
+            if(previous >= 0 && key != previous && events[i].find(key) == events[i].end())
+                events[i][key] = time;
+            previous = key;
+        }
+    }
+
+    unsigned int reference = 0;
+    for(unsigned int i = 1; i < events.size(); i++)
+    {
+        if(events[i].size() > events[reference].size())
+            reference = i;
+    }
+
+    bool aligned = !m_robots.empty();
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        std::vector<double> differences;
+        for(std::map<int, double>::const_iterator it = events[i].begin(); it != events[i].end(); ++it)
+        {
+            std::map<int, double>::const_iterator match = events[reference].find(it->first);
+            if(match != events[reference].end())
+                differences.push_back(it->second - match->second);
+        }
+        if(differences.empty())
+        {
+            qDebug("Team log: Unable to align player %d, no game controller events in common.", m_robots[i]->playerNumber);
+            aligned = false;
+            continue;
+        }
+        std::nth_element(differences.begin(), differences.begin() + differences.size()/2, differences.end());
+        m_robots[i]->offset = differences[differences.size()/2];
+        qDebug("Team log: Player %d offset %.0fms from %d events.", m_robots[i]->playerNumber, m_robots[i]->offset, (int)differences.size());
+    }
+
+    Seek(StartTime());
+    return aligned;
+}
+
+/**
+  *     Set a robot's time offset. The team time of the robot's data is its timestamp less the offset.
+  *     The cursor is placed at the start of the logs.
+  *     @param robot The index of the robot.
+  *     @param offset The robot's time at team time 0 (ms).
+  */
+void TeamLogReader::SetTimeOffset(unsigned int robot, double offset)
+{
+    if(robot >= m_robots.size())
+        return;
+    m_robots[robot]->offset = offset;
+    Seek(StartTime());
+}
+
+/**
+  *     Get a robot's time offset.
+  *     @param robot The index of the robot.
+  *     @return The robot's time at team time 0 (ms).
+  */
+double TeamLogReader::TimeOffset(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return 0.0;
+    return m_robots[robot]->offset;
+}
+
+/**
+  *     Gives the team time of the earliest frame in any stream.
+  *     @return The time in milliseconds, 0 if there are no frames.
+  */
+double TeamLogReader::StartTime()
+{
+    bool found = false;
+    double start = 0.0;
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        for(int type = 0; type < NumDataTypes; type++)
+        {
+            IndexedFileReader* reader = Reader(i, static_cast<DataType>(type));
+            if(!reader->IsValid())
+                continue;
+            double time = reader->StartTime() - m_robots[i]->offset;
+            if(!found || time < start)
+                start = time;
+            found = true;
+        }
+    }
+    return start;
+}
+
+/**
+  *     Gives the team time of the last frame in any stream.
+  *     @return The time in milliseconds, 0 if there are no frames.
+  */
+double TeamLogReader::EndTime()
+{
+    bool found = false;
+    double end = 0.0;
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        for(int type = 0; type < NumDataTypes; type++)
+        {
+            IndexedFileReader* reader = Reader(i, static_cast<DataType>(type));
+            if(!reader->IsValid())
+                continue;
+            double time = reader->EndTime() - m_robots[i]->offset;
+            if(!found || time > end)
+                end = time;
+            found = true;
+        }
+    }
+    return end;
+}
+
+/**
+  *     Gives the team time of the cursor.
+  *     @return The time in milliseconds.
+  */
+double TeamLogReader::CurrentTime() const
+{
+    return m_currentTime;
+}
+
+/**
+  *     Move the cursor to a time. Every robot's data is then the data that was valid at that time.
+  *     @param time The team time in milliseconds.
+  *     @return True if there is a frame after the cursor.
+  */
+bool TeamLogReader::Seek(double time)
+{
+    ClearQueue();
+    m_currentTime = time;
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        for(int t = 0; t < NumDataTypes; t++)
+        {
+            DataType type = static_cast<DataType>(t);
+            IndexedFileReader* reader = Reader(i, type);
+            if(!reader->IsValid())
+                continue;
+            unsigned int sequence = reader->SequenceNumberAtTime(time + m_robots[i]->offset);
+            ReadFrame(i, type, sequence);
+            QueueFrame(i, type, sequence + 1);
+        }
+    }
+    return !m_queue.empty();
+}
+
+/**
+  *     Move the cursor to the next frame in any stream, and read it.
+  *     @param event If not NULL, the frame that was read.
+  *     @return True if a frame was read, false at the end of the logs.
+  */
+bool TeamLogReader::Next(Event* event)
+{
+    while(!m_queue.empty())
+    {
+        Event next = m_queue.top();
+        m_queue.pop();
+        QueueFrame(next.robot, next.type, next.sequence + 1);
+        if(!ReadFrame(next.robot, next.type, next.sequence))
+            continue;
+        m_currentTime = std::max(m_currentTime, next.time);
+        if(event != NULL)
+            *event = next;
+        return true;
+    }
+    return false;
+}
+
+/**
+  *     Move the cursor forward to a time, reading every frame in between in time order.
+  *     @param time The team time in milliseconds. If this is before the cursor nothing is read.
+  *     @return The number of frames read.
+  */
+unsigned int TeamLogReader::StepTo(double time)
+{
+    unsigned int count = 0;
+    while(!m_queue.empty() && m_queue.top().time <= time)
+    {
+        if(Next())
+            count++;
+    }
+    m_currentTime = std::max(m_currentTime, time);
+    return count;
+}
+
+/**
+  *     Get a robot's team information at the cursor.
+  *     @param robot The index of the robot.
+  *     @return The team information, or NULL if there is none at or before the cursor.
+  */
+const TeamInformation* TeamLogReader::GetTeamInfo(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return NULL;
+    return m_robots[robot]->currentTeamInfo;
+}
+
+/**
+  *     Get a robot's game information at the cursor.
+  *     @param robot The index of the robot.
+  *     @return The game information, or NULL if there is none at or before the cursor.
+  */
+const GameInformation* TeamLogReader::GetGameInfo(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return NULL;
+    return m_robots[robot]->currentGameInfo;
+}
+
+/**
+  *     Get a robot's field objects at the cursor.
+  *     @param robot The index of the robot.
+  *     @return The field objects, or NULL if there are none at or before the cursor.
+  */
+const FieldObjects* TeamLogReader::GetObjectData(unsigned int robot) const
+{
+    if(robot >= m_robots.size())
+        return NULL;
+    return m_robots[robot]->currentObjects;
+}
+
+/**
+  *     Gives the name of a stream, as used in the log file names.
+  */
+QString TeamLogReader::DataTypeName(DataType type)
+{
+    switch(type)
+    {
+    case TeamInfoData:
+        return "teaminfo";
+    case GameInfoData:
+        return "gameinfo";
+    case ObjectData:
+        return "object";
+    default:
+        return QString();
+    }
+}
+
+/**
+  *     Open the logs, in a single directory, of every robot.
+  *     @param directory The directory.
+  */
+void TeamLogReader::FindRobots(const QDir& directory)
+{
+    QStringList files = directory.entryList(QStringList() << "*.strm", QDir::Files);
+    QRegExp rx("(\\d+)_([A-Za-z]+)\\.strm");
+    for(QStringList::const_iterator it = files.constBegin(); it != files.constEnd(); ++it)
+    {
+        if(!rx.exactMatch(*it))
+            continue;
+        int playerNumber = rx.cap(1).toInt();
+        QString name = rx.cap(2).toLower();
+        for(int t = 0; t < NumDataTypes; t++)
+        {
+            DataType type = static_cast<DataType>(t);
+            if(name != DataTypeName(type))
+                continue;
+            unsigned int robot = FindRobot(directory, playerNumber);
+            bool success = Reader(robot, type)->OpenFile(directory.filePath(*it).toStdString());
+            qDebug("Opening %s - %s", qPrintable(directory.filePath(*it)), success ? "Successful!" : "Failed!");
+        }
+    }
+}
+
+/**
+  *     Get a robot, adding it if it has not been seen before.
+  *     @param directory The directory containing the robot's logs.
+  *     @param playerNumber The robot's player number.
+  *     @return The index of the robot.
+  */
+unsigned int TeamLogReader::FindRobot(const QDir& directory, int playerNumber)
+{
+    QString path = directory.absolutePath();
+    for(unsigned int i = 0; i < m_robots.size(); i++)
+    {
+        if(m_robots[i]->playerNumber == playerNumber && m_robots[i]->directory == path)
+            return i;
+    }
+    Robot* robot = new Robot();
+    robot->playerNumber = playerNumber;
+    robot->directory = path;
+    robot->offset = 0.0;
+    robot->currentTeamInfo = NULL;
+    robot->currentGameInfo = NULL;
+    robot->currentObjects = NULL;
+    m_robots.push_back(robot);
+    return m_robots.size() - 1;
+}
+
+/**
+  *     Get the reader for one of a robot's streams.
+  *     @param robot The index of the robot.
+  *     @param type The stream.
+  *     @return The reader, or NULL if there is no such robot.
+  */
+IndexedFileReader* TeamLogReader::Reader(unsigned int robot, DataType type) const
+{
+    if(robot >= m_robots.size())
+        return NULL;
+    switch(type)
+    {
+    case TeamInfoData:
+        return &m_robots[robot]->teamInfo;
+    case GameInfoData:
+        return &m_robots[robot]->gameInfo;
+    case ObjectData:
+        return &m_robots[robot]->objects;
+    default:
+        return NULL;
+    }
+}
+
+/**
+  *     Read a frame of one of a robot's streams, making it the robot's data at the cursor.
+  *     @param robot The index of the robot.
+  *     @param type The stream.
+  *     @param sequence The sequence number of the frame, 0 for no data.
+  *     @return True if the frame was read.
+  */
+bool TeamLogReader::ReadFrame(unsigned int robot, DataType type, unsigned int sequence)
+{
+    Robot* r = m_robots[robot];
+    double time = Reader(robot, type)->TimeAtSequenceNumber(sequence);
+    bool found = sequence > 0 && time >= 0.0;
+    switch(type)
+    {
+    case TeamInfoData:
+        r->currentTeamInfo = found ? r->teamInfo.ReadFrameAtTime(time) : NULL;
+        return r->currentTeamInfo != NULL;
+    case GameInfoData:
+        r->currentGameInfo = found ? r->gameInfo.ReadFrameAtTime(time) : NULL;
+        return r->currentGameInfo != NULL;
+    case ObjectData:
+        r->currentObjects = found ? r->objects.ReadFrameAtTime(time) : NULL;
+        return r->currentObjects != NULL;
+    default:
+        return false;
+    }
+}
+
+/**
+  *     Add a frame of one of a robot's streams to the merge.
+  *     @param robot The index of the robot.
+  *     @param type The stream.
+  *     @param sequence The sequence number of the frame. Nothing is added if it is past the end of the stream.
+  */
+void TeamLogReader::QueueFrame(unsigned int robot, DataType type, unsigned int sequence)
+{
+    double time = Reader(robot, type)->TimeAtSequenceNumber(sequence);
+    if(time < 0.0)
+        return;
+    Event event;
+    event.time = time - m_robots[robot]->offset;
+    event.robot = robot;
+    event.type = type;
+    event.sequence = sequence;
+    m_queue.push(event);
+}
+
+/**
+  *     Empty the merge.
+  */
+void TeamLogReader::ClearQueue()
+{
+    while(!m_queue.empty())
+        m_queue.pop();
+}
@@ -0,0 +1,151 @@
+/*! @file TeamLogReader.h
+    @brief Declaration of the TeamLogReader class
+
+    @class TeamLogReader
+    @brief Replays the logs of a whole team against a single time cursor.
+
+    Each robot writes its own <player>_<type>.strm files (see LogRecorder::GetLogPath). The team
+    log reader finds the team information, game information and field object streams of every robot
+    in a directory, and in its immediate subdirectories, and merges them by timestamp.
+
+    The merge is a k-way merge over the streams' indices: a heap holds the time of the next frame in
+    every stream, so stepping the cursor only reads the one frame that comes next. Nothing is loaded
+    ahead of the cursor, so a whole match can be replayed without holding it in memory.
+
+    The robots' clocks are not synchronised; each starts when the robot's program starts. The reader
+    keeps a time offset for each robot, so that the team time is the robot's time less its offset.
+    AlignToGameController() estimates the offsets from the game controller's secsRemaining, which every
+    robot receives at close to the same instant; the offsets can also be set by hand.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEAMLOGREADER_H
+#define TEAMLOGREADER_H
+#include "StreamFileReader.h"
+#include "Infrastructure/GameInformation/GameInformation.h"
+#include "Infrastructure/TeamInformation/TeamInformation.h"
+#include "Infrastructure/FieldObjects/FieldObjects.h"
+#include <QDir>
+#include <QString>
+#include <queue>
+#include <vector>
+
+class TeamLogReader
+{
+public:
+    /*!
+      @brief The streams replayed for each robot.
+      */
+    enum DataType
+    {
+        TeamInfoData,
+        GameInfoData,
+        ObjectData,
+        NumDataTypes
+    };
+
+    /*!
+      @brief A frame of one of the streams.
+      */
+    struct Event
+    {
+        double time;                //!< The team time of the frame (ms).
+        unsigned int robot;         //!< The index of the robot.
+        DataType type;              //!< The stream.
+        unsigned int sequence;      //!< The sequence number of the frame in the stream.
+    };
+
+    TeamLogReader();
+    ~TeamLogReader();
+
+    unsigned int OpenDirectory(const QString& path);
+    void Close();
+
+    unsigned int NumRobots() const;
+    int PlayerNumber(unsigned int robot) const;
+    QString RobotDirectory(unsigned int robot) const;
+    bool HasData(unsigned int robot, DataType type) const;
+
+    bool AlignToGameController();
+    void SetTimeOffset(unsigned int robot, double offset);
+    double TimeOffset(unsigned int robot) const;
+
+    double StartTime();
+    double EndTime();
+    double CurrentTime() const;
+
+    bool Seek(double time);
+    bool Next(Event* event = NULL);
+    unsigned int StepTo(double time);
+
+    const TeamInformation* GetTeamInfo(unsigned int robot) const;
+    const GameInformation* GetGameInfo(unsigned int robot) const;
+    const FieldObjects* GetObjectData(unsigned int robot) const;
+
+    static QString DataTypeName(DataType type);
+
+private:
+    /*!
+      @brief The streams of one robot, and the data from each at the cursor.
+      */
+    struct Robot
+    {
+        /*! @brief The streams are only read at the cursor, so they are not given prefetch buffers. */
+        Robot(): teamInfo(0), gameInfo(0), objects(0) {}
+
+        int playerNumber;                               //!< The robot's player number, from the file names.
+        QString directory;                              //!< The directory containing the robot's files.
+        double offset;                                  //!< The robot's time at team time 0 (ms).
+        StreamFileReader<TeamInformation> teamInfo;
+        StreamFileReader<GameInformation> gameInfo;
+        StreamFileReader<FieldObjects> objects;
+        const TeamInformation* currentTeamInfo;         //!< The team information at the cursor, NULL if there is none.
+        const GameInformation* currentGameInfo;         //!< The game information at the cursor, NULL if there is none.
+        const FieldObjects* currentObjects;             //!< The field objects at the cursor, NULL if there are none.
+    };
+
+    /*!
+      @brief Orders events so that the earliest is at the top of the heap.
+      */
+    struct LaterEvent
+    {
+        bool operator()(const Event& a, const Event& b) const
+        {
+            if(a.time != b.time)
+                return a.time > b.time;
+            if(a.robot != b.robot)
+                return a.robot > b.robot;
+            return a.type > b.type;
+        }
+    };
+    typedef std::priority_queue<Event, std::vector<Event>, LaterEvent> EventQueue;
+
+    void FindRobots(const QDir& directory);
+    unsigned int FindRobot(const QDir& directory, int playerNumber);
+    IndexedFileReader* Reader(unsigned int robot, DataType type) const;
+    bool ReadFrame(unsigned int robot, DataType type, unsigned int sequence);
+    void QueueFrame(unsigned int robot, DataType type, unsigned int sequence);
+    void ClearQueue();
+
+    std::vector<Robot*> m_robots;   //!< The robots found.
+    EventQueue m_queue;             //!< The next frame in every stream, earliest first.
+    double m_currentTime;           //!< The team time of the cursor (ms).
+};
+
+#endif // TEAMLOGREADER_H
@@ -56,6 +56,7 @@ HEADERS += ui_mainwindow.h \
     GLDisplay.h \
     ../Infrastructure/NUImage/NUImage.h \
     ../Infrastructure/NUImage/ClassifiedImage.h \
+    ../Infrastructure/NUImage/ImageStreamCodec.h \
     ../Vision/ClassifiedSection.h \
     ../Vision/ScanLine.h \
     ../Vision/TransitionSegment.h \
@@ -71,6 +72,7 @@ HEADERS += ui_mainwindow.h \
     ../Infrastructure/FieldObjects/MobileObject.h \
     ../Infrastructure/FieldObjects/AmbiguousObject.h \
     ../Infrastructure/FieldObjects/FieldObjects.h \
+    ../Infrastructure/FieldObjects/ObstacleGrid.h \
     ../Vision/Threads/SaveImagesThread.h \
     ../Vision/ObjectCandidate.h \
     ../Localisation/WMPoint.h \
@@ -82,6 +84,11 @@ HEADERS += ui_mainwindow.h \
     localisationwidget.h \
     ../Vision/Ball.h \
     ../Vision/CircleFitting.h \
+    ../Vision/EdgeDetection.h \
+    ../Vision/ScanInterestMap.h \
+    ../Vision/BallTracker.h \
+    ../Vision/GoalPostTracker.h \
+    ../Vision/CameraProjection.h \
     FileAccess/LogFileFormatReader.h \
     FileAccess/nifVersion1FormatReader.h \
     FileAccess/LogFileReader.h \
@@ -92,15 +99,19 @@ HEADERS += ui_mainwindow.h \
     ../Tools/FileFormats/Parse.h \
     ../Localisation/KF.h \
     ../Localisation/Localisation.h \
+    ../Localisation/FieldLineMatcher.h \
     ../Infrastructure/FieldObjects/WorldModelShareObject.h \
     ../Infrastructure/GameInformation/GameInformation.h \
     ../Tools/Threading/Thread.h \
     ../Tools/Threading/ConditionalThread.h \
     ../Tools/Threading/PeriodicThread.h \
+    ../Tools/Threading/QueueThread.h \
+    ../Tools/Threading/LockFreeQueue.h \
     NUViewIO/NUViewIO.h \
     ../Kinematics/Kinematics.h \
     ../Tools/Math/TransformMatrices.h \
     frameInformationWidget.h \
+    TeamLogWidget.h \
     ../Tools/Math/UKF.h \
     ../Tools/Math/SRUKF.h \
     ../Kinematics/Link.h \
@@ -156,6 +167,9 @@ HEADERS += ui_mainwindow.h \
     ../Vision/fitellipsethroughcircle.h \
     ../Localisation/LocWmFrame.h \
     FileAccess/IndexedFileReader.h \
+    FileAccess/MemoryStreamBuffer.h \
+    FileAccess/LogPrefetcher.h \
+    FileAccess/TeamLogReader.h \
     LUTGlDisplay.h \
     ../Vision/SplitAndMerge/SAM.h \
     ../NUPlatform/NUSensors/EndEffectorTouch.h \
@@ -176,6 +190,9 @@ HEADERS += ui_mainwindow.h \
     GameInformationDisplayWidget.h \
     ../Infrastructure/TeamInformation/TeamInformation.h \
     ../Tools/FileFormats/LogRecorder.h \
+    ../Tools/FileFormats/LogRecord.h \
+    ../Tools/FileFormats/LogIndex.h \
+    ../Tools/FileFormats/LogWriterThread.h \
     ../Tools/FileFormats/FileFormatException.h \
     offlinelocalisationdialog.h
 
@@ -203,6 +220,7 @@ SOURCES += mainwindow.cpp \
     GLDisplay.cpp \
     ../Infrastructure/NUImage/NUImage.cpp \
     ../Infrastructure/NUImage/ClassifiedImage.cpp \
+    ../Infrastructure/NUImage/ImageStreamCodec.cpp \
     ../Vision/ClassifiedSection.cpp \
     ../Vision/ScanLine.cpp \
     ../Vision/TransitionSegment.cpp \
@@ -235,6 +253,7 @@ SOURCES += mainwindow.cpp \
     ../Infrastructure/FieldObjects/MobileObject.cpp \
     ../Infrastructure/FieldObjects/AmbiguousObject.cpp \
     ../Infrastructure/FieldObjects/FieldObjects.cpp \
+    ../Infrastructure/FieldObjects/ObstacleGrid.cpp \
     ../Vision/Threads/SaveImagesThread.cpp \
     ../Localisation/WMPoint.cpp \
     ../Localisation/WMLine.cpp \
@@ -245,6 +264,11 @@ SOURCES += mainwindow.cpp \
     localisationwidget.cpp \
     ../Vision/Ball.cpp \
     ../Vision/CircleFitting.cpp \
+    ../Vision/EdgeDetection.cpp \
+    ../Vision/ScanInterestMap.cpp \
+    ../Vision/BallTracker.cpp \
+    ../Vision/GoalPostTracker.cpp \
+    ../Vision/CameraProjection.cpp \
     FileAccess/LogFileFormatReader.cpp \
     FileAccess/nifVersion1FormatReader.cpp \
     FileAccess/LogFileReader.cpp \
@@ -255,6 +279,7 @@ SOURCES += mainwindow.cpp \
     ../Tools/FileFormats/Parse.cpp \
     ../Localisation/KF.cpp \
     ../Localisation/Localisation.cpp \
+    ../Localisation/FieldLineMatcher.cpp \
     ../Infrastructure/FieldObjects/WorldModelShareObject.cpp \
     ../Infrastructure/GameInformation/GameInformation.cpp \
     ../Tools/Threading/Thread.cpp \
@@ -263,6 +288,7 @@ SOURCES += mainwindow.cpp \
     ../Kinematics/Kinematics.cpp \
     ../Tools/Math/TransformMatrices.cpp \
     frameInformationWidget.cpp \
+    TeamLogWidget.cpp \
     ../Tools/Math/UKF.cpp \
     ../Tools/Math/SRUKF.cpp \
     ../Kinematics/Link.cpp \
@@ -282,6 +308,8 @@ SOURCES += mainwindow.cpp \
     ../Vision/fitellipsethroughcircle.cpp \
     ../Localisation/LocWmFrame.cpp \
     FileAccess/IndexedFileReader.cpp \
+    FileAccess/LogPrefetcher.cpp \
+    FileAccess/TeamLogReader.cpp \
     LUTGlDisplay.cpp \
     ../Vision/SplitAndMerge/SAM.cpp \
     ../NUPlatform/NUSensors/EndEffectorTouch.cpp \
@@ -299,6 +327,9 @@ SOURCES += mainwindow.cpp \
     TeamInformationDisplayWidget.cpp \
     GameInformationDisplayWidget.cpp \
     ../Tools/FileFormats/LogRecorder.cpp \
+    ../Tools/FileFormats/LogRecord.cpp \
+    ../Tools/FileFormats/LogIndex.cpp \
+    ../Tools/FileFormats/LogWriterThread.cpp \
     offlinelocalisationdialog.cpp
 
 !win32{
@@ -0,0 +1,116 @@
+/*! @file TeamLogWidget.cpp
+    @brief Implementation of the TeamLogWidget class
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TeamLogWidget.h"
+#include <QLabel>
+#include <QSlider>
+#include <QString>
+#include <QTextBrowser>
+#include <QVBoxLayout>
+
+TeamLogWidget::TeamLogWidget(QWidget *parent) :
+    QWidget(parent)
+{
+    setWindowTitle(tr("Team Log"));
+    setObjectName(tr("Team Log"));
+    m_widgetLayout = new QVBoxLayout();
+
+    m_timeLabel = new QLabel(tr("No team logs open"));
+
+    m_timeSlider = new QSlider(Qt::Horizontal);
+    m_timeSlider->setRange(0, 0);
+    m_timeSlider->setSingleStep(100);
+    m_timeSlider->setPageStep(10000);
+    m_timeSlider->setEnabled(false);
+    connect(m_timeSlider, SIGNAL(valueChanged(int)), this, SLOT(setTime(int)));
+
+    m_display = new QTextBrowser();
+
+    m_widgetLayout->addWidget(m_timeLabel);
+    m_widgetLayout->addWidget(m_timeSlider);
+    m_widgetLayout->addWidget(m_display);
+    setLayout(m_widgetLayout);
+}
+
+TeamLogWidget::~TeamLogWidget()
+{
+    delete m_widgetLayout;
+}
+
+/*! @brief Opens the team logs in a directory, and aligns the robots' clocks to the game controller.
+    @param path The directory.
+    @return The number of robots found.
+ */
+unsigned int TeamLogWidget::openDirectory(const QString& path)
+{
+    m_reader.Close();
+    unsigned int robots = m_reader.OpenDirectory(path);
+    if(robots > 1)
+        m_reader.AlignToGameController();
+
+    m_timeSlider->blockSignals(true);
+    m_timeSlider->setRange(0, static_cast<int>(m_reader.EndTime() - m_reader.StartTime()));
+    m_timeSlider->setValue(0);
+    m_timeSlider->blockSignals(false);
+    m_timeSlider->setEnabled(robots > 0);
+    updateDisplay();
+    return robots;
+}
+
+/*! @brief Moves the cursor, stepping forward through the merged logs when it can rather than seeking.
+    @param time The time in milliseconds from the start of the logs.
+ */
+void TeamLogWidget::setTime(int time)
+{
+    double teamTime = m_reader.StartTime() + time;
+    if(teamTime >= m_reader.CurrentTime())
+        m_reader.StepTo(teamTime);
+    else
+        m_reader.Seek(teamTime);
+    updateDisplay();
+}
+
+void TeamLogWidget::updateDisplay()
+{
+    if(m_reader.NumRobots() == 0)
+    {
+        m_timeLabel->setText(tr("No team logs open"));
+        m_display->clear();
+        return;
+    }
+    QString timeMessage(tr("%1 of %2 seconds, %3 robot(s)"));
+    double start = m_reader.StartTime();
+    m_timeLabel->setText(timeMessage.arg((m_reader.CurrentTime() - start)/1000.0, 0, 'f', 1).arg((m_reader.EndTime() - start)/1000.0, 0, 'f', 1).arg(m_reader.NumRobots()));
+
+    QString text;
+    for(unsigned int robot = 0; robot < m_reader.NumRobots(); robot++)
+    {
+        text += tr("Player %1 (%2)\n").arg(m_reader.PlayerNumber(robot)).arg(m_reader.RobotDirectory(robot));
+        if(const TeamInformation* teamInfo = m_reader.GetTeamInfo(robot))
+            text += QString::fromStdString(teamInfo->toString());
+        if(const GameInformation* gameInfo = m_reader.GetGameInfo(robot))
+            text += QString::fromStdString(gameInfo->toString());
+        if(const FieldObjects* objects = m_reader.GetObjectData(robot))
+            text += QString::fromStdString(objects->toString(true));
+        text += "\n";
+    }
+    m_display->setPlainText(text);
+}
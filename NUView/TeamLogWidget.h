@@ -0,0 +1,62 @@
+/*! @file TeamLogWidget.h
+    @brief Declaration of the TeamLogWidget class
+
+    @class TeamLogWidget
+    @brief Replays the logs of a whole team side by side.
+
+    The widget opens a directory of team logs with a TeamLogReader, aligns the robots' clocks to the
+    game controller, and shows the team information, game information and field objects of every
+    robot at the time selected with the slider.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEAMLOGWIDGET_H
+#define TEAMLOGWIDGET_H
+
+#include <QWidget>
+#include "FileAccess/TeamLogReader.h"
+
+class QLabel;
+class QSlider;
+class QTextBrowser;
+class QVBoxLayout;
+
+class TeamLogWidget : public QWidget
+{
+Q_OBJECT
+public:
+    explicit TeamLogWidget(QWidget *parent = 0);
+    ~TeamLogWidget();
+
+signals:
+
+public slots:
+    unsigned int openDirectory(const QString& path);
+    void setTime(int time);
+private:
+    void updateDisplay();
+
+    TeamLogReader m_reader;             //!< The reader of the open team logs.
+    QLabel* m_timeLabel;                //!< Shows the team time of the cursor.
+    QSlider* m_timeSlider;              //!< Selects the team time, in milliseconds from the start of the logs.
+    QTextBrowser* m_display;            //!< Shows every robot's data at the cursor.
+    QVBoxLayout* m_widgetLayout;
+};
+
+#endif // TEAMLOGWIDGET_H
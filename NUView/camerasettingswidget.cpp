@@ -155,6 +155,7 @@ void cameraSettingsWidget::createWidgets()  //!< Create all of the child widgets
     StartSavingImagesButton = new QPushButton("Start Saving Images");
     StopSavingImagesButton = new QPushButton("Stop Saving Images");
     StartSavingImagesWithSettingsCheckBox = new QCheckBox("Vary Camera Settings");
+    StartSavingImagesPreTriggerCheckBox = new QCheckBox("Only Save Falls and Goals");
 
     TopCameraSelected = new QCheckBox("Top Camera");
     TopCameraSelected->setChecked(false);
@@ -250,6 +251,7 @@ void cameraSettingsWidget::createLayout()   //!< Layout all of the child widgets
     saveImagesButtonLayout->addWidget(StartSavingImagesButton);
     saveImagesButtonLayout->addWidget(StopSavingImagesButton);
     saveImagesButtonLayout->addWidget(StartSavingImagesWithSettingsCheckBox);
+    saveImagesButtonLayout->addWidget(StartSavingImagesPreTriggerCheckBox);
 
     overallLayout = new QVBoxLayout();                 //!< Overall widget layout.
     //overallLayout->addLayout(shiftGainLayout);
@@ -271,6 +273,7 @@ void cameraSettingsWidget::createLayout()   //!< Layout all of the child widgets
     overallLayout->addWidget(StartSavingImagesButton);
     overallLayout->addWidget(StopSavingImagesButton);
     overallLayout->addWidget(StartSavingImagesWithSettingsCheckBox);
+    overallLayout->addWidget(StartSavingImagesPreTriggerCheckBox);
     //overallLayout->addLayout(pushButtonLayout);
     //overallLayout->addLayout(saveImagesButtonLayout);
 
@@ -517,7 +520,7 @@ void cameraSettingsWidget::readPendingData()
 
      //(*nuio) >> m_job_list;
 
-        static list<Job*>::iterator it;     // the iterator over the motion jobs
+        static IntrusiveJobList::iterator it;     // the iterator over the motion jobs
         for (it = Blackboard->Jobs->camera_begin(); it !=Blackboard->Jobs->camera_end(); ++it)
         {
             qDebug()  << "CameraSettings - Processing Recieved Job" << endl;
@@ -598,7 +601,7 @@ void cameraSettingsWidget::stopStreamCameraSetting()
 
 void cameraSettingsWidget::sendStartSavingImagesJob()
 {
-    SaveImagesJob* saveimagesjob = new SaveImagesJob(true, StartSavingImagesWithSettingsCheckBox->isChecked());
+    SaveImagesJob* saveimagesjob = new SaveImagesJob(true, StartSavingImagesWithSettingsCheckBox->isChecked(), StartSavingImagesPreTriggerCheckBox->isChecked());
     m_job_list->addVisionJob(saveimagesjob);
     m_job_list->summaryTo(debug);
 
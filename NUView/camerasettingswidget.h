@@ -135,6 +135,7 @@ private:
     QPushButton* StartSavingImagesButton;
     QPushButton* StopSavingImagesButton;
     QCheckBox* StartSavingImagesWithSettingsCheckBox;
+    QCheckBox* StartSavingImagesPreTriggerCheckBox;
 
 
     int datasize;
@@ -108,6 +108,14 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     locInfoDock->setShown(false);
     addDockWidget(Qt::RightDockWidgetArea,locInfoDock);
 
+    // Team log display
+    teamLog = new TeamLogWidget(this);
+    teamLogDock = new QDockWidget("Team Log");
+    teamLogDock->setObjectName("Team Log");
+    teamLogDock->setWidget(teamLog);
+    teamLogDock->setShown(false);
+    addDockWidget(Qt::RightDockWidgetArea,teamLogDock);
+
     // Add localisation widget
     localisation = new LocalisationWidget(this);
     addDockWidget(Qt::BottomDockWidgetArea,localisation);
@@ -189,6 +197,7 @@ MainWindow::~MainWindow()
 
 // Delete Actions
     delete openAction;
+    delete openTeamLogsAction;
     delete copyAction;
     delete undoAction;
     delete exitAction;
@@ -218,6 +227,11 @@ void MainWindow::createActions()
     openAction->setStatusTip(tr("Open a new file"));
     connect(openAction, SIGNAL(triggered()), this, SLOT(openLog()));
 
+    // Open Team Logs Action
+    openTeamLogsAction = new QAction(QIcon(":/icons/open.png"),tr("Open &Team Logs..."), this);
+    openTeamLogsAction->setStatusTip(tr("Open the logs of every robot in a team"));
+    connect(openTeamLogsAction, SIGNAL(triggered()), this, SLOT(openTeamLogs()));
+
     // Copy Action
     copyAction = new QAction(QIcon(":/icons/copy.png"),tr("&Copy"), this);
     copyAction->setShortcut(QKeySequence::Copy);
@@ -326,6 +340,7 @@ void MainWindow::createMenus()
     // File Menu
     fileMenu = menuBar()->addMenu(tr("&File"));
     fileMenu->addAction(openAction);
+    fileMenu->addAction(openTeamLogsAction);
     fileMenu->addAction(LUT_Action);
     fileMenu->addSeparator();
     fileMenu->addAction(exitAction);
@@ -437,6 +452,7 @@ void MainWindow::createConnections()
     connect(VisionStreamer,SIGNAL(rawImageChanged(const NUImage*)), this, SLOT(updateSelection()));
     connect(VisionStreamer,SIGNAL(rawImageChanged(const NUImage*)),&virtualRobot, SLOT(setRawImage(const NUImage*)));
     connect(VisionStreamer,SIGNAL(rawImageChanged(const NUImage*)),&virtualRobot, SLOT(processVisionFrame()));
+    connect(VisionStreamer,SIGNAL(classifiedDisplayChanged(ClassifiedImage*, GLDisplay::display)),&glManager, SLOT(writeClassImageToDisplay(ClassifiedImage*, GLDisplay::display)));
     connect(VisionStreamer,SIGNAL(sensorsDataChanged(NUSensorsData*)),&virtualRobot, SLOT(setSensorData(NUSensorsData*)));
     connect(VisionStreamer,SIGNAL(sensorsDataChanged(NUSensorsData*)),sensorDisplay, SLOT(SetSensorData(NUSensorsData*)));
     // Setup navigation control enabling/disabling
@@ -504,6 +520,16 @@ void MainWindow::openLog()
 
 }
 
+void MainWindow::openTeamLogs()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Open Team Logs"), ".");
+    if (!directory.isEmpty()){
+        unsigned int robots = teamLog->openDirectory(directory);
+        teamLogDock->setShown(true);
+        statusBar->showMessage(tr("Opened the logs of %1 robot(s) in %2").arg(robots).arg(directory), 10000);
+    }
+}
+
 void MainWindow::openLog(const QString& fileName)
 {
     if (!fileName.isEmpty()){
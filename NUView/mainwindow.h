@@ -19,6 +19,7 @@
 #include "ObjectDisplayWidget.h"
 #include "GameInformationDisplayWidget.h"
 #include "TeamInformationDisplayWidget.h"
+#include "TeamLogWidget.h"
 #include <QHostInfo>
 
 class QMdiArea;
@@ -67,6 +68,7 @@ public:
 public slots:
     void openLog();                    //!< To open a file
     void openLog(const QString& fileName); //!< To open a log file
+    void openTeamLogs();               //!< To open a directory of team logs
     void copy();                    //!< To copy the contents of the selected display to file.
     void openLUT();                 //!< To open a LUT file
     void selectFrame();             //!< Takes you to a selected frame
@@ -154,6 +156,8 @@ private:
     GameInformationDisplayWidget* gameInfoDisplay;
     TeamInformationDisplayWidget* teamInfoDisplay;
     QTextBrowser* locInfoDisplay;
+    TeamLogWidget* teamLog;
+    QDockWidget* teamLogDock;
     //QDockWidget* walkParameterDock;
 
     QStatusBar* statusBar;          //!< Instance of the status bar.
@@ -181,6 +185,7 @@ private:
 
 
     QAction *openAction;            //!< Instance of the open action
+    QAction *openTeamLogsAction;    //!< Instance of the open team logs action
     QAction *copyAction;            //!< Instance of the copy action
     QAction *undoAction;            //!< Instance of the undo action
     QAction *LUT_Action;            //!< Instance of the open action
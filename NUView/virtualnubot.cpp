@@ -240,15 +240,21 @@ void virtualNUbot::processVisionFrame(const NUImage* image)
     std::vector< Vector2<int> > interpolatedBoarderPoints = vision.interpolateBorders(boarderPoints,spacings);
     emit pointsDisplayChanged(interpolatedBoarderPoints,GLDisplay::greenHorizonPoints);
     //qDebug() << "Find Field border: finnished";
-    //! Scan Below Horizon Image
-    ClassifiedSection vertScanArea = vision.verticalScan(interpolatedBoarderPoints,spacings);
     //! Scan Above the Horizon
     ClassifiedSection horiScanArea = vision.horizontalScan(interpolatedBoarderPoints,spacings);
-    //qDebug() << "Generate Scanlines: finnished";
-    //! Classify Line Segments
-
-    vision.ClassifyScanArea(&vertScanArea);
     vision.ClassifyScanArea(&horiScanArea);
+    //! Scan Below Horizon Image
+    ClassifiedSection vertScanArea;
+    if(vision.getScanMethod() == Vision::COARSE_TO_FINE)
+    {
+        vertScanArea = vision.verticalScanCoarseToFine(interpolatedBoarderPoints,spacings,&horizonLine);
+    }
+    else
+    {
+        vertScanArea = vision.verticalScan(interpolatedBoarderPoints,spacings);
+        vision.ClassifyScanArea(&vertScanArea);
+    }
+    //qDebug() << "Generate and Classify Scanlines: finnished";
     //qDebug() << "Classify Scanlines: finnished";
 
 
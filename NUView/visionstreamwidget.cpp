@@ -3,6 +3,7 @@
 #include <QLineEdit>
 #include <QHBoxLayout>
 #include <QPushButton>
+#include <QComboBox>
 #include <QPainter>
 #include <QImage>
 #include <cstring>
@@ -50,11 +51,21 @@ visionStreamWidget::visionStreamWidget(QMdiArea* parentMdiWidget, QWidget *paren
     selectLayout4->addWidget(frameRateLabel,2);
     selectLayout4->addWidget(frameRateMessageLabel,1);
 
+    encodingLabel = new QLabel("Encoding: ");
+    encodingComboBox = new QComboBox();
+    for (int i = 0; i < ImageStreamCodec::NumEncodings; i++)
+        encodingComboBox->addItem(QString(ImageStreamCodec::getName(i).c_str()));
+    selectLayout5 = new QHBoxLayout;
+    selectLayout5->setAlignment(Qt::AlignTop);
+    selectLayout5->addWidget(encodingLabel);
+    selectLayout5->addWidget(encodingComboBox,2);
+
     //selectLayout2->addWidget(disconnectButton,1);
     layout->addLayout(selectLayout1);
     layout->addLayout(selectLayout2);
     layout->addLayout(selectLayout3);
     layout->addLayout(selectLayout4);
+    layout->addLayout(selectLayout5);
     layout->setAlignment(Qt::AlignLeft);
     //window = new QWidget;
     setLayout(layout);
@@ -63,6 +74,10 @@ visionStreamWidget::visionStreamWidget(QMdiArea* parentMdiWidget, QWidget *paren
     disconnectButton->setEnabled(false);
     connectButton->setEnabled(false);
 
+    datasize = 0;
+    headerSize = 0;
+    streamEncoding = -1;
+
     tcpSocket = new QTcpSocket(this);
     tcpSocket->setReadBufferSize(0);
     connect(tcpSocket,SIGNAL(readyRead()),this, SLOT(readPendingData()));
@@ -128,8 +143,16 @@ void visionStreamWidget::connectToRobot()
 
 void visionStreamWidget::sendDataToRobot()
 {
-    const char* data = "1";
-    if(tcpSocket->write(data) == -1)
+    // "1" asks for the original raw frame, so that Raw still works with robots that do not know about the encodings
+    int encoding = encodingComboBox->currentIndex();
+    std::string data("1");
+    streamEncoding = -1;
+    if (encoding > ImageStreamCodec::Raw and encoding < ImageStreamCodec::NumEncodings)
+    {
+        data = ImageStreamCodec::makeRequest(static_cast<ImageStreamCodec::Encoding>(encoding), decoder.getReference());
+        streamEncoding = encoding;
+    }
+    if(tcpSocket->write(data.c_str(), data.size()) == -1)
     {
         statusNetworkLabel->setText("Disconnect Error: Unable to send packet.");
         disconnectButton->setEnabled(false);
@@ -175,71 +198,87 @@ void visionStreamWidget::readPendingData()
     {
         timeToRecievePacket = QTime();
         timeToRecievePacket.start();
-        netdata.append(tcpSocket->readAll());
-        //update total bytes to recieve:
-        //datasize = (((int)netdata[1])*((int)netdata[2]));
-        QString data;
-        for(int i = 0; i < netdata.size(); i++)
-        {
-            data.append(" ");
-            data.append(QString::number(netdata[i]));
-        }
+        datasize = 0;
+    }
+    netdata.append(tcpSocket->readAll());
+
+    if(datasize == 0)
+    {   // the frame starts with [sensors size, width, height, timestamp], and an ImageStreamCodec::FrameInfo if the frame is encoded
+        headerSize = 3*sizeof(int) + sizeof(double);
+        if(streamEncoding >= 0)
+            headerSize += sizeof(ImageStreamCodec::FrameInfo);
+        if(netdata.size() < headerSize)
+            return;
 
         std::stringstream buffer;
         buffer.write(reinterpret_cast<char*>(netdata.data()), netdata.size());
-
-        //QTextStream *stream = new QTextStream(&netdata, QIODevice::ReadOnly);
-        //stream->setByteOrder(QDataStream::LittleEndian);
-
         buffer.read(reinterpret_cast<char*>(&sizeOfSensors), sizeof(sizeOfSensors));
         buffer.read(reinterpret_cast<char*>(&width), sizeof(width));
         buffer.read(reinterpret_cast<char*>(&height), sizeof(height));
 
         //qDebug() << height << ", " << width;
-        imageSize = height*width*4+buffer.tellg()+sizeof(double);
         sensorsSize = sizeOfSensors;
+        if(streamEncoding >= 0)
+        {
+            ImageStreamCodec::FrameInfo info;
+            memcpy(&info, netdata.data() + 3*sizeof(int) + sizeof(double), sizeof(info));
+            imageSize = headerSize + info.BodySize;
+        }
+        else
+            imageSize = height*width*4+buffer.tellg()+sizeof(double);
         datasize = imageSize + sensorsSize; // height*width*4+buffer.tellg()+sizeof(double)+ sizeof(NUSensorsData);
     }
-    else
+
+    if(netdata.size() < datasize)
+        return;
+
+    QString text = QString("Recieved Total Size: ");
+    text.append(QString::number(netdata.size()));
+    text.append(" of ");
+    text.append(QString::number(datasize));
+    if(streamEncoding >= 0)
     {
-    //QHostAddress sender;
-    //quint16 senderPort;
-
-    ////while(tcpSocket->)
-    //{
-        //READ from Socket
-        //netdata.resize(tcpSocket->readBufferSize());
-        netdata.append(tcpSocket->readAll());
-    //}
-
-        //emit PacketReady(&datagram);
-        if(datasize == netdata.size())
+        ImageStreamCodec::FrameInfo info;
+        double timestamp;
+        memcpy(&width, netdata.data() + sizeof(int), sizeof(width));
+        memcpy(&height, netdata.data() + 2*sizeof(int), sizeof(height));
+        memcpy(&timestamp, netdata.data() + 3*sizeof(int), sizeof(timestamp));
+        memcpy(&info, netdata.data() + 3*sizeof(int) + sizeof(double), sizeof(info));
+        if(decoder.decode(info, width, height, timestamp, netdata.data() + headerSize))
         {
-            std::stringstream buffer;
-            buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors)), imageSize);
-            buffer >> image;
-            emit rawImageChanged(&image);
-            buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors) + imageSize), sensorsSize);
-            buffer >> sensors;
-            qDebug() << "Size of Data:" << sensorsSize;
-            emit sensorsDataChanged(&sensors);
-
-            int mstime = timeToRecievePacket.elapsed();
-            time.setInterval(0);
-            float frameRate = (float)(1000.00/mstime);
-            QString text = QString("Recieved Total Size: ");
-            //datasize = datasize +netdata.size();
-            text.append(QString::number(netdata.size()));
-            text.append(" of ");
-            text.append(QString::number(datasize));
-
-            frameRateMessageLabel->setText(QString::number(frameRate));
-            statusNetworkLabel->setText(text);
-            netdata.clear();
-            disconnectFromRobot();
+            if(info.Encoding == ImageStreamCodec::ClassifiedRLE)
+                emit classifiedDisplayChanged(decoder.getClassifiedImage(), GLDisplay::classifiedImage);
+            else
+                emit rawImageChanged(decoder.getImage());
         }
+        text.append(" (");
+        text.append(QString(ImageStreamCodec::getName(info.Encoding).c_str()));
+        text.append(", encoded in ");
+        text.append(QString::number(info.EncodeTime/1000.0));
+        text.append(" ms)");
+    }
+    else
+    {
+        std::stringstream buffer;
+        buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors)), imageSize);
+        buffer >> image;
+        emit rawImageChanged(&image);
     }
+    std::stringstream sensorsbuffer;
+    sensorsbuffer.write(reinterpret_cast<char*>(netdata.data() + imageSize), sensorsSize);
+    sensorsbuffer >> sensors;
+    qDebug() << "Size of Data:" << sensorsSize;
+    emit sensorsDataChanged(&sensors);
 
+    int mstime = timeToRecievePacket.elapsed();
+    time.setInterval(0);
+    float frameRate = (float)(1000.00/mstime);
+
+    frameRateMessageLabel->setText(QString::number(frameRate));
+    statusNetworkLabel->setText(text);
+    netdata.clear();
+    datasize = 0;
+    disconnectFromRobot();
 }
 
 void visionStreamWidget::sendRequestForImage()
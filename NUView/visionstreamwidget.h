@@ -9,11 +9,14 @@
 #include <iostream>
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUImage/ImageStreamCodec.h"
+#include "GLDisplay.h"
 #include <QTimer>
 #include <QTime>
 class QLabel;
 class QLineEdit;
 class QPushButton;
+class QComboBox;
 class QWidget;
 class QVBoxLayout;
 class QHBoxLayout;
@@ -62,6 +65,7 @@ signals:
       */
     void PacketReady(QByteArray* datagram);
     void rawImageChanged(const NUImage*);
+    void classifiedDisplayChanged(ClassifiedImage* image, GLDisplay::display displayId);
     void sensorsDataChanged(NUSensorsData*);
     void sensorsDataChanged(const float* joint, const float* balance, const float* touch);
 
@@ -70,6 +74,8 @@ private:
     int datasize;
     int imageSize;
     int sensorsSize;
+    int headerSize;
+    int streamEncoding;                 //!< the encoding requested for the current frame, -1 for the original raw frame
     QByteArray netdata;
     QLabel* nameLabel;
     QLineEdit* nameLineEdit;
@@ -78,11 +84,14 @@ private:
     QPushButton* getImageButton;
     QPushButton* startStreamButton;
     QPushButton* stopStreamButton;
+    QLabel* encodingLabel;
+    QComboBox* encodingComboBox;
     QVBoxLayout* layout;
     QHBoxLayout* selectLayout1;
     QHBoxLayout* selectLayout2;
     QHBoxLayout* selectLayout3;
     QHBoxLayout* selectLayout4;
+    QHBoxLayout* selectLayout5;
     QLabel* frameLabel;
     QLabel* frameNumberLabel;
     QLabel* statusLabel;
@@ -93,6 +102,7 @@ private:
     QTcpSocket* tcpSocket;
     QTimer time;
     NUImage image;
+    ImageStreamCodec decoder;
     NUSensorsData sensors;
     QTime timeToRecievePacket;
 
@@ -74,6 +74,9 @@
 #elif defined(TARGET_IS_BEAR)
     #include "NUPlatform/Platforms/Bear/BearPlatform.h"
     #include "NUPlatform/Platforms/Bear/BearIO.h"
+#elif defined(TARGET_IS_REPLAY)
+    #include "NUPlatform/Platforms/Replay/ReplayPlatform.h"
+    #include "NUPlatform/Platforms/Replay/ReplayIO.h"
 #elif defined(TARGET_IS_NUVIEW)
     #error You should not be compiling NUbot.cpp when targeting NUview, you should use the virtualNUbot.
 #else
@@ -179,6 +182,8 @@ void NUbot::createPlatform(int argc, const char *argv[])
         m_platform = new CycloidPlatform();
     #elif defined(TARGET_IS_BEAR)
         m_platform = new BearPlatform();
+    #elif defined(TARGET_IS_REPLAY)
+        m_platform = new ReplayPlatform(argc, argv);
     #else
         #error You need to create a Platform instance for this platform
     #endif
@@ -221,6 +226,7 @@ void NUbot::destroyBlackboard()
         debug << "NUbot::destroyBlackboard()." << endl;
     #endif
     
+    m_blackboard->Image = 0;            // the image is owned by the camera, which deletes it in destroyPlatform()
     delete m_blackboard;
     m_blackboard = 0;
 }
@@ -240,6 +246,8 @@ void NUbot::createNetwork()
         m_io = new CycloidIO(this);
     #elif defined(TARGET_IS_BEAR)
         m_io = new BearIO(this);
+    #elif defined(TARGET_IS_REPLAY)
+        m_io = new ReplayIO(this, dynamic_cast<ReplayPlatform*>(m_platform));
     #else
         #error You need to create an IO class for this platform
     #endif
@@ -327,7 +335,7 @@ void NUbot::createThreads()
     m_sensemove_thread = new SenseMoveThread(this);
     m_sensemove_thread->start();
     
-    #ifndef TARGET_IS_NAOWEBOTS
+    #if not defined(TARGET_IS_NAOWEBOTS) and not defined(TARGET_IS_REPLAY)
         m_watchdog_thread = new WatchDogThread(this);
         m_watchdog_thread->start();
     #endif
@@ -351,12 +359,12 @@ void NUbot::destroyThreads()
     #if defined(USE_VISION) or defined(USE_LOCALISATION)
         m_seethink_thread->stop();
     #endif
-    #ifndef TARGET_IS_NAOWEBOTS
+    #if not defined(TARGET_IS_NAOWEBOTS) and not defined(TARGET_IS_REPLAY)
         m_watchdog_thread->stop();
     #endif
     m_sensemove_thread->stop();
     
-    #ifndef TARGET_IS_NAOWEBOTS
+    #if not defined(TARGET_IS_NAOWEBOTS) and not defined(TARGET_IS_REPLAY)
         delete m_watchdog_thread;
         m_watchdog_thread = 0;
     #endif
@@ -372,7 +380,7 @@ void NUbot::destroyThreads()
 
 /*! @brief The nubot's main loop
     
-    The nubot's main loop. This function will probably never return.
+    The nubot's main loop. This function will probably never return; on the Replay platform it returns once the logs have been replayed.
  
     The idea is to simply have 
     @verbatim
@@ -405,6 +413,29 @@ void NUbot::run()
         #endif
         count++;
     };
+#elif defined(TARGET_IS_REPLAY)
+    // each thread is run to completion before the next is signalled, so the modules always see the same data in the same order
+    ReplayPlatform* replay = (ReplayPlatform*) m_platform;
+    ReplayIO* io = (ReplayIO*) m_io;
+    m_sensemove_thread->waitForIdle();
+    #if defined(USE_VISION) or defined(USE_LOCALISATION)
+        m_seethink_thread->waitForIdle();
+    #endif
+    while (replay->step())
+    {
+        io->update(Platform->getTime());
+        m_sensemove_thread->signal(true);
+        m_sensemove_thread->waitForIdle();
+        
+        #if defined(USE_VISION) or defined(USE_LOCALISATION)
+            if (replay->isFrameDue())
+            {
+                m_seethink_thread->signal(true);
+                m_seethink_thread->waitForIdle();
+            }
+        #endif
+    }
+    debug << "NUbot::run(). The replay is finished." << endl;
 #else
     while (true)
     {
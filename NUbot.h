@@ -68,6 +68,9 @@ public:
 #ifdef USE_LOCALISATION
     const Localisation* GetLocWm(){return m_localisation;};
 #endif
+#ifdef USE_VISION
+    const Vision* GetVision(){return m_vision;};
+#endif
     
 private:
     void createErrorHandling();
@@ -0,0 +1,105 @@
+/*! @file ObstacleFusion.cpp
+    @brief Implementation of the obstacle fusion class.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObstacleFusion.h"
+#include "Infrastructure/FieldObjects/FieldObjects.h"
+#include "Infrastructure/FieldObjects/ObstacleGrid.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/GameInformation/GameInformation.h"
+
+#include <cmath>
+#include <vector>
+
+const unsigned char ObstacleFusion::RobotHit = 96;
+const float ObstacleFusion::RobotRadius = 20;
+const float ObstacleFusion::EchoOffset = 0.35f;
+const float ObstacleFusion::GoalAreaDepth = 60;
+const float ObstacleFusion::GoalAreaWidth = 220;
+
+ObstacleFusion::ObstacleFusion()
+{
+    m_timestamp = 0;
+}
+
+ObstacleFusion::~ObstacleFusion()
+{
+}
+
+/*! @brief Updates the grid with the odometry and ultrasonic readings in the sensor data, the robots seen this frame,
+           and the robot's position on the field. This should be called once a frame after vision, and before localisation
+           takes the odometry.
+    @param grid the obstacle grid to update
+    @param sensors the sensor data pinned for this frame
+    @param objects the field objects for this frame
+    @param gameinfo the game information, used to find the robot's own goal. If it is NULL the goal area is not used.
+ */
+void ObstacleFusion::update(ObstacleGrid& grid, NUSensorsData* sensors, FieldObjects* objects, GameInformation* gameinfo)
+{
+    if (sensors == NULL or objects == NULL)
+        return;
+    if (sensors->CurrentTime <= m_timestamp)
+        return;             // the same sensor data as last time
+    if (m_timestamp > 0)
+        grid.decay((sensors->CurrentTime - m_timestamp)/1000);
+    m_timestamp = sensors->CurrentTime;
+
+    std::vector<float> temp;
+    if (sensors->get(NUSensorsData::Odometry, temp) and temp.size() >= 3)
+        grid.move(temp[0], temp[1], temp[2]);
+
+    // the robots seen by vision
+    for (size_t i = 0; i < objects->ambiguousFieldObjects.size(); i++)
+    {
+        const AmbiguousObject& object = objects->ambiguousFieldObjects[i];
+        int id = object.getID();
+        if (not object.isObjectVisible() or (id != FieldObjects::FO_ROBOT_UNKNOWN and id != FieldObjects::FO_BLUE_ROBOT_UNKNOWN and id != FieldObjects::FO_PINK_ROBOT_UNKNOWN))
+            continue;
+        float distance = object.measuredDistance()*cos(object.measuredElevation());
+        if (distance <= 0)
+            continue;
+        grid.addObstacle(distance*cos(object.measuredBearing()), distance*sin(object.measuredBearing()), RobotRadius, RobotHit);
+    }
+
+    // the nearest echo of each ultrasonic sensor
+    if (sensors->get(NUSensorsData::LDistance, temp) and temp.size() > 0)
+        grid.addEcho(EchoOffset, temp[0]);
+    if (sensors->get(NUSensorsData::RDistance, temp) and temp.size() > 0)
+        grid.addEcho(-EchoOffset, temp[0]);
+
+    // the robot's own goal area, which only the goalie is allowed in
+    Self& self = objects->self;
+    if (gameinfo == NULL or gameinfo->getPlayerNumber() == 1 or self.lost())
+        grid.clearGoalArea();
+    else
+    {
+        int ownpost = gameinfo->getTeamColour() == GameInformation::RedTeam ? FieldObjects::FO_YELLOW_LEFT_GOALPOST : FieldObjects::FO_BLUE_LEFT_GOALPOST;
+        float goalx = objects->stationaryFieldObjects[ownpost].X();
+        float towardscentre = goalx > 0 ? -1 : 1;
+        float c = cos(self.Heading());
+        float s = sin(self.Heading());
+        float dx = goalx - self.wmX();
+        float dy = -GoalAreaWidth/2 - self.wmY();
+        Vector2<float> corner(dx*c + dy*s, -dx*s + dy*c);
+        Vector2<float> length(towardscentre*GoalAreaDepth*c, -towardscentre*GoalAreaDepth*s);
+        Vector2<float> width(GoalAreaWidth*s, GoalAreaWidth*c);
+        grid.setGoalArea(corner, length, width);
+    }
+}
@@ -0,0 +1,54 @@
+/*! @file ObstacleFusion.h
+    @brief Declaration of the obstacle fusion class.
+
+    @class ObstacleFusion
+    @brief Fuses the sensors and field objects of each frame into the obstacle grid.
+
+    Each frame the grid is decayed by the time since the last frame and moved by the odometry, then the robots seen
+    by vision and the nearest ultrasonic echo on each side are added, and the robot's own goal area is set. This is
+    run by the see->think thread after vision, and before localisation takes the odometry.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBSTACLE_FUSION_H
+#define OBSTACLE_FUSION_H
+
+class ObstacleGrid;
+class NUSensorsData;
+class FieldObjects;
+class GameInformation;
+
+class ObstacleFusion
+{
+public:
+    ObstacleFusion();
+    ~ObstacleFusion();
+
+    void update(ObstacleGrid& grid, NUSensorsData* sensors, FieldObjects* objects, GameInformation* gameinfo);
+private:
+    static const unsigned char RobotHit;        //!< The amount a robot seen by vision adds to the cells it covers
+    static const float RobotRadius;             //!< The radius of a robot on the ground (cm)
+    static const float EchoOffset;              //!< The angle between the robot's x axis and each ultrasonic sensor (rad)
+    static const float GoalAreaDepth;           //!< The distance the goal area extends from the goal line (cm)
+    static const float GoalAreaWidth;           //!< The width of the goal area across the field (cm)
+
+    double m_timestamp;                         //!< The time of the sensor data last fused (ms)
+};
+
+#endif
@@ -25,6 +25,7 @@
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
+#include "Infrastructure/FieldObjects/FieldObjects.h"
 #include "NUPlatform/NUActionators/NUSounds.h"
 #include "NUPlatform/NUIO.h"
 #include "NUbot.h"
@@ -34,7 +35,6 @@
 
 
 #ifdef USE_VISION
-    #include "Infrastructure/FieldObjects/FieldObjects.h"
     #include "Infrastructure/NUImage/NUImage.h"
     #include "Vision/Vision.h"
 #endif
@@ -52,6 +52,10 @@
     #include "Motion/NUMotion.h"
 #endif
 
+#if defined(TARGET_IS_REPLAY)
+    #include "NUPlatform/Platforms/Replay/ReplayPlatform.h"
+#endif
+
 #include "debug.h"
 #include "debugverbositynubot.h"
 #include "debugverbositythreading.h"
@@ -115,11 +119,15 @@ void SeeThinkThread::run()
     {
         try
         {
-            #if defined(TARGET_IS_NAOWEBOTS) or (not defined(USE_VISION))
+            #if defined(TARGET_IS_NAOWEBOTS) or defined(TARGET_IS_REPLAY) or (not defined(USE_VISION))
                 wait();
             #endif
             #ifdef USE_VISION
+                m_nubot->m_io->releaseImage();                      // the image stream encodes the image and sensors on its own thread, so it must be done with them first
                 m_nubot->m_platform->updateImage();
+            #endif
+            NUSensorsData* sensors = Blackboard->pinSensors();      // the SenseMoveThread owns Blackboard->Sensors, we use the same published snapshot for the whole cycle
+            #ifdef USE_VISION
                 *(m_nubot->m_io) << m_nubot;  //<! Raw IMAGE STREAMING (TCP)
             #endif
             
@@ -128,26 +136,30 @@ void SeeThinkThread::run()
             #endif
             // -----------------------------------------------------------------------------------------------------------------------------------------------------------------
             #ifdef USE_VISION
-                m_nubot->m_vision->ProcessFrame(Blackboard->Image, Blackboard->Sensors, Blackboard->Actions, Blackboard->Objects);
+                m_nubot->m_vision->ProcessFrame(Blackboard->Image, sensors, Blackboard->Actions, Blackboard->Objects);
                 #ifdef THREAD_SEETHINK_PROFILE
                     prof.split("vision");
                 #endif
             #endif
+            m_obstacle_fusion.update(Blackboard->Objects->obstacles, sensors, Blackboard->Objects, Blackboard->GameInfo);     // this must be before localisation takes the odometry
+            #ifdef THREAD_SEETHINK_PROFILE
+                prof.split("obstacles");
+            #endif
 
-            double current_time = Blackboard->Sensors->GetTimestamp();
-            Blackboard->TeamInfo->UpdateTime(current_time);
+            double current_time = sensors->GetTimestamp();
+            Blackboard->TeamInfo->update(sensors);
             Blackboard->GameInfo->UpdateTime(current_time);
             m_logrecorder->WriteData(Blackboard);
 
             #ifdef USE_LOCALISATION
-                m_nubot->m_localisation->process(Blackboard->Sensors, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
+                m_nubot->m_localisation->process(sensors, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SEETHINK_PROFILE
                     prof.split("localisation");
                 #endif
             #endif
             
             #if defined(USE_BEHAVIOUR)
-                m_nubot->m_behaviour->process(Blackboard->Jobs, Blackboard->Sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
+                m_nubot->m_behaviour->process(Blackboard->Jobs, sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SEETHINK_PROFILE
                     prof.split("behaviour");
                 #endif
@@ -156,6 +168,9 @@ void SeeThinkThread::run()
             #if DEBUG_VERBOSITY > 0
                 Blackboard->Jobs->summaryTo(debug);
             #endif
+            #if defined(TARGET_IS_REPLAY)
+                static_cast<ReplayPlatform*>(m_nubot->m_platform)->recordJobs(Blackboard->Jobs);
+            #endif
 
             #ifdef USE_VISION
 
@@ -27,6 +27,7 @@
 
 #include "Tools/Threading/ConditionalThread.h"
 #include "Tools/FileFormats/LogRecorder.h"
+#include "ObstacleFusion.h"
 #include <vector>
 #include <fstream>
 
@@ -45,6 +46,7 @@ protected:
 private:
     NUbot* m_nubot;
     LogRecorder* m_logrecorder;
+    ObstacleFusion m_obstacle_fusion;       //!< fuses the sensors and field objects into Blackboard->Objects->obstacles each frame
 };
 
 #endif
@@ -35,6 +35,8 @@
 
 #ifdef USE_BEHAVIOUR
     #include "Behaviour/Behaviour.h"
+    #include "Infrastructure/GameInformation/GameInformation.h"
+    #include "Infrastructure/TeamInformation/TeamInformation.h"
     #include "Infrastructure/Jobs/Jobs.h"
 #endif
 
@@ -114,6 +116,7 @@ void SenseMoveThread::run()
                 prof.start();
             #endif
             m_nubot->m_platform->updateSensors();
+            Blackboard->publishSensors();
             #ifdef THREAD_SENSEMOVE_PROFILE
                 prof.split("sensors");
             #endif
@@ -124,6 +127,8 @@ void SenseMoveThread::run()
                 #endif
             #endif
             #if defined(USE_BEHAVIOUR) and not defined(USE_VISION) and not defined(USE_LOCALISATION)        // This is a special clause. When there is no vision or localisation we reduce down to a single thread; ie the behaviour is no called from this thread.
+                Blackboard->TeamInfo->update(Blackboard->Sensors);
+                Blackboard->GameInfo->UpdateTime(Blackboard->Sensors->GetTimestamp());
                 m_nubot->m_behaviour->process(Blackboard->Jobs, Blackboard->Sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SENSEMOVE_PROFILE
                     prof.split("behaviour");
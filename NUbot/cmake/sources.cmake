@@ -23,6 +23,7 @@ ENDIF()
 SET (YOUR_SRCS  SeeThinkThread.cpp
 		SenseMoveThread.cpp
 		WatchDogThread.cpp
+		ObstacleFusion.cpp
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
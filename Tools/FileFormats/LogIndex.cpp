@@ -0,0 +1,154 @@
+/*! @file LogIndex.cpp
+    @brief Implementation of the sidecar index written alongside stream files.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogIndex.h"
+#include <cstring>
+#include <fstream>
+
+#ifndef WIN32
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#else
+    #include <iterator>
+#endif
+
+static const char c_magic[4] = {'N', 'U', 'i', 'x'};
+static const std::string c_extension = ".idx";
+
+static void PutUnsigned(char* buffer, unsigned long long value, int bytes)
+{
+    for(int i = 0; i < bytes; ++i)
+        buffer[i] = static_cast<char>((value >> (8*i)) & 0xFF);
+}
+
+static unsigned long long GetUnsigned(const char* buffer, int bytes)
+{
+    unsigned long long value = 0;
+    for(int i = 0; i < bytes; ++i)
+        value |= static_cast<unsigned long long>(static_cast<unsigned char>(buffer[i])) << (8*i);
+    return value;
+}
+
+/*!
+  @brief Get the name of the index file for a stream file.
+  @param streamFileName The name of the stream file.
+  @return The name of its index file.
+  */
+std::string LogIndex::IndexFileName(const std::string& streamFileName)
+{
+    return streamFileName + c_extension;
+}
+
+/*!
+  @brief Encode the index header.
+  @param buffer The destination, which must have room for HeaderSize bytes.
+  */
+void LogIndex::EncodeHeader(char* buffer)
+{
+    std::memcpy(buffer, c_magic, sizeof(c_magic));
+    PutUnsigned(buffer + 4, Version, 4);
+}
+
+/*!
+  @brief Encode an index entry.
+  @param entry The entry.
+  @param buffer The destination, which must have room for EntrySize bytes.
+  */
+void LogIndex::EncodeEntry(const Entry& entry, char* buffer)
+{
+    PutUnsigned(buffer, entry.Offset, 8);
+    PutUnsigned(buffer + 8, entry.Length, 4);
+    PutUnsigned(buffer + 12, entry.Sequence, 4);
+    unsigned long long timestamp;
+    std::memcpy(&timestamp, &entry.Timestamp, sizeof(timestamp));
+    PutUnsigned(buffer + 16, timestamp, 8);
+}
+
+/*!
+  @brief Parse the contents of an index file.
+  @param data The contents of the index file.
+  @param size The number of bytes in data.
+  @param entries The entries found. Any existing entries are removed.
+  @return True if the data is an index, false if it is not.
+  */
+bool LogIndex::Parse(const char* data, unsigned long long size, std::vector<Entry>& entries)
+{
+    entries.clear();
+    if(size < HeaderSize || std::memcmp(data, c_magic, sizeof(c_magic)) != 0)
+        return false;
+    if(GetUnsigned(data + 4, 4) != Version)
+        return false;
+
+    unsigned long long numEntries = (size - HeaderSize)/EntrySize;
+    entries.resize(numEntries);
+    const char* entryData = data + HeaderSize;
+    for(unsigned long long i = 0; i < numEntries; ++i, entryData += EntrySize)
+    {
+        Entry& entry = entries[i];
+        entry.Offset = GetUnsigned(entryData, 8);
+        entry.Length = static_cast<unsigned int>(GetUnsigned(entryData + 8, 4));
+        entry.Sequence = static_cast<unsigned int>(GetUnsigned(entryData + 12, 4));
+        unsigned long long timestamp = GetUnsigned(entryData + 16, 8);
+        std::memcpy(&entry.Timestamp, &timestamp, sizeof(entry.Timestamp));
+    }
+    return true;
+}
+
+/*!
+  @brief Load the index of a stream file. The index file is memory mapped where possible.
+  @param streamFileName The name of the stream file (not the index file).
+  @param entries The entries found.
+  @return True if an index was loaded, false if the stream file does not have a valid index.
+  */
+bool LogIndex::Load(const std::string& streamFileName, std::vector<Entry>& entries)
+{
+    entries.clear();
+    std::string filename = IndexFileName(streamFileName);
+#ifndef WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* mapped = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapped == MAP_FAILED)
+        return false;
+    bool success = Parse(static_cast<const char*>(mapped), info.st_size, entries);
+    munmap(mapped, info.st_size);
+    return success;
+#else
+    std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!file.is_open())
+        return false;
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if(data.empty())
+        return false;
+    return Parse(&data[0], data.size(), entries);
+#endif
+}
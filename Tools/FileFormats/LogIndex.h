@@ -0,0 +1,71 @@
+/*! @file LogIndex.h
+    @brief Declaration of the sidecar index written alongside stream files.
+
+    @class LogIndex
+    @brief Functions used to write and load the index of a stream file.
+
+    As each entry is appended to a stream file, its location and timestamp are appended to a
+    sidecar index file (the stream file's name with IndexExtension appended). A reader can then
+    load the index instead of scanning the whole stream file.
+
+    The index file is a header (the 4 byte magic "NUix" and a uint32 version) followed by fixed
+    size entries:
+        - Offset    uint64, the position of the entry in the stream file
+        - Length    uint32, the number of bytes in the entry
+        - Sequence  uint32, the entry's sequence number, starting at 1
+        - Timestamp float64, the entry's timestamp in milliseconds
+    Everything is little endian. A partially written entry at the end of the index is ignored.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+class LogIndex
+{
+public:
+    /*!
+      @brief The location and timestamp of one entry in a stream file.
+      */
+    struct Entry
+    {
+        unsigned long long Offset;  //!< The position of the entry in the stream file.
+        unsigned int Length;        //!< The number of bytes in the entry.
+        unsigned int Sequence;      //!< The entry's sequence number.
+        double Timestamp;           //!< The entry's timestamp (ms).
+    };
+
+    static const unsigned int Version = 1;          //!< The version of the index format.
+    static const unsigned int HeaderSize = 8;       //!< The size of the index header in bytes.
+    static const unsigned int EntrySize = 24;       //!< The size of each index entry in bytes.
+
+    static std::string IndexFileName(const std::string& streamFileName);
+
+    static void EncodeHeader(char* buffer);
+    static void EncodeEntry(const Entry& entry, char* buffer);
+
+    static bool Parse(const char* data, unsigned long long size, std::vector<Entry>& entries);
+    static bool Load(const std::string& streamFileName, std::vector<Entry>& entries);
+};
+
+#endif // LOGINDEX_H
@@ -0,0 +1,132 @@
+/*! @file LogRecord.cpp
+    @brief Implementation of the binary log record format.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogRecord.h"
+#include <cstring>
+
+static const char c_magic[4] = {'N', 'U', 'l', 'r'};
+
+static void PutUnsigned(char* buffer, unsigned long long value, int bytes)
+{
+    for(int i = 0; i < bytes; ++i)
+        buffer[i] = static_cast<char>((value >> (8*i)) & 0xFF);
+}
+
+static unsigned long long GetUnsigned(const char* buffer, int bytes)
+{
+    unsigned long long value = 0;
+    for(int i = 0; i < bytes; ++i)
+        value |= static_cast<unsigned long long>(static_cast<unsigned char>(buffer[i])) << (8*i);
+    return value;
+}
+
+/*!
+  @brief Get the version of the serialised form currently written for a type of data.
+
+  The version must be incremented whenever the data's operator<< changes. Fields should only
+  be appended, so that older readers can still read the start of a newer record.
+  @param type The type of data.
+  @return The current version.
+  */
+int LogRecord::CurrentVersion(RecordType type)
+{
+    switch(type)
+    {
+        case FieldObjectsType:
+            return 1;
+        case LocalisationType:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*!
+  @brief Get the record type of field objects.
+  @return FieldObjectsType
+  */
+LogRecord::RecordType LogRecord::TypeOf(const FieldObjects&)
+{
+    return FieldObjectsType;
+}
+
+/*!
+  @brief Get the record type of localisation data.
+  @return LocalisationType
+  */
+LogRecord::RecordType LogRecord::TypeOf(const Localisation&)
+{
+    return LocalisationType;
+}
+
+/*!
+  @brief Get the record type of data that is not written as records.
+  @return UnknownType
+  */
+LogRecord::RecordType LogRecord::TypeOf(const TimestampedData&)
+{
+    return UnknownType;
+}
+
+/*!
+  @brief Write a record header to a stream.
+  @param output The stream to which the header is written.
+  @param header The header.
+  */
+void LogRecord::WriteHeader(std::ostream& output, const Header& header)
+{
+    char buffer[HeaderSize];
+    std::memcpy(buffer, c_magic, sizeof(c_magic));
+    PutUnsigned(buffer + 4, header.Type, 2);
+    PutUnsigned(buffer + 6, header.Version, 2);
+    PutUnsigned(buffer + 8, header.Length, 4);
+    unsigned long long timestamp;
+    std::memcpy(&timestamp, &header.Timestamp, sizeof(timestamp));
+    PutUnsigned(buffer + 12, timestamp, 8);
+    output.write(buffer, HeaderSize);
+}
+
+/*!
+  @brief Read a record header from a stream.
+
+  If there is not a record header at the current position the stream is left where it was.
+  @param input The stream from which the header is read.
+  @param header The header read.
+  @return True if a header was read, false if there is not a record at the current position.
+  */
+bool LogRecord::ReadHeader(std::istream& input, Header& header)
+{
+    std::streampos start = input.tellg();
+    char buffer[HeaderSize];
+    input.read(buffer, HeaderSize);
+    if(input.gcount() != static_cast<std::streamsize>(HeaderSize) || std::memcmp(buffer, c_magic, sizeof(c_magic)) != 0)
+    {
+        input.clear();
+        input.seekg(start);
+        return false;
+    }
+    header.Type = static_cast<int>(GetUnsigned(buffer + 4, 2));
+    header.Version = static_cast<int>(GetUnsigned(buffer + 6, 2));
+    header.Length = static_cast<unsigned int>(GetUnsigned(buffer + 8, 4));
+    unsigned long long timestamp = GetUnsigned(buffer + 12, 8);
+    std::memcpy(&header.Timestamp, &timestamp, sizeof(header.Timestamp));
+    return true;
+}
@@ -0,0 +1,163 @@
+/*! @file LogRecord.h
+    @brief Declaration of the binary log record format.
+
+    @class LogRecord
+    @brief Functions used to write and read timestamped data as self-describing log records.
+
+    Each record in a stream file is a fixed size header followed by the data's serialised form:
+        - Magic     4 bytes "NUlr"
+        - Type      uint16, one of RecordType
+        - Version   uint16, the version of the data's serialised form
+        - Length    uint32, the number of bytes after the header
+        - Timestamp float64, the data's timestamp in milliseconds
+    The header is little endian. The data itself is written by its existing operator<<.
+
+    Because the header carries the length and timestamp, a reader can index a file by reading
+    the headers and seeking over the data, without parsing it. Files without record headers
+    (ie. logs written before the record format) are still read, by parsing each entry. A record
+    is only parsed if its type is the type being read, and its version is not older than the
+    current one.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGRECORD_H
+#define LOGRECORD_H
+
+#include "Tools/FileFormats/TimestampedData.h"
+#include "Tools/FileFormats/FileFormatException.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+class FieldObjects;
+class Localisation;
+
+class LogRecord
+{
+public:
+    /*!
+      @brief The types of data written as records.
+      */
+    enum RecordType
+    {
+        UnknownType = 0,
+        FieldObjectsType = 1,
+        LocalisationType = 2
+    };
+
+    /*!
+      @brief The contents of a record header.
+      */
+    struct Header
+    {
+        int Type;               //!< The type of data in the record.
+        int Version;            //!< The version of the data's serialised form.
+        unsigned int Length;    //!< The number of bytes of data after the header.
+        double Timestamp;       //!< The timestamp of the data (ms).
+    };
+
+    static const unsigned int HeaderSize = 20;      //!< The size of a record header in bytes.
+
+    static int CurrentVersion(RecordType type);
+    static RecordType TypeOf(const FieldObjects& data);
+    static RecordType TypeOf(const Localisation& data);
+    static RecordType TypeOf(const TimestampedData& data);
+    static void WriteHeader(std::ostream& output, const Header& header);
+    static bool ReadHeader(std::istream& input, Header& header);
+
+    /*!
+      @brief Write data to a stream as a record.
+
+      The header is written first with a zero length, which is filled in once the data has been
+      written, so the data is not copied. If the stream can not seek the data is buffered instead.
+      @param output The stream to which the record is written.
+      @param type The type of the data.
+      @param data The data to be written.
+      */
+    template<class T>
+    static void Write(std::ostream& output, RecordType type, const T& data)
+    {
+        Header header;
+        header.Type = type;
+        header.Version = CurrentVersion(type);
+        header.Length = 0;
+        header.Timestamp = static_cast<const TimestampedData&>(data).GetTimestamp();
+
+        std::streampos start = output.tellp();
+        if(start == std::streampos(-1))
+        {
+            std::stringstream buffer;
+            buffer << data;
+            std::string payload = buffer.str();
+            header.Length = payload.size();
+            WriteHeader(output, header);
+            output.write(payload.data(), payload.size());
+            return;
+        }
+
+        WriteHeader(output, header);
+        output << data;
+        std::streampos end = output.tellp();
+        header.Length = static_cast<unsigned int>(end - start) - HeaderSize;
+        output.seekp(start);
+        WriteHeader(output, header);
+        output.seekp(end);
+    }
+
+    /*!
+      @brief Read data from a stream that may or may not contain records.
+
+      If there is a record at the current position its data is read, and the stream is left at the
+      end of the record regardless of how much of the data was parsed. Otherwise the data is parsed
+      directly, as it was written before the record format.
+
+      A record of a different type, or of an older version than the current one, is not parsed. The
+      stream is left at the end of the record and a FileFormatException is thrown.
+      @param input The stream from which the data is read.
+      @param data The data to be read.
+      @return True if a record was read, false if the data was read without a record.
+      */
+    template<class T>
+    static bool Read(std::istream& input, T& data)
+    {
+        std::streampos start = input.tellg();
+        Header header;
+        if(!ReadHeader(input, header))
+        {
+            input >> data;
+            return false;
+        }
+        RecordType type = TypeOf(data);
+        if(header.Type != type || header.Version < CurrentVersion(type))
+        {
+            input.clear();
+            input.seekg(start + std::streamoff(HeaderSize + header.Length));
+            std::stringstream error;
+            error << "LogRecord::Read(). Record of type " << header.Type << " version " << header.Version;
+            error << " can not be read as type " << type << " version " << CurrentVersion(type) << ".";
+            throw FileFormatException(error.str());
+        }
+        input >> data;
+        input.clear();
+        input.seekg(start + std::streamoff(HeaderSize + header.Length));
+        return true;
+    }
+};
+
+#endif // LOGRECORD_H
@@ -1,4 +1,5 @@
 #include "LogRecorder.h"
+#include "LogRecord.h"
 #include "debug.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
 #include "Infrastructure/NUImage/NUImage.h"
@@ -6,16 +7,18 @@
 #include "Infrastructure/GameInformation/GameInformation.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
 
-LogFileWriter::LogFileWriter(std::string data_type)
+LogFileWriter::LogFileWriter(std::string data_type, LogWriterThread* writer)
 {
     m_data_name = data_type;
     m_status = lf_UNKNOWN;
+    m_writer = writer;
+    m_stream = -1;
 }
 
 
 LogFileWriter::~LogFileWriter()
 {
-    m_file_stream.close();
+    Close();
 }
 
 std::string LogFileWriter::toString()
@@ -27,8 +30,8 @@ std::string LogFileWriter::toString()
 bool LogFileWriter::Open(std::string file_path)
 {
     debug << "LW:Opening log file: " << file_path << " - ";
-    m_file_stream.open(file_path.c_str(),std::ios_base::out | std::ios_base::trunc);
-    if(m_file_stream.is_open() && m_file_stream.good())
+    m_stream = m_writer->openStream(file_path);
+    if(m_stream >= 0)
     {
         m_file_name = file_path;
         m_status = lf_OPEN;
@@ -43,29 +46,44 @@ bool LogFileWriter::Open(std::string file_path)
     }
 }
 
+/*! @brief Gets an empty buffer to serialise an entry into. Never blocks.
+    @return the buffer, or NULL if the writer is too far behind and the entry has to be dropped
+ */
+LogWriterBuffer* LogFileWriter::NewEntry()
+{
+    if(m_status != lf_OPEN)
+        return NULL;
+    return m_writer->acquire(m_stream);
+}
+
+/*! @brief Queues an entry, from NewEntry(), to be appended to the file and its sidecar index. Never blocks.
+    @param entry the serialised entry
+    @param timestamp the entry's timestamp
+ */
+void LogFileWriter::WriteEntry(LogWriterBuffer* entry, double timestamp)
+{
+    entry->Timestamp = timestamp;
+    m_writer->submit(entry);
+}
+
 bool LogFileWriter::Close()
 {
-    m_file_stream.close();
-    if(!m_file_stream.is_open())
-    {
-        m_status = lf_CLOSED;
-        return true;
-    }
-    else
-    {
-        m_status = lf_UNKNOWN;
-        return false;
-    }
+    // blocks until every entry already queued has been written
+    m_writer->closeStream(m_stream);
+    m_stream = -1;
+    m_status = lf_CLOSED;
+    return true;
 }
 
 LogRecorder::LogRecorder(int playerNumber)
 {
     m_player_number = playerNumber;
-    m_log_writers.push_back(new LogFileWriter("sensor"));
-    m_log_writers.push_back(new LogFileWriter("image"));
-    m_log_writers.push_back(new LogFileWriter("object"));
-    m_log_writers.push_back(new LogFileWriter("teaminfo"));
-    m_log_writers.push_back(new LogFileWriter("gameinfo"));
+    m_writer = new LogWriterThread();
+    m_log_writers.push_back(new LogFileWriter("sensor", m_writer));
+    m_log_writers.push_back(new LogFileWriter("image", m_writer));
+    m_log_writers.push_back(new LogFileWriter("object", m_writer));
+    m_log_writers.push_back(new LogFileWriter("teaminfo", m_writer));
+    m_log_writers.push_back(new LogFileWriter("gameinfo", m_writer));
 }
 
 LogRecorder::~LogRecorder()
@@ -76,6 +94,7 @@ LogRecorder::~LogRecorder()
         delete (*it);
     }
     m_log_writers.clear();
+    delete m_writer;
     return;
 }
 
@@ -162,16 +181,38 @@ bool LogRecorder::WriteData(NUBlackboard* theBlackboard)
         if((*it)->GetFileStatus() == lf_OPEN)
         {
             std::string data_type = (*it)->GetDataType();
+            LogWriterBuffer* entry = (*it)->NewEntry();
+            if(entry == NULL)
+                continue;
+            std::ostream& file = entry->Output();
+            double timestamp = 0.0;
             if(data_type == "sensor")
-                (*it)->GetFile() << *(theBlackboard->Sensors) << std::flush;
+            {
+                NUSensorsData* sensors = theBlackboard->getPinnedSensors();
+                file << *sensors;
+                timestamp = sensors->GetTimestamp();
+            }
             else if(data_type == "image")
-                (*it)->GetFile() << *(theBlackboard->Image) << std::flush;
+            {
+                file << *(theBlackboard->Image);
+                timestamp = theBlackboard->Image->GetTimestamp();
+            }
             else if(data_type == "object")
-                (*it)->GetFile() << *(theBlackboard->Objects) << std::flush;
+            {
+                LogRecord::Write(file, LogRecord::FieldObjectsType, *(theBlackboard->Objects));
+                timestamp = theBlackboard->Objects->GetTimestamp();
+            }
             else if(data_type == "gameinfo")
-                (*it)->GetFile() << *(theBlackboard->GameInfo) << std::flush;
+            {
+                file << *(theBlackboard->GameInfo);
+                timestamp = theBlackboard->GameInfo->GetTimestamp();
+            }
             else if(data_type == "teaminfo")
-                (*it)->GetFile() << *(theBlackboard->TeamInfo) << std::flush;
+            {
+                file << *(theBlackboard->TeamInfo);
+                timestamp = theBlackboard->TeamInfo->GetTimestamp();
+            }
+            (*it)->WriteEntry(entry, timestamp);
         }
     }
     return true;
@@ -1,12 +1,12 @@
 #ifndef LOGRECORDER_H
 #define LOGRECORDER_H
 
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
 #include "nubotdataconfig.h"
 #include "Infrastructure/NUBlackboard.h"
+#include "LogWriterThread.h"
 
 enum LogFileStatus
 {
@@ -17,10 +17,11 @@ enum LogFileStatus
 };
 
 // Wrapper for log file writer class. One of these is required for each data type.
+// The entries are written to the file, and its index, by the shared LogWriterThread.
 class LogFileWriter
 {
 public:
-    LogFileWriter(std::string data_type);
+    LogFileWriter(std::string data_type, LogWriterThread* writer);
     ~LogFileWriter();
 
     bool Open(std::string log_path);
@@ -41,10 +42,8 @@ public:
         return m_status;
     }
 
-    std::fstream& GetFile()
-    {
-        return m_file_stream;
-    }
+    LogWriterBuffer* NewEntry();
+    void WriteEntry(LogWriterBuffer* entry, double timestamp);
 
     std::string toString();
 
@@ -52,7 +51,8 @@ private:
     std::string m_data_name;
     std::string m_file_name;
     LogFileStatus m_status;
-    std::fstream m_file_stream;
+    LogWriterThread* m_writer;      // background thread that writes the entries
+    int m_stream;                   // id of the file in m_writer
 
 };
 
@@ -64,6 +64,10 @@ public:
     ~LogRecorder();
     bool SetLogging(std::string dataType, bool enabled);
     bool WriteData(NUBlackboard* theBlackboard);
+    LogWriterThread* GetWriter()
+    {
+        return m_writer;
+    }
     static std::string GetLogPath(int robot_number, std::string data_name)
     {
         const std::string extension = "strm";
@@ -79,6 +83,7 @@ private:
     bool HasDataType(std::string dataType);
     LogFileWriter* GetDataWriter(std::string dataType);
     std::vector<LogFileWriter*> m_log_writers;
+    LogWriterThread* m_writer;
 
 };
 
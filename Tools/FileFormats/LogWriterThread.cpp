@@ -0,0 +1,759 @@
+/*! @file LogWriterThread.cpp
+    @brief Implementation of the background writer used by the LogRecorder.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogWriterThread.h"
+#include "LogIndex.h"
+#include "debug.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#ifndef WIN32
+    #include <sys/uio.h>
+    #include <unistd.h>
+#else
+    #include <io.h>
+#endif
+
+#ifndef O_BINARY
+    #define O_BINARY 0
+#endif
+
+/*!
+  @brief Create an empty buffer. No memory is allocated until something is written.
+  */
+LogWriterBuffer::LogWriterBuffer() : m_end(0), m_output(this)
+{
+    Stream = -1;
+    Timestamp = 0.0;
+    Close = false;
+}
+
+/*!
+  @brief Empty the buffer, keeping its memory, so that a new record can be written to it.
+  @param stream The stream the new record is for.
+  */
+void LogWriterBuffer::Reset(int stream)
+{
+    Stream = stream;
+    Timestamp = 0.0;
+    Close = false;
+    m_end = 0;
+    if(m_data.empty())
+        setp(0, 0);
+    else
+        setp(&m_data[0], &m_data[0] + m_data.size());
+    m_output.clear();
+}
+
+/*!
+  @brief Empty the buffer, and free its memory.
+  */
+void LogWriterBuffer::Release()
+{
+    std::vector<char>().swap(m_data);
+    Reset(Stream);
+}
+
+/*!
+  @brief Get the size of the record in the buffer.
+  @return The number of bytes written.
+  */
+size_t LogWriterBuffer::Size() const
+{
+    size_t position = pptr() - pbase();
+    return position > m_end ? position : m_end;
+}
+
+/*!
+  @brief Make sure there is room for the buffer to hold at least the required number of bytes.
+  @param required The number of bytes needed.
+  */
+void LogWriterBuffer::Grow(size_t required)
+{
+    size_t position = pptr() - pbase();
+    if(position > m_end)
+        m_end = position;
+    size_t capacity = 2*m_data.size();
+    if(capacity < 4096)
+        capacity = 4096;
+    if(capacity < required)
+        capacity = required;
+    m_data.resize(capacity);
+    setp(&m_data[0], &m_data[0] + capacity);
+    pbump(static_cast<int>(position));
+}
+
+LogWriterBuffer::int_type LogWriterBuffer::overflow(int_type c)
+{
+    if(traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    Grow(pptr() - pbase() + 1);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+std::streamsize LogWriterBuffer::xsputn(const char* s, std::streamsize n)
+{
+    if(n <= 0)
+        return 0;
+    if(epptr() - pptr() < n)
+        Grow(pptr() - pbase() + n);
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+}
+
+LogWriterBuffer::pos_type LogWriterBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if(!(which & std::ios_base::out))
+        return pos_type(off_type(-1));
+    size_t position = pptr() - pbase();
+    if(position > m_end)
+        m_end = position;
+
+    off_type target = off;
+    if(dir == std::ios_base::cur)
+        target += position;
+    else if(dir == std::ios_base::end)
+        target += m_end;
+    if(target < 0 || target > static_cast<off_type>(m_end))
+        return pos_type(off_type(-1));
+
+    setp(pbase(), epptr());
+    pbump(static_cast<int>(target));
+    return pos_type(target);
+}
+
+LogWriterBuffer::pos_type LogWriterBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+/*!
+  @brief Create and start the writer thread.
+  @param memorycap The maximum number of bytes queued. Records that would exceed it are dropped.
+  @param numbuffers The number of record buffers. When they are all queued new records are dropped.
+  @param syncperiod The time between each fdatasync() of a stream (ms), 0 to leave it to the kernel.
+  */
+LogWriterThread::LogWriterThread(size_t memorycap, unsigned int numbuffers, int syncperiod) :
+        QueueThread<LogWriterBuffer*>("LogWriterThread", 0, (numbuffers > 0 ? numbuffers : 1) + MaxStreams),
+        m_memory_cap(memorycap), m_sync_period(syncperiod), m_free(numbuffers > 0 ? numbuffers : 1)
+{
+    if(numbuffers == 0)
+        numbuffers = 1;
+    for(unsigned int i = 0; i < numbuffers; ++i)
+    {
+        LogWriterBuffer* buffer = new LogWriterBuffer();
+        bool wasEmpty;
+        m_buffers.push_back(buffer);
+        m_free.push(buffer, wasEmpty);
+    }
+    m_batch.reserve(numbuffers + MaxStreams);
+
+    for(unsigned int i = 0; i < MaxStreams; ++i)
+    {
+        StreamState& state = m_streams[i];
+        state.Open = false;
+        state.Failed = false;
+        state.Direct = false;
+        state.File = -1;
+        state.Index = -1;
+        state.Offset = 0;
+        state.Sequence = 0;
+        state.Segments.reserve(MaxSegments);
+        state.Staging = 0;
+        state.StagingSize = 0;
+        state.Pending = false;
+        state.Unsynced = false;
+        state.LastSync = 0.0;
+    }
+    m_queued_bytes = 0;
+
+    m_num_written = 0;
+    m_num_dropped = 0;
+    m_bytes_written = 0;
+    m_num_writes = 0;
+    m_total_latency = 0.0;
+    m_max_latency = 0.0;
+    pthread_cond_init(&m_closed_condition, NULL);
+    pthread_mutex_init(&m_counter_mutex, NULL);
+
+    start();
+}
+
+/*!
+  @brief Close every open stream, writing everything queued, and then stop the thread.
+  */
+LogWriterThread::~LogWriterThread()
+{
+    for(unsigned int i = 0; i < MaxStreams; ++i)
+        closeStream(i);
+    stop();
+    join();
+    for(size_t i = 0; i < m_buffers.size(); ++i)
+        delete m_buffers[i];
+    pthread_mutex_destroy(&m_counter_mutex);
+    pthread_cond_destroy(&m_closed_condition);
+}
+
+/*!
+  @brief Open a stream file, and its sidecar index, for writing. Any existing file is truncated.
+  @param filename The name of the stream file.
+  @param direct True to write the stream with O_DIRECT, bypassing the page cache, where it is supported.
+  @return The id of the stream, or -1 if it could not be opened.
+  */
+int LogWriterThread::openStream(const std::string& filename, bool direct)
+{
+    int id = -1;
+    pthread_mutex_lock(&m_condition_mutex);
+    for(unsigned int i = 0; i < MaxStreams && id < 0; ++i)
+    {
+        if(!m_streams[i].Open)
+            id = i;
+    }
+    pthread_mutex_unlock(&m_condition_mutex);
+    if(id < 0)
+        return -1;
+
+    StreamState& state = m_streams[id];
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_BINARY;
+    state.File = -1;
+    state.Direct = false;
+#ifdef O_DIRECT
+    if(direct && posix_memalign(reinterpret_cast<void**>(&state.Staging), DirectAlignment, ChunkSize) == 0)
+    {
+        state.File = open(filename.c_str(), flags | O_DIRECT, 0644);
+        state.Direct = state.File >= 0;
+        if(!state.Direct)
+        {   // not every file system supports O_DIRECT (tmpfs does not)
+            free(state.Staging);
+            state.Staging = 0;
+        }
+    }
+#endif
+    if(state.File < 0)
+        state.File = open(filename.c_str(), flags, 0644);
+    if(state.File < 0)
+    {
+        errorlog << "LogWriterThread::openStream(). Unable to open " << filename << ", errno: " << errno << std::endl;
+        return -1;
+    }
+
+    state.Index = open(LogIndex::IndexFileName(filename).c_str(), flags, 0644);
+    state.IndexData.clear();
+    if(state.Index >= 0)
+    {
+        state.IndexData.resize(LogIndex::HeaderSize);
+        LogIndex::EncodeHeader(&state.IndexData[0]);
+    }
+    state.Failed = false;
+    state.Offset = 0;
+    state.Sequence = 0;
+    state.Segments.clear();
+    state.StagingSize = 0;
+    state.Unsynced = false;
+    state.LastSync = getTime();
+
+    pthread_mutex_lock(&m_condition_mutex);
+    state.Open = true;
+    pthread_mutex_unlock(&m_condition_mutex);
+    return id;
+}
+
+/*!
+  @brief Close a stream. Blocks until every record submitted to the stream has been written.
+  @param stream The id of the stream from openStream().
+  */
+void LogWriterThread::closeStream(int stream)
+{
+    if(stream < 0 || stream >= static_cast<int>(MaxStreams))
+        return;
+    StreamState& state = m_streams[stream];
+    pthread_mutex_lock(&m_condition_mutex);
+    bool open = state.Open;
+    pthread_mutex_unlock(&m_condition_mutex);
+    if(!open)
+        return;
+
+    // the queue has room for a close request from every stream, so this never waits for the writer to make room
+    state.CloseRequest.Reset(stream);
+    state.CloseRequest.Close = true;
+    pushBack(&state.CloseRequest);
+
+    pthread_mutex_lock(&m_condition_mutex);
+    while(state.Open)
+        pthread_cond_wait(&m_closed_condition, &m_condition_mutex);
+    pthread_mutex_unlock(&m_condition_mutex);
+}
+
+/*!
+  @brief Get an empty buffer to serialise a record into, and then pass to submit(). Never blocks, and takes no lock.
+  @param stream The id of the stream the record is for.
+  @return The buffer, or NULL if every buffer is queued, in which case the record is dropped.
+  */
+LogWriterBuffer* LogWriterThread::acquire(int stream)
+{
+    LogWriterBuffer* buffer = 0;
+    if(!m_free.pop(buffer))
+    {
+        drop();
+        return 0;
+    }
+    buffer->Reset(stream);
+    return buffer;
+}
+
+/*!
+  @brief Queue a record, from acquire(), to be written. Never waits on the disk; the writer's condition
+         mutex is only taken, briefly, to wake the writer if its queue was empty.
+
+  If the record would take the bytes queued over the memory cap it is dropped.
+  @param buffer The record.
+  */
+void LogWriterThread::submit(LogWriterBuffer* buffer)
+{
+    long size = static_cast<long>(buffer->Size());
+    long queued = __sync_add_and_fetch(&m_queued_bytes, size);
+    if(!buffer->Output().good() || static_cast<size_t>(queued) > m_memory_cap)
+    {
+        __sync_sub_and_fetch(&m_queued_bytes, size);
+        drop();
+        bool wasEmpty;
+        m_free.push(buffer, wasEmpty);
+        return;
+    }
+    pushBack(buffer);
+}
+
+/*!
+  @brief Get the number of bytes submitted and not yet written.
+  */
+size_t LogWriterThread::getQueuedBytes()
+{
+    return static_cast<size_t>(__sync_add_and_fetch(&m_queued_bytes, 0));
+}
+
+/*!
+  @brief Get the number of records written.
+  */
+unsigned long LogWriterThread::getNumWritten()
+{
+    pthread_mutex_lock(&m_counter_mutex);
+    unsigned long value = m_num_written;
+    pthread_mutex_unlock(&m_counter_mutex);
+    return value;
+}
+
+/*!
+  @brief Get the number of records dropped because there was no buffer, they exceeded the memory cap, or a write failed.
+  */
+unsigned long LogWriterThread::getNumDropped()
+{
+    return __sync_add_and_fetch(&m_num_dropped, 0);
+}
+
+/*!
+  @brief Get the number of bytes written to the stream and index files.
+  */
+unsigned long long LogWriterThread::getBytesWritten()
+{
+    pthread_mutex_lock(&m_counter_mutex);
+    unsigned long long value = m_bytes_written;
+    pthread_mutex_unlock(&m_counter_mutex);
+    return value;
+}
+
+/*!
+  @brief Get the longest time spent in a single write (ms).
+  */
+double LogWriterThread::getMaxWriteLatency()
+{
+    pthread_mutex_lock(&m_counter_mutex);
+    double value = m_max_latency;
+    pthread_mutex_unlock(&m_counter_mutex);
+    return value;
+}
+
+/*!
+  @brief Get the average time spent in a single write (ms).
+  */
+double LogWriterThread::getAverageWriteLatency()
+{
+    pthread_mutex_lock(&m_counter_mutex);
+    double value = m_num_writes > 0 ? m_total_latency/m_num_writes : 0.0;
+    pthread_mutex_unlock(&m_counter_mutex);
+    return value;
+}
+
+/*!
+  @brief The writer's main loop. Waits for records, and then writes everything queued in one batch.
+  */
+void LogWriterThread::run()
+{
+    // The thread is only cancelled while it is waiting, never part way through writing a batch.
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    while(true)
+    {
+        pthread_mutex_lock(&m_condition_mutex);
+        pthread_cleanup_push(unlockMutex, &m_condition_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+        while(m_queue.empty())
+            pthread_cond_wait(&m_condition, &m_condition_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+        pthread_cleanup_pop(0);
+        pthread_mutex_unlock(&m_condition_mutex);
+
+        m_queue.drain(m_batch);
+        for(size_t i = 0; i < m_batch.size(); ++i)
+            process(m_batch[i]);
+
+        double now = getTime();
+        for(unsigned int i = 0; i < MaxStreams; ++i)
+        {
+            StreamState& state = m_streams[i];
+            if(state.Pending)
+            {
+                flush(state, false);
+                sync(state, now, false);
+            }
+        }
+
+        for(size_t i = 0; i < m_batch.size(); ++i)
+            recycle(m_batch[i]);
+        m_batch.clear();
+    }
+}
+
+/*!
+  @brief Add a record to its stream's pending writes, or close the stream if it is a close request.
+  @param buffer The record.
+  */
+void LogWriterThread::process(LogWriterBuffer* buffer)
+{
+    StreamState& state = m_streams[buffer->Stream];
+    if(buffer->Close)
+    {
+        close(state);
+        return;
+    }
+    if(state.File < 0 || state.Failed)
+    {
+        drop();
+        return;
+    }
+
+    size_t size = buffer->Size();
+    LogIndex::Entry entry;
+    entry.Offset = state.Offset;
+    entry.Length = static_cast<unsigned int>(size);
+    entry.Sequence = ++state.Sequence;
+    entry.Timestamp = buffer->Timestamp;
+    state.Offset += size;
+    if(state.Index >= 0)
+    {
+        size_t end = state.IndexData.size();
+        state.IndexData.resize(end + LogIndex::EntrySize);
+        LogIndex::EncodeEntry(entry, &state.IndexData[end]);
+    }
+    state.Pending = true;
+
+    if(state.Direct)
+    {   // copy the record into the aligned staging chunk, writing it each time it fills
+        const char* data = buffer->Data();
+        while(size > 0)
+        {
+            size_t n = ChunkSize - state.StagingSize;
+            if(n > size)
+                n = size;
+            std::memcpy(state.Staging + state.StagingSize, data, n);
+            state.StagingSize += n;
+            data += n;
+            size -= n;
+            if(state.StagingSize == ChunkSize)
+            {
+                state.Failed = !write(state, state.File, state.Staging, ChunkSize) || state.Failed;
+                state.StagingSize = 0;
+            }
+        }
+    }
+    else
+    {   // the record is written straight from the buffer, which is not recycled until the end of the batch
+        Segment segment;
+        segment.Data = buffer->Data();
+        segment.Size = size;
+        state.Segments.push_back(segment);
+        if(state.Segments.size() >= MaxSegments)
+            state.Failed = !writeSegments(state) || state.Failed;
+    }
+
+    pthread_mutex_lock(&m_counter_mutex);
+    m_num_written++;
+    pthread_mutex_unlock(&m_counter_mutex);
+}
+
+/*!
+  @brief Write a stream's pending records and index entries.
+  @param state The stream.
+  @param final True if the stream is being closed. An O_DIRECT stream otherwise keeps the unaligned end of its
+               staging chunk for the next batch.
+  */
+void LogWriterThread::flush(StreamState& state, bool final)
+{
+    if(state.Direct)
+    {
+        size_t aligned = state.StagingSize & ~(DirectAlignment - 1);
+        if(aligned > 0)
+        {
+            state.Failed = !write(state, state.File, state.Staging, aligned) || state.Failed;
+            state.StagingSize -= aligned;
+            std::memmove(state.Staging, state.Staging + aligned, state.StagingSize);
+        }
+        if(final && state.StagingSize > 0)
+        {   // the end of the file is not aligned, so it has to go through the page cache
+        #ifdef O_DIRECT
+            fcntl(state.File, F_SETFL, fcntl(state.File, F_GETFL) & ~O_DIRECT);
+        #endif
+            state.Failed = !write(state, state.File, state.Staging, state.StagingSize) || state.Failed;
+            state.StagingSize = 0;
+        }
+    }
+    else if(!state.Segments.empty())
+        state.Failed = !writeSegments(state) || state.Failed;
+
+    if(state.Index >= 0 && !state.IndexData.empty())
+    {
+        write(state, state.Index, &state.IndexData[0], state.IndexData.size());
+        state.IndexData.clear();
+    }
+    state.Pending = false;
+}
+
+/*!
+  @brief Write everything pending for a stream, close its files, and tell closeStream() it is closed.
+  @param state The stream.
+  */
+void LogWriterThread::close(StreamState& state)
+{
+    if(state.File >= 0)
+    {
+        flush(state, true);
+        sync(state, getTime(), true);
+        ::close(state.File);
+        state.File = -1;
+    }
+    if(state.Index >= 0)
+    {
+        ::close(state.Index);
+        state.Index = -1;
+    }
+    if(state.Staging)
+    {
+        free(state.Staging);
+        state.Staging = 0;
+    }
+    state.Direct = false;
+
+    pthread_mutex_lock(&m_condition_mutex);
+    state.Open = false;
+    pthread_cond_broadcast(&m_closed_condition);
+    pthread_mutex_unlock(&m_condition_mutex);
+}
+
+/*!
+  @brief Flush a stream's files to the disk, if it has been written to and it has been at least the sync period since the last time.
+  @param state The stream.
+  @param now The current time (ms).
+  @param force True to sync regardless of the time since the last sync.
+  */
+void LogWriterThread::sync(StreamState& state, double now, bool force)
+{
+    if(m_sync_period <= 0 || !state.Unsynced || (!force && now - state.LastSync < m_sync_period))
+        return;
+    double start = getTime();
+#if defined(WIN32)
+    _commit(state.File);
+    if(state.Index >= 0)
+        _commit(state.Index);
+#elif defined(__APPLE__)
+    fsync(state.File);
+    if(state.Index >= 0)
+        fsync(state.Index);
+#else
+    fdatasync(state.File);
+    if(state.Index >= 0)
+        fdatasync(state.Index);
+#endif
+    state.Unsynced = false;
+    state.LastSync = getTime();
+    countWrite(0, state.LastSync - start);
+}
+
+/*!
+  @brief Return a buffer to the free list once its record has been written, releasing its memory if it has grown past its share of the cap.
+  @param buffer The buffer.
+  */
+void LogWriterThread::recycle(LogWriterBuffer* buffer)
+{
+    if(buffer->Close)
+        return;
+    __sync_sub_and_fetch(&m_queued_bytes, static_cast<long>(buffer->Size()));
+    if(buffer->Capacity() > m_memory_cap/m_buffers.size())
+        buffer->Release();
+    bool wasEmpty;
+    m_free.push(buffer, wasEmpty);
+}
+
+/*!
+  @brief Write a stream's pending records, with as few calls as possible.
+  @param state The stream.
+  @return True if every record was written.
+  */
+bool LogWriterThread::writeSegments(StreamState& state)
+{
+    bool success = true;
+#ifndef WIN32
+    iovec iov[MaxSegments];
+    size_t total = 0;
+    int count = 0;
+    for(size_t i = 0; i < state.Segments.size(); ++i)
+    {
+        iov[count].iov_base = const_cast<char*>(state.Segments[i].Data);
+        iov[count].iov_len = state.Segments[i].Size;
+        total += state.Segments[i].Size;
+        count++;
+    }
+
+    iovec* next = iov;
+    double start = getTime();
+    size_t written = 0;
+    while(count > 0)
+    {
+        ssize_t n = writev(state.File, next, count);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            errorlog << "LogWriterThread::writeSegments(). Write failed, errno: " << errno << std::endl;
+            success = false;
+            break;
+        }
+        written += n;
+        // skip over the records that have been written completely, and advance into the partially written one
+        size_t remaining = n;
+        while(count > 0 && remaining >= next->iov_len)
+        {
+            remaining -= next->iov_len;
+            next++;
+            count--;
+        }
+        if(count > 0)
+        {
+            next->iov_base = static_cast<char*>(next->iov_base) + remaining;
+            next->iov_len -= remaining;
+        }
+    }
+    countWrite(written, getTime() - start);
+    state.Unsynced = state.Unsynced || written > 0;
+    success = success && written == total;
+#else
+    for(size_t i = 0; i < state.Segments.size() && success; ++i)
+        success = write(state, state.File, state.Segments[i].Data, state.Segments[i].Size);
+#endif
+    state.Segments.clear();
+    return success;
+}
+
+/*!
+  @brief Write a block of data to one of a stream's files, timing it.
+  @param state The stream.
+  @param file The stream's file or index file.
+  @param data The data.
+  @param size The number of bytes.
+  @return True if every byte was written.
+  */
+bool LogWriterThread::write(StreamState& state, int file, const char* data, size_t size)
+{
+    double start = getTime();
+    size_t written = 0;
+    while(written < size)
+    {
+        int n = ::write(file, data + written, size - written);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+        {
+            errorlog << "LogWriterThread::write(). Write failed, errno: " << errno << std::endl;
+            break;
+        }
+        written += n;
+    }
+    countWrite(written, getTime() - start);
+    state.Unsynced = state.Unsynced || written > 0;
+    return written == size;
+}
+
+/*!
+  @brief Count a write, or a sync, of the files.
+  @param bytes The number of bytes written.
+  @param latency The time taken (ms).
+  */
+void LogWriterThread::countWrite(size_t bytes, double latency)
+{
+    pthread_mutex_lock(&m_counter_mutex);
+    m_bytes_written += bytes;
+    m_num_writes++;
+    m_total_latency += latency;
+    if(latency > m_max_latency)
+        m_max_latency = latency;
+    pthread_mutex_unlock(&m_counter_mutex);
+}
+
+/*!
+  @brief Count a dropped record.
+  */
+void LogWriterThread::drop()
+{
+    __sync_add_and_fetch(&m_num_dropped, 1);
+}
+
+/*!
+  @brief Get the current time (ms). Only differences between times are used.
+  */
+double LogWriterThread::getTime()
+{
+    timeval now;
+    gettimeofday(&now, 0);
+    return 1e3*now.tv_sec + 1e-3*now.tv_usec;
+}
+
+/*!
+  @brief Unlocks the mutex. Used as a cancellation cleanup handler.
+  */
+void LogWriterThread::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
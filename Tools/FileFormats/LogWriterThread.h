@@ -0,0 +1,173 @@
+/*! @file LogWriterThread.h
+    @brief Declaration of the background writer used by the LogRecorder.
+
+    @class LogWriterBuffer
+    @brief A reusable, seekable output buffer holding one serialised record.
+
+    The buffer keeps its memory between records, so once it has grown to the size of the largest
+    record written to it there are no further allocations. It supports seekp() within what has
+    been written, so LogRecord::Write can back-patch its header in place.
+
+    @class LogWriterThread
+    @brief A thread that writes serialised records to the stream files, so that the disk never blocks the caller.
+
+    The producer (the LogRecorder in the SeeThinkThread) gets an empty buffer with acquire(), serialises
+    a record into it, and queues it with submit(). The buffers are preallocated and reused, and passed to
+    the writer through a LockFreeQueue, so the producer never waits on the disk. The only lock it takes is
+    the writer's condition mutex, for the moment it takes to wake the writer when its queue was empty.
+    Only one thread should acquire and submit buffers, and open and close streams.
+
+    Memory is bounded in two ways:
+        - the number of buffers is fixed; when every buffer is queued acquire() drops the new record.
+        - the bytes queued are capped; when a record would exceed the cap submit() drops it.
+    A buffer that has grown past its share of the cap has its memory released once it has been written.
+
+    The writer drains everything queued and coalesces the records for each stream into a single writev(),
+    or into ChunkSize writes when the stream was opened with O_DIRECT. The sidecar index entries (see
+    LogIndex) are written after each batch. Each stream is flushed to the disk with fdatasync() every
+    sync period, if it is non-zero.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGWRITERTHREAD_H
+#define LOGWRITERTHREAD_H
+
+#include "Tools/Threading/QueueThread.h"
+#include "Tools/Threading/LockFreeQueue.h"
+
+#include <pthread.h>
+#include <streambuf>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class LogWriterBuffer : public std::streambuf
+{
+public:
+    LogWriterBuffer();
+
+    void Reset(int stream);
+    void Release();
+
+    std::ostream& Output() {return m_output;}
+    const char* Data() const {return m_data.empty() ? 0 : &m_data[0];}
+    size_t Size() const;
+    size_t Capacity() const {return m_data.size();}
+
+    int Stream;             //!< The stream the record is to be written to.
+    double Timestamp;       //!< The record's timestamp (ms), used for the index.
+    bool Close;             //!< True if this is not a record, but a request to close the stream.
+
+protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char* s, std::streamsize n);
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+private:
+    void Grow(size_t required);
+
+    std::vector<char> m_data;   //!< The storage, pbase() to epptr().
+    size_t m_end;               //!< The end of what has been written, which can be past pptr() after a seekp().
+    std::ostream m_output;      //!< The stream the record is serialised with.
+};
+
+class LogWriterThread : public QueueThread<LogWriterBuffer*>
+{
+public:
+    static const unsigned int MaxStreams = 8;           //!< The maximum number of streams open at once.
+    static const unsigned int MaxSegments = 64;         //!< The maximum number of records coalesced into a single writev().
+    static const size_t ChunkSize = 256*1024;           //!< The size of each write to a stream opened with O_DIRECT.
+    static const size_t DirectAlignment = 4096;         //!< The alignment of the memory, sizes and offsets used with O_DIRECT.
+
+    LogWriterThread(size_t memorycap = 16*1024*1024, unsigned int numbuffers = 16, int syncperiod = 1000);
+    ~LogWriterThread();
+
+    int openStream(const std::string& filename, bool direct = false);
+    void closeStream(int stream);
+
+    LogWriterBuffer* acquire(int stream);
+    void submit(LogWriterBuffer* buffer);
+
+    size_t getQueuedBytes();
+    unsigned long getNumWritten();
+    unsigned long getNumDropped();
+    unsigned long long getBytesWritten();
+    double getMaxWriteLatency();
+    double getAverageWriteLatency();
+
+private:
+    struct Segment
+    {
+        const char* Data;
+        size_t Size;
+    };
+    struct StreamState
+    {
+        bool Open;                      //!< True from openStream() until the writer has closed the files.
+        bool Failed;                    //!< True if a write failed; the rest of the stream's records are dropped.
+        bool Direct;                    //!< True if the file was opened with O_DIRECT.
+        int File;                       //!< The stream file.
+        int Index;                      //!< The sidecar index file, -1 if it could not be opened.
+        unsigned long long Offset;      //!< The number of bytes of records in the stream.
+        unsigned int Sequence;          //!< The sequence number of the last record in the stream.
+        std::vector<Segment> Segments;  //!< The records waiting to be written with writev().
+        char* Staging;                  //!< The aligned chunk used to write to an O_DIRECT stream.
+        size_t StagingSize;             //!< The number of bytes in Staging.
+        std::vector<char> IndexData;    //!< The index entries waiting to be written.
+        bool Pending;                   //!< True if there are records or index entries waiting to be written.
+        bool Unsynced;                  //!< True if there has been a write since the last fdatasync().
+        double LastSync;                //!< The time of the last fdatasync() (ms).
+        LogWriterBuffer CloseRequest;   //!< The record queued by closeStream().
+    };
+
+    void run();
+    void process(LogWriterBuffer* buffer);
+    void flush(StreamState& state, bool final);
+    void close(StreamState& state);
+    void sync(StreamState& state, double now, bool force);
+    void recycle(LogWriterBuffer* buffer);
+    bool writeSegments(StreamState& state);
+    bool write(StreamState& state, int file, const char* data, size_t size);
+    void countWrite(size_t bytes, double latency);
+    void drop();
+    static double getTime();
+    static void unlockMutex(void* mutex);
+
+private:
+    const size_t m_memory_cap;                  //!< The maximum number of bytes queued.
+    const int m_sync_period;                    //!< The time between each fdatasync() (ms), 0 to never sync.
+    std::vector<LogWriterBuffer*> m_buffers;    //!< All of the record buffers.
+    LockFreeQueue<LogWriterBuffer*> m_free;     //!< The record buffers not in use.
+    StreamState m_streams[MaxStreams];          //!< The streams, indexed by the id returned from openStream().
+    std::vector<LogWriterBuffer*> m_batch;      //!< The records drained from the queue by the writer.
+    volatile long m_queued_bytes;               //!< The number of bytes submitted but not yet written.
+
+    pthread_cond_t m_closed_condition;          //!< Signalled, with m_condition_mutex, when the writer closes a stream.
+
+    volatile unsigned long m_num_dropped;       //!< The number of records dropped, counted atomically as the producer drops records too.
+    pthread_mutex_t m_counter_mutex;            //!< Lock for the writer's counters.
+    unsigned long m_num_written;                //!< The number of records written.
+    unsigned long long m_bytes_written;         //!< The number of bytes written, including the index.
+    unsigned long m_num_writes;                 //!< The number of writes and syncs of the files.
+    double m_total_latency;                     //!< The total time spent writing and syncing the files (ms).
+    double m_max_latency;                       //!< The longest time spent in a single write or sync (ms).
+};
+
+#endif // LOGWRITERTHREAD_H
@@ -26,6 +26,12 @@ NUbotImage.cpp
 Parse.cpp
 LogRecorder.cpp
 LogRecorder.h
+LogRecord.cpp
+LogRecord.h
+LogIndex.cpp
+LogIndex.h
+LogWriterThread.cpp
+LogWriterThread.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
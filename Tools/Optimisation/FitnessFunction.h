@@ -0,0 +1,50 @@
+/*! @file FitnessFunction.h
+    @brief Declaration of an abstract fitness function for offline optimisation
+
+    @class FitnessFunction
+    @brief An abstract fitness function that evaluates a set of parameters without the robot.
+
+    The ParallelEvaluator runs several evaluations at once, one per thread, so it needs one
+    FitnessFunction per thread. Each FitnessFunction must therefore be able to clone() itself,
+    and must not share mutable state (including the global Blackboard) with its clones. See
+    JuppWalkModel for a fitness function that runs a walk engine.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FITNESS_FUNCTION_H
+#define FITNESS_FUNCTION_H
+
+#include <vector>
+using namespace std;
+
+class FitnessFunction
+{
+public:
+    virtual ~FitnessFunction() {};
+
+    /*! @brief Returns the fitness of the parameters, one entry for each objective. The higher the fitness the better the parameters. */
+    virtual vector<float> evaluate(const vector<float>& parameters) = 0;
+    /*! @brief Returns the number of objectives, ie. the size of the vector returned by evaluate() */
+    virtual unsigned int getNumObjectives() const = 0;
+    /*! @brief Returns a new, independent, copy of this fitness function. The caller owns the copy. */
+    virtual FitnessFunction* clone() const = 0;
+};
+
+#endif
+
@@ -0,0 +1,96 @@
+/*! @file JuppWalkOptimisation.cpp
+    @brief Optimises the JuppWalk's parameters offline, on a kinematic model of the walk, using every core of the machine.
+
+    Each batch of candidates from the optimiser (a PSO swarm, or a PGRL gradient estimate) is evaluated by a
+    ParallelEvaluator on a JuppWalkModel per thread. The optimiser is saved to DATA_DIR/Optimisation/<name>.log
+    after every batch, and loaded from there when it is constructed, so a run that is stopped resumes from its
+    last completed batch when it is started again with the same optimiser. Delete the log to start again.
+
+    This is not part of the nubot build. It needs the objects of a nubot build with the JuppWalk, so build a
+    target (eg. Replay in Build/Replay) and then:
+        ar rcs libnubot.a $(find Build/Replay/CMakeFiles/nubot.dir -name '*.o' ! -name main.cpp.o)
+        g++ -O2 -pthread -I. -INUView/NUViewConfig Tools/Optimisation/Headless/JuppWalkOptimisation.cpp libnubot.a -o juppwalkoptimisation
+        ./juppwalkoptimisation [PSO|PGRL] [batches] [threads]
+    By default it runs 10 batches of PSO with a thread per core. The debug output, including the fitness of every
+    candidate, goes to DATA_DIR/debug.log.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NUPlatform/NUPlatform.h"
+#include "Motion/Walks/JuppWalk/JuppWalkModel.h"
+#include "Tools/Optimisation/ParallelEvaluator.h"
+#include "Tools/Optimisation/PSOOptimiser.h"
+#include "Tools/Optimisation/PGRLOptimiser.h"
+#include "nubotdataconfig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+int main(int argc, char** argv)
+{
+    std::string type = argc > 1 ? argv[1] : "PSO";
+    unsigned int numbatches = argc > 2 ? atoi(argv[2]) : 10;
+    long numthreads = argc > 3 ? atol(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (numthreads < 1)
+        numthreads = 1;
+    if (type != "PSO" and type != "PGRL")
+    {
+        printf("Usage: %s [PSO|PGRL] [batches] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    Platform = new NUPlatform();
+    debug.open((DATA_DIR + "debug.log").c_str());
+    errorlog.open((DATA_DIR + "error.log").c_str());
+
+    JuppWalkModel model;
+    std::vector<Parameter> parameters = model.getInitialParameters();
+    std::vector<float> initial;
+    for (size_t i=0; i<parameters.size(); i++)
+        initial.push_back(parameters[i].get());
+    std::vector<float> fitness = model.evaluate(initial);
+    printf("The default parameters have a speed of %.2fcm/s and a cost fitness of %.2f\n", fitness[0], fitness[1]);
+
+    Optimiser* optimiser;
+    if (type == "PGRL")
+        optimiser = new PGRLOptimiser("JuppWalkModelPGRL", parameters);
+    else
+        optimiser = new PSOOptimiser("JuppWalkModelPSO", parameters);
+
+    double starttime = Platform->getRealTime();
+    ParallelEvaluator evaluator(model, numthreads);
+    for (unsigned int i=0; i<numbatches; i++)
+    {
+        evaluator.optimise(optimiser, 1);
+        printf("Batch %u of %u done, %u candidates evaluated\n", i + 1, numbatches, evaluator.getNumEvaluations());
+        fflush(stdout);
+    }
+    double elapsed = Platform->getRealTime() - starttime;
+    printf("Evaluated %u candidates on %ld threads in %.1fs\n", evaluator.getNumEvaluations(), numthreads, elapsed/1000);
+    printf("The optimiser was saved to %s\n", (DATA_DIR + "Optimisation/" + optimiser->getName() + ".log").c_str());
+    delete optimiser;
+    return 0;
+}
+
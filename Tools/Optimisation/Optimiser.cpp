@@ -54,6 +54,37 @@ void Optimiser::setParametersResult(const vector<float>& fitness)
 		setParametersResult(fitness[0]);
 }
 
+/*! @brief Returns all of the parameters that can be evaluated before the optimiser needs any of their results.
+ 
+           The default returns just getNextParameters(). Population based optimisers override this to return the rest 
+           of the current population, so that the candidates can be evaluated in parallel. The results must be given 
+           back with setBatchResult, in the same order.
+    @return the parameters to evaluate
+ */
+vector<vector<float> > Optimiser::getNextParametersBatch()
+{
+    return vector<vector<float> >(1, getNextParameters());
+}
+
+/*! @brief Gives the optimiser the result of each set of parameters returned by getNextParametersBatch(). This is exactly 
+           equivalent to evaluating each set of parameters in turn.
+ 	@param fitnesses the fitness of each set of parameters, in the order they were returned by getNextParametersBatch()
+ */
+void Optimiser::setBatchResult(const vector<float>& fitnesses)
+{
+    for (size_t i=0; i<fitnesses.size(); i++)
+        setParametersResult(fitnesses[i]);
+}
+
+/*! @brief Gives the optimiser the (multi-objective) result of each set of parameters returned by getNextParametersBatch().
+ 	@param fitnesses the fitnesses of each set of parameters, in the order they were returned by getNextParametersBatch()
+ */
+void Optimiser::setBatchResult(const vector<vector<float> >& fitnesses)
+{
+    for (size_t i=0; i<fitnesses.size(); i++)
+        setParametersResult(fitnesses[i]);
+}
+
 /*! @brief Returns the optimiser's name
     @return the optimiser's name
 */
@@ -42,6 +42,10 @@ public:
     virtual void setParametersResult(float fitness) = 0;
     virtual void setParametersResult(const vector<float>& fitness);
     
+    virtual vector<vector<float> > getNextParametersBatch();
+    void setBatchResult(const vector<float>& fitnesses);
+    void setBatchResult(const vector<vector<float> >& fitnesses);
+    
     string& getName();
     virtual void summaryTo(ostream& stream) = 0;
     friend ostream& operator<<(ostream& o, const Optimiser& optimser);
@@ -99,6 +99,12 @@ vector<float> PGRLOptimiser::getNextParameters()
     return m_random_policies[m_random_policies_index];
 }
 
+/*! @brief Returns all of the random policies that haven't been evaluated for the current gradient estimate */
+vector<vector<float> > PGRLOptimiser::getNextParametersBatch()
+{
+    return vector<vector<float> >(m_random_policies.begin() + m_random_policies_index, m_random_policies.end());
+}
+
 /*! @brief Generates a set of policies from the seed to estimate the gradient
  */
 void PGRLOptimiser::generatePolicies()
@@ -39,6 +39,7 @@ public:
     ~PGRLOptimiser();
     
     vector<float> getNextParameters();
+    vector<vector<float> > getNextParametersBatch();
     void setParametersResult(const vector<float>& fitness);
     void setParametersResult(float fitness);
     
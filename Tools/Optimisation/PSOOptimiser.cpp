@@ -97,6 +97,15 @@ vector<float> PSOOptimiser::getNextParameters()
     return Parameter::getAsVector(m_swarm_position[m_swarm_fitness.size()]);
 }
 
+/*! @brief Returns the positions of all of the particles that haven't been evaluated this iteration */
+vector<vector<float> > PSOOptimiser::getNextParametersBatch()
+{
+    vector<vector<float> > batch;
+    for (size_t i=m_swarm_fitness.size(); i<m_swarm_position.size(); i++)
+        batch.push_back(Parameter::getAsVector(m_swarm_position[i]));
+    return batch;
+}
+
 void PSOOptimiser::updateSwarm()
 {
     debug << "Fitnesses: " << m_swarm_fitness << endl;
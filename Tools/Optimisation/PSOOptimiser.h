@@ -39,6 +39,7 @@ public:
     ~PSOOptimiser();
     
     vector<float> getNextParameters();
+    vector<vector<float> > getNextParametersBatch();
     void setParametersResult(float fitness);
     
     void summaryTo(ostream& stream);
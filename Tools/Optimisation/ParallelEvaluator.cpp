@@ -0,0 +1,146 @@
+/*! @file ParallelEvaluator.cpp
+    @brief Implementation of the parallel optimisation driver
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ParallelEvaluator.h"
+#include "FitnessFunction.h"
+#include "Optimiser.h"
+
+#include <pthread.h>
+#include <exception>
+
+#include "debug.h"
+
+/*! @brief Constructs a parallel evaluator
+    @param fitness the fitness function. Each thread gets its own clone, so the caller keeps ownership of fitness
+    @param numthreads the number of evaluations to run at once. Usually the number of cores.
+ */
+ParallelEvaluator::ParallelEvaluator(const FitnessFunction& fitness, unsigned int numthreads)
+{
+    if (numthreads == 0)
+        numthreads = 1;
+    for (unsigned int i=0; i<numthreads; i++)
+    {
+        Worker worker;
+        worker.Evaluator = this;
+        worker.Function = fitness.clone();
+        m_workers.push_back(worker);
+    }
+    m_candidates = 0;
+    m_next_candidate = 0;
+    m_num_evaluations = 0;
+}
+
+ParallelEvaluator::~ParallelEvaluator()
+{
+    for (size_t i=0; i<m_workers.size(); i++)
+        delete m_workers[i].Function;
+}
+
+/*! @brief Evaluates each of the candidates, using all of the threads. Blocks until every candidate has been evaluated.
+    @param candidates the parameters to evaluate
+    @return the fitnesses of each candidate, in the same order as the candidates
+ */
+vector<vector<float> > ParallelEvaluator::evaluate(const vector<vector<float> >& candidates)
+{
+    m_candidates = &candidates;
+    m_results = vector<vector<float> >(candidates.size());
+    m_next_candidate = 0;
+    __sync_synchronize();
+
+    size_t numthreads = m_workers.size() < candidates.size() ? m_workers.size() : candidates.size();
+    vector<pthread_t> threads(numthreads);
+    vector<bool> started(numthreads, false);
+    for (size_t i=0; i<numthreads; i++)
+    {
+        int err = pthread_create(&threads[i], NULL, runWorker, (void*) &m_workers[i]);
+        if (err != 0)
+            errorlog << "ParallelEvaluator::evaluate(). Failed to create worker " << i << ". The error code was: " << err << endl;
+        else
+            started[i] = true;
+    }
+
+    bool anystarted = false;
+    for (size_t i=0; i<numthreads; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+            anystarted = true;
+        }
+    }
+    if (not anystarted and not m_workers.empty())
+        runWorker((void*) &m_workers[0]);          // fall back to evaluating everything on this thread
+
+    m_num_evaluations += candidates.size();
+    m_candidates = 0;
+    return m_results;
+}
+
+/*! @brief Runs the optimiser for a number of batches, saving the optimiser after every batch.
+    @param optimiser the optimiser to run
+    @param numbatches the number of batches to evaluate
+ */
+void ParallelEvaluator::optimise(Optimiser* optimiser, unsigned int numbatches)
+{
+    if (optimiser == 0)
+        return;
+    for (unsigned int i=0; i<numbatches; i++)
+    {
+        vector<vector<float> > batch = optimiser->getNextParametersBatch();
+        vector<vector<float> > results = evaluate(batch);
+        optimiser->setBatchResult(results);
+        optimiser->save();
+        debug << "ParallelEvaluator::optimise(). " << optimiser->getName() << " completed batch " << i << " of " << batch.size() << " candidates. Total evaluations: " << m_num_evaluations << endl;
+    }
+}
+
+/*! @brief Returns the total number of candidates that have been evaluated */
+unsigned int ParallelEvaluator::getNumEvaluations() const
+{
+    return m_num_evaluations;
+}
+
+/*! @brief The main loop of a worker thread. Claims candidates one at a time until there are none left.
+    @param arg a pointer to the Worker
+ */
+void* ParallelEvaluator::runWorker(void* arg)
+{
+    Worker* worker = reinterpret_cast<Worker*>(arg);
+    ParallelEvaluator* evaluator = worker->Evaluator;
+    const vector<vector<float> >& candidates = *(evaluator->m_candidates);
+
+    unsigned int index = __sync_fetch_and_add(&evaluator->m_next_candidate, 1);
+    while (index < candidates.size())
+    {
+        try
+        {
+            evaluator->m_results[index] = worker->Function->evaluate(candidates[index]);
+        }
+        catch (std::exception& e)
+        {
+            errorlog << "ParallelEvaluator::runWorker(). Evaluation of candidate " << index << " failed: " << e.what() << endl;
+            evaluator->m_results[index] = vector<float>(worker->Function->getNumObjectives(), 0);
+        }
+        index = __sync_fetch_and_add(&evaluator->m_next_candidate, 1);
+    }
+    return arg;
+}
+
@@ -0,0 +1,67 @@
+/*! @file ParallelEvaluator.h
+    @brief Declaration of a headless driver that evaluates an optimiser's candidates in parallel
+
+    @class ParallelEvaluator
+    @brief Runs an Optimiser against a FitnessFunction, evaluating each batch of candidates across several threads.
+
+    Each iteration the optimiser is asked for every candidate it can have evaluated at once
+    (Optimiser::getNextParametersBatch(); the rest of a PSO swarm, or a PGRL gradient estimate),
+    the candidates are shared between the worker threads, and the results are given back to the
+    optimiser in order. The optimiser is then saved, so an interrupted run resumes from the
+    last completed batch the next time the optimiser is constructed with the same name.
+
+    @author agent
+
+  Copyright (c) 2026 agent
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PARALLEL_EVALUATOR_H
+#define PARALLEL_EVALUATOR_H
+
+class Optimiser;
+class FitnessFunction;
+
+#include <vector>
+using namespace std;
+
+class ParallelEvaluator
+{
+public:
+    ParallelEvaluator(const FitnessFunction& fitness, unsigned int numthreads);
+    ~ParallelEvaluator();
+
+    vector<vector<float> > evaluate(const vector<vector<float> >& candidates);
+    void optimise(Optimiser* optimiser, unsigned int numbatches);
+
+    unsigned int getNumEvaluations() const;
+private:
+    struct Worker
+    {
+        ParallelEvaluator* Evaluator;                   //!< the evaluator the worker belongs to
+        FitnessFunction* Function;                      //!< the worker's own copy of the fitness function
+    };
+    static void* runWorker(void* arg);
+private:
+    vector<Worker> m_workers;                           //!< one worker per thread
+
+    const vector<vector<float> >* m_candidates;         //!< the batch currently being evaluated
+    vector<vector<float> > m_results;                   //!< the fitnesses of the current batch
+    volatile unsigned int m_next_candidate;             //!< the index of the next candidate to be claimed by a worker
+    unsigned int m_num_evaluations;                     //!< the total number of evaluations performed
+};
+
+#endif
+
@@ -25,6 +25,8 @@ SET (YOUR_SRCS Optimiser.h  Optimiser.cpp
                PGRLOptimiser.h PGRLOptimiser.cpp	
                PSOOptimiser.h PSOOptimiser.cpp
                Parameter.h  Parameter.cpp
+               FitnessFunction.h
+               ParallelEvaluator.h ParallelEvaluator.cpp
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
@@ -46,6 +46,12 @@ ConditionalThread::ConditionalThread(string name, unsigned char priority) : Thre
     if (err != 0)
         errorlog << "ConditionalThread::ConditionalThread(" << m_name << ") Failed to create m_condition." << endl;
     
+    err = pthread_cond_init(&m_idle_condition, NULL);
+    if (err != 0)
+        errorlog << "ConditionalThread::ConditionalThread(" << m_name << ") Failed to create m_idle_condition." << endl;
+    m_num_signals = 0;
+    m_num_waits = 0;
+    
     err = pthread_mutex_init(&m_running_mutex, NULL);
     if (err != 0)
         errorlog << "ConditionalThread::ConditionalThread(" << m_name << ") Failed to create m_running_mutex." << endl;
@@ -61,6 +67,7 @@ ConditionalThread::~ConditionalThread()
     #endif
     stop();
     pthread_cond_destroy(&m_condition);
+    pthread_cond_destroy(&m_idle_condition);
     pthread_mutex_destroy(&m_condition_mutex);
     pthread_mutex_destroy(&m_running_mutex);
 }
@@ -87,6 +94,7 @@ void ConditionalThread::signal(bool blocking)
     	}
     }
 	pthread_mutex_lock(&m_condition_mutex);
+	m_num_signals++;
 	pthread_cond_signal(&m_condition);
 	pthread_mutex_unlock(&m_running_mutex);
 	pthread_mutex_unlock(&m_condition_mutex);
@@ -110,6 +118,8 @@ void ConditionalThread::wait()
         debug << "ConditionalThread: " << m_name << " is waiting at " << Platform->getTime() << endl;
     #endif
     pthread_mutex_lock(&m_condition_mutex);
+    m_num_waits++;
+    pthread_cond_broadcast(&m_idle_condition);
 	pthread_mutex_unlock(&m_running_mutex);
     pthread_cond_wait(&m_condition, &m_condition_mutex);
     pthread_mutex_lock(&m_running_mutex);
@@ -118,3 +128,16 @@ void ConditionalThread::wait()
         debug << "ConditionalThread: " << m_name << " finished waiting at " << Platform->getTime() << endl;
     #endif
 }
+
+/*! @brief Blocks the calling thread until this thread has finished the executions it has been signalled to do, and is waiting for the next signal
+
+    A thread that is signalled and then waited for in turn runs in lock step with the caller, which is used to get the same result every time 
+    the threads are run on the same data (ie. on the Replay platform).
+ */
+void ConditionalThread::waitForIdle()
+{
+    pthread_mutex_lock(&m_condition_mutex);
+    while (m_num_waits <= m_num_signals)
+        pthread_cond_wait(&m_idle_condition, &m_condition_mutex);
+    pthread_mutex_unlock(&m_condition_mutex);
+}
@@ -42,6 +42,7 @@ class ConditionalThread : public Thread
     
         void signal();
         void signal(bool blocking);
+        void waitForIdle();
     
     protected:
         virtual void run() = 0;                // To be overridden by code to run.
@@ -51,5 +52,8 @@ class ConditionalThread : public Thread
         pthread_mutex_t m_condition_mutex;     //!< lock for new data signal
         pthread_cond_t m_condition;            //!< signal for new data
         pthread_mutex_t m_running_mutex;       //!< mutex to indicate that the main loop is currently executing
+        pthread_cond_t m_idle_condition;       //!< signal for the thread starting to wait
+        unsigned long m_num_signals;           //!< the number of signals sent to the thread
+        unsigned long m_num_waits;             //!< the number of times the thread has started waiting
 };
 #endif
@@ -0,0 +1,246 @@
+/*!  @file LockFreeQueue.cpp
+     @brief Implementation of the LockFreeQueue class.
+
+     The algorithm is the bounded queue with per-cell sequence numbers described by
+     Dmitry Vyukov. The GCC __sync builtins are used for the atomic operations and barriers.
+
+     @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LockFreeQueue.h"
+
+#include <sched.h>
+
+/*! @brief Creates an empty queue
+    @param capacity the maximum number of items in the queue. This will be rounded up to the nearest power of two.
+    @param policy what to do when pushing onto a full queue
+ */
+template <typename T>
+LockFreeQueue<T>::LockFreeQueue(size_t capacity, FullPolicy policy) : m_mask(roundUpToPowerOfTwo(capacity) - 1), m_policy(policy)
+{
+    m_buffer = new Cell[m_mask + 1];
+    for (size_t i=0; i<=m_mask; i++)
+        m_buffer[i].Sequence = i;
+    m_head = 0;
+    m_tail = 0;
+    m_count = 0;
+    m_num_dropped = 0;
+    __sync_synchronize();
+}
+
+/*! @brief Destroys the queue. Any data left in the queue is discarded.
+ */
+template <typename T>
+LockFreeQueue<T>::~LockFreeQueue()
+{
+    delete [] m_buffer;
+}
+
+/*! @brief Adds data to the back of the queue. This is safe to call from multiple threads at the same time.
+
+    If the queue is full then either we wait for the consumer to make room, or the oldest item
+    is discarded, depending on the queue's FullPolicy.
+
+    @param data the data to add to the queue
+    @param wasEmpty will be set to true if the queue was empty before this push, that is when the consumer might need to be woken
+    @return true if the data was added without discarding any old data, false if old data had to be dropped
+ */
+template <typename T>
+bool LockFreeQueue<T>::push(const T& data, bool& wasEmpty)
+{
+    bool nothingdropped = true;
+    while (not tryPush(data))
+    {
+        if (m_policy == DropOldestWhenFull)
+        {   // make room by throwing away the oldest item. The consumer may beat us to it, in which case there will be room anyway
+            T oldest;
+            if (tryPop(oldest))
+            {
+                __sync_fetch_and_sub(&m_count, 1);
+                __sync_fetch_and_add(&m_num_dropped, 1);
+                nothingdropped = false;
+            }
+        }
+        else
+            sched_yield();
+    }
+    long previouscount = __sync_fetch_and_add(&m_count, 1);
+    wasEmpty = previouscount <= 0;
+    return nothingdropped;
+}
+
+/*! @brief Removes the front of the queue. This should only be called by the consumer thread.
+    @param data will be updated with the front of the queue
+    @return true if there was data in the queue, false if the queue was empty
+ */
+template <typename T>
+bool LockFreeQueue<T>::pop(T& data)
+{
+    if (tryPop(data))
+    {
+        __sync_fetch_and_sub(&m_count, 1);
+        return true;
+    }
+    else
+        return false;
+}
+
+/*! @brief Removes everything currently in the queue in a single pass. This should only be called by the consumer thread.
+    @param data the contents of the queue will be appended to this vector, oldest first
+    @return the number of items removed from the queue
+ */
+template <typename T>
+size_t LockFreeQueue<T>::drain(std::vector<T>& data)
+{
+    size_t n = 0;
+    T item;
+    while (tryPop(item))
+    {
+        data.push_back(item);
+        n++;
+    }
+    if (n > 0)
+        __sync_fetch_and_sub(&m_count, static_cast<long>(n));
+    return n;
+}
+
+/*! @brief Returns true if the queue appears to be empty.
+           Note. Producers may be in the middle of a push, so this is only a hint.
+ */
+template <typename T>
+bool LockFreeQueue<T>::empty() const
+{
+    return load(m_count) <= 0;
+}
+
+/*! @brief Returns the approximate number of items in the queue
+ */
+template <typename T>
+long LockFreeQueue<T>::size() const
+{
+    return load(m_count);
+}
+
+/*! @brief Returns the maximum number of items that can be stored in the queue
+ */
+template <typename T>
+size_t LockFreeQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+/*! @brief Returns the total number of items that have been discarded to make room for new data
+ */
+template <typename T>
+unsigned long LockFreeQueue<T>::getNumDropped() const
+{
+    return load(m_num_dropped);
+}
+
+/*! @brief Returns the policy used when pushing onto a full queue
+ */
+template <typename T>
+typename LockFreeQueue<T>::FullPolicy LockFreeQueue<T>::getPolicy() const
+{
+    return m_policy;
+}
+
+/*! @brief Attempts to add data to the queue without waiting
+    @return true if successful, false if the queue was full
+ */
+template <typename T>
+bool LockFreeQueue<T>::tryPush(const T& data)
+{
+    Cell* cell;
+    size_t position = load(m_tail);
+    while (true)
+    {
+        cell = &m_buffer[position & m_mask];
+        size_t sequence = load(cell->Sequence);
+        long difference = static_cast<long>(sequence) - static_cast<long>(position);
+        if (difference == 0)
+        {   // the cell is free, so try to claim it
+            if (__sync_bool_compare_and_swap(&m_tail, position, position + 1))
+                break;
+            position = load(m_tail);
+        }
+        else if (difference < 0)
+            return false;                               // the cell still holds data from the previous lap, so the queue is full
+        else
+            position = load(m_tail);                    // another producer claimed the cell first
+    }
+    cell->Data = data;
+    __sync_fetch_and_add(&cell->Sequence, 1);           // publish the data; the Sequence goes from position to position + 1
+    return true;
+}
+
+/*! @brief Attempts to remove the front of the queue without waiting
+    @return true if successful, false if the queue was empty
+ */
+template <typename T>
+bool LockFreeQueue<T>::tryPop(T& data)
+{
+    Cell* cell;
+    size_t position = load(m_head);
+    while (true)
+    {
+        cell = &m_buffer[position & m_mask];
+        size_t sequence = load(cell->Sequence);
+        long difference = static_cast<long>(sequence) - static_cast<long>(position + 1);
+        if (difference == 0)
+        {   // the cell has been published, so try to claim it (a producer dropping old data may be competing with us)
+            if (__sync_bool_compare_and_swap(&m_head, position, position + 1))
+                break;
+            position = load(m_head);
+        }
+        else if (difference < 0)
+            return false;                               // the cell has not been published yet, so the queue is empty
+        else
+            position = load(m_head);
+    }
+    data = cell->Data;
+    __sync_fetch_and_add(&cell->Sequence, m_mask);      // free the cell for the next lap; the Sequence goes from position + 1 to position + m_mask + 1
+    return true;
+}
+
+/*! @brief Reads a value shared with other threads, so that the read of a cell's Sequence is ordered before the read 
+           or write of its Data. Compilers with the __atomic builtins do this with a plain load on x86; older ones
+           fall back to a __sync read-modify-write, which is a full barrier.
+ */
+template <typename T>
+template <typename V>
+V LockFreeQueue<T>::load(const volatile V& value)
+{
+    #if defined(__ATOMIC_SEQ_CST)
+        return __atomic_load_n(&value, __ATOMIC_SEQ_CST);
+    #else
+        return __sync_fetch_and_add(const_cast<volatile V*>(&value), 0);
+    #endif
+}
+
+/*! @brief Returns the smallest power of two greater than or equal to value
+ */
+template <typename T>
+size_t LockFreeQueue<T>::roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
@@ -0,0 +1,97 @@
+/*! @file LockFreeQueue.h
+    @brief Declaration of the LockFreeQueue class.
+
+    @class LockFreeQueue
+    @brief A bounded, lock-free, multi-producer single-consumer ring buffer.
+
+    Each slot in the ring carries a sequence number which tells producers and the
+    consumer whether the slot is free or holds published data. Producers claim a slot
+    with a single compare-and-swap on the tail, so there are no locks and no allocations
+    when pushing or popping.
+
+    The queue has a fixed capacity (rounded up to a power of two). When it is full the
+    behaviour is selected by the FullPolicy; either the producer waits for the consumer
+    to make room (BlockWhenFull), or the oldest item in the queue is discarded to make
+    room for the new one (DropOldestWhenFull).
+
+    The queue also keeps an approximate count of the items it holds. push() returns true in
+    its wasEmpty argument when the push moved the queue from empty to non-empty, so that
+    a consumer sleeping on the queue only needs to be woken on that transition.
+
+    The template parameter must be default constructible and assignable.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOCK_FREE_QUEUE_H_DEFINED
+#define LOCK_FREE_QUEUE_H_DEFINED
+
+#include <vector>
+#include <cstddef>
+
+template <typename T>
+class LockFreeQueue
+{
+    public:
+        enum FullPolicy
+        {
+            BlockWhenFull,                      //!< producers wait until the consumer makes room
+            DropOldestWhenFull                  //!< the oldest item is discarded to make room
+        };
+    public:
+        LockFreeQueue(size_t capacity, FullPolicy policy = BlockWhenFull);
+        ~LockFreeQueue();
+
+        bool push(const T& data, bool& wasEmpty);
+        bool pop(T& data);
+        size_t drain(std::vector<T>& data);
+
+        bool empty() const;
+        long size() const;
+        size_t capacity() const;
+        unsigned long getNumDropped() const;
+        FullPolicy getPolicy() const;
+    private:
+        bool tryPush(const T& data);
+        bool tryPop(T& data);
+        template <typename V> static V load(const volatile V& value);
+        static size_t roundUpToPowerOfTwo(size_t value);
+    private:
+        struct Cell
+        {
+            volatile size_t Sequence;           //!< tells us whether the cell is free (Sequence == position) or full (Sequence == position + 1)
+            T Data;                             //!< the data stored in the cell
+        };
+
+        Cell* m_buffer;                         //!< the ring of cells
+        const size_t m_mask;                    //!< the capacity - 1, used to wrap positions into the ring
+        const FullPolicy m_policy;              //!< what to do when the queue is full
+
+        char m_pad0[64];                        //!< keep the head and tail on separate cache lines
+        volatile size_t m_head;                 //!< the position of the next cell to be popped
+        char m_pad1[64];
+        volatile size_t m_tail;                 //!< the position of the next cell to be pushed
+        char m_pad2[64];
+        volatile long m_count;                  //!< the approximate number of items in the queue
+        volatile unsigned long m_num_dropped;   //!< the number of items discarded by the DropOldestWhenFull policy
+};
+
+#include "LockFreeQueue.cpp"                    // this is the standard way to do template classes if when you separate declaration and implementation.
+                                                // just make sure that you don't compile LockFreeQueue.cpp separately
+#endif
+
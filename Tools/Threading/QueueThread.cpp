@@ -28,9 +28,11 @@ using namespace std;
 /*! @brief Creates a thread
     @param name the name of the thread (used entirely for debug purposes)
     @param priority the priority of the thread. If non-zero the thread will be a bona fide real-time thread.
+    @param capacity the maximum number of items in the queue
+    @param policy what to do when the queue is full; wait for room or discard the oldest data
  */
 template <typename T>
-QueueThread<T>::QueueThread(string name, unsigned char priority) : Thread(name, priority)
+QueueThread<T>::QueueThread(string name, unsigned char priority, size_t capacity, typename LockFreeQueue<T>::FullPolicy policy) : Thread(name, priority), m_queue(capacity, policy)
 {
     #if DEBUG_THREADING_VERBOSITY > 1
         debug << "QueueThread::QueueThread(" << m_name << ", " << static_cast<int>(m_priority) << ")" << endl;
@@ -59,30 +61,83 @@ QueueThread<T>::~QueueThread()
 }
 
 /*! @brief Adds new data to the thread's queue. This also increments the number of required loops
+ 
+           This is safe to call from several threads at once. The thread is only signalled when 
+           the queue was previously empty, if it wasn't the thread is already awake and will find the data.
     @param newdata the data to add to the queue
+    @return true if the data was added without discarding older data
  */
 template <typename T>
-void QueueThread<T>::pushBack(T newdata)
+bool QueueThread<T>::pushBack(const T& newdata)
 {
     #if DEBUG_THREADING_VERBOSITY > 2
         debug << "QueueThread::pushBack(" << newdata << ") " << m_name << endl;
     #endif
-    m_queue.push_back(newdata);
+    bool wasempty = false;
+    bool nothingdropped = m_queue.push(newdata, wasempty);
     
-    pthread_mutex_lock(&m_condition_mutex);
-    pthread_cond_signal(&m_condition);
-    pthread_mutex_unlock(&m_condition_mutex);
+    if (wasempty)
+    {
+        pthread_mutex_lock(&m_condition_mutex);
+        pthread_cond_signal(&m_condition);
+        pthread_mutex_unlock(&m_condition_mutex);
+    }
+    #if DEBUG_THREADING_VERBOSITY > 0
+        if (not nothingdropped)
+            debug << "QueueThread::pushBack() " << m_name << " is full. " << m_queue.getNumDropped() << " items have been dropped." << endl;
+    #endif
+    return nothingdropped;
 }
 
-/*! @brief Blocks this thread until the condition is signalled
+/*! @brief Returns the number of items discarded because the queue was full. This is always zero with BlockWhenFull.
+ */
+template <typename T>
+unsigned long QueueThread<T>::getNumDropped() const
+{
+    return m_queue.getNumDropped();
+}
+
+/*! @brief Removes the oldest item from the queue. This must only be called from the thread's run().
+    @param data will be updated with the oldest item
+    @return false if the queue was empty
+ */
+template <typename T>
+bool QueueThread<T>::popFront(T& data)
+{
+    return m_queue.pop(data);
+}
+
+/*! @brief Removes everything in the queue, oldest first. This must only be called from the thread's run().
+ 
+           Use this after waitForCondition() to handle everything pushed while the thread was asleep in one pass.
+    @param data the items are appended to this
+    @return the number of items removed
+ */
+template <typename T>
+size_t QueueThread<T>::drain(std::vector<T>& data)
+{
+    return m_queue.drain(data);
+}
+
+/*! @brief Blocks this thread until there is data in the queue
+ 
+           The queue is checked while holding m_condition_mutex, and pushBack() takes the same mutex
+           to signal after the data is in the queue, so a wake up can not be missed. If the thread is
+           stopped while it is waiting the mutex is unlocked, so that it can be destroyed.
  */
 template <typename T>
 void QueueThread<T>::waitForCondition()
 {
-    if (m_queue.size() == 0)
-    {   // if there is no data in the queue to be processed then wait until new data is added
-        pthread_mutex_lock(&m_condition_mutex);
+    pthread_mutex_lock(&m_condition_mutex);
+    pthread_cleanup_push(unlockMutex, &m_condition_mutex);
+    while (m_queue.empty())     // if there is no data in the queue to be processed then wait until new data is added
         pthread_cond_wait(&m_condition, &m_condition_mutex);
-        pthread_mutex_unlock(&m_condition_mutex);
-    }
+    pthread_cleanup_pop(0);
+    pthread_mutex_unlock(&m_condition_mutex);
+}
+
+template <typename T>
+void QueueThread<T>::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
 }
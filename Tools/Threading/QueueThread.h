@@ -12,6 +12,11 @@
     in quick succession the main loop will run exactly three times. A queue is provided
     which stores data for each execution.
  
+    The queue is a bounded LockFreeQueue, so any number of threads can pushBack() without
+    taking a lock. The consumer is only woken when the queue goes from empty to non-empty,
+    and it should pop() or drain() everything available before waiting again. The capacity
+    and what to do when the queue is full are selected in the constructor.
+ 
     The QueueThread is a template, the template parameter selects the type of data
     in the queue.
 
@@ -37,29 +42,35 @@
 #define QUEUE_THREAD_H_DEFINED
 
 #include "Thread.h"
+#include "LockFreeQueue.h"
 
 #include <string>
-#include <deque>
+#include <vector>
 #include <pthread.h>
 
 template <typename T>
 class QueueThread : public Thread
 {
 	public:
-		QueueThread(std::string name, unsigned char priority);
+		QueueThread(std::string name, unsigned char priority, size_t capacity = 64, typename LockFreeQueue<T>::FullPolicy policy = LockFreeQueue<T>::BlockWhenFull);
         virtual ~QueueThread();
     
-        void pushBack(T newdata);
+        bool pushBack(const T& newdata);
+        unsigned long getNumDropped() const;
     
     protected:
         virtual void run() = 0;                // To be overridden by code to run.
         void waitForCondition();              
+        bool popFront(T& data);
+        size_t drain(std::vector<T>& data);
+    private:
+        static void unlockMutex(void* mutex);
 
     protected:
         pthread_mutex_t m_condition_mutex;     //!< lock for new data signal
         pthread_cond_t m_condition;            //!< signal for new data
     
-        std::deque<T> m_queue;                 //!< the queue of the data for the thread
+        LockFreeQueue<T> m_queue;              //!< the queue of the data for the thread
 };
 
 #include "QueueThread.cpp"                      // this is the standard way to do template classes if when you separate declaration and implementation.
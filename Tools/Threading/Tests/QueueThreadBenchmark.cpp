@@ -0,0 +1,221 @@
+/*! @file QueueThreadBenchmark.cpp
+    @brief A throughput benchmark of QueueThread against a locked std::deque.
+
+    Several producer threads push items as fast as they can while one consumer takes them. This is
+    timed for a QueueThread (BlockWhenFull), and for a std::deque behind a mutex and condition that
+    is signalled on every push, which is what QueueThread used to be. The deque is given the same
+    capacity, and producers wait when it is full, so that both queues hold the same amount. The items
+    per second through each queue are printed.
+
+    This is not part of the nubot build. From the repository root:
+        g++ -O2 -pthread -I. -INUView/NUViewConfig Tools/Threading/Tests/QueueThreadBenchmark.cpp Tools/Threading/Thread.cpp -o queuebenchmark
+        ./queuebenchmark [producers] [items per producer]
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Tools/Threading/QueueThread.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <vector>
+#include <pthread.h>
+#include <sys/time.h>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+static int NumProducers = 4;
+static long NumItems = 500000;              // per producer
+static const size_t Capacity = 256;
+
+static double now()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec/1e6;
+}
+
+/*! @brief The interface the producers push through */
+class Queue
+{
+public:
+    virtual ~Queue() {}
+    virtual void push(long item) = 0;
+    virtual void waitForAll(long total) = 0;
+};
+
+/*! @brief A QueueThread that counts the items it drains */
+class CountingThread : public QueueThread<long>, public Queue
+{
+public:
+    CountingThread() : QueueThread<long>("CountingThread", 0, Capacity)
+    {
+        m_received = 0;
+        pthread_mutex_init(&m_done_mutex, NULL);
+        pthread_cond_init(&m_done_condition, NULL);
+        start();
+    }
+    ~CountingThread()
+    {
+        stop();
+        join();
+        pthread_cond_destroy(&m_done_condition);
+        pthread_mutex_destroy(&m_done_mutex);
+    }
+    void push(long item)
+    {
+        pushBack(item);
+    }
+    void waitForAll(long total)
+    {
+        pthread_mutex_lock(&m_done_mutex);
+        while (m_received < total)
+            pthread_cond_wait(&m_done_condition, &m_done_mutex);
+        pthread_mutex_unlock(&m_done_mutex);
+    }
+protected:
+    void run()
+    {
+        std::vector<long> batch;
+        while (true)
+        {
+            waitForCondition();
+            batch.clear();
+            drain(batch);
+            pthread_mutex_lock(&m_done_mutex);
+            m_received += batch.size();
+            pthread_cond_signal(&m_done_condition);
+            pthread_mutex_unlock(&m_done_mutex);
+        }
+    }
+private:
+    long m_received;
+    pthread_mutex_t m_done_mutex;
+    pthread_cond_t m_done_condition;
+};
+
+/*! @brief A bounded std::deque behind a mutex, with the consumer signalled on every push */
+class LockedDeque : public Queue
+{
+public:
+    LockedDeque()
+    {
+        m_received = 0;
+        pthread_mutex_init(&m_mutex, NULL);
+        pthread_cond_init(&m_condition, NULL);
+        pthread_cond_init(&m_not_full, NULL);
+        pthread_cond_init(&m_done_condition, NULL);
+        pthread_create(&m_thread, NULL, consume, this);
+    }
+    ~LockedDeque()
+    {
+        pthread_cancel(m_thread);
+        pthread_join(m_thread, NULL);
+        pthread_cond_destroy(&m_done_condition);
+        pthread_cond_destroy(&m_not_full);
+        pthread_cond_destroy(&m_condition);
+        pthread_mutex_destroy(&m_mutex);
+    }
+    void push(long item)
+    {
+        pthread_mutex_lock(&m_mutex);
+        while (m_queue.size() >= Capacity)
+            pthread_cond_wait(&m_not_full, &m_mutex);
+        m_queue.push_back(item);
+        pthread_cond_signal(&m_condition);
+        pthread_mutex_unlock(&m_mutex);
+    }
+    void waitForAll(long total)
+    {
+        pthread_mutex_lock(&m_mutex);
+        while (m_received < total)
+            pthread_cond_wait(&m_done_condition, &m_mutex);
+        pthread_mutex_unlock(&m_mutex);
+    }
+private:
+    static void unlock(void* mutex)
+    {
+        pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+    }
+    static void* consume(void* arg)
+    {
+        LockedDeque* self = reinterpret_cast<LockedDeque*>(arg);
+        pthread_mutex_lock(&self->m_mutex);
+        pthread_cleanup_push(unlock, &self->m_mutex);
+        while (true)
+        {
+            while (self->m_queue.empty())
+                pthread_cond_wait(&self->m_condition, &self->m_mutex);
+            self->m_queue.pop_front();
+            self->m_received++;
+            pthread_cond_signal(&self->m_not_full);
+            pthread_cond_signal(&self->m_done_condition);
+        }
+        pthread_cleanup_pop(0);
+        return NULL;
+    }
+    std::deque<long> m_queue;
+    long m_received;
+    pthread_t m_thread;
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_condition;
+    pthread_cond_t m_not_full;
+    pthread_cond_t m_done_condition;
+};
+
+static void* produce(void* arg)
+{
+    Queue* queue = reinterpret_cast<Queue*>(arg);
+    for (long i = 0; i < NumItems; i++)
+        queue->push(i);
+    return NULL;
+}
+
+/*! @brief Times the producers pushing everything through a queue, and the consumer taking it */
+static void benchmark(Queue* queue, const char* name)
+{
+    std::vector<pthread_t> producers(NumProducers);
+    double start = now();
+    for (int p = 0; p < NumProducers; p++)
+        pthread_create(&producers[p], NULL, produce, queue);
+    for (int p = 0; p < NumProducers; p++)
+        pthread_join(producers[p], NULL);
+    queue->waitForAll(NumProducers*NumItems);
+    double elapsed = now() - start;
+    printf("%-12s %d producers x %ld items: %.3f s, %.2f million items/s\n", name, NumProducers, NumItems, elapsed, NumProducers*NumItems/elapsed/1e6);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        NumProducers = atoi(argv[1]);
+    if (argc > 2)
+        NumItems = atol(argv[2]);
+
+    Queue* queue = new CountingThread();
+    benchmark(queue, "QueueThread");
+    delete queue;
+
+    queue = new LockedDeque();
+    benchmark(queue, "LockedDeque");
+    delete queue;
+    return 0;
+}
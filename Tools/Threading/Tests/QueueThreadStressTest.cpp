@@ -0,0 +1,172 @@
+/*! @file QueueThreadStressTest.cpp
+    @brief A stress test of QueueThread and LockFreeQueue with many producers.
+
+    Several producer threads push numbered items into a QueueThread as fast as they can, while the
+    QueueThread drains them. The consumer checks that every producer's items arrive in order, that
+    with BlockWhenFull none are lost, and that with DropOldestWhenFull the items received plus the
+    items dropped add up to the items pushed. It is run for both policies.
+
+    This is not part of the nubot build. From the repository root:
+        g++ -O2 -pthread -I. -INUView/NUViewConfig Tools/Threading/Tests/QueueThreadStressTest.cpp Tools/Threading/Thread.cpp -o queuestress
+    and add -fsanitize=thread -g to check for data races. It exits with 0 if every check passed.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Tools/Threading/QueueThread.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <pthread.h>
+
+std::ofstream debug;
+std::ofstream errorlog;
+
+static const int NumProducers = 4;
+static const int NumItems = 200000;          // per producer
+static const size_t Capacity = 64;
+
+struct Item
+{
+    int Producer;
+    int Number;
+};
+
+std::ostream& operator<<(std::ostream& output, const Item& item)
+{
+    return output << item.Producer << ":" << item.Number;
+}
+
+/*! @brief A QueueThread that checks the order and count of the items it drains */
+class CheckingThread : public QueueThread<Item>
+{
+public:
+    CheckingThread(LockFreeQueue<Item>::FullPolicy policy) : QueueThread<Item>("CheckingThread", 0, Capacity, policy), m_last(NumProducers, -1)
+    {
+        m_received = 0;
+        m_errors = 0;
+        m_done = false;
+        pthread_mutex_init(&m_done_mutex, NULL);
+        pthread_cond_init(&m_done_condition, NULL);
+    }
+    ~CheckingThread()
+    {
+        pthread_cond_destroy(&m_done_condition);
+        pthread_mutex_destroy(&m_done_mutex);
+    }
+
+    /*! @brief Blocks until the items received and dropped add up to the total pushed */
+    void waitUntilDone()
+    {
+        pthread_mutex_lock(&m_done_mutex);
+        while (not m_done)
+            pthread_cond_wait(&m_done_condition, &m_done_mutex);
+        pthread_mutex_unlock(&m_done_mutex);
+    }
+
+    long m_received;
+    long m_errors;
+protected:
+    void run()
+    {
+        std::vector<Item> batch;
+        while (true)
+        {
+            waitForCondition();
+            batch.clear();
+            drain(batch);
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                const Item& item = batch[i];
+                bool inorder = m_queue.getPolicy() == LockFreeQueue<Item>::BlockWhenFull ? item.Number == m_last[item.Producer] + 1 : item.Number > m_last[item.Producer];
+                if (not inorder)
+                    m_errors++;
+                m_last[item.Producer] = item.Number;
+                m_received++;
+            }
+            if (m_received + static_cast<long>(getNumDropped()) >= static_cast<long>(NumProducers)*NumItems)
+            {
+                pthread_mutex_lock(&m_done_mutex);
+                m_done = true;
+                pthread_cond_signal(&m_done_condition);
+                pthread_mutex_unlock(&m_done_mutex);
+            }
+        }
+    }
+private:
+    std::vector<int> m_last;
+    bool m_done;
+    pthread_mutex_t m_done_mutex;
+    pthread_cond_t m_done_condition;
+};
+
+struct ProducerArgs
+{
+    CheckingThread* Thread;
+    int Producer;
+};
+
+static void* produce(void* arg)
+{
+    ProducerArgs* args = reinterpret_cast<ProducerArgs*>(arg);
+    for (int i = 0; i < NumItems; i++)
+    {
+        Item item = {args->Producer, i};
+        args->Thread->pushBack(item);
+    }
+    return NULL;
+}
+
+/*! @brief Runs the producers against a QueueThread with a policy
+    @return true if every check passed
+ */
+static bool runTest(LockFreeQueue<Item>::FullPolicy policy, const char* name)
+{
+    CheckingThread consumer(policy);
+    consumer.start();
+
+    pthread_t producers[NumProducers];
+    ProducerArgs args[NumProducers];
+    for (int p = 0; p < NumProducers; p++)
+    {
+        args[p].Thread = &consumer;
+        args[p].Producer = p;
+        pthread_create(&producers[p], NULL, produce, &args[p]);
+    }
+    for (int p = 0; p < NumProducers; p++)
+        pthread_join(producers[p], NULL);
+    consumer.waitUntilDone();
+    consumer.stop();
+    consumer.join();
+
+    long total = static_cast<long>(NumProducers)*NumItems;
+    long dropped = static_cast<long>(consumer.getNumDropped());
+    bool passed = consumer.m_errors == 0 and consumer.m_received + dropped == total;
+    if (policy == LockFreeQueue<Item>::BlockWhenFull)
+        passed = passed and dropped == 0;
+    printf("%s: pushed %ld received %ld dropped %ld out of order %ld: %s\n", name, total, consumer.m_received, dropped, consumer.m_errors, passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+int main()
+{
+    bool passed = runTest(LockFreeQueue<Item>::BlockWhenFull, "BlockWhenFull");
+    passed = runTest(LockFreeQueue<Item>::DropOldestWhenFull, "DropOldestWhenFull") and passed;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/*! @file TripleBufferTest.cpp
+    @brief A stress test of TripleBuffer with one writer and one reader.
+
+    The writer publishes snapshots as fast as it can, each filled with its own number. The reader
+    acquires snapshots as fast as it can, and checks that every snapshot is whole (every element
+    holds the same number), that the number matches the version of the snapshot, and that versions
+    never go backwards.
+
+    This is not part of the nubot build. From the repository root:
+        g++ -O2 -pthread -I. Tools/Threading/Tests/TripleBufferTest.cpp -o triplebuffertest
+    and add -fsanitize=thread -g to check for data races. It exits with 0 if every check passed.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Tools/Threading/TripleBuffer.h"
+
+#include <cstdio>
+#include <vector>
+#include <pthread.h>
+
+static const unsigned long NumPublishes = 2000000;
+static const size_t SnapshotSize = 64;
+
+struct Snapshot
+{
+    std::vector<unsigned long> Values;
+};
+
+static TripleBuffer<Snapshot> Buffer;
+static volatile int WriterDone = 0;
+
+static void* write(void*)
+{
+    for (unsigned long n = 1; n <= NumPublishes; n++)
+    {
+        Snapshot& snapshot = Buffer.getWriteBuffer();
+        for (size_t i = 0; i < SnapshotSize; i++)
+            snapshot.Values[i] = n;
+        Buffer.publish();
+    }
+    __sync_fetch_and_add(&WriterDone, 1);
+    return NULL;
+}
+
+int main()
+{
+    Snapshot initial;
+    initial.Values.assign(SnapshotSize, 0);
+    Buffer.initialise(initial);
+
+    pthread_t writer;
+    pthread_create(&writer, NULL, write, NULL);
+
+    unsigned long acquired = 0, fresh = 0, torn = 0, mismatched = 0, backwards = 0;
+    unsigned long lastversion = 0;
+    bool done = false;
+    while (not done)
+    {
+        done = __sync_fetch_and_add(&WriterDone, 0) > 0;        // check before acquiring, so the last snapshot is always seen
+        bool isnew = Buffer.hasNewData();
+        const Snapshot& snapshot = Buffer.acquire();
+        unsigned long version = Buffer.getReadVersion();
+        acquired++;
+        if (isnew)
+            fresh++;
+        for (size_t i = 1; i < SnapshotSize; i++)
+        {
+            if (snapshot.Values[i] != snapshot.Values[0])
+            {
+                torn++;
+                break;
+            }
+        }
+        if (snapshot.Values[0] != version)
+            mismatched++;
+        if (version < lastversion)
+            backwards++;
+        lastversion = version;
+    }
+    pthread_join(writer, NULL);
+
+    bool passed = torn == 0 and mismatched == 0 and backwards == 0 and lastversion == NumPublishes;
+    printf("published %lu acquired %lu (%lu new) last version %lu torn %lu mismatched %lu backwards %lu: %s\n", NumPublishes, acquired, fresh, lastversion, torn, mismatched, backwards, passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
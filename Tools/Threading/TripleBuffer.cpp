@@ -0,0 +1,122 @@
+/*!  @file TripleBuffer.cpp
+     @brief Implementation of the TripleBuffer class.
+
+     @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TripleBuffer.h"
+
+/*! @brief Creates a triple buffer. The writer starts with buffer 0, the shared buffer is 1 and the reader has 2.
+ */
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+{
+    for (int i=0; i<3; i++)
+        m_versions[i] = 0;
+    m_write_index = 0;
+    m_write_version = 0;
+    m_state = 1;
+    m_read_index = 2;
+    __sync_synchronize();
+}
+
+template <typename T>
+TripleBuffer<T>::~TripleBuffer()
+{
+}
+
+/*! @brief Copies data into all three buffers. This must be called before the reader and writer threads are started.
+           The version numbers are left at zero.
+    @param data the initial value of the data
+ */
+template <typename T>
+void TripleBuffer<T>::initialise(const T& data)
+{
+    for (int i=0; i<3; i++)
+        m_buffers[i] = data;
+    __sync_synchronize();
+}
+
+/*! @brief Returns the buffer owned by the writer. Fill this with the new data before calling publish()
+ */
+template <typename T>
+T& TripleBuffer<T>::getWriteBuffer()
+{
+    return m_buffers[m_write_index];
+}
+
+/*! @brief Makes the write buffer available to the reader, and gives the writer the previously shared buffer.
+           After this call getWriteBuffer() returns a different buffer, its contents are stale.
+    @return the version number of the published data
+ */
+template <typename T>
+unsigned long TripleBuffer<T>::publish()
+{
+    m_write_version++;
+    m_versions[m_write_index] = m_write_version;
+    int oldstate;
+    do
+    {
+        oldstate = __sync_fetch_and_or(&m_state, 0);
+    } while (not __sync_bool_compare_and_swap(&m_state, oldstate, m_write_index | FreshFlag));
+    m_write_index = oldstate & IndexMask;
+    return m_write_version;
+}
+
+/*! @brief Returns the most recently published data. If nothing has been published since the last acquire()
+           the reader keeps its current snapshot.
+ */
+template <typename T>
+T& TripleBuffer<T>::acquire()
+{
+    if (hasNewData())
+    {
+        int oldstate;
+        do
+        {
+            oldstate = __sync_fetch_and_or(&m_state, 0);
+        } while (not __sync_bool_compare_and_swap(&m_state, oldstate, m_read_index));
+        m_read_index = oldstate & IndexMask;
+    }
+    return m_buffers[m_read_index];
+}
+
+/*! @brief Returns the snapshot previously obtained by acquire(), without looking for newer data
+ */
+template <typename T>
+T& TripleBuffer<T>::getReadBuffer()
+{
+    return m_buffers[m_read_index];
+}
+
+/*! @brief Returns the version number of the snapshot held by the reader. Zero means nothing has ever been published.
+ */
+template <typename T>
+unsigned long TripleBuffer<T>::getReadVersion() const
+{
+    return m_versions[m_read_index];
+}
+
+/*! @brief Returns true if the writer has published data that the reader has not yet acquired
+ */
+template <typename T>
+bool TripleBuffer<T>::hasNewData()
+{
+    return __sync_fetch_and_or(&m_state, 0) & FreshFlag;
+}
+
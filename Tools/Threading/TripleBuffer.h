@@ -0,0 +1,80 @@
+/*! @file TripleBuffer.h
+    @brief Declaration of the TripleBuffer class.
+
+    @class TripleBuffer
+    @brief A lock-free triple buffer for passing snapshots of data from one thread to another.
+
+    The buffer holds three copies of the data. The writer fills the write buffer and
+    then publish()es it, the reader acquire()s the most recently published copy. Neither
+    side ever waits for the other; publishing and acquiring are each a single atomic swap
+    of a buffer index. The reader keeps the copy it acquired until it next calls acquire(),
+    so it sees a consistent snapshot for as long as it needs, even while the writer
+    publishes new data.
+
+    Every publish is given a version number, so the reader can tell how fresh its
+    snapshot is and whether it has already seen it.
+
+    There must be exactly one writer thread and one reader thread. The template parameter
+    must be default constructible and assignable.
+
+    @author agent
+
+ Copyright (c) 2026 agent
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIPLE_BUFFER_H_DEFINED
+#define TRIPLE_BUFFER_H_DEFINED
+
+template <typename T>
+class TripleBuffer
+{
+    public:
+        TripleBuffer();
+        ~TripleBuffer();
+
+        void initialise(const T& data);
+
+        // writer thread only
+        T& getWriteBuffer();
+        unsigned long publish();
+
+        // reader thread only
+        T& acquire();
+        T& getReadBuffer();
+        unsigned long getReadVersion() const;
+        bool hasNewData();
+    private:
+        enum
+        {
+            IndexMask = 3,                      //!< the bits of m_state holding the index of the shared buffer
+            FreshFlag = 4                       //!< set in m_state when the shared buffer has been published but not acquired
+        };
+
+        T m_buffers[3];                         //!< the three copies of the data
+        unsigned long m_versions[3];            //!< the version number of the data in each buffer
+        volatile int m_state;                   //!< the index of the shared (published) buffer, and the FreshFlag
+
+        char m_pad0[64];                        //!< keep the writer's and reader's indices on separate cache lines
+        int m_write_index;                      //!< the index of the buffer owned by the writer
+        unsigned long m_write_version;          //!< the version number of the last publish
+        char m_pad1[64];
+        int m_read_index;                       //!< the index of the buffer owned by the reader
+};
+
+#include "TripleBuffer.cpp"                     // this is the standard way to do template classes if when you separate declaration and implementation.
+                                                // just make sure that you don't compile TripleBuffer.cpp separately
+#endif
+
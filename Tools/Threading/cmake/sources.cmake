@@ -25,6 +25,8 @@ Thread.cpp
 ConditionalThread.cpp
 PeriodicThread.cpp
 QueueThread.h
+TripleBuffer.h
+LockFreeQueue.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
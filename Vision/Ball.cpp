@@ -7,7 +7,6 @@
 #include "debug.h"
 #include "debugverbosityvision.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
-#include "Kinematics/Kinematics.h"
 
 #if TARGET_OS_IS_WINDOWS
     #include <QDebug>
@@ -99,24 +98,18 @@ bool Ball::isVisualBallDistanceCloseDistanceToPoint(Circle circ, Vision* vision,
     visualSphericalPosition[1] = bearing;
     visualSphericalPosition[2] = elevation;
 
-    vector<float> ctvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraTransform, ctvector);
-    if(isOK == true)
+    const CameraProjection& projection = vision->getCameraProjection();
+    if(projection.transformPosition(visualSphericalPosition, transformedSphericalPosition))
     {
-        Matrix cameraTransform = Matrix4x4fromVector(ctvector);
-        transformedSphericalPosition = Kinematics::TransformPosition(cameraTransform,visualSphericalPosition);
         VisualFlatDistance = transformedSphericalPosition[0];
     }
 
     //GET CENTRE POINT on CIRCLE, use Distance to point:
 
-    vector<float> ctgvector;
     float distanceD2P =0.0;
-    isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector);
-    if(isOK == true)
+    Vector3<float> relativePoint;
+    if(projection.groundPosition(circ.centreX, circ.centreY, relativePoint))
     {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-        Vector3<float> relativePoint = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
         distanceD2P = relativePoint[0];
         //#if DEBUG_VISION_VERBOSITY > 6
         //    debug << "\t\tCalculated Distance to Point: " << *distance<<endl;
@@ -468,8 +461,31 @@ Circle Ball::isCorrectFit(const std::vector < Vector2<int> > &ballPoints, const
 
     if(ballPoints.size() >= 5)
     {
+            //! Move each point to the edge of the ball in the image, searching along the axis closest to the direction from the centre of the candidate
+            const int EDGE_SEARCH_RADIUS = 2;
+            std::vector < Vector2<float> > edgePoints;
+            edgePoints.reserve(ballPoints.size());
+            //! The candidate, and the search either side of its edge, is filtered once for every point
+            Vector2<int> topLeft = PossibleBall.getTopLeft();
+            Vector2<int> bottomRight = PossibleBall.getBottomRight();
+            vision->filterEdgeRegion(topLeft.x - EDGE_SEARCH_RADIUS - 1, topLeft.y - EDGE_SEARCH_RADIUS - 1,
+                                     bottomRight.x - topLeft.x + 2*EDGE_SEARCH_RADIUS + 3, bottomRight.y - topLeft.y + 2*EDGE_SEARCH_RADIUS + 3);
+            for(unsigned int i = 0; i < ballPoints.size(); i++)
+            {
+                Vector2<float> edgePoint(ballPoints[i].x, ballPoints[i].y);
+                bool horizontal = abs(ballPoints[i].x - PossibleBall.getCentreX()) >= abs(ballPoints[i].y - PossibleBall.getCentreY());
+                float position;
+                if(vision->refineEdge(ballPoints[i].x, ballPoints[i].y, horizontal, EDGE_SEARCH_RADIUS, position))
+                {
+                    if(horizontal)
+                        edgePoint.x = position;
+                    else
+                        edgePoint.y = position;
+                }
+                edgePoints.push_back(edgePoint);
+            }
 
-            circ = CircleFit.FitCircleLMF(ballPoints);
+            circ = CircleFit.FitCircleLMF(edgePoints);
             if(circ.sd > 3.5 ||  circ.radius*2 > getMaxPixelsOfBall(vision) )
             {
                 circ.isDefined = false;
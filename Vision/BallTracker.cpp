@@ -0,0 +1,133 @@
+/*!
+  @file BallTracker.cpp
+  @brief Implementation of the BallTracker class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BallTracker.h"
+
+#include <cmath>
+
+const float BallTracker::BaseUncertainty = 10.0f;
+const float BallTracker::MaxBallSpeed = 200.0f;
+
+BallTracker::BallTracker()
+{
+    m_max_misses = DefaultMaxMisses;
+    m_misses = 0;
+    m_tracking = false;
+    m_time = 0;
+    m_num_window_hits = 0;
+    m_num_window_misses = 0;
+}
+
+BallTracker::~BallTracker()
+{
+}
+
+/*! @brief Sets the number of frames in a row the ball can be missed before tracking stops. 0 turns tracking off. */
+void BallTracker::setMaxMisses(int misses)
+{
+    m_max_misses = misses;
+    if (m_max_misses <= 0)
+        lose();
+}
+
+/*! @brief Returns the number of frames in a row the ball can be missed before tracking stops */
+int BallTracker::getMaxMisses() const
+{
+    return m_max_misses;
+}
+
+/*! @brief Returns true if the ball is being tracked, and should be searched for in a window */
+bool BallTracker::isTracking() const
+{
+    return m_tracking;
+}
+
+/*! @brief Records that the ball was seen
+    @param position the position of the ball relative to the robot (x, y, z in cm)
+    @param time the time the ball was seen (ms)
+ */
+void BallTracker::hit(const Vector3<float>& position, double time)
+{
+    if (m_tracking)
+        m_num_window_hits++;
+    m_position = position;
+    m_time = time;
+    m_misses = 0;
+    m_tracking = m_max_misses > 0;
+}
+
+/*! @brief Records that the ball was not seen. Tracking stops once the ball has been missed too many times in a row. */
+void BallTracker::miss()
+{
+    if (not m_tracking)
+        return;
+    m_num_window_misses++;
+    m_misses++;
+    if (m_misses >= m_max_misses)
+        lose();
+}
+
+/*! @brief Stops tracking the ball, for when there is no way to predict where it is */
+void BallTracker::lose()
+{
+    m_tracking = false;
+    m_misses = 0;
+}
+
+/*! @brief Returns the predicted position of the ball relative to the robot (x, y, z in cm)
+    @param velocity the velocity of the ball relative to the robot (x, y in cm/s)
+    @param time the current time (ms)
+ */
+Vector3<float> BallTracker::predict(const Vector2<float>& velocity, double time) const
+{
+    float dt = 1e-3*(time - m_time);
+    if (dt < 0)
+        dt = 0;
+    return Vector3<float>(m_position.x + velocity.x*dt, m_position.y + velocity.y*dt, m_position.z);
+}
+
+/*! @brief Returns the distance from the predicted position in which the ball is expected to be (cm)
+    @param velocityerror the standard deviation of the velocity of the ball (x, y in cm/s)
+    @param time the current time (ms)
+ */
+float BallTracker::getUncertainty(const Vector2<float>& velocityerror, double time) const
+{
+    float dt = 1e-3*(time - m_time);
+    if (dt < 0)
+        dt = 0;
+    float speederror = sqrt(velocityerror.x*velocityerror.x + velocityerror.y*velocityerror.y);
+    if (m_misses > 0)
+        speederror += MaxBallSpeed;
+    return BaseUncertainty + speederror*dt;
+}
+
+/*! @brief Returns the number of frames the ball was found in the window */
+unsigned long BallTracker::getNumWindowHits() const
+{
+    return m_num_window_hits;
+}
+
+/*! @brief Returns the number of frames the ball was not found in the window */
+unsigned long BallTracker::getNumWindowMisses() const
+{
+    return m_num_window_misses;
+}
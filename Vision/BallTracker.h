@@ -0,0 +1,74 @@
+/*!
+  @file BallTracker.h
+  @brief Declaration of the BallTracker class.
+
+  @class BallTracker
+  @brief Keeps track of where the ball was last seen, so that vision can search a small window about where it should be now.
+
+  The ball's position is kept relative to the robot, so that the window can be projected into each new image with the
+  current camera transform; the head moving is then not mistaken for the ball moving. The position is moved on by the
+  ball's velocity from localisation, and the window grows with the time since the ball was last seen.
+
+  The ball is tracked from the frame it is found in until it has not been found in the window for a number of frames
+  in a row. Vision then goes back to searching the full scan.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BALLTRACKER_H
+#define BALLTRACKER_H
+
+#include "Tools/Math/Vector2.h"
+#include "Tools/Math/Vector3.h"
+
+class BallTracker
+{
+public:
+    static const int DefaultMaxMisses = 3;      //!< The default number of frames in a row the ball can be missed before tracking stops
+
+    BallTracker();
+    ~BallTracker();
+
+    void setMaxMisses(int misses);
+    int getMaxMisses() const;
+    bool isTracking() const;
+
+    void hit(const Vector3<float>& position, double time);
+    void miss();
+    void lose();
+
+    Vector3<float> predict(const Vector2<float>& velocity, double time) const;
+    float getUncertainty(const Vector2<float>& velocityerror, double time) const;
+
+    unsigned long getNumWindowHits() const;
+    unsigned long getNumWindowMisses() const;
+private:
+    static const float BaseUncertainty;         //!< The uncertainty in the ball's position when it has just been seen (cm)
+    static const float MaxBallSpeed;            //!< The speed used to grow the uncertainty while the ball is missed (cm/s)
+
+    int m_max_misses;                   //!< The number of frames in a row the ball can be missed before tracking stops
+    int m_misses;                       //!< The number of frames in a row the ball has been missed
+    bool m_tracking;                    //!< True while the ball is being tracked
+    Vector3<float> m_position;          //!< The position of the ball relative to the robot when it was last seen (x, y, z in cm)
+    double m_time;                      //!< The time the ball was last seen (ms)
+
+    unsigned long m_num_window_hits;    //!< The number of frames the ball was found in the window
+    unsigned long m_num_window_misses;  //!< The number of frames the ball was not found in the window
+};
+
+#endif
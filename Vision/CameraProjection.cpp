@@ -0,0 +1,277 @@
+/*!
+  @file CameraProjection.cpp
+  @brief Implementation of the CameraProjection class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CameraProjection.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/Math/General.h"
+
+#include <cmath>
+
+const double CameraProjection::FOVx = mathGeneral::deg2rad(45.0);     // Taken from Old Globals
+const double CameraProjection::FOVy = mathGeneral::deg2rad(34.8);     // Taken from DOCUMENTATION OF NAO
+
+CameraProjection::CameraProjection()
+{
+    m_width = 0;
+    m_height = 0;
+    m_bearing_focal = 1;
+    m_elevation_focal = 1;
+    m_ground_valid = false;
+    m_camera_valid = false;
+}
+
+CameraProjection::~CameraProjection()
+{
+}
+
+/*! @brief Builds the bearing and elevation tables for an image size. Nothing is done if the size has not changed.
+    @param width the width of the image in pixels
+    @param height the height of the image in pixels
+ */
+void CameraProjection::setImageSize(int width, int height)
+{
+    if (width == m_width and height == m_height)
+        return;
+    m_width = width;
+    m_height = height;
+    m_bearing_focal = (m_width/2)/tan(FOVx/2.0);
+    m_elevation_focal = (m_height/2)/tan(FOVy/2.0);
+
+    m_bearings.resize(m_width);
+    m_bearing_cos.resize(m_width);
+    m_bearing_sin.resize(m_width);
+    for (int x = 0; x < m_width; x++)
+    {
+        m_bearings[x] = atan((m_width/2 - x)/m_bearing_focal);
+        m_bearing_cos[x] = cos(m_bearings[x]);
+        m_bearing_sin[x] = sin(m_bearings[x]);
+    }
+
+    m_elevations.resize(m_height);
+    m_elevation_cos.resize(m_height);
+    m_elevation_sin.resize(m_height);
+    for (int y = 0; y < m_height; y++)
+    {
+        m_elevations[y] = atan((m_height/2 - y)/m_elevation_focal);
+        m_elevation_cos[y] = cos(m_elevations[y]);
+        m_elevation_sin[y] = sin(m_elevations[y]);
+    }
+}
+
+/*! @brief Copies the camera to ground and camera transforms for the current frame from the sensor data
+    @param data the sensor data for the current frame. If it is NULL the transforms are marked as unavailable.
+ */
+void CameraProjection::setTransforms(NUSensorsData* data)
+{
+    std::vector<float> transform;
+    m_ground_valid = data != NULL and data->get(NUSensorsData::CameraToGroundTransform, transform) and copyTransform(transform, m_ground);
+    m_camera_valid = data != NULL and data->get(NUSensorsData::CameraTransform, transform) and copyTransform(transform, m_camera);
+}
+
+/*! @brief Copies the top three rows of a 4x4 row-major transform. Returns false if the source is not a 4x4 transform. */
+bool CameraProjection::copyTransform(const std::vector<float>& source, float transform[3][4])
+{
+    if (source.size() != 16)
+        return false;
+    for (int row = 0; row < 3; row++)
+        for (int col = 0; col < 4; col++)
+            transform[row][col] = source[4*row + col];
+    return true;
+}
+
+/*! @brief Returns true if there is a camera to ground transform for the current frame */
+bool CameraProjection::hasCameraToGroundTransform() const
+{
+    return m_ground_valid;
+}
+
+/*! @brief Returns true if there is a camera transform for the current frame */
+bool CameraProjection::hasCameraTransform() const
+{
+    return m_camera_valid;
+}
+
+/*! @brief Returns the bearing from the camera of an image column (rad). Whole columns are looked up in the table. */
+double CameraProjection::bearing(double x) const
+{
+    int column = (int)x;
+    if (column == x and column >= 0 and column < m_width)
+        return m_bearings[column];
+    return atan((m_width/2 - x)/m_bearing_focal);
+}
+
+/*! @brief Returns the elevation from the camera of an image row (rad). Whole rows are looked up in the table. */
+double CameraProjection::elevation(double y) const
+{
+    int row = (int)y;
+    if (row == y and row >= 0 and row < m_height)
+        return m_elevations[row];
+    return atan((m_height/2 - y)/m_elevation_focal);
+}
+
+/*! @brief The inverse of bearing; returns the x position in the image at a bearing from the camera */
+double CameraProjection::screenX(double bearing) const
+{
+    return m_width/2 - tan(bearing)*m_bearing_focal;
+}
+
+/*! @brief The inverse of elevation; returns the y position in the image at an elevation from the camera */
+double CameraProjection::screenY(double elevation) const
+{
+    return m_height/2 - tan(elevation)*m_elevation_focal;
+}
+
+/*! @brief Finds the position on the ground of a point in the image
+    @param x the x position of the point in the image
+    @param y the y position of the point in the image
+    @param position the position on the ground relative to the robot (distance, bearing, elevation)
+    @return false if there is no camera to ground transform, or the point does not lie on the ground
+ */
+bool CameraProjection::groundPosition(double x, double y, Vector3<float>& position) const
+{
+    int column = (int)x;
+    int row = (int)y;
+    if (column == x and row == y and column >= 0 and column < m_width and row >= 0 and row < m_height)
+        return intersectGround(m_bearing_cos[column], m_bearing_sin[column], m_elevation_cos[row], m_elevation_sin[row], position);
+    return groundPositionAt(bearing(x), elevation(y), position);
+}
+
+/*! @brief Finds the position on the ground at a bearing and elevation from the camera
+    @param bearing the bearing from the camera (rad)
+    @param elevation the elevation from the camera (rad)
+    @param position the position on the ground relative to the robot (distance, bearing, elevation)
+    @return false if there is no camera to ground transform, or the direction does not meet the ground
+ */
+bool CameraProjection::groundPositionAt(double bearing, double elevation, Vector3<float>& position) const
+{
+    return intersectGround(cos(bearing), sin(bearing), cos(elevation), sin(elevation), position);
+}
+
+/*! @brief Finds the positions on the ground of a set of points in the image
+    @param points the positions of the points in the image
+    @param positions the positions on the ground relative to the robot (distance, bearing, elevation), one per point
+    @param valid true for each point that lies on the ground
+    @return the number of points that lie on the ground
+ */
+int CameraProjection::groundPositions(const std::vector<Vector2<float> >& points, std::vector<Vector3<float> >& positions, std::vector<bool>& valid) const
+{
+    positions.resize(points.size());
+    valid.assign(points.size(), false);
+    if (not m_ground_valid)
+        return 0;
+
+    int numvalid = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        valid[i] = groundPosition(points[i].x, points[i].y, positions[i]);
+        if (valid[i])
+            numvalid++;
+    }
+    return numvalid;
+}
+
+/*! @brief Moves a position relative to the camera into a position relative to the robot with the camera transform
+    @param cameraPosition the position relative to the camera (distance, bearing, elevation)
+    @param position the position relative to the robot (distance, bearing, elevation)
+    @return false if there is no camera transform
+ */
+bool CameraProjection::transformPosition(const Vector3<float>& cameraPosition, Vector3<float>& position) const
+{
+    if (not m_camera_valid)
+        return false;
+
+    float flat = cameraPosition.x*cos(cameraPosition.z);
+    float c[3] = {static_cast<float>(flat*cos(cameraPosition.y)), static_cast<float>(flat*sin(cameraPosition.y)), static_cast<float>(cameraPosition.x*sin(cameraPosition.z))};
+    float p[3];
+    for (int row = 0; row < 3; row++)
+        p[row] = m_camera[row][0]*c[0] + m_camera[row][1]*c[1] + m_camera[row][2]*c[2] + m_camera[row][3];
+
+    position.x = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+    position.y = atan2(p[1], p[0]);
+    position.z = asin(p[2]/position.x);
+    return true;
+}
+
+/*! @brief Finds the direction relative to the robot of a point in the image, with the rotation of the camera transform only
+    @param x the x position of the point in the image
+    @param y the y position of the point in the image
+    @param direction the unit vector from the camera through the point, in the robot's coordinates
+    @return false if there is no camera transform
+ */
+bool CameraProjection::robotDirection(double x, double y, Vector3<float>& direction) const
+{
+    if (not m_camera_valid)
+        return false;
+
+    double b = bearing(x);
+    double e = elevation(y);
+    float c[3] = {static_cast<float>(cos(b)*cos(e)), static_cast<float>(sin(b)*cos(e)), static_cast<float>(sin(e))};
+    direction.x = m_camera[0][0]*c[0] + m_camera[0][1]*c[1] + m_camera[0][2]*c[2];
+    direction.y = m_camera[1][0]*c[0] + m_camera[1][1]*c[1] + m_camera[1][2]*c[2];
+    direction.z = m_camera[2][0]*c[0] + m_camera[2][1]*c[1] + m_camera[2][2]*c[2];
+    return true;
+}
+
+/*! @brief The inverse of robotDirection; finds where a direction relative to the robot is in the image
+    @param direction the direction in the robot's coordinates
+    @param point the position of the direction in the image, which may be off the screen
+    @return false if there is no camera transform, or the direction is not in front of the camera
+ */
+bool CameraProjection::screenPosition(const Vector3<float>& direction, Vector2<float>& point) const
+{
+    if (not m_camera_valid)
+        return false;
+
+    // the rotation is orthonormal, so its inverse is its transpose
+    float c[3];
+    for (int col = 0; col < 3; col++)
+        c[col] = m_camera[0][col]*direction.x + m_camera[1][col]*direction.y + m_camera[2][col]*direction.z;
+    if (c[0] <= 0)
+        return false;
+
+    point.x = screenX(atan2(c[1], c[0]));
+    point.y = screenY(atan2(c[2], sqrt(c[0]*c[0] + c[1]*c[1])));
+    return true;
+}
+
+/*! @brief Finds where the ray from the camera in a direction crosses the ground plane
+    @param position the position on the ground relative to the robot (distance, bearing, elevation)
+    @return false if there is no camera to ground transform, or the ray does not go down to the ground
+ */
+bool CameraProjection::intersectGround(float cosbearing, float sinbearing, float coselevation, float sinelevation, Vector3<float>& position) const
+{
+    if (not m_ground_valid)
+        return false;
+
+    float d[3] = {cosbearing*coselevation, sinbearing*coselevation, sinelevation};
+    float dz = m_ground[2][0]*d[0] + m_ground[2][1]*d[1] + m_ground[2][2]*d[2];
+    float s = -m_ground[2][3]/dz;
+    if (dz == 0 or s <= 0)
+        return false;
+
+    float x = m_ground[0][3] + s*(m_ground[0][0]*d[0] + m_ground[0][1]*d[1] + m_ground[0][2]*d[2]);
+    float y = m_ground[1][3] + s*(m_ground[1][0]*d[0] + m_ground[1][1]*d[1] + m_ground[1][2]*d[2]);
+    position.x = sqrt(x*x + y*y);
+    position.y = atan2(y, x);
+    position.z = 0;
+    return true;
+}
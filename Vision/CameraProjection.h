@@ -0,0 +1,92 @@
+/*!
+  @file CameraProjection.h
+  @brief Declaration of the CameraProjection class.
+
+  @class CameraProjection
+  @brief Caches the projection of pixels onto bearings, elevations and the ground for the current frame.
+
+  The bearing of each image column and the elevation of each image row, and their sines and cosines, are kept in
+  tables which are only rebuilt when the size of the image changes. The camera to ground and camera transforms
+  are copied once per frame from the sensor data, so that a pixel is mapped onto the ground plane with a few
+  multiply-adds instead of the heap Matrix products in Kinematics::DistanceToPoint and Kinematics::TransformPosition.
+
+  The ground position of a pixel is where the ray through it crosses z = 0, which is the same point that
+  Kinematics::DistanceToPoint finds by interpolating between a near and a far point on the ray. Pixels on or above
+  the horizon have no ground position.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAMERAPROJECTION_H
+#define CAMERAPROJECTION_H
+
+#include "Tools/Math/Vector2.h"
+#include "Tools/Math/Vector3.h"
+
+#include <vector>
+
+class NUSensorsData;
+
+class CameraProjection
+{
+public:
+    static const double FOVx;       //!< The horizontal field of view of the camera (rad)
+    static const double FOVy;       //!< The vertical field of view of the camera (rad)
+
+    CameraProjection();
+    ~CameraProjection();
+
+    void setImageSize(int width, int height);
+    void setTransforms(NUSensorsData* data);
+
+    bool hasCameraToGroundTransform() const;
+    bool hasCameraTransform() const;
+
+    double bearing(double x) const;
+    double elevation(double y) const;
+    double screenX(double bearing) const;
+    double screenY(double elevation) const;
+
+    bool groundPosition(double x, double y, Vector3<float>& position) const;
+    bool groundPositionAt(double bearing, double elevation, Vector3<float>& position) const;
+    int groundPositions(const std::vector<Vector2<float> >& points, std::vector<Vector3<float> >& positions, std::vector<bool>& valid) const;
+    bool transformPosition(const Vector3<float>& cameraPosition, Vector3<float>& position) const;
+    bool robotDirection(double x, double y, Vector3<float>& direction) const;
+    bool screenPosition(const Vector3<float>& direction, Vector2<float>& point) const;
+private:
+    bool intersectGround(float cosbearing, float sinbearing, float coselevation, float sinelevation, Vector3<float>& position) const;
+    static bool copyTransform(const std::vector<float>& source, float transform[3][4]);
+
+    int m_width;                            //!< The width of the image the tables were built for
+    int m_height;                           //!< The height of the image the tables were built for
+    double m_bearing_focal;                 //!< The distance to the image plane in horizontal pixels
+    double m_elevation_focal;               //!< The distance to the image plane in vertical pixels
+    std::vector<double> m_bearings;         //!< The bearing of each column
+    std::vector<float> m_bearing_cos;       //!< The cosine of the bearing of each column
+    std::vector<float> m_bearing_sin;       //!< The sine of the bearing of each column
+    std::vector<double> m_elevations;       //!< The elevation of each row
+    std::vector<float> m_elevation_cos;     //!< The cosine of the elevation of each row
+    std::vector<float> m_elevation_sin;     //!< The sine of the elevation of each row
+
+    bool m_ground_valid;                    //!< True if there is a camera to ground transform for the current frame
+    float m_ground[3][4];                   //!< The top three rows of the camera to ground transform
+    bool m_camera_valid;                    //!< True if there is a camera transform for the current frame
+    float m_camera[3][4];                   //!< The top three rows of the camera transform
+};
+
+#endif
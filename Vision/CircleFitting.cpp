@@ -109,7 +109,27 @@ Circle CircleFitting::FitCircleLMF(std::vector < Vector2<int> > points)
          tempPoint.y = points[i].y;
          fittedPoints.push_back(tempPoint);
     }
+    return FitPointsLMF();
+}
+
+// Fits a circle to sub-pixel points, for example edges found with EdgeDetection
+Circle CircleFitting::FitCircleLMF(const std::vector < Vector2<float> >& points)
+{
+    numFittedPoints = points.size();
+    fittedPoints.clear();
+    for(int i = 0; i < numFittedPoints; i++)
+    {
+         point tempPoint;
+         tempPoint.x = points[i].x;
+         tempPoint.y = points[i].y;
+         fittedPoints.push_back(tempPoint);
+    }
+    return FitPointsLMF();
+}
 
+// Fits a circle to the points in fittedPoints
+Circle CircleFitting::FitPointsLMF()
+{
     if (numFittedPoints > 5)
     {
         Circle algebraicCircle = AlgebraicCircleFit(); // Generates an approximate centre using an algebraic approximation to the centre of the circle
@@ -173,8 +193,8 @@ Circle CircleFitting::AlgebraicCircleFit()
     }
 
     // Calculate the average
-    meanX = (int) meanX/numFittedPoints;
-    meanY = (int) meanY/numFittedPoints;
+    meanX = meanX/numFittedPoints;
+    meanY = meanY/numFittedPoints;
 
     // Shift the data to the mean
     for (int j=0; j < numFittedPoints; j++)
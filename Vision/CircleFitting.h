@@ -23,8 +23,8 @@
 
 // Defines the stucture for a point
 struct point {
-  int x;
-  int y;
+  double x;
+  double y;
 };
 
 enum {
@@ -46,13 +46,15 @@ class CircleFitting {
 
     Circle FitCircleLMA(std::vector < Vector2<int> > points);
     Circle FitCircleLMF(std::vector < Vector2<int> > points);
+    Circle FitCircleLMF(const std::vector < Vector2<float> >& points);
     //Circle FitCircleLMF(uint8* image, Blob* ballBlob, int direction);
     //Circle ThreePointFit(uint8*,point,point,point);
     int numFittedPoints; //  Stores the number of points found so far
     std::vector<point> fittedPoints; // Stores the points which have been found so far
-    int meanX, meanY; 
+    double meanX, meanY;
 
   private:
+    Circle FitPointsLMF();
     Circle AlgebraicCircleFit();
     Circle GeometricCircleFitLMA(Circle initialCircle);
     Circle GeometricCircleFitLMF(Circle initialCircle);
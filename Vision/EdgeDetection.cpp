@@ -0,0 +1,335 @@
+/*!
+  @file EdgeDetection.cpp
+  @brief Implementation of the EdgeDetection class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "EdgeDetection.h"
+#include "Infrastructure/NUImage/NUImage.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define EDGEDETECTION_LANES 8
+#elif defined(__MMX__)
+    #include <mmintrin.h>
+    #define EDGEDETECTION_LANES 4
+#else
+    #define EDGEDETECTION_LANES 1
+#endif
+
+/*! @brief Constructs an edge detector
+    @param kernel the kernel the gradients are calculated with
+ */
+EdgeDetection::EdgeDetection(Kernel kernel)
+{
+    m_kernel = kernel;
+    m_valid = false;
+    m_x = 0;
+    m_y = 0;
+    m_width = 0;
+    m_height = 0;
+    m_stride = 0;
+    m_luma_stride = 0;
+}
+
+EdgeDetection::~EdgeDetection()
+{
+}
+
+/*! @brief Returns the name of the instruction set the gradients are calculated with */
+const char* EdgeDetection::getInstructionSet()
+{
+    #if defined(__SSE2__)
+        return "SSE2";
+    #elif defined(__MMX__)
+        return "MMX";
+    #else
+        return "C++";
+    #endif
+}
+
+/*! @brief Sets the kernel the gradients are calculated with. The region must be filtered again for it to take effect. */
+void EdgeDetection::setKernel(Kernel kernel)
+{
+    m_kernel = kernel;
+}
+
+/*! @brief Calculates the gradients of a region of the image, for refineEdge() to search.
+
+    The region should include the transitions to be refined, and the search radius either side of them; it is
+    clipped to the image.
+
+    @param image the image to filter
+    @param x the left of the region
+    @param y the top of the region
+    @param width the width of the region
+    @param height the height of the region
+    @return false if the region is entirely outside of the image
+ */
+bool EdgeDetection::filterRegion(const NUImage* image, int x, int y, int width, int height)
+{
+    m_valid = setRegion(image, x, y, width, height);
+    if (m_valid)
+    {
+        extractLuma(image);
+        calculateGradients();
+    }
+    return m_valid;
+}
+
+/*! @brief Finds the strongest edge along a row or column, within radius pixels of (x, y), in the filtered region.
+
+    This is intended to move a colour transition to the edge in the image. Only the gradient across the search
+    direction is used, so an edge along the search direction is ignored. The search is clipped to the region, and
+    to one pixel in from its ends so that there is a neighbour either side of every position in it.
+
+    @param x the x position of the transition
+    @param y the y position of the transition
+    @param horizontal true to search along the row, false to search along the column
+    @param radius the number of pixels either side of the transition to search
+    @param position the sub-pixel x position (horizontal) or y position (vertical) of the edge, if one is found
+    @return true if there is an edge of at least MinEdgeStrength whose peak is within the search
+ */
+bool EdgeDetection::refineEdge(int x, int y, bool horizontal, int radius, float& position) const
+{
+    if (not m_valid)
+        return false;
+    const int i = x - m_x;
+    const int j = y - m_y;
+    if (i < 0 or i >= m_width or j < 0 or j >= m_height)
+        return false;
+
+    const int length = horizontal ? m_width : m_height;
+    const int centre = horizontal ? i : j;
+    const int step = horizontal ? 1 : m_stride;
+    const short* gradient = horizontal ? &m_gx[j*m_stride] : &m_gy[i];
+    const int first = std::max(1, centre - radius);
+    const int last = std::min(length - 2, centre + radius);
+
+    int best = -1;
+    int bestvalue = MinEdgeStrength - 1;
+    for (int k = first; k <= last; k++)
+    {
+        int value = abs(gradient[k*step]);
+        if (value > bestvalue)
+        {
+            best = k;
+            bestvalue = value;
+        }
+    }
+    if (best < 0)
+        return false;
+
+    float offset = interpolatePeak(abs(gradient[(best - 1)*step]), bestvalue, abs(gradient[(best + 1)*step]));
+    position = (horizontal ? m_x : m_y) + best + offset;
+    return true;
+}
+
+/*! @brief Sets the region to be filtered, clipped to the image, and sizes the buffers for it.
+    @return false if the region is entirely outside of the image
+ */
+bool EdgeDetection::setRegion(const NUImage* image, int x, int y, int width, int height)
+{
+    if (image == NULL or image->m_image == NULL)
+        return false;
+    int left = std::max(0, x);
+    int top = std::max(0, y);
+    int right = std::min(image->getWidth(), x + width);
+    int bottom = std::min(image->getHeight(), y + height);
+    if (right <= left or bottom <= top)
+        return false;
+
+    m_x = left;
+    m_y = top;
+    m_width = right - left;
+    m_height = bottom - top;
+    // the rows are padded to a whole number of SIMD vectors, and the luma rows have room for the border either side
+    m_stride = (m_width + EDGEDETECTION_LANES - 1)/EDGEDETECTION_LANES*EDGEDETECTION_LANES;
+    m_luma_stride = m_stride + 2 + EDGEDETECTION_LANES;
+
+    size_t lumasize = (m_height + 2)*m_luma_stride;
+    if (m_luma.size() < lumasize)
+        m_luma.resize(lumasize, 0);
+    size_t size = m_height*m_stride;
+    if (m_gx.size() < size)
+    {
+        m_gx.resize(size);
+        m_gy.resize(size);
+    }
+    return true;
+}
+
+/*! @brief Unpacks the Y channel of the region, and a one pixel border, into m_luma. The border is clamped to the image. */
+void EdgeDetection::extractLuma(const NUImage* image)
+{
+    const int imagewidth = image->getWidth();
+    const int imageheight = image->getHeight();
+    const int left = std::max(0, m_x - 1);
+    const int right = std::min(imagewidth - 1, m_x + m_width);
+
+    for (int j = -1; j <= m_height; j++)
+    {
+        const Pixel* source = image->m_image[std::min(imageheight - 1, std::max(0, m_y + j))];
+        short* row = &m_luma[(j + 1)*m_luma_stride];
+        // row[0] is column m_x - 1 of the image
+        int i = left;
+        row[0] = source[left].y;
+        #if defined(__SSE2__)
+            const __m128i mask = _mm_set1_epi32(0xff);
+            for (; i + 8 <= right + 1; i += 8)
+            {   // the Y channel is the third byte of each pixel
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 4));
+                a = _mm_and_si128(_mm_srli_epi32(a, 16), mask);
+                b = _mm_and_si128(_mm_srli_epi32(b, 16), mask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i - m_x + 1), _mm_packs_epi32(a, b));
+            }
+        #elif defined(__MMX__)
+            const __m64 mask = _mm_set1_pi32(0xff);
+            for (; i + 4 <= right + 1; i += 4)
+            {   // the Y channel is the third byte of each pixel
+                __m64 a = *reinterpret_cast<const __m64*>(source + i);
+                __m64 b = *reinterpret_cast<const __m64*>(source + i + 2);
+                a = _mm_and_si64(_mm_srli_pi32(a, 16), mask);
+                b = _mm_and_si64(_mm_srli_pi32(b, 16), mask);
+                *reinterpret_cast<__m64*>(row + i - m_x + 1) = _mm_packs_pi32(a, b);
+            }
+        #endif
+        for (; i <= right; i++)
+            row[i - m_x + 1] = source[i].y;
+        row[m_width + 1] = source[right].y;
+    }
+    #if defined(__MMX__) && !defined(__SSE2__)
+        _mm_empty();
+    #endif
+}
+
+/*! @brief Calculates the gradients of the region from m_luma, with the Sobel or Scharr kernel.
+
+    Sobel is gx = [-1 0 1; -2 0 2; -1 0 1] and gy = [-1 -2 -1; 0 0 0; 1 2 1], which are at most 1020 in size.
+    Scharr is gx = [-3 0 3; -10 0 10; -3 0 3] and gy = [-3 -10 -3; 0 0 0; 3 10 3], which are at most 4080 in size,
+    and are divided by 4 to have the same gain as Sobel. Either way everything fits in a short. The padding at the
+    end of each row is calculated too, and ignored.
+ */
+void EdgeDetection::calculateGradients()
+{
+    const bool scharr = m_kernel == Scharr;
+    for (int j = 0; j < m_height; j++)
+    {
+        const short* r0 = &m_luma[j*m_luma_stride];
+        const short* r1 = r0 + m_luma_stride;
+        const short* r2 = r1 + m_luma_stride;
+        short* gx = &m_gx[j*m_stride];
+        short* gy = &m_gy[j*m_stride];
+        #if defined(__SSE2__)
+            const __m128i three = _mm_set1_epi16(3);
+            const __m128i ten = _mm_set1_epi16(10);
+            for (int i = 0; i < m_stride; i += 8)
+            {
+                __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i));
+                __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i + 1));
+                __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i + 2));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i));
+                __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i + 2));
+                __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r2 + i));
+                __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r2 + i + 1));
+                __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r2 + i + 2));
+
+                __m128i xcorners = _mm_add_epi16(_mm_sub_epi16(a2, a0), _mm_sub_epi16(c2, c0));
+                __m128i xcentre = _mm_sub_epi16(b2, b0);
+                __m128i ycorners = _mm_add_epi16(_mm_sub_epi16(c0, a0), _mm_sub_epi16(c2, a2));
+                __m128i ycentre = _mm_sub_epi16(c1, a1);
+                __m128i x, y;
+                if (scharr)
+                {
+                    x = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(xcorners, three), _mm_mullo_epi16(xcentre, ten)), 2);
+                    y = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(ycorners, three), _mm_mullo_epi16(ycentre, ten)), 2);
+                }
+                else
+                {
+                    x = _mm_add_epi16(xcorners, _mm_slli_epi16(xcentre, 1));
+                    y = _mm_add_epi16(ycorners, _mm_slli_epi16(ycentre, 1));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(gx + i), x);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(gy + i), y);
+            }
+        #elif defined(__MMX__)
+            const __m64 three = _mm_set1_pi16(3);
+            const __m64 ten = _mm_set1_pi16(10);
+            for (int i = 0; i < m_stride; i += 4)
+            {
+                __m64 a0 = *reinterpret_cast<const __m64*>(r0 + i);
+                __m64 a1 = *reinterpret_cast<const __m64*>(r0 + i + 1);
+                __m64 a2 = *reinterpret_cast<const __m64*>(r0 + i + 2);
+                __m64 b0 = *reinterpret_cast<const __m64*>(r1 + i);
+                __m64 b2 = *reinterpret_cast<const __m64*>(r1 + i + 2);
+                __m64 c0 = *reinterpret_cast<const __m64*>(r2 + i);
+                __m64 c1 = *reinterpret_cast<const __m64*>(r2 + i + 1);
+                __m64 c2 = *reinterpret_cast<const __m64*>(r2 + i + 2);
+
+                __m64 xcorners = _mm_add_pi16(_mm_sub_pi16(a2, a0), _mm_sub_pi16(c2, c0));
+                __m64 xcentre = _mm_sub_pi16(b2, b0);
+                __m64 ycorners = _mm_add_pi16(_mm_sub_pi16(c0, a0), _mm_sub_pi16(c2, a2));
+                __m64 ycentre = _mm_sub_pi16(c1, a1);
+                __m64 x, y;
+                if (scharr)
+                {
+                    x = _mm_srai_pi16(_mm_add_pi16(_mm_mullo_pi16(xcorners, three), _mm_mullo_pi16(xcentre, ten)), 2);
+                    y = _mm_srai_pi16(_mm_add_pi16(_mm_mullo_pi16(ycorners, three), _mm_mullo_pi16(ycentre, ten)), 2);
+                }
+                else
+                {
+                    x = _mm_add_pi16(xcorners, _mm_slli_pi16(xcentre, 1));
+                    y = _mm_add_pi16(ycorners, _mm_slli_pi16(ycentre, 1));
+                }
+
+                *reinterpret_cast<__m64*>(gx + i) = x;
+                *reinterpret_cast<__m64*>(gy + i) = y;
+            }
+        #else
+            const int cornerweight = scharr ? 3 : 1;
+            const int centreweight = scharr ? 10 : 2;
+            const int shift = scharr ? 2 : 0;
+            for (int i = 0; i < m_width; i++)
+            {
+                int xcorners = (r0[i+2] - r0[i]) + (r2[i+2] - r2[i]);
+                int ycorners = (r2[i] - r0[i]) + (r2[i+2] - r0[i+2]);
+                gx[i] = (cornerweight*xcorners + centreweight*(r1[i+2] - r1[i])) >> shift;
+                gy[i] = (cornerweight*ycorners + centreweight*(r2[i+1] - r0[i+1])) >> shift;
+            }
+        #endif
+    }
+    #if defined(__MMX__) && !defined(__SSE2__)
+        _mm_empty();
+    #endif
+}
+
+/*! @brief Returns the offset, between -0.5 and 0.5, of the peak of the parabola through three equally spaced values */
+float EdgeDetection::interpolatePeak(int before, int peak, int after)
+{
+    int denominator = before - 2*peak + after;
+    if (denominator >= 0)
+        return 0;
+    float offset = 0.5f*(before - after)/denominator;
+    return std::max(-0.5f, std::min(0.5f, offset));
+}
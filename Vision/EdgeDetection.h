@@ -0,0 +1,86 @@
+/*!
+  @file EdgeDetection.h
+  @brief Declaration of the EdgeDetection class.
+
+  @class EdgeDetection
+  @brief Finds edges in the Y channel of an NUImage, to sub-pixel accuracy, within a region of interest.
+
+  The Y channel of the region is unpacked into a buffer of shorts, and the Sobel or Scharr gradients are calculated
+  a row at a time, with SSE2 (8 pixels at a time) or MMX (4 pixels at a time) when the compiler targets them,
+  and in plain C++ otherwise. The buffers are kept between calls, so once they have grown to the largest
+  region there are no further allocations.
+
+  Only the regions of interest are filtered (ball candidates, goal post rows and field line segments), so the
+  cost is a small fraction of filtering the whole image. A region is filtered once with filterRegion(), and then
+  refineEdge() moves each colour transition in it to the strongest edge along its row or column. The position of
+  the edge is interpolated with a parabola through the gradient magnitude either side of the peak, giving the edge
+  to a fraction of a pixel.
+
+  The Scharr kernel is more accurate for edges that are not along a row or column, for the cost of a multiply.
+  Its gradients are divided by 4, so that both kernels have the same gain and MinEdgeStrength holds for both.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EDGEDETECTION_H
+#define EDGEDETECTION_H
+
+#include <vector>
+
+class NUImage;
+
+class EdgeDetection
+{
+public:
+    //! The gradient kernels
+    enum Kernel
+    {
+        Sobel,          //!< [-1 0 1; -2 0 2; -1 0 1]
+        Scharr          //!< [-3 0 3; -10 0 10; -3 0 3], divided by 4
+    };
+    static const int MinEdgeStrength = 48;          //!< The gradient below which refineEdge() does not report an edge
+
+    EdgeDetection(Kernel kernel = Sobel);
+    ~EdgeDetection();
+
+    void setKernel(Kernel kernel);
+    bool filterRegion(const NUImage* image, int x, int y, int width, int height);
+    bool refineEdge(int x, int y, bool horizontal, int radius, float& position) const;
+
+    static const char* getInstructionSet();
+private:
+    bool setRegion(const NUImage* image, int x, int y, int width, int height);
+    void extractLuma(const NUImage* image);
+    void calculateGradients();
+    static float interpolatePeak(int before, int peak, int after);
+
+    Kernel m_kernel;                    //!< The kernel the gradients are calculated with
+    bool m_valid;                       //!< True if a region has been filtered
+    std::vector<short> m_luma;          //!< The Y channel of the region, with a one pixel border, (m_height + 2) rows of m_luma_stride
+    std::vector<short> m_gx;            //!< The horizontal gradient of the region, m_height rows of m_stride
+    std::vector<short> m_gy;            //!< The vertical gradient of the region, m_height rows of m_stride
+    int m_x;                            //!< The left of the region in the image
+    int m_y;                            //!< The top of the region in the image
+    int m_width;                        //!< The width of the region
+    int m_height;                       //!< The height of the region
+    int m_stride;                       //!< The length of each row of the gradient buffers; a multiple of the SIMD width
+    int m_luma_stride;                  //!< The length of each row of the luma buffer
+};
+
+#endif
+
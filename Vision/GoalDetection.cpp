@@ -5,8 +5,8 @@
 #include "ClassifiedSection.h"
 #include "debug.h"
 #include "Tools/Math/General.h"
-#include "Infrastructure/NUSensorsData/NUSensorsData.h"
-#include "Kinematics/Kinematics.h"
+#include <algorithm>
+#include <cstdlib>
 //#ifdef WIN32
 //    #include <QDebug>
 //#end
@@ -697,7 +697,7 @@ Vector3<float> GoalDetection::FindGoalSphericalPosition( const ObjectCandidate &
 {
     float distance = 0.0;
     std::vector < TransitionSegment > tempSegments = PossibleGoal.getSegments();
-    std::vector < Vector2<int> > midpoints, leftPoints, rightPoints;
+    std::vector < Vector2<float> > midpoints, leftPoints, rightPoints;
     Vector2<int> tempStart, tempEnd;
     float pixelError = 0.0;
     //! USE CANDIDATE HEIGHT:
@@ -760,7 +760,6 @@ Vector3<float> GoalDetection::FindGoalSphericalPosition( const ObjectCandidate &
 
         if(fabs(tempEnd.x-tempStart.x) > 2 && i < (int)tempSegments.size())
         {
-            Vector2<int> tempMidPoint;
             //FIND the EXACT TEMPEND and TEMPSTART points:
             int checkEndx = tempEnd.x;
             int checkStartx = tempStart.x;
@@ -804,12 +803,23 @@ Vector3<float> GoalDetection::FindGoalSphericalPosition( const ObjectCandidate &
             //qDebug() << "Start, End: "<< i <<":" << tempStart.x << ", " << tempStart.y << "\t" <<  tempEnd.x << ", " << tempEnd.y << "\t" << tempEnd.x - tempStart.x << MINIMUM_GOAL_WIDTH_IN_PIXELS/2;
             if(fabs(tempEnd.x -tempStart.x) < MINIMUM_GOAL_WIDTH_IN_PIXELS/2) continue;
 
-
-            tempMidPoint.x = (int)((tempEnd.x -tempStart.x)/2)+tempStart.x;
-            tempMidPoint.y = (int)((tempEnd.y - tempStart.y)/2)+tempStart.y;
+            //! Move the left and right points to the edges of the post in the image, to sub-pixel accuracy
+            const int EDGE_SEARCH_RADIUS = 2;
+            Vector2<float> leftEdge(tempStart.x, tempStart.y);
+            Vector2<float> rightEdge(tempEnd.x, tempEnd.y);
+            //! The row across the post, and the search either side of it, is filtered once for both edges
+            int left = std::min(tempStart.x, tempEnd.x);
+            vision->filterEdgeRegion(left - EDGE_SEARCH_RADIUS - 1, tempStart.y, abs(tempEnd.x - tempStart.x) + 2*EDGE_SEARCH_RADIUS + 3, 1);
+            float position;
+            if(vision->refineEdge(tempStart.x, tempStart.y, true, EDGE_SEARCH_RADIUS, position))
+                leftEdge.x = position;
+            if(vision->refineEdge(tempEnd.x, tempEnd.y, true, EDGE_SEARCH_RADIUS, position))
+                rightEdge.x = position;
+
+            Vector2<float> tempMidPoint((leftEdge.x + rightEdge.x)/2, (leftEdge.y + rightEdge.y)/2);
             midpoints.push_back(tempMidPoint);
-            leftPoints.push_back(tempStart);
-            rightPoints.push_back(tempEnd);
+            leftPoints.push_back(leftEdge);
+            rightPoints.push_back(rightEdge);
         }
 
     }
@@ -903,7 +913,7 @@ Vector3<float> GoalDetection::FindGoalSphericalPosition( const ObjectCandidate &
     //qDebug()<< "Interescting Screen at TOP: \t"<< rightPointLine.findXFromY(0)<< ","<< 0 << endl;
     //qDebug()<< "Interescting Screen at Bottom: \t"<< rightPointLine.findXFromY(240)<< ","<< 240 << endl;
 
-    Vector2<int> leftpoint;
+    Vector2<float> leftpoint;
     leftpoint.y = (PossibleGoal.getBottomRight().y + PossibleGoal.getTopLeft().y)/2;
     leftpoint.x = leftPointLine.findXFromY(leftpoint.y);
 
@@ -928,8 +938,8 @@ Vector3<float> GoalDetection::FindGoalSphericalPosition( const ObjectCandidate &
     //! Largest Width is obtained by itterating through the midpoint distances, and obtaining the largest width that has symetrical left and right distances.
     for(int i = 0 ; i < (int)leftPoints.size()-1; i++)
     {
-        Vector2<int> leftpoint = leftPoints[i];
-        Vector2<int> rightpoint = rightPoints[i];
+        Vector2<float> leftpoint = leftPoints[i];
+        Vector2<float> rightpoint = rightPoints[i];
         float leftPixels = DistanceLineToPoint(midPointLine, leftpoint);
         float rightPixels = DistanceLineToPoint(midPointLine, rightpoint);
 
@@ -1041,31 +1051,19 @@ float GoalDetection::DistanceToPoint(const ObjectCandidate &PossibleGoal, Vision
     float MiddleX = (PossibleGoal.getTopLeft().x + PossibleGoal.getBottomRight().x)/2;
     float BottomY = PossibleGoal.getBottomRight().y;
 
-    float bearing = vision->CalculateBearing(MiddleX);
-    float elevation = vision->CalculateElevation(BottomY);
-
-    //! @todo TODO: the camera to ground transform is going to be made private in a future release.
-    // I think Kinematics::DistanceToPoint should be a friend with the sensor data, and get the transform itself
-    // Also will need to be updated when the sensor data can properly store kinematic data
-    vector<float> ctgvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector); 
-    if(isOK == true)
+    Vector3<float> result;
+    if(vision->getCameraProjection().groundPosition(MiddleX, BottomY, result))
     {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-        Vector3<float> result;
-        result = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
         D2Pdistance = result[0];
-        bearing = result[1];
-        elevation = result[2];
 
         #if DEBUG_VISION_VERBOSITY > 6
-            debug << "\t\tCalculated Distance to Point: " << *distance<<endl;
+            debug << "\t\tCalculated Distance to Point: " << D2Pdistance<<endl;
         #endif
     }
     return D2Pdistance;
 }
 
-float GoalDetection::DistanceLineToPoint(const LSFittedLine &midPointLine, const Vector2<int> & point)
+float GoalDetection::DistanceLineToPoint(const LSFittedLine &midPointLine, const Vector2<float> & point)
 {
     float distance = fabs( point.x * midPointLine.getA() + point.y *  midPointLine.getB() - midPointLine.getC())
                    / sqrt( midPointLine.getA() *  midPointLine.getA() + midPointLine.getB() *  midPointLine.getB());
@@ -1107,16 +1105,7 @@ void GoalDetection::UpdateAFieldObject(FieldObjects* AllObjects, Vision* vision,
     Vector3 <float> transformedSphericalPosition;
     Vector2<float> screenPositionAngle(sphericalPosition[1], sphericalPosition[2]);
     
-    //! @todo TODO: the camera to ground transform is going to be made private in a future release.
-    // I think Kinematics::DistanceToPoint should be a friend with the sensor data, and get the transform itself
-    // Also will need to be updated when the sensor data can properly store kinematic data
-    vector<float> ctvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraTransform, ctvector);
-    if(isOK == true)
-    {
-        Matrix cameraTransform = Matrix4x4fromVector(ctvector);
-        transformedSphericalPosition = Kinematics::TransformPosition(cameraTransform,sphericalPosition);
-    }
+    vision->getCameraProjection().transformPosition(sphericalPosition, transformedSphericalPosition);
 
     sizeOnScreen.x = GoalPost->width();
     sizeOnScreen.y = GoalPost->height();
@@ -1297,13 +1286,7 @@ void GoalDetection::AddAmbiguousGoalPost(ObjectCandidate* GoalPost, FieldObjects
     Vector3 <float> transformedSphericalPosition;
     Vector2<float> screenPositionAngle(sphericalPosition[1], sphericalPosition[2]);
     
-    vector<float> ctvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraTransform, ctvector);
-    if(isOK == true)
-    {
-        Matrix cameraTransform = Matrix4x4fromVector(ctvector);
-        transformedSphericalPosition = Kinematics::TransformPosition(cameraTransform,sphericalPosition);
-    }
+    vision->getCameraProjection().transformPosition(sphericalPosition, transformedSphericalPosition);
 
     sizeOnScreen.x = GoalPost->width();
     sizeOnScreen.y = GoalPost->height();
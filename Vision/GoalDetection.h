@@ -51,7 +51,7 @@ class GoalDetection
 
         float DistanceToPoint(const ObjectCandidate &PossibleGoal, Vision* vision);
 
-        float DistanceLineToPoint(const LSFittedLine &midPointLine, const Vector2<int> &point);
+        float DistanceLineToPoint(const LSFittedLine &midPointLine, const Vector2<float> &point);
 
         //! SORTING: BIGGEST TO SMALLEST
         void SortObjectCandidates(std::vector<ObjectCandidate>& FO_Candidates);
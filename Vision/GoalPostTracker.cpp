@@ -0,0 +1,164 @@
+/*!
+  @file GoalPostTracker.cpp
+  @brief Implementation of the GoalPostTracker class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GoalPostTracker.h"
+
+const float GoalPostTracker::BaseMargin = 0.05f;
+const float GoalPostTracker::MissMargin = 0.05f;
+
+GoalPostTracker::GoalPostTracker()
+{
+    m_max_misses = DefaultMaxMisses;
+    m_search_period = DefaultSearchPeriod;
+    m_frames_since_search = 0;
+    m_num_searches = 0;
+    m_num_tracked_frames = 0;
+}
+
+GoalPostTracker::~GoalPostTracker()
+{
+}
+
+/*! @brief Sets the number of frames in a row a post can be missed before it is dropped */
+void GoalPostTracker::setMaxMisses(int misses)
+{
+    m_max_misses = misses;
+}
+
+/*! @brief Returns the number of frames in a row a post can be missed before it is dropped */
+int GoalPostTracker::getMaxMisses() const
+{
+    return m_max_misses;
+}
+
+/*! @brief Sets the number of frames between full searches while posts are tracked. 0 or 1 turns tracking off. */
+void GoalPostTracker::setSearchPeriod(int frames)
+{
+    m_search_period = frames;
+    if (m_search_period <= 1)
+        lose();
+}
+
+/*! @brief Returns the number of frames between full searches while posts are tracked */
+int GoalPostTracker::getSearchPeriod() const
+{
+    return m_search_period;
+}
+
+/*! @brief Returns true if there are posts being tracked */
+bool GoalPostTracker::isTracking() const
+{
+    return not m_posts.empty();
+}
+
+/*! @brief Returns true if the full goal search should be run in this frame, because no posts are tracked or a search is due */
+bool GoalPostTracker::isSearchDue() const
+{
+    return m_search_period <= 1 or m_max_misses <= 0 or m_posts.empty() or m_frames_since_search + 1 >= m_search_period;
+}
+
+/*! @brief Returns the posts being tracked, so that their windows can be predicted */
+std::vector<GoalPostTracker::Post>& GoalPostTracker::getPosts()
+{
+    return m_posts;
+}
+
+/*! @brief Returns the distance from the predicted position of a post in which it is expected to be (rad) */
+float GoalPostTracker::getMargin(const Post& post) const
+{
+    return BaseMargin + MissMargin*post.Misses;
+}
+
+/*! @brief Replaces the tracked posts with the ones found by a full search
+    @param seen the posts found; their windows are the boxes they were found in
+ */
+void GoalPostTracker::searched(const std::vector<Post>& seen)
+{
+    m_num_searches++;
+    m_frames_since_search = 0;
+    m_posts.clear();
+    if (m_search_period <= 1 or m_max_misses <= 0)
+        return;
+    for (size_t i = 0; i < seen.size(); i++)
+    {
+        m_posts.push_back(seen[i]);
+        m_posts.back().Misses = 0;
+    }
+}
+
+/*! @brief Updates the tracked posts with the ones found in their windows. Posts not found are missed, and dropped once
+           they have been missed too many times in a row.
+    @param seen the posts found; their windows are the boxes they were found in
+ */
+void GoalPostTracker::tracked(const std::vector<Post>& seen)
+{
+    m_num_tracked_frames++;
+    m_frames_since_search++;
+    std::vector<bool> used(seen.size(), false);
+    std::vector<Post>::iterator it = m_posts.begin();
+    while (it != m_posts.end())
+    {
+        bool found = false;
+        for (size_t i = 0; i < seen.size() and not found; i++)
+        {
+            int x = (seen[i].WindowTopLeft.x + seen[i].WindowBottomRight.x)/2;
+            if (not used[i] and it->InView and seen[i].Colour == it->Colour and x >= it->WindowTopLeft.x and x <= it->WindowBottomRight.x)
+            {
+                it->Top = seen[i].Top;
+                it->Bottom = seen[i].Bottom;
+                it->Width = seen[i].Width;
+                it->Misses = 0;
+                used[i] = true;
+                found = true;
+            }
+        }
+        if (not found)
+        {
+            it->Misses++;
+            if (it->Misses >= m_max_misses)
+            {
+                it = m_posts.erase(it);
+                continue;
+            }
+        }
+        ++it;
+    }
+}
+
+/*! @brief Stops tracking every post, for when there is no way to predict where they are */
+void GoalPostTracker::lose()
+{
+    m_posts.clear();
+    m_frames_since_search = 0;
+}
+
+/*! @brief Returns the number of frames the full goal search was run */
+unsigned long GoalPostTracker::getNumSearches() const
+{
+    return m_num_searches;
+}
+
+/*! @brief Returns the number of frames the posts were only checked in their windows */
+unsigned long GoalPostTracker::getNumTrackedFrames() const
+{
+    return m_num_tracked_frames;
+}
@@ -0,0 +1,94 @@
+/*!
+  @file GoalPostTracker.h
+  @brief Declaration of the GoalPostTracker class.
+
+  @class GoalPostTracker
+  @brief Keeps track of the goal posts seen in previous frames, so that vision can check a few windows instead of searching for them.
+
+  Each post is kept as its colour, its width on the screen, and the directions of the top and bottom of its centre line
+  relative to the robot. The directions are projected into each new image with the current camera transform, so the head
+  moving is not mistaken for the posts moving; the camera's offset from the neck is ignored, which is a fraction of a pixel
+  for a post more than a metre away. The posts do not move, so the only other error in the prediction is the robot walking
+  or turning, which the window margin allows for. The margin grows while a post is missed.
+
+  The full goal search is run when no posts are tracked, and every SearchPeriod frames while they are, so that posts coming
+  into view are found. A post is dropped once it has been missed in its window MaxMisses frames in a row.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOALPOSTTRACKER_H
+#define GOALPOSTTRACKER_H
+
+#include "Tools/Math/Vector2.h"
+#include "Tools/Math/Vector3.h"
+
+#include <vector>
+
+class GoalPostTracker
+{
+public:
+    //! A tracked goal post
+    struct Post
+    {
+        unsigned char Colour;           //!< The colour of the post (ClassIndex::yellow or ClassIndex::blue)
+        Vector3<float> Top;             //!< The direction of the top of the post relative to the robot (unit vector)
+        Vector3<float> Bottom;          //!< The direction of the bottom of the post relative to the robot (unit vector)
+        float Width;                    //!< The width of the post on the screen (pixels)
+        int Misses;                     //!< The number of frames in a row the post has not been found in its window
+        bool InView;                    //!< True if the post's window is on the screen in the current frame
+        Vector2<int> WindowTopLeft;     //!< The top left of the window the post is expected in, or of where a seen post was found
+        Vector2<int> WindowBottomRight; //!< The bottom right of the window the post is expected in, or of where a seen post was found
+    };
+
+    static const int DefaultMaxMisses = 3;          //!< The default number of frames in a row a post can be missed before it is dropped
+    static const int DefaultSearchPeriod = 10;      //!< The default number of frames between full searches while posts are tracked
+
+    GoalPostTracker();
+    ~GoalPostTracker();
+
+    void setMaxMisses(int misses);
+    int getMaxMisses() const;
+    void setSearchPeriod(int frames);
+    int getSearchPeriod() const;
+    bool isTracking() const;
+
+    bool isSearchDue() const;
+    std::vector<Post>& getPosts();
+    float getMargin(const Post& post) const;
+
+    void searched(const std::vector<Post>& seen);
+    void tracked(const std::vector<Post>& seen);
+    void lose();
+
+    unsigned long getNumSearches() const;
+    unsigned long getNumTrackedFrames() const;
+private:
+    static const float BaseMargin;              //!< The window margin about a post that has just been seen (rad)
+    static const float MissMargin;              //!< The amount the window margin grows each frame the post is missed (rad)
+
+    int m_max_misses;                   //!< The number of frames in a row a post can be missed before it is dropped
+    int m_search_period;                //!< The number of frames between full searches while posts are tracked, 0 turns tracking off
+    int m_frames_since_search;          //!< The number of frames since the last full search
+    std::vector<Post> m_posts;          //!< The posts being tracked
+
+    unsigned long m_num_searches;       //!< The number of frames the full search was run
+    unsigned long m_num_tracked_frames; //!< The number of frames the posts were only checked in their windows
+};
+
+#endif
@@ -118,6 +118,7 @@ void LineDetection::FormLines(FieldObjects* AllObjects, Vision* vision, NUSensor
 
 
     TransformLinesToWorldModelSpace(vision);
+    ExportFieldLinePoints(AllObjects, vision);
 
 
     #if DEBUG_VISION_VERBOSITY > 5
@@ -208,6 +209,9 @@ void LineDetection::FormLines(FieldObjects* AllObjects,
     vector< TransitionSegment > tempseg;
     LinePoint* temppoint;
     vector<LinePoint*> tempcluster;
+    Vector2<float> midpoint;
+    //! The number of pixels either side of each end of a segment searched for the edge of the line
+    const int EDGE_SEARCH_RADIUS = 2;
     for(unsigned int i=0; i<candidates.size(); i++)
     {
         //For each ObjectCandidate create vector of linepoints and add it to clusters
@@ -217,8 +221,9 @@ void LineDetection::FormLines(FieldObjects* AllObjects,
         {
             //For each segment create a new linepoint and push it to a vector
             temppoint = new LinePoint();
-            temppoint->x = (double)tempseg[k].getMidPoint().x;
-            temppoint->y = (double)tempseg[k].getMidPoint().y;
+            midpoint = vision->refineSegmentMidPoint(tempseg[k], EDGE_SEARCH_RADIUS);
+            temppoint->x = (double)midpoint.x;
+            temppoint->y = (double)midpoint.y;
             /*
             if(GetDistanceToPoint(*temppoint, convertVals, vision)) {
                 SAM::convertPoint(*temppoint, convertVals);
@@ -233,8 +238,9 @@ void LineDetection::FormLines(FieldObjects* AllObjects,
     for(unsigned int i=0; i<leftoverPoints.size(); i++)
     {
         temppoint = new LinePoint();
-        temppoint->x = (double)leftoverPoints[i].getMidPoint().x;
-        temppoint->y = (double)leftoverPoints[i].getMidPoint().y;
+        midpoint = vision->refineSegmentMidPoint(leftoverPoints[i], EDGE_SEARCH_RADIUS);
+        temppoint->x = (double)midpoint.x;
+        temppoint->y = (double)midpoint.y;
         /*
         if(GetDistanceToPoint(*temppoint, convertVals, vision)) {
             SAM::convertPoint(*temppoint, convertVals);
@@ -369,6 +375,7 @@ void LineDetection::FormLines(FieldObjects* AllObjects,
 
 
     TransformLinesToWorldModelSpace(vision);
+    ExportFieldLinePoints(AllObjects, vision);
 
     //qDebug() << "Finding Penalty Spots:";
     FindPenaltySpot(vision);
@@ -2519,18 +2526,53 @@ void LineDetection::DecodePenaltySpot(FieldObjects* AllObjects, double timestamp
     }
 }
 
+/*! @brief Puts the points on the valid field lines onto the ground, for localisation to match against the field
+
+    At most MAX_FIELDLINE_MEASUREMENT_POINTS points, spread evenly over the lines, are kept. The points are relative
+    to the robot (x forward, y left in cm).
+ */
+void LineDetection::ExportFieldLinePoints(FieldObjects* AllObjects, Vision* vision)
+{
+    std::vector< Vector2<float> > screenPoints;
+    for(unsigned int i = 0; i < fieldLines.size(); i++)
+    {
+        if(fieldLines[i].valid == false)
+            continue;
+        std::vector<LinePoint*> points = fieldLines[i].getPoints();
+        for(unsigned int k = 0; k < points.size(); k++)
+            screenPoints.push_back(Vector2<float>(points[k]->x, points[k]->y));
+    }
+    if(screenPoints.size() > MAX_FIELDLINE_MEASUREMENT_POINTS)
+    {
+        std::vector< Vector2<float> > sample;
+        sample.reserve(MAX_FIELDLINE_MEASUREMENT_POINTS);
+        for(unsigned int i = 0; i < MAX_FIELDLINE_MEASUREMENT_POINTS; i++)
+            sample.push_back(screenPoints[(i*screenPoints.size())/MAX_FIELDLINE_MEASUREMENT_POINTS]);
+        screenPoints.swap(sample);
+    }
+
+    std::vector< Vector3<float> > groundPoints;
+    std::vector< bool > isOnGround;
+    vision->getCameraProjection().groundPositions(screenPoints, groundPoints, isOnGround);
+    for(unsigned int i = 0; i < groundPoints.size(); i++)
+    {
+        if(isOnGround[i])
+            AllObjects->fieldLinePoints.push_back(Vector2<float>(groundPoints[i].x*cos(groundPoints[i].y), groundPoints[i].x*sin(groundPoints[i].y)));
+    }
+
+    #if DEBUG_VISION_VERBOSITY > 5
+        debug << "\t\tLineDetection::ExportFieldLinePoints: " << AllObjects->fieldLinePoints.size() << " points." << endl;
+    #endif
+}
+
 void LineDetection::GetDistanceToPoint(double cx, double cy, double* distance, double* bearing, double* elevation, Vision* vision)
 {
     *bearing = vision->CalculateBearing(cx);
     *elevation = vision->CalculateElevation(cy);
 
-    vector<float> ctgvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector); 
-    if(isOK == true)
+    Vector3<float> result;
+    if(vision->getCameraProjection().groundPosition(cx, cy, result))
     {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-        Vector3<float> result;
-        result = Kinematics::DistanceToPoint(camera2groundTransform, *bearing, *elevation);
         *distance = result[0];
         *bearing = result[1];
         *elevation = result[2];
@@ -2544,42 +2586,12 @@ void LineDetection::GetDistanceToPoint(double cx, double cy, double* distance, d
 
 bool LineDetection::GetDistanceToPoint(LinePoint point, Vector3<float> &relativePoint, Vision* vision)
 {
-    float bearing = vision->CalculateBearing(point.x);
-    float elevation = vision->CalculateElevation(point.y);
-
-    vector<float> ctgvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector);
-    if(isOK == true)
-    {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-
-        relativePoint = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
-
-        //#if DEBUG_VISION_VERBOSITY > 6
-        //    debug << "\t\tCalculated Distance to Point: " << *distance<<endl;
-        //#endif
-    }
-    return isOK;
+    return vision->getCameraProjection().groundPosition(point.x, point.y, relativePoint);
 }
 
 bool LineDetection::GetDistanceToPoint(Point point, Vector3<float> &relativePoint, Vision* vision)
 {
-    float bearing = vision->CalculateBearing(point.x);
-    float elevation = vision->CalculateElevation(point.y);
-
-    vector<float> ctgvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector);
-    if(isOK == true)
-    {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-
-        relativePoint = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
-
-        //#if DEBUG_VISION_VERBOSITY > 6
-        //    debug << "\t\tCalculated Distance to Point: " << *distance<<endl;
-        //#endif
-    }
-    return isOK;
+    return vision->getCameraProjection().groundPosition(point.x, point.y, relativePoint);
 }
 
 /*
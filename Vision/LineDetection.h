@@ -17,6 +17,7 @@ class Kinematics;
 #define MAX_LINEPOINTS 100
 #define MAX_FIELDLINES 15
 #define MAX_CORNERPOINTS 10
+#define MAX_FIELDLINE_MEASUREMENT_POINTS 64
 #define VERT_POINT_THICKNESS 40
 #define MIN_POINT_THICKNESS 1
 #define HORZ_POINT_THICKNESS 40
@@ -89,6 +90,7 @@ class LineDetection{
         void GetDistanceToPoint(double,double,double*,double*,double*, Vision* vision);
         bool GetDistanceToPoint(LinePoint point,  Vector3<float> &result, Vision* vision);
         void TransformLinesToWorldModelSpace(Vision* vision);
+        void ExportFieldLinePoints(FieldObjects* AllObjects, Vision* vision);
         //! Line Point Sorting
         void qsort(std::vector<LinePoint> &array, int left, int right, int type);
         void swap(std::vector<LinePoint> &array, int i, int j);
@@ -0,0 +1,410 @@
+/*!
+  @file ScanInterestMap.cpp
+  @brief Implementation of the ScanInterestMap class.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ScanInterestMap.h"
+#include "Kinematics/Horizon.h"
+
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <iomanip>
+
+const float ScanInterestMap::TransitionWeight = 1.0f;
+const float ScanInterestMap::HorizonWeight = 2.0f;
+const float ScanInterestMap::BallWeight = 8.0f;
+const float ScanInterestMap::MinInterest = 0.5f;
+
+ScanInterestMap::ScanInterestMap()
+{
+    m_budget = DefaultPixelBudget;
+    m_width = 0;
+    m_height = 0;
+    m_spacing = 1;
+    m_columns = 0;
+    m_rows = 0;
+    m_ball_known = false;
+    m_ball_radius = 0;
+    m_num_frames = 0;
+    m_total_pixels = 0;
+}
+
+ScanInterestMap::~ScanInterestMap()
+{
+}
+
+/*! @brief Sets the maximum number of pixels classified each frame, including those classified before the fine scan lines */
+void ScanInterestMap::setPixelBudget(int pixels)
+{
+    m_budget = pixels;
+}
+
+/*! @brief Returns the maximum number of pixels classified each frame */
+int ScanInterestMap::getPixelBudget() const
+{
+    return m_budget;
+}
+
+/*! @brief Sets where the ball is expected to be in the image
+    @param position the position in the image the ball was last seen
+    @param radius the distance from position in which the ball is expected to be
+ */
+void ScanInterestMap::setBall(const Vector2<int>& position, int radius)
+{
+    m_ball_known = true;
+    m_ball_position = position;
+    m_ball_radius = radius;
+}
+
+/*! @brief Clears the expected position of the ball, for when it has not been seen recently */
+void ScanInterestMap::clearBall()
+{
+    m_ball_known = false;
+}
+
+/*! @brief Calculates the interest in each region from the coarse scan lines.
+    @param coarse the classified coarse scan lines, one at each field border point
+    @param fieldBorders the field border points, one scan spacing apart
+    @param horizonLine the horizon, or NULL to use the field border in its place
+    @param width the width of the image
+    @param height the height of the image
+    @param spacing the scan spacing
+ */
+void ScanInterestMap::build(ClassifiedSection* coarse, const std::vector<Vector2<int> >& fieldBorders, const Horizon* horizonLine,
+                            int width, int height, int spacing)
+{
+    if (spacing < 1)
+        spacing = 1;
+    int columns = (width + spacing - 1)/spacing;
+    int rows = (height + spacing - 1)/spacing;
+    if (columns != m_columns or rows != m_rows or spacing != m_spacing)
+    {   // the statistics are meaningless if the regions change
+        m_columns = columns;
+        m_rows = rows;
+        m_spacing = spacing;
+        m_regions.resize(m_columns*m_rows);
+        resetStatistics();
+    }
+    m_width = width;
+    m_height = height;
+
+    m_border.assign(m_columns, -1);
+    for (size_t i = 0; i < fieldBorders.size(); i++)
+    {
+        int column = fieldBorders[i].x/m_spacing;
+        if (column >= 0 and column < m_columns)
+            m_border[column] = fieldBorders[i].y;
+    }
+
+    for (size_t i = 0; i < m_regions.size(); i++)
+    {
+        m_regions[i].Transitions = 0;
+        m_regions[i].Interest = 0;
+        m_regions[i].Level = 0;
+        m_regions[i].Pixels = 0;
+        m_regions[i].Segments = 0;
+    }
+
+    //! Count the transitions on each coarse scan line; the line is on the left of its column and the right of the previous one
+    for (int i = 0; i < coarse->getNumberOfScanLines(); i++)
+    {
+        ScanLine* line = coarse->getScanLine(i);
+        int column = line->getStart().x/m_spacing;
+        for (int j = 0; j < line->getNumberOfSegments(); j++)
+        {
+            TransitionSegment* segment = line->getSegment(j);
+            int ends[2] = {segment->getStartPoint().y/m_spacing, segment->getEndPoint().y/m_spacing};
+            for (int k = 0; k < 2; k++)
+            {
+                if (ends[k] < 0 or ends[k] >= m_rows)
+                    continue;
+                if (column >= 0 and column < m_columns)
+                    m_regions[ends[k]*m_columns + column].Transitions++;
+                if (column - 1 >= 0 and column - 1 < m_columns)
+                    m_regions[ends[k]*m_columns + column - 1].Transitions++;
+            }
+        }
+    }
+
+    //! Combine the transitions, the closeness to the horizon and the closeness to the ball
+    for (int c = 0; c < m_columns; c++)
+    {
+        if (m_border[c] < 0)
+            continue;
+        int x = c*m_spacing + m_spacing/2;
+        int horizon = horizonLine != NULL ? (int)horizonLine->findYFromX(x) : borderAt(x);
+        for (int r = 0; r < m_rows; r++)
+        {
+            int h = regionHeight(c, r);
+            if (h <= 0)
+                continue;
+            Region& region = m_regions[r*m_columns + c];
+            int bottom = std::min(regionTop(r + 1), m_height);
+            int top = bottom - h;
+            float closeness = 1 - (float)((top + bottom)/2 - horizon)/m_height;
+            closeness = std::max(0.0f, std::min(1.0f, closeness));
+            region.Interest = TransitionWeight*region.Transitions + HorizonWeight*closeness;
+
+            if (m_ball_known)
+            {   // the distance from the ball to the nearest point in the region
+                int dx = std::max(0, std::max(c*m_spacing - m_ball_position.x, m_ball_position.x - (c + 1)*m_spacing));
+                int dy = std::max(0, std::max(top - m_ball_position.y, m_ball_position.y - bottom));
+                if (dx*dx + dy*dy <= m_ball_radius*m_ball_radius)
+                    region.Interest += BallWeight;
+            }
+        }
+    }
+}
+
+/*! @brief Shares the fine scan lines out between the regions, most interesting first, until the budget is spent.
+
+    Each time a region goes up a level the number of its fine scan lines doubles, so the interest is halved
+    each level to give the interest per pixel.
+
+    @param pixelsused the number of pixels already classified this frame
+    @param fine the fine scan lines are added to this section, a column at a time
+ */
+void ScanInterestMap::allocate(int pixelsused, ClassifiedSection* fine)
+{
+    int remaining = m_budget - pixelsused;
+
+    std::priority_queue<std::pair<float, int> > queue;
+    for (int i = 0; i < (int)m_regions.size(); i++)
+    {
+        if (m_regions[i].Interest >= MinInterest and regionHeight(i % m_columns, i/m_columns) > 0)
+            queue.push(std::make_pair(m_regions[i].Interest, i));
+    }
+
+    while (not queue.empty() and remaining > 0)
+    {
+        int i = queue.top().second;
+        queue.pop();
+        Region& region = m_regions[i];
+        int level = region.Level + 1;
+        int cost = linesAddedAtLevel(level)*regionHeight(i % m_columns, i/m_columns);
+        if (cost > remaining)
+            continue;
+        region.Level = level;
+        region.Pixels += cost;
+        remaining -= cost;
+        if (level < MaxLevel)
+            queue.push(std::make_pair(region.Interest/(1 << level), i));
+    }
+
+    //! Make the scan lines, joining the regions above and below each other with the same or higher level
+    const int numlines = (1 << MaxLevel) - 1;
+    for (int c = 0; c < m_columns; c++)
+    {
+        if (m_border[c] < 0)
+            continue;
+        for (int line = 0; line < numlines; line++)
+        {
+            int x = c*m_spacing + offsetOfLine(line);
+            if (x < 0 or x >= m_width)
+                continue;
+            int level = levelOfLine(line);
+            int border = borderAt(x);
+            int r = 0;
+            while (r < m_rows)
+            {
+                if (m_regions[r*m_columns + c].Level < level)
+                {
+                    r++;
+                    continue;
+                }
+                int start = r;
+                while (r < m_rows and m_regions[r*m_columns + c].Level >= level)
+                    r++;
+                int top = std::max(regionTop(start), border);
+                int bottom = std::min(regionTop(r), m_height);
+                if (bottom > top)
+                {
+                    ScanLine scanline(Vector2<int>(x, top), bottom - top);
+                    fine->addScanLine(scanline);
+                }
+            }
+        }
+    }
+}
+
+/*! @brief Counts the segments found by the classified fine scan lines in each region, and adds the frame to the statistics
+    @param fine the classified fine scan lines
+ */
+void ScanInterestMap::count(ClassifiedSection* fine)
+{
+    for (int i = 0; i < fine->getNumberOfScanLines(); i++)
+    {
+        ScanLine* line = fine->getScanLine(i);
+        int column = line->getStart().x/m_spacing;
+        if (column < 0 or column >= m_columns)
+            continue;
+        for (int j = 0; j < line->getNumberOfSegments(); j++)
+        {
+            TransitionSegment* segment = line->getSegment(j);
+            int row = (segment->getStartPoint().y + segment->getEndPoint().y)/(2*m_spacing);
+            if (row >= 0 and row < m_rows)
+                m_regions[row*m_columns + column].Segments++;
+        }
+    }
+
+    m_num_frames++;
+    for (size_t i = 0; i < m_regions.size(); i++)
+    {
+        m_total_pixels += m_regions[i].Pixels;
+        m_sum_interest[i] += m_regions[i].Interest;
+        m_sum_level[i] += m_regions[i].Level;
+        m_sum_segments[i] += m_regions[i].Segments;
+    }
+}
+
+/*! @brief Returns the number of columns of regions */
+int ScanInterestMap::getNumColumns() const
+{
+    return m_columns;
+}
+
+/*! @brief Returns the number of rows of regions */
+int ScanInterestMap::getNumRows() const
+{
+    return m_rows;
+}
+
+/*! @brief Returns a region in the current frame */
+const ScanInterestMap::Region& ScanInterestMap::getRegion(int column, int row) const
+{
+    return m_regions[row*m_columns + column];
+}
+
+/*! @brief Returns the number of frames the statistics are over */
+int ScanInterestMap::getNumFrames() const
+{
+    return m_num_frames;
+}
+
+/*! @brief Clears the statistics */
+void ScanInterestMap::resetStatistics()
+{
+    m_num_frames = 0;
+    m_total_pixels = 0;
+    m_sum_interest.assign(m_regions.size(), 0);
+    m_sum_level.assign(m_regions.size(), 0);
+    m_sum_segments.assign(m_regions.size(), 0);
+}
+
+/*! @brief Returns the y of the top of a row of regions */
+int ScanInterestMap::regionTop(int row) const
+{
+    return row*m_spacing;
+}
+
+/*! @brief Returns the height of the part of a region below the field border */
+int ScanInterestMap::regionHeight(int column, int row) const
+{
+    if (m_border[column] < 0)
+        return 0;
+    int top = std::max(regionTop(row), borderAt(column*m_spacing + m_spacing/2));
+    int bottom = std::min(regionTop(row + 1), m_height);
+    return std::max(0, bottom - top);
+}
+
+/*! @brief Returns the y of the field border at x, interpolated between the field border points either side */
+int ScanInterestMap::borderAt(int x) const
+{
+    int column = x/m_spacing;
+    if (column < 0 or column >= m_columns)
+        return m_height;
+    int left = m_border[column];
+    if (column + 1 < m_columns and m_border[column + 1] >= 0)
+    {
+        int right = m_border[column + 1];
+        return left + (right - left)*(x - column*m_spacing)/m_spacing;
+    }
+    return left;
+}
+
+/*! @brief Returns the number of scan lines added to a region when it goes up to level */
+int ScanInterestMap::linesAddedAtLevel(int level)
+{
+    return 1 << (level - 1);
+}
+
+/*! @brief Returns the level at which a fine scan line in a region is used. The lines are numbered middle, quarters, then eighths. */
+int ScanInterestMap::levelOfLine(int line)
+{
+    if (line < 1)
+        return 1;
+    else if (line < 3)
+        return 2;
+    else
+        return 3;
+}
+
+/*! @brief Returns the x of a fine scan line from the left of its region; the same pattern as Vision::verticalScan */
+int ScanInterestMap::offsetOfLine(int line) const
+{
+    int skip = m_spacing/2;
+    switch (line)
+    {
+        case 0: return skip;
+        case 1: return skip - skip/2;
+        case 2: return skip + skip/2;
+        case 3: return skip - 3*skip/4;
+        case 4: return skip - skip/4;
+        case 5: return skip + skip/4;
+        default: return skip + 3*skip/4;
+    }
+}
+
+/*! @brief Writes the mean interest, level and number of segments found of each region over the frames in the statistics */
+std::ostream& operator<< (std::ostream& output, const ScanInterestMap& map)
+{
+    int frames = std::max(map.m_num_frames, 1);
+    output << "ScanInterestMap over " << map.m_num_frames << " frames. Budget: " << map.m_budget;
+    output << " Mean pixels on fine scan lines: " << map.m_total_pixels/frames << std::endl;
+
+    std::ios_base::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << std::fixed << std::setprecision(1);
+    const char* names[3] = {"Interest", "Level", "Segments"};
+    for (int table = 0; table < 3; table++)
+    {
+        output << names[table] << ":" << std::endl;
+        for (int r = 0; r < map.m_rows; r++)
+        {
+            for (int c = 0; c < map.m_columns; c++)
+            {
+                int i = r*map.m_columns + c;
+                float value;
+                if (table == 0)
+                    value = map.m_sum_interest[i]/frames;
+                else if (table == 1)
+                    value = (float)map.m_sum_level[i]/frames;
+                else
+                    value = (float)map.m_sum_segments[i]/frames;
+                output << std::setw(6) << value;
+            }
+            output << std::endl;
+        }
+    }
+    output.flags(flags);
+    output.precision(precision);
+    return output;
+}
@@ -0,0 +1,125 @@
+/*!
+  @file ScanInterestMap.h
+  @brief Declaration of the ScanInterestMap class.
+
+  @class ScanInterestMap
+  @brief Decides where the fine vertical scan lines go, from a coarse scan of the image below the field border.
+
+  The image is divided into regions one scan spacing wide and one scan spacing high. The columns of regions lie
+  between the coarse scan lines, which are one per field border point. After the coarse scan lines have been
+  classified, each region below the field border is given an interest from
+    - the number of colour transitions found by the coarse scan lines either side of it,
+    - its closeness to the horizon, where the objects are far away and small, and
+    - its closeness to where the ball was last seen.
+
+  The fine scan lines are then shared out in order of interest, until the pixel budget for the frame is spent.
+  Each region has a level; at level 1 there is one fine scan line through the middle of the region, at level 2
+  there are three, and at level 3 there are seven, which is the same pattern as the fixed vertical scan.
+  The fine scan lines through vertically adjacent regions at the same level are joined into one scan line.
+
+  The per region statistics are kept over a number of frames, and can be written to a stream to tune the
+  weights and the budget from the logs.
+
+  @author agent
+
+  Copyright (c) 2026 agent
+
+  This file is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This file is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCANINTERESTMAP_H
+#define SCANINTERESTMAP_H
+
+#include "ClassifiedSection.h"
+#include "Tools/Math/Vector2.h"
+
+#include <vector>
+#include <iostream>
+
+class Horizon;
+
+class ScanInterestMap
+{
+public:
+    //! The interest and scanning of a single region
+    struct Region
+    {
+        int Transitions;        //!< The number of colour transitions found by the coarse scan lines either side of the region
+        float Interest;         //!< The interest in the region
+        int Level;              //!< The number of times the fine scan lines through the region were subdivided (0 to MaxLevel)
+        int Pixels;             //!< The number of pixels on the fine scan lines through the region
+        int Segments;           //!< The number of segments found by the fine scan lines through the region
+    };
+
+    static const int MaxLevel = 3;                  //!< The finest subdivision of a region; 7 scan lines
+    static const int DefaultPixelBudget = 6000;     //!< The default maximum number of pixels classified each frame
+    static const int StatisticsPeriod = 300;        //!< The number of frames over which the statistics are usually kept
+
+    ScanInterestMap();
+    ~ScanInterestMap();
+
+    void setPixelBudget(int pixels);
+    int getPixelBudget() const;
+
+    void setBall(const Vector2<int>& position, int radius);
+    void clearBall();
+
+    void build(ClassifiedSection* coarse, const std::vector<Vector2<int> >& fieldBorders, const Horizon* horizonLine,
+               int width, int height, int spacing);
+    void allocate(int pixelsused, ClassifiedSection* fine);
+    void count(ClassifiedSection* fine);
+
+    int getNumColumns() const;
+    int getNumRows() const;
+    const Region& getRegion(int column, int row) const;
+
+    int getNumFrames() const;
+    void resetStatistics();
+
+    friend std::ostream& operator<< (std::ostream& output, const ScanInterestMap& map);
+private:
+    int regionTop(int row) const;
+    int regionHeight(int column, int row) const;
+    int borderAt(int x) const;
+    static int linesAddedAtLevel(int level);
+    static int levelOfLine(int line);
+    int offsetOfLine(int line) const;
+
+    static const float TransitionWeight;            //!< The interest for each transition
+    static const float HorizonWeight;               //!< The interest of a region on the horizon
+    static const float BallWeight;                  //!< The interest of a region near where the ball was last seen
+    static const float MinInterest;                 //!< The interest below which a region gets no fine scan lines
+
+    int m_budget;                       //!< The maximum number of pixels classified each frame
+    int m_width;                        //!< The width of the image
+    int m_height;                       //!< The height of the image
+    int m_spacing;                      //!< The size of each region, and the distance between the coarse scan lines
+    int m_columns;                      //!< The number of columns of regions
+    int m_rows;                         //!< The number of rows of regions
+    std::vector<int> m_border;          //!< The y of the field border on the left of each column, or -1 where there is no coarse scan line
+    std::vector<Region> m_regions;      //!< The regions, a row at a time
+
+    bool m_ball_known;                  //!< True if the ball has been seen recently
+    Vector2<int> m_ball_position;       //!< The position in the image the ball was last seen
+    int m_ball_radius;                  //!< The radius about m_ball_position the ball is expected to be in
+
+    // The statistics over a number of frames
+    int m_num_frames;                   //!< The number of frames the statistics are over
+    int m_total_pixels;                 //!< The number of pixels allocated to fine scan lines
+    std::vector<float> m_sum_interest;  //!< The sum of the interest in each region
+    std::vector<int> m_sum_level;       //!< The sum of the level of each region
+    std::vector<int> m_sum_segments;    //!< The sum of the segments found in each region
+};
+
+#endif
@@ -20,22 +20,47 @@
  */
 
 #include "SaveImagesThread.h"
-#include "Vision/Vision.h"
 
 #include "debug.h"
 #include "debugverbosityvision.h"
+#include "nubotdataconfig.h"
 
-#include <errno.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <limits>
 
-/*! @brief Constructs the network thread
+/*! @brief Constructs the save images thread
+    @param numframes the number of frames in the ring. Each frame holds a copy of an image and the sensor data.
+    @param pretrigger the time before a trigger from which the frames are saved (ms)
+    @param posttrigger the time after a trigger until which the frames are saved (ms)
+    @param maxrate the maximum number of frames written per second, 0 for no limit
  */
-
-SaveImagesThread::SaveImagesThread(Vision* vision) : ConditionalThread(string("SaveImagesThread"), 0)
+SaveImagesThread::SaveImagesThread(unsigned int numframes, double pretrigger, double posttrigger, double maxrate) :
+    Thread(string("SaveImagesThread"), 0),
+    m_pretrigger(pretrigger),
+    m_posttrigger(posttrigger),
+    m_min_period(maxrate > 0 ? 1000/maxrate : 0)
 {
     #if DEBUG_VISION_VERBOSITY > 0
-        debug << "SaveImagesThread::SaveImagesThread(" << vision << ") with priority " << static_cast<int>(m_priority) << endl;
+        debug << "SaveImagesThread::SaveImagesThread(" << numframes << ", " << pretrigger << ", " << posttrigger << ", " << maxrate << ") with priority " << static_cast<int>(m_priority) << endl;
     #endif
-    m_vision = vision;
+    for (unsigned int i = 0; i < numframes; i++)
+    {
+        Frame* frame = new Frame();
+        frame->State = Frame::Free;
+        frame->Sequence = 0;
+        frame->Time = 0;
+        m_frames.push_back(frame);
+    }
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_condition, NULL);
+    m_mode = Off;
+    m_sequence = 0;
+    m_latest_time = 0;
+    m_trigger_until = -std::numeric_limits<double>::max();
+    m_num_saved = 0;
+    m_num_dropped = 0;
+    m_last_write = 0;
     start();
 }
 
@@ -44,25 +69,249 @@ SaveImagesThread::~SaveImagesThread()
     #if DEBUG_VISION_VERBOSITY > 0
         debug << "SaveImagesThread::~SaveImagesThread()" << endl;
     #endif
+    stop();
+    join();
+    for (size_t i = 0; i < m_frames.size(); i++)
+        delete m_frames[i];
+    m_image_file.close();
+    m_sensor_file.close();
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
 }
 
-/*! @brief The save images main loop
- 
+/*! @brief Sets the capture mode.
+
+    Turning capture off discards the frames kept for a trigger, but the frames already waiting to be written
+    are still saved. Changing the mode also ends the post-trigger period of the last trigger.
+ */
+void SaveImagesThread::setMode(CaptureMode mode)
+{
+    pthread_mutex_lock(&m_mutex);
+    if (mode != m_mode)
+    {
+        #if DEBUG_VISION_VERBOSITY > 0
+            debug << "SaveImagesThread::setMode(" << mode << ")" << endl;
+        #endif
+        m_mode = mode;
+        m_trigger_until = -std::numeric_limits<double>::max();
+        for (size_t i = 0; i < m_frames.size(); i++)
+        {
+            if (m_frames[i]->State == Frame::Buffered)
+                m_frames[i]->State = Frame::Free;
+        }
+    }
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Returns the current capture mode */
+SaveImagesThread::CaptureMode SaveImagesThread::getMode()
+{
+    pthread_mutex_lock(&m_mutex);
+    CaptureMode mode = m_mode;
+    pthread_mutex_unlock(&m_mutex);
+    return mode;
+}
+
+/*! @brief Returns a frame for the caller to capture into, or NULL if capture is off, or every frame is waiting to be written.
+
+    A free frame is used if there is one, otherwise the oldest frame kept for a trigger is overwritten.
+    The frame belongs to the caller until it is passed to commitFrame().
+ */
+SaveImagesThread::Frame* SaveImagesThread::acquireFrame()
+{
+    Frame* frame = NULL;
+    pthread_mutex_lock(&m_mutex);
+    if (m_mode != Off)
+    {
+        Frame* oldest = NULL;
+        for (size_t i = 0; i < m_frames.size() and frame == NULL; i++)
+        {
+            if (m_frames[i]->State == Frame::Free)
+                frame = m_frames[i];
+            else if (m_frames[i]->State == Frame::Buffered and (oldest == NULL or m_frames[i]->Sequence < oldest->Sequence))
+                oldest = m_frames[i];
+        }
+        if (frame == NULL)
+            frame = oldest;
+
+        if (frame != NULL)
+            frame->State = Frame::Filling;
+        else
+            m_num_dropped++;
+    }
+    pthread_mutex_unlock(&m_mutex);
+    return frame;
+}
+
+/*! @brief Hands a frame filled by the caller back to the ring.
+
+    In Continuous mode, and in the post-trigger period, the frame is queued to be written. Otherwise the frame
+    is kept until it is overwritten, in case there is a trigger.
+ */
+void SaveImagesThread::commitFrame(Frame* frame)
+{
+    if (frame == NULL)
+        return;
+    pthread_mutex_lock(&m_mutex);
+    frame->Sequence = ++m_sequence;
+    frame->Time = frame->Image.m_timestamp;
+    m_latest_time = frame->Time;
+    if (m_mode == Continuous or (m_mode == PreTrigger and frame->Time <= m_trigger_until))
+    {
+        frame->State = Frame::Pending;
+        pthread_cond_signal(&m_condition);
+    }
+    else if (m_mode == PreTrigger)
+        frame->State = Frame::Buffered;
+    else
+        frame->State = Frame::Free;
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Saves the frames captured in the pre-trigger period before the last committed frame, and those committed in the post-trigger period after it.
+
+    Only has an effect in PreTrigger mode.
+ */
+void SaveImagesThread::trigger()
+{
+    pthread_mutex_lock(&m_mutex);
+    if (m_mode == PreTrigger)
+    {
+        #if DEBUG_VISION_VERBOSITY > 0
+            debug << "SaveImagesThread::trigger() at " << m_latest_time << endl;
+        #endif
+        bool queued = false;
+        for (size_t i = 0; i < m_frames.size(); i++)
+        {
+            Frame* frame = m_frames[i];
+            if (frame->State == Frame::Buffered and frame->Time >= m_latest_time - m_pretrigger)
+            {
+                frame->State = Frame::Pending;
+                queued = true;
+            }
+        }
+        m_trigger_until = m_latest_time + m_posttrigger;
+        if (queued)
+            pthread_cond_signal(&m_condition);
+    }
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Returns the number of frames written to the files */
+unsigned long SaveImagesThread::getNumSaved()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_saved;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief Returns the number of frames that were not captured because every frame was waiting to be written, or not written because MaxSavedImages had been reached */
+unsigned long SaveImagesThread::getNumDropped()
+{
+    pthread_mutex_lock(&m_mutex);
+    unsigned long value = m_num_dropped;
+    pthread_mutex_unlock(&m_mutex);
+    return value;
+}
+
+/*! @brief The save images main loop. Waits for a frame to be queued, writes it, and then frees it.
  */
 void SaveImagesThread::run()
 {
     #if DEBUG_VISION_VERBOSITY > 0
         debug << "SaveImagesThread::run()" << endl;
     #endif
-    
-    int err = 0;
-    while (err == 0 && errno != EINTR)
+
+    // The thread is only cancelled while it is waiting, never part way through writing a frame.
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    while (true)
+    {
+        Frame* frame = NULL;
+        pthread_mutex_lock(&m_mutex);
+        pthread_cleanup_push(unlockMutex, &m_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+        while ((frame = nextPending()) == NULL)
+            pthread_cond_wait(&m_condition, &m_mutex);
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+        frame->State = Frame::Writing;
+        pthread_cleanup_pop(0);
+        pthread_mutex_unlock(&m_mutex);
+
+        waitForRate();
+        save(frame);
+
+        pthread_mutex_lock(&m_mutex);
+        frame->State = Frame::Free;
+        pthread_mutex_unlock(&m_mutex);
+    }
+}
+
+/*! @brief Returns the oldest frame waiting to be written, or NULL if there is none. m_mutex must be held. */
+SaveImagesThread::Frame* SaveImagesThread::nextPending()
+{
+    Frame* oldest = NULL;
+    for (size_t i = 0; i < m_frames.size(); i++)
     {
-        wait();
-        // -----------------------------------------------------------------------------------------------------------------------------------------------------------------
-        m_vision->SaveAnImage();
-        // -----------------------------------------------------------------------------------------------------------------------------------------------------------------
-        
-    } 
-    errorlog << "SaveImagesThread is exiting. err: " << err << " errno: " << errno << endl;
+        if (m_frames[i]->State == Frame::Pending and (oldest == NULL or m_frames[i]->Sequence < oldest->Sequence))
+            oldest = m_frames[i];
+    }
+    return oldest;
+}
+
+/*! @brief Writes the frame's sensor data and image to the files, opening them if necessary */
+void SaveImagesThread::save(Frame* frame)
+{
+    if (not m_image_file.is_open())
+        m_image_file.open((string(DATA_DIR) + string("image.strm")).c_str());
+    if (not m_sensor_file.is_open())
+        m_sensor_file.open((string(DATA_DIR) + string("sensor.strm")).c_str());
+
+    pthread_mutex_lock(&m_mutex);
+    bool full = m_num_saved >= MaxSavedImages;
+    if (full)
+        m_num_dropped++;
+    pthread_mutex_unlock(&m_mutex);
+
+    if (m_image_file.is_open() and not full)
+    {
+        if (m_sensor_file.is_open())
+            m_sensor_file << frame->Sensors << flush;
+        m_image_file << frame->Image << flush;
+        m_last_write = getTime();
+
+        pthread_mutex_lock(&m_mutex);
+        m_num_saved++;
+        pthread_mutex_unlock(&m_mutex);
+        #if DEBUG_VISION_VERBOSITY > 1
+            debug << "SaveImagesThread::save(). Saved the frame at " << frame->Time << endl;
+        #endif
+    }
+}
+
+/*! @brief Sleeps until the minimum period since the last frame was written has passed. The thread can be cancelled while it sleeps. */
+void SaveImagesThread::waitForRate()
+{
+    double remaining = m_last_write + m_min_period - getTime();
+    if (remaining > 0)
+    {
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+        usleep(static_cast<useconds_t>(1000*remaining));
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    }
+}
+
+/*! @brief Returns the current time (ms) */
+double SaveImagesThread::getTime()
+{
+    timeval now;
+    gettimeofday(&now, 0);
+    return 1e3*now.tv_sec + 1e-3*now.tv_usec;
+}
+
+/*! @brief Unlocks the mutex. Used as a cancellation cleanup handler.
+ */
+void SaveImagesThread::unlockMutex(void* mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
 }
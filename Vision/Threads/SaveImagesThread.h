@@ -1,9 +1,23 @@
 /*! @file SaveImagesThread.h
-    @brief Declaration of a simple low priority thread for saving images.
+    @brief Declaration of a low priority thread for saving images.
 
     @class SaveImagesThread
-    @brief A simple thread to save images when requested
- 
+    @brief A thread to save images, and their sensor data, to image.strm and sensor.strm.
+
+    The images are captured into a fixed ring of frames. The vision thread gets a frame with acquireFrame(),
+    copies the image and sensor data into it, and hands it back with commitFrame(). The frames' memory is
+    reused, so once every frame has been filled there are no further allocations, and committing a frame
+    only passes a pointer to this thread.
+
+    There are two capture modes:
+        - Continuous, where every committed frame is saved, as long as there is a free frame to capture into.
+        - PreTrigger, where the ring holds the last frames captured, and they are only saved when trigger() is
+          called, for example by a fall or a goal. The frames captured in the pre-trigger period before the
+          trigger, and those committed in the post-trigger period after it, are saved.
+
+    The frames are written in the order they were captured, at no more than the maximum rate, so that a
+    burst of frames does not take the disk away from the rest of the system.
+
     @author Jason Kulk
  
   Copyright (c) 2010 Jason Kulk
@@ -25,22 +39,87 @@
 #ifndef SAVEIMAGES_THREAD_H
 #define SAVEIMAGES_THREAD_H
 
-#include "Tools/Threading/ConditionalThread.h"
+#include "Tools/Threading/Thread.h"
+#include "Infrastructure/NUImage/NUImage.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
 
-class Vision;
+#include <pthread.h>
+#include <fstream>
+#include <vector>
 
-/*! @brief The top-level class
- */
-class SaveImagesThread : public ConditionalThread
+class SaveImagesThread : public Thread
 {
 public:
-    SaveImagesThread(Vision* vision);
+    enum CaptureMode
+    {
+        Off,                        //!< Nothing is captured
+        Continuous,                 //!< Every frame captured is saved
+        PreTrigger                  //!< The frames captured around each trigger() are saved
+    };
+
+    /*! @brief A slot in the ring. The vision thread fills Image and Sensors between acquireFrame() and commitFrame(). */
+    class Frame
+    {
+    public:
+        NUImage Image;              //!< The captured image
+        NUSensorsData Sensors;      //!< The sensor data at the time the image was captured
+    private:
+        friend class SaveImagesThread;
+        enum FrameState
+        {
+            Free,                   //!< Holds nothing
+            Filling,                //!< Acquired by the vision thread
+            Buffered,               //!< Captured, and kept in case there is a trigger
+            Pending,                //!< Captured, and waiting to be written
+            Writing                 //!< Being written
+        };
+        FrameState State;
+        unsigned long Sequence;     //!< The order in which the frames were committed
+        double Time;                //!< The image's timestamp (ms)
+    };
+
+    static const unsigned int MaxSavedImages = 2500;    //!< The maximum number of images saved to the files
+
+    SaveImagesThread(unsigned int numframes = 64, double pretrigger = 2000, double posttrigger = 1000, double maxrate = 15);
     ~SaveImagesThread();
+
+    void setMode(CaptureMode mode);
+    CaptureMode getMode();
+
+    Frame* acquireFrame();
+    void commitFrame(Frame* frame);
+    void trigger();
+
+    unsigned long getNumSaved();
+    unsigned long getNumDropped();
 protected:
     void run();
-    
+
 private:
-    Vision* m_vision;
+    Frame* nextPending();
+    void save(Frame* frame);
+    void waitForRate();
+    static double getTime();
+    static void unlockMutex(void* mutex);
+
+private:
+    std::vector<Frame*> m_frames;               //!< The ring of frames
+    const double m_pretrigger;                  //!< The time before a trigger from which frames are saved (ms)
+    const double m_posttrigger;                 //!< The time after a trigger until which frames are saved (ms)
+    const double m_min_period;                  //!< The minimum time between writing each frame (ms)
+
+    pthread_mutex_t m_mutex;                    //!< Lock for the frames' state, the mode and the counters
+    pthread_cond_t m_condition;                 //!< Signalled when a frame becomes Pending
+    CaptureMode m_mode;                         //!< The current capture mode
+    unsigned long m_sequence;                   //!< The sequence number of the last frame committed
+    double m_latest_time;                       //!< The timestamp of the last frame committed (ms)
+    double m_trigger_until;                     //!< The time until which committed frames are saved (ms)
+    unsigned long m_num_saved;                  //!< The number of frames written
+    unsigned long m_num_dropped;                //!< The number of frames that could not be captured or written
+
+    double m_last_write;                        //!< The time the last frame was written (ms)
+    std::ofstream m_image_file;                 //!< The file the images are saved to
+    std::ofstream m_sensor_file;                //!< The file the sensor data is saved to
 };
 
 #endif
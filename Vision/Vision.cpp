@@ -14,6 +14,7 @@
 #include <boost/circular_buffer.hpp>
 #include <queue>
 #include <algorithm>
+#include <functional>
 #include "debug.h"
 #include "debugverbosityvision.h"
 #include "nubotdataconfig.h"
@@ -21,6 +22,7 @@
 #include "Kinematics/Kinematics.h"
 #include "NUPlatform/NUPlatform.h"
 #include "Infrastructure/NUBlackboard.h"
+#include "Infrastructure/GameInformation/GameInformation.h"
 #include "Infrastructure/Jobs/JobList.h"
 #include "Infrastructure/Jobs/CameraJobs/ChangeCameraSettingsJob.h"
 #include "Infrastructure/Jobs/VisionJobs/SaveImagesJob.h"
@@ -38,16 +40,23 @@ using namespace mathGeneral;
 Vision::Vision()
 {
     classifiedCounter = 0;
+    currentImage = NULL;
+    m_sensor_data = NULL;
+    m_actions = NULL;
     LUTBuffer = new unsigned char[LUTTools::LUT_SIZE];
     currentLookupTable = LUTBuffer;
     loadLUTFromFile(string(DATA_DIR) + string("default.lut"));
-    m_saveimages_thread = new SaveImagesThread(this);
+    m_saveimages_thread = new SaveImagesThread();
     isSavingImages = false;
     isSavingImagesWithVaryingSettings = false;
     numSavedImages = 0;
+    wasFalling = false;
+    previousTotalScore = 0;
     ImageFrameNumber = 0;
     numFramesDropped = 0;
     numFramesProcessed = 0;
+    m_scan_method = UNIFORM;
+    m_edge_detection.setKernel(EdgeDetection::Scharr);
 
     return;
 }
@@ -56,8 +65,7 @@ Vision::~Vision()
 {
     // delete AllFieldObjects;
     delete [] LUTBuffer;
-    imagefile.close();
-    sensorfile.close();
+    delete m_saveimages_thread;
     return;
 }
 
@@ -66,7 +74,7 @@ void Vision::process(JobList* jobs)
     #if DEBUG_VISION_VERBOSITY > 4
         debug  << "Vision::Process - Begin" << endl;
     #endif
-    static list<Job*>::iterator it;     // the iterator over the motion jobs
+    static IntrusiveJobList::iterator it;     // the iterator over the motion jobs
     
     for (it = jobs->vision_begin(); it != jobs->vision_end();)
     {
@@ -77,34 +85,34 @@ void Vision::process(JobList* jobs)
             #endif
             static SaveImagesJob* job;
             job = (SaveImagesJob*) (*it);
+            SaveImagesThread::CaptureMode mode = SaveImagesThread::Off;
+            if (job->saving())
+                mode = job->preTrigger() ? SaveImagesThread::PreTrigger : SaveImagesThread::Continuous;
             if(isSavingImages != job->saving())
             {
                 if(job->saving() == true)
                 {
                     currentSettings = currentImage->getCameraSettings();
-                    if (!imagefile.is_open())
-                        imagefile.open((string(DATA_DIR) + string("image.strm")).c_str());
-                    if (!sensorfile.is_open())
-                        sensorfile.open((string(DATA_DIR) + string("sensor.strm")).c_str());
                     m_actions->add(NUActionatorsData::Sound, m_sensor_data->CurrentTime, NUSounds::START_SAVING_IMAGES);
                 }
                 else
                 {
-                    imagefile.flush();
-                    sensorfile.flush();
-
                     ChangeCameraSettingsJob* newJob  = new ChangeCameraSettingsJob(currentSettings);
                     jobs->addCameraJob(newJob);
                     m_actions->add(NUActionatorsData::Sound, m_sensor_data->CurrentTime, NUSounds::STOP_SAVING_IMAGES);
                 }
             }
+            m_saveimages_thread->setMode(mode);
             isSavingImages = job->saving();
             isSavingImagesWithVaryingSettings = job->varyCameraSettings();
             it = jobs->removeVisionJob(it);
         }
         else 
-        {
-            ++it;
+        {   // nothing else consumes vision jobs, so unhandled jobs are recycled rather than left in the list
+            #if DEBUG_VISION_VERBOSITY > 0
+                debug << "Vision::process(): Discarding an unhandled job: " << (*it)->getID() << endl;
+            #endif
+            it = jobs->removeVisionJob(it);
         }
     }
 }
@@ -149,8 +157,9 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
         #if DEBUG_VISION_VERBOSITY > 1
             debug << "Vision::starting the save images loop." << endl;
         #endif
-        m_saveimages_thread->signal();
+        SaveAnImage();
     }
+    checkSaveImagesTriggers();
     #if DEBUG_VISION_VERBOSITY > 5
         debug << "Generating Horizon Line: " <<endl;
     #endif
@@ -210,26 +219,32 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
     #endif
 
 
-    //! Scan Below Horizon Image:
-    ClassifiedSection vertScanArea = verticalScan(points,spacings);
-
-    #if DEBUG_VISION_VERBOSITY > 5
-        debug << "\tVert ScanPaths : Finnished " << vertScanArea.getNumberOfScanLines() <<endl;
-    #endif
-
-
     //! Scan Above the Horizon
     ClassifiedSection horiScanArea = horizontalScan(points,spacings);
 
     #if DEBUG_VISION_VERBOSITY > 5
         debug << "\tHorizontal ScanPaths : Finnished " << horiScanArea.getNumberOfScanLines() <<endl;
     #endif
-    
 
-    //! Classify Scan Lines to find Segments
-    ClassifyScanArea(&vertScanArea);
+    //! Classify the horizontal scan lines first, so that the coarse to fine scan gets what is left of the pixel budget
     ClassifyScanArea(&horiScanArea);
 
+    //! Scan Below Horizon Image:
+    ClassifiedSection vertScanArea;
+    if(m_scan_method == COARSE_TO_FINE)
+    {
+        vertScanArea = verticalScanCoarseToFine(points,spacings,&m_horizonLine);
+    }
+    else
+    {
+        vertScanArea = verticalScan(points,spacings);
+        ClassifyScanArea(&vertScanArea);
+    }
+
+    #if DEBUG_VISION_VERBOSITY > 5
+        debug << "\tVert ScanPaths : Finnished " << vertScanArea.getNumberOfScanLines() <<endl;
+    #endif
+
     #if DEBUG_VISION_VERBOSITY > 5
         debug << "\tClassify ScanPaths : Finnished" <<endl;
     #endif
@@ -342,8 +357,17 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
     std::vector< ObjectCandidate > BlueGoalAboveHorizonCandidates;
     std::vector< ObjectCandidate > YellowGoalAboveHorizonCandidates;
 
+    //! While goal posts are tracked they are only checked in windows about where they should be, with a full search every so often
+    bool goalSearch = m_goal_tracker.isSearchDue();
+    if(not goalSearch and not predictGoalPostWindows())
+    {
+        //! There is no camera transform to predict the windows with: fall back to the full search
+        m_goal_tracker.lose();
+        goalSearch = true;
+    }
+
     mode = ROBOTS;
-    method = Vision::PRIMS;
+    method = Vision::DBSCAN;
    for (int i = 0; i < 4; i++)
     {
 
@@ -369,16 +393,13 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
 
                 break;
             case BALL:
-                validColours.clear();
-                validColours.push_back(ClassIndex::orange);
-                validColours.push_back(ClassIndex::pink_orange);
-                validColours.push_back(ClassIndex::yellow_orange);
-
                 #if DEBUG_VISION_VERBOSITY > 5
                     debug << "\tPRE-BALL" << endl;
                 #endif
 
-                BallCandidates = classifyCandidates(BallSegments, points, validColours, spacings, 0, 3.0, 1, method);
+                //! While the ball is tracked it is only searched for in the window about where it should be
+                if(not m_ball_tracker.isTracking())
+                    BallCandidates = classifyBallCandidates(BallSegments, points, spacings, method);
 
                 #if DEBUG_VISION_VERBOSITY > 5
                     debug << "\tPOST-BALL" << endl;
@@ -386,6 +407,8 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
 
                 break;
             case YELLOW_GOALS:
+                if(not goalSearch)
+                    break;
                 validColours.clear();
                 validColours.push_back(ClassIndex::yellow);
                 //validColours.push_back(ClassIndex::yellow_orange);
@@ -402,6 +425,8 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
 
                 break;
             case BLUE_GOALS:
+                if(not goalSearch)
+                    break;
                 validColours.clear();
                 validColours.push_back(ClassIndex::blue);
                 //validColours.push_back(ClassIndex::shadow_blue);
@@ -447,10 +472,21 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
             debug << "\tPre-GOALPost Recognition: " <<endl;
         #endif
 
+        if(not goalSearch)
+        {
+            YellowGoalAboveHorizonCandidates = classifyGoalPostWindows(ClassIndex::yellow);
+            BlueGoalAboveHorizonCandidates = classifyGoalPostWindows(ClassIndex::blue);
+            #if DEBUG_VISION_VERBOSITY > 5
+                debug << "\tGoal Post Windows: " << m_goal_tracker.getPosts().size() << " Candidates: "
+                      << YellowGoalAboveHorizonCandidates.size() + BlueGoalAboveHorizonCandidates.size() << endl;
+            #endif
+        }
+
         DetectGoals(YellowGoalCandidates, YellowGoalAboveHorizonCandidates, horizontalsegments);
         DetectGoals(BlueGoalCandidates, BlueGoalAboveHorizonCandidates, horizontalsegments);
 
         PostProcessGoals();
+        updateGoalPostTracker(goalSearch);
 
         #if DEBUG_VISION_VERBOSITY > 5
             debug << "\tPost-GOALPost Recognition: " <<endl;
@@ -479,10 +515,33 @@ void Vision::ProcessFrame(NUImage* image, NUSensorsData* data, NUActionatorsData
             debug << "\tPre-Ball Recognition: " <<endl;
         #endif
 
+        if(m_ball_tracker.isTracking())
+        {
+            Vector2<int> windowTopLeft, windowBottomRight;
+            if(predictBallWindow(windowTopLeft, windowBottomRight))
+            {
+                BallCandidates = classifyBallWindow(windowTopLeft, windowBottomRight, points, method);
+                #if DEBUG_VISION_VERBOSITY > 5
+                    debug << "\tBall Window: " << windowTopLeft.x << "," << windowTopLeft.y << " to " << windowBottomRight.x << "," << windowBottomRight.y
+                          << " Candidates: " << BallCandidates.size() << endl;
+                #endif
+            }
+            else
+            {
+                //! The window is off the screen, or there is no camera transform: fall back to the full scan
+                m_ball_tracker.lose();
+                BallCandidates = classifyBallCandidates(BallSegments, points, spacings, method);
+            }
+        }
+
         if(BallCandidates.size() > 0)
         {
             circ = DetectBall(BallCandidates);
         }
+        if(not circ.isDefined)
+        {
+            m_ball_tracker.miss();
+        }
 
         #if DEBUG_VISION_VERBOSITY > 5
             debug << "\tPost-Ball Recognition: " <<endl;
@@ -595,77 +654,94 @@ void Vision::SaveAnImage()
         debug << "Vision::SaveAnImage(). Starting..." << endl;
     #endif
 
-    if (!imagefile.is_open())
-        imagefile.open((string(DATA_DIR) + string("image.strm")).c_str());
-    if (!sensorfile.is_open())
-        sensorfile.open((string(DATA_DIR) + string("sensor.strm")).c_str());
-
-    if (imagefile.is_open() and numSavedImages < 2500)
+    // The image and sensor data are copied into one of the save images thread's preallocated frames,
+    // and the frame is passed to the thread to be written.
+    SaveImagesThread::Frame* frame = m_saveimages_thread->acquireFrame();
+    if (frame != NULL)
     {
-        if(sensorfile.is_open())
-        {
-            sensorfile << (*m_sensor_data) << flush;
-        }
-        NUImage buffer;
-        buffer.cloneExisting(*currentImage);
-        imagefile << buffer;
+        frame->Image.copyFromExisting(*currentImage);
+        frame->Image.setCameraSettings(currentImage->getCameraSettings());
+        frame->Sensors = *m_sensor_data;
+        m_saveimages_thread->commitFrame(frame);
         numSavedImages++;
-        
+
         if (isSavingImagesWithVaryingSettings)
-        {
-            CameraSettings tempCameraSettings = currentImage->getCameraSettings();
-            if (numSavedImages % 10 == 0 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 0);
-            }
-            else if (numSavedImages % 10 == 1 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 50);
-            }
-            else if (numSavedImages % 10 == 2 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 25);
-            }
-            else if (numSavedImages % 10 == 3 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 0);
-            }
-            else if (numSavedImages % 10 == 4 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 25);
-            }
-            else if (numSavedImages % 10 == 5 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 50);
-            }
-            else if (numSavedImages % 10 == 6 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 100);
-            }
-            else if (numSavedImages % 10 == 7 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 150);
-            }
-            else if (numSavedImages % 10 == 8 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 200);
-            }
-            else if (numSavedImages % 10 == 9 )
-            {
-                tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 300);
-            }
-            
-            //Set the Camera Setttings using Jobs:
-            ChangeCameraSettingsJob* newJob = new ChangeCameraSettingsJob(tempCameraSettings);
-            Blackboard->Jobs->addCameraJob(newJob);
-            //m_camera->setSettings(tempCameraSettings);
-        }
+            varyCameraSettings();
     }
     #if DEBUG_VISION_VERBOSITY > 1
         debug << "Vision::SaveAnImage(). Finished" << endl;
     #endif
 }
 
+/*! @brief Triggers the save images thread when the robot starts to fall, or a goal is scored.
+
+    This is checked every frame, so that the state is current when saving starts. The save images thread
+    ignores triggers unless it is in pre-trigger mode.
+ */
+void Vision::checkSaveImagesTriggers()
+{
+    bool falling = m_sensor_data->isFalling() or m_sensor_data->isFallen();
+    int totalscore = 0;
+    if (Blackboard->GameInfo != NULL)
+        totalscore = Blackboard->GameInfo->ourScore() + Blackboard->GameInfo->opponentScore();
+
+    if ((falling and not wasFalling) or totalscore != previousTotalScore)
+        m_saveimages_thread->trigger();
+
+    wasFalling = falling;
+    previousTotalScore = totalscore;
+}
+
+/*! @brief Cycles the camera exposure through a set of offsets from the settings when saving started, one per saved image */
+void Vision::varyCameraSettings()
+{
+    CameraSettings tempCameraSettings = currentImage->getCameraSettings();
+    if (numSavedImages % 10 == 0 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 0);
+    }
+    else if (numSavedImages % 10 == 1 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 50);
+    }
+    else if (numSavedImages % 10 == 2 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 25);
+    }
+    else if (numSavedImages % 10 == 3 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() - 0);
+    }
+    else if (numSavedImages % 10 == 4 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 25);
+    }
+    else if (numSavedImages % 10 == 5 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 50);
+    }
+    else if (numSavedImages % 10 == 6 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 100);
+    }
+    else if (numSavedImages % 10 == 7 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 150);
+    }
+    else if (numSavedImages % 10 == 8 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 200);
+    }
+    else if (numSavedImages % 10 == 9 )
+    {
+        tempCameraSettings.p_exposure.set(currentSettings.p_exposure.get() + 300);
+    }
+    
+    //Set the Camera Setttings using Jobs:
+    ChangeCameraSettingsJob* newJob = new ChangeCameraSettingsJob(tempCameraSettings);
+    Blackboard->Jobs->addCameraJob(newJob);
+}
+
 void Vision::setSensorsData(NUSensorsData* data)
 {
     m_sensor_data = data;
@@ -703,6 +779,8 @@ void Vision::setImage(const NUImage* newImage)
     currentImage = newImage;
     m_timestamp = currentImage->m_timestamp;
     spacings = (int)(currentImage->getWidth()/20); //16 for Robot, 8 for simulator = width/20
+    m_projection.setImageSize(currentImage->getWidth(), currentImage->getHeight());
+    m_projection.setTransforms(m_sensor_data);
     ImageFrameNumber++;
 }
 
@@ -918,6 +996,75 @@ ClassifiedSection Vision::verticalScan(const std::vector<Vector2<int> >&fieldBor
     return scanArea;
 }
 
+/*! @brief Scans below the field border with a coarse scan line at each field border point, and then fine scan lines
+           where the coarse scan found colour transitions, near the horizon and near where the ball was last seen.
+
+    The scan lines are classified, and the total number of pixels classified this frame is kept within the
+    ScanInterestMap's pixel budget. The lines are returned in the same order as verticalScan, each coarse scan
+    line followed by the fine scan lines to its right.
+
+    @param fieldBorders the interpolated field border points
+    @param scanSpacing the distance between the field border points
+    @param horizonLine the horizon
+    @return the classified scan lines
+ */
+ClassifiedSection Vision::verticalScanCoarseToFine(const std::vector<Vector2<int> >&fieldBorders, int scanSpacing, Horizon* horizonLine)
+{
+    ClassifiedSection scanArea(ScanLine::DOWN);
+    if(!fieldBorders.size()) return scanArea;
+    int width = currentImage->getWidth();
+    int height = currentImage->getHeight();
+
+    //! Coarse pass: a full scan line at each field border point
+    ClassifiedSection coarseArea(ScanLine::DOWN);
+    std::vector<Vector2<int> >::const_iterator nextPoint = fieldBorders.begin();
+    for (; nextPoint != fieldBorders.end(); ++nextPoint)
+    {
+        ScanLine tempScanLine(*nextPoint, height - nextPoint->y);
+        coarseArea.addScanLine(tempScanLine);
+    }
+    ClassifyScanArea(&coarseArea);
+
+    //! Fine pass: where the coarse pass found something, or something is expected
+    const float BALL_MEMORY = 1000;             // the time after the ball was last seen that it is still looked for (ms)
+    const MobileObject& ball = AllFieldObjects->mobileFieldObjects[FieldObjects::FO_BALL];
+    if (ball.TimeLastSeen() > 0 and m_timestamp - ball.TimeLastSeen() < BALL_MEMORY)
+        m_scan_interest.setBall(Vector2<int>(ball.ScreenX(), ball.ScreenY()), ball.getObjectWidth() + scanSpacing);
+    else
+        m_scan_interest.clearBall();
+
+    m_scan_interest.build(&coarseArea, fieldBorders, horizonLine, width, height, scanSpacing);
+    ClassifiedSection fineArea(ScanLine::DOWN);
+    m_scan_interest.allocate(classifiedCounter, &fineArea);
+    ClassifyScanArea(&fineArea);
+    m_scan_interest.count(&fineArea);
+
+    #if DEBUG_VISION_VERBOSITY > 2
+        if (m_scan_interest.getNumFrames() >= ScanInterestMap::StatisticsPeriod)
+        {
+            debug << "Vision::verticalScanCoarseToFine. " << m_scan_interest;
+            m_scan_interest.resetStatistics();
+        }
+    #endif
+
+    //! Put each coarse scan line before the fine scan lines to its right
+    int fine = 0;
+    for (int i = 0; i < coarseArea.getNumberOfScanLines(); i++)
+    {
+        ScanLine* coarseLine = coarseArea.getScanLine(i);
+        scanArea.addScanLine(*coarseLine);
+        int column = coarseLine->getStart().x/scanSpacing;
+        while (fine < fineArea.getNumberOfScanLines() and fineArea.getScanLine(fine)->getStart().x/scanSpacing <= column)
+        {
+            scanArea.addScanLine(*fineArea.getScanLine(fine));
+            fine++;
+        }
+    }
+    for (; fine < fineArea.getNumberOfScanLines(); fine++)
+        scanArea.addScanLine(*fineArea.getScanLine(fine));
+    return scanArea;
+}
+
 ClassifiedSection Vision::horizontalScan(const std::vector<Vector2<int> >&fieldBorders,int scanSpacing)
 {
     ClassifiedSection scanArea(ScanLine::RIGHT);
@@ -2117,10 +2264,229 @@ std::vector<ObjectCandidate> Vision::classifyCandidatesDBSCAN(std::vector< Trans
                                         int spacing,
                                         float min_aspect, float max_aspect, int min_segments)
 {
+    //! Overall runtime O( N*logN + N*K ), K is the number of segments in the grid cells around each segment
+    //! The segments are joined with the same rules as classifyCandidatesPrims, but the neighbours of each segment
+    //! are found with a uniform grid, rather than by scanning every segment within the horizontal join limit.
+    //! Every segment is treated as a core point (ie. minPts is 1), so each candidate is a set of density-connected
+    //! segments, and a segment with no neighbours is a candidate on its own, exactly as with PRIMS.
     std::vector<ObjectCandidate> candidateList;
 
-    //unimplemented
+    const int VERT_JOIN_LIMIT = 3;
+    const int HORZ_JOIN_LIMIT = 1;
+    const int GRID_CELL_HEIGHT = 16;
+
+    if (segments.empty())
+        return candidateList;
+
+    //! Sorting O(N*logN). The segments are sorted so that the candidates are formed in the same order as PRIMS,
+    //! and so that the segments above and below each segment in its scan line are its neighbours in the list.
+    sort(segments.begin(), segments.end(), Vision::sortTransitionSegments);
+
+    const int numsegments = segments.size();
+    std::vector<bool> isSegUsed(numsegments, false);
+    int rawSegsLeft = numsegments;
+    int min_grid_x = segments.front().getStartPoint().x;
+    int max_grid_x = segments.back().getStartPoint().x;
+    int min_grid_y = segments.front().getStartPoint().y;
+    int max_grid_y = segments.front().getEndPoint().y;
+    //! Removing invalid colours O(N)
+    for (int i = 0; i < numsegments; i++)
+    {
+        //may have non-robot colour segments, so pre-mark them as used
+        if (not isValidColour(segments[i].getColour(), validColours))
+        {
+            isSegUsed[i] = true;
+            rawSegsLeft--;
+        }
+        min_grid_y = std::min(min_grid_y, segments[i].getStartPoint().y);
+        max_grid_y = std::max(max_grid_y, segments[i].getEndPoint().y);
+    }
 
+    //! Building the grid O(N). Each segment is put in the cell for its scan line, in every row it spans. The cells are
+    //! stored as one list of segment indices, with the start of each cell's indices in cellStart.
+    const int join_distance = spacing*HORZ_JOIN_LIMIT;
+    const int cell_width = std::max(1, join_distance);
+    const int grid_width = (max_grid_x - min_grid_x)/cell_width + 1;
+    const int grid_height = (max_grid_y - min_grid_y)/GRID_CELL_HEIGHT + 1;
+    std::vector<int> cellStart(grid_width*grid_height + 1, 0);
+    for (int i = 0; i < numsegments; i++)
+    {
+        if (isSegUsed[i])
+            continue;
+        int column = (segments[i].getStartPoint().x - min_grid_x)/cell_width;
+        int top = (segments[i].getStartPoint().y - min_grid_y)/GRID_CELL_HEIGHT;
+        int bottom = (segments[i].getEndPoint().y - min_grid_y)/GRID_CELL_HEIGHT;
+        for (int row = top; row <= bottom; row++)
+            cellStart[row*grid_width + column + 1]++;
+    }
+    for (unsigned int cell = 1; cell < cellStart.size(); cell++)
+        cellStart[cell] += cellStart[cell - 1];
+    std::vector<int> cellSegments(cellStart.back());
+    std::vector<int> cellFill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < numsegments; i++)
+    {
+        if (isSegUsed[i])
+            continue;
+        int column = (segments[i].getStartPoint().x - min_grid_x)/cell_width;
+        int top = (segments[i].getStartPoint().y - min_grid_y)/GRID_CELL_HEIGHT;
+        int bottom = (segments[i].getEndPoint().y - min_grid_y)/GRID_CELL_HEIGHT;
+        for (int row = top; row <= bottom; row++)
+            cellSegments[cellFill[row*grid_width + column]++] = i;
+    }
+
+    std::queue<int> qUnprocessed;
+    std::vector<TransitionSegment> candidate_segments;
+    std::vector<int> usedSegments;
+    std::vector<int> rightNeighbours;
+    std::vector<int> leftNeighbours;
+    std::vector<int> lastVisited(numsegments, -1);     // the segment whose neighbours were being found when each segment was last looked at
+    std::vector<int> colourHistogram(validColours.size(), 0);
+    int nextRawSeg = 0;
+
+    //! For all valid segments O(M)
+    while (rawSegsLeft > 0)
+    {
+        //! Find next unused segment, O(M) over all of the candidates
+        while (isSegUsed[nextRawSeg])
+            nextRawSeg++;
+        //Prime unprocessed segment queue to build next candidate
+        qUnprocessed.push(nextRawSeg);
+        isSegUsed[nextRawSeg] = true;
+        rawSegsLeft--;
+
+        int min_x = segments[nextRawSeg].getStartPoint().x;
+        int max_x = segments[nextRawSeg].getStartPoint().x;
+        int min_y = segments[nextRawSeg].getStartPoint().y;
+        int max_y = segments[nextRawSeg].getEndPoint().y;
+        int segCount = 0;
+        std::fill(colourHistogram.begin(), colourHistogram.end(), 0);
+        candidate_segments.clear();
+        usedSegments.clear();
+
+        //! For all unprocessed joined segment in a candidate O(M*K)
+        while (!qUnprocessed.empty())
+        {
+            int thisSeg = qUnprocessed.front();
+            qUnprocessed.pop();
+            segCount++;
+            const TransitionSegment& segment = segments[thisSeg];
+            Vector2<int> start = segment.getStartPoint();
+            Vector2<int> end = segment.getEndPoint();
+            for (unsigned int i = 0; i < validColours.size(); i++)
+            {
+                if (segment.getColour() == validColours[i] && validColours[i] != ClassIndex::white)
+                {
+                    colourHistogram[i] += 1;
+                    break;
+                }
+            }
+            min_x = std::min(min_x, start.x);
+            max_x = std::max(max_x, start.x);
+            min_y = std::min(min_y, start.y);
+            max_y = std::max(max_y, end.y);
+
+            //if there is a seg above AND 'close enough', then qUnprocessed->push()
+            if (thisSeg > 0 && !isSegUsed[thisSeg-1] &&
+                start.x == segments[thisSeg-1].getStartPoint().x &&
+                start.y - segments[thisSeg-1].getEndPoint().y < VERT_JOIN_LIMIT)
+            {
+                qUnprocessed.push(thisSeg-1);
+                isSegUsed[thisSeg-1] = true;
+                rawSegsLeft--;
+            }
+            //if there is a seg below AND 'close enough', then qUnprocessed->push()
+            if (thisSeg+1 < numsegments && !isSegUsed[thisSeg+1] &&
+                start.x == segments[thisSeg+1].getStartPoint().x &&
+                segments[thisSeg+1].getStartPoint().y - end.y < VERT_JOIN_LIMIT)
+            {
+                qUnprocessed.push(thisSeg+1);
+                isSegUsed[thisSeg+1] = true;
+                rawSegsLeft--;
+            }
+
+            //! Find the overlapping segments in the neighbouring scan lines from the grid O(K)
+            rightNeighbours.clear();
+            leftNeighbours.clear();
+            int column = (start.x - min_grid_x)/cell_width;
+            int top = (start.y - min_grid_y)/GRID_CELL_HEIGHT;
+            int bottom = (end.y - min_grid_y)/GRID_CELL_HEIGHT;
+            for (int c = std::max(0, column - 1); c <= std::min(grid_width - 1, column + 1); c++)
+            {
+                for (int row = top; row <= bottom; row++)
+                {
+                    int cell = row*grid_width + c;
+                    for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++)
+                    {
+                        int thatSeg = cellSegments[k];
+                        if (isSegUsed[thatSeg] || lastVisited[thatSeg] == thisSeg)
+                            continue;
+                        lastVisited[thatSeg] = thisSeg;
+                        Vector2<int> thatStart = segments[thatSeg].getStartPoint();
+                        Vector2<int> thatEnd = segments[thatSeg].getEndPoint();
+                        if (thatStart.x == start.x || abs(thatStart.x - start.x) > join_distance)
+                            continue;
+                        if (thatStart.y <= end.y && start.y <= thatEnd.y)
+                        {
+                            //thisSeg overlaps with thatSeg
+                            int intercept = findInterceptFromPerspectiveFrustum(fieldBorders, start.x, thatStart.x, join_distance);
+                            if (intercept >= 0 && thatEnd.y >= intercept && intercept <= end.y)
+                            {
+                                if (thatStart.x > start.x)
+                                    rightNeighbours.push_back(thatSeg);
+                                else
+                                    leftNeighbours.push_back(thatSeg);
+                            }
+                        }
+                    }
+                }
+            }
+            // the neighbours are queued in the same order as PRIMS; nearest first to the right, and then to the left
+            sort(rightNeighbours.begin(), rightNeighbours.end());
+            sort(leftNeighbours.begin(), leftNeighbours.end(), std::greater<int>());
+            for (unsigned int i = 0; i < rightNeighbours.size(); i++)
+            {
+                qUnprocessed.push(rightNeighbours[i]);
+                isSegUsed[rightNeighbours[i]] = true;
+                rawSegsLeft--;
+            }
+            for (unsigned int i = 0; i < leftNeighbours.size(); i++)
+            {
+                qUnprocessed.push(leftNeighbours[i]);
+                isSegUsed[leftNeighbours[i]] = true;
+                rawSegsLeft--;
+            }
+
+            //add thisSeg to CandidateVector
+            candidate_segments.push_back(segment);
+            usedSegments.push_back(thisSeg);
+        }
+
+        //HEURISTICS FOR ADDING THIS CANDIDATE AS A ROBOT CANDIDATE
+        if ( max_x - min_x >= 0 &&                                               // width  is non-zero
+             max_y - min_y >= 0 &&                                               // height is non-zero
+             (float)(max_x - min_x) / (float)(max_y - min_y) <= max_aspect &&    // Less    than specified landscape aspect
+             (float)(max_x - min_x) / (float)(max_y - min_y) >= min_aspect &&    // greater than specified portrait aspect
+             segCount >= min_segments                                    // greater than minimum amount of segments to remove noise
+             )
+        {
+            int max_col = 0;
+            for (int i = 0; i < (int)validColours.size(); i++)
+            {
+                if (i != max_col && colourHistogram[i] > colourHistogram[max_col])
+                    max_col = i;
+            }
+            for (unsigned int i = 0; i < candidate_segments.size(); i++)
+                candidate_segments[i].isUsed = true;
+            for (unsigned int i = 0; i < usedSegments.size(); i++)
+                segments[usedSegments[i]].isUsed = true;
+            candidateList.push_back(ObjectCandidate(min_x, min_y, max_x, max_y, validColours.at(max_col), candidate_segments));
+        }
+        else
+        {
+            for (unsigned int i = 0; i < usedSegments.size(); i++)
+                segments[usedSegments[i]].isUsed = false;
+        }
+    }
     return candidateList;
 }
 
@@ -2614,13 +2980,18 @@ Circle Vision::DetectBall(const std::vector<ObjectCandidate> &FO_Candidates)
         visualSphericalPosition[1] = bearing;
         visualSphericalPosition[2] = elevation;
         
-        vector<float> ctvector;
-        bool isOK = getSensorsData()->get(NUSensorsData::CameraTransform, ctvector);
-        if(isOK == true)
+        if(m_projection.transformPosition(visualSphericalPosition, transformedSphericalPosition))
         {
-            Matrix cameraTransform = Matrix4x4fromVector(ctvector);
-            transformedSphericalPosition = Kinematics::TransformPosition(cameraTransform,visualSphericalPosition);
-
+            //! Track the ball from its position relative to the robot
+            float flatDistance = transformedSphericalPosition[0]*cos(transformedSphericalPosition[2]);
+            Vector3<float> relativePosition(flatDistance*cos(transformedSphericalPosition[1]),
+                                            flatDistance*sin(transformedSphericalPosition[1]),
+                                            transformedSphericalPosition[0]*sin(transformedSphericalPosition[2]));
+            m_ball_tracker.hit(relativePosition, currentImage->m_timestamp);
+        }
+        else
+        {
+            m_ball_tracker.lose();
         }
         //qDebug() << "Vision::DetectBall : Update FO_Ball" << (ball.radius*2);
         sizeOnScreen.x = int(ball.radius*2);
@@ -2648,6 +3019,105 @@ Circle Vision::DetectBall(const std::vector<ObjectCandidate> &FO_Candidates)
 
 }
 
+/*! @brief Joins the ball coloured segments into candidates
+    @param segments the segments to join; only the ball colours are used
+    @param fieldBorders the field border points
+    @param spacing the distance between the scan lines the segments are on
+    @param method the method used to join the segments
+ */
+std::vector<ObjectCandidate> Vision::classifyBallCandidates(std::vector< TransitionSegment > &segments,
+                                                            const std::vector<Vector2<int> >&fieldBorders,
+                                                            int spacing, tCLASSIFY_METHOD method)
+{
+    std::vector<unsigned char> validColours;
+    validColours.push_back(ClassIndex::orange);
+    validColours.push_back(ClassIndex::pink_orange);
+    validColours.push_back(ClassIndex::yellow_orange);
+    return classifyCandidates(segments, fieldBorders, validColours, spacing, 0, 3.0, 1, method);
+}
+
+/*! @brief Predicts the window in the current image that the tracked ball should be in.
+
+    The ball's last position relative to the robot is moved on by its velocity from localisation, rotated from
+    field to robot coordinates, and then projected into the image with the current camera transform. The window
+    is the ball's predicted size, plus the uncertainty in its position at its predicted distance.
+
+    @param topLeft the top left of the window
+    @param bottomRight the bottom right of the window
+    @return false if there is no camera transform, or the window is not on the screen
+ */
+bool Vision::predictBallWindow(Vector2<int>& topLeft, Vector2<int>& bottomRight)
+{
+    vector<float> ctvector;
+    if(m_sensor_data == NULL or not m_sensor_data->get(NUSensorsData::CameraTransform, ctvector))
+        return false;
+
+    const MobileObject& ball = AllFieldObjects->mobileFieldObjects[FieldObjects::FO_BALL];
+    float heading = AllFieldObjects->self.Heading();
+    Vector2<float> velocity(ball.velX()*cos(heading) + ball.velY()*sin(heading), -ball.velX()*sin(heading) + ball.velY()*cos(heading));
+    Vector2<float> velocityError(ball.sdVelX(), ball.sdVelY());
+    Vector3<float> position = m_ball_tracker.predict(velocity, m_timestamp);
+
+    //! Move the predicted position into the camera's coordinates
+    Matrix groundPosition(4,1);
+    groundPosition[0][0] = position.x;
+    groundPosition[1][0] = position.y;
+    groundPosition[2][0] = position.z;
+    groundPosition[3][0] = 1.0;
+    Matrix cameraPosition = mathGeneral::Cartesian2Spherical(InverseMatrix(Matrix4x4fromVector(ctvector))*groundPosition);
+    float distance = cameraPosition[0][0];
+    float bearing = cameraPosition[1][0];
+    float elevation = cameraPosition[2][0];
+    if(distance <= 0 or fabs(bearing) >= mathGeneral::PI/2 or fabs(elevation) >= mathGeneral::PI/2)
+        return false;
+
+    float x = CalculateScreenX(bearing);
+    float y = CalculateScreenY(elevation);
+    float radius = EFFECTIVE_CAMERA_DISTANCE_IN_PIXELS()*ORANGE_BALL_DIAMETER/(2*distance);
+    float margin = EFFECTIVE_CAMERA_DISTANCE_IN_PIXELS()*m_ball_tracker.getUncertainty(velocityError, m_timestamp)/distance;
+    float halfSize = radius + margin;
+
+    topLeft.x = std::max(0, (int)(x - halfSize));
+    topLeft.y = std::max(0, (int)(y - halfSize));
+    bottomRight.x = std::min(currentImage->getWidth() - 1, (int)(x + halfSize));
+    bottomRight.y = std::min(currentImage->getHeight() - 1, (int)(y + halfSize));
+    return bottomRight.x > topLeft.x and bottomRight.y > topLeft.y;
+}
+
+/*! @brief Classifies vertical scan lines close together in a window, and joins the ball coloured segments into candidates
+    @param topLeft the top left of the window
+    @param bottomRight the bottom right of the window
+    @param fieldBorders the field border points
+    @param method the method used to join the segments
+ */
+std::vector<ObjectCandidate> Vision::classifyBallWindow(const Vector2<int>& topLeft, const Vector2<int>& bottomRight,
+                                                        const std::vector<Vector2<int> >&fieldBorders,
+                                                        tCLASSIFY_METHOD method)
+{
+    const int MIN_SPACING = 2;          // the scan lines are no closer than this (pixels)
+    const int MAX_LINES = 32;           // the scan lines are spread out in large windows to keep the cost down
+    int spacing = std::max(MIN_SPACING, (bottomRight.x - topLeft.x)/MAX_LINES);
+
+    ClassifiedSection scanArea(ScanLine::DOWN);
+    for(int x = topLeft.x; x <= bottomRight.x; x += spacing)
+    {
+        ScanLine tempScanLine(Vector2<int>(x, topLeft.y), bottomRight.y - topLeft.y + 1);
+        scanArea.addScanLine(tempScanLine);
+    }
+    ClassifyScanArea(&scanArea);
+
+    std::vector< TransitionSegment > segments;
+    for(int i = 0; i < scanArea.getNumberOfScanLines(); i++)
+    {
+        ScanLine* tempScanLine = scanArea.getScanLine(i);
+        for(int seg = 0; seg < tempScanLine->getNumberOfSegments(); seg++)
+        {
+            segments.push_back(*tempScanLine->getSegment(seg));
+        }
+    }
+    return classifyBallCandidates(segments, fieldBorders, spacing, method);
+}
+
 void Vision::DetectGoals(std::vector<ObjectCandidate>& FO_Candidates,std::vector<ObjectCandidate>& FO_AboveHorizonCandidates,std::vector< TransitionSegment > horizontalSegments)
 {
     int width = currentImage->getWidth();
@@ -2664,6 +3134,146 @@ void Vision::PostProcessGoals()
     return;
 }
 
+/*! @brief Predicts the window in the current image that each tracked goal post should be in.
+
+    The directions of the top and bottom of each post relative to the robot are projected into the image with the
+    current camera transform. The window is the post's width, and the length of the post, plus a margin which grows
+    while the post is missed. Posts whose window is off the screen are marked as not in view.
+
+    @return false if there is no camera transform
+ */
+bool Vision::predictGoalPostWindows()
+{
+    if(not m_projection.hasCameraTransform())
+        return false;
+
+    int width = currentImage->getWidth();
+    int height = currentImage->getHeight();
+    std::vector<GoalPostTracker::Post>& posts = m_goal_tracker.getPosts();
+    for(unsigned int i = 0; i < posts.size(); i++)
+    {
+        GoalPostTracker::Post& post = posts[i];
+        Vector2<float> top, bottom;
+        post.InView = m_projection.screenPosition(post.Top, top) and m_projection.screenPosition(post.Bottom, bottom);
+        if(not post.InView)
+            continue;
+
+        float margin = EFFECTIVE_CAMERA_DISTANCE_IN_PIXELS()*m_goal_tracker.getMargin(post);
+        float halfWidth = post.Width/2 + margin;
+        post.WindowTopLeft.x = std::max(0, (int)(std::min(top.x, bottom.x) - halfWidth));
+        post.WindowTopLeft.y = std::max(0, (int)(std::min(top.y, bottom.y) - margin));
+        post.WindowBottomRight.x = std::min(width - 1, (int)(std::max(top.x, bottom.x) + halfWidth));
+        post.WindowBottomRight.y = std::min(height - 1, (int)(std::max(top.y, bottom.y) + margin));
+        post.InView = post.WindowBottomRight.x > post.WindowTopLeft.x and post.WindowBottomRight.y > post.WindowTopLeft.y;
+    }
+    return true;
+}
+
+/*! @brief Classifies a few horizontal scan lines across the window of each tracked post of a colour, and joins the
+           segments of that colour in each window into a candidate.
+
+    The scan lines are half the scan spacing apart, like the horizontal scan above the field border, but no more than
+    MAX_LINES of them are used in a window. The candidates are ordered like those from ClassifyCandidatesAboveTheHorizon,
+    bottom row first and right to left along each row, so that they can be given to DetectGoals in their place.
+
+    @param colour the colour of the posts (ClassIndex::yellow or ClassIndex::blue)
+ */
+std::vector<ObjectCandidate> Vision::classifyGoalPostWindows(unsigned char colour)
+{
+    const int MAX_LINES = 24;           // the scan lines are spread out in tall windows to keep the cost down
+    const int MIN_SEGMENTS = 3;         // the same as the search above the horizon
+
+    std::vector<ObjectCandidate> candidates;
+    std::vector<GoalPostTracker::Post>& posts = m_goal_tracker.getPosts();
+    for(unsigned int i = 0; i < posts.size(); i++)
+    {
+        const GoalPostTracker::Post& post = posts[i];
+        if(post.Colour != colour or not post.InView)
+            continue;
+
+        int windowHeight = post.WindowBottomRight.y - post.WindowTopLeft.y;
+        int spacing = std::max(std::max(1, spacings/2), windowHeight/MAX_LINES);
+        ClassifiedSection scanArea(ScanLine::RIGHT);
+        for(int y = post.WindowBottomRight.y; y >= post.WindowTopLeft.y; y -= spacing)
+        {
+            ScanLine tempScanLine(Vector2<int>(post.WindowTopLeft.x, y), post.WindowBottomRight.x - post.WindowTopLeft.x + 1);
+            scanArea.addScanLine(tempScanLine);
+        }
+        ClassifyScanArea(&scanArea);
+
+        std::vector<TransitionSegment> segments;
+        Vector2<int> topLeft(post.WindowBottomRight.x, post.WindowBottomRight.y);
+        Vector2<int> bottomRight(post.WindowTopLeft.x, post.WindowTopLeft.y);
+        for(int line = 0; line < scanArea.getNumberOfScanLines(); line++)
+        {
+            ScanLine* tempScanLine = scanArea.getScanLine(line);
+            for(int seg = tempScanLine->getNumberOfSegments() - 1; seg >= 0; seg--)
+            {
+                TransitionSegment* segment = tempScanLine->getSegment(seg);
+                if(segment->getColour() != colour)
+                    continue;
+                topLeft.x = std::min(topLeft.x, segment->getStartPoint().x);
+                topLeft.y = std::min(topLeft.y, segment->getStartPoint().y);
+                bottomRight.x = std::max(bottomRight.x, segment->getEndPoint().x);
+                bottomRight.y = std::max(bottomRight.y, segment->getEndPoint().y);
+                segments.push_back(*segment);
+            }
+        }
+        if((int)segments.size() >= MIN_SEGMENTS)
+            candidates.push_back(ObjectCandidate(topLeft.x, topLeft.y, bottomRight.x, bottomRight.y, colour, segments));
+    }
+    return candidates;
+}
+
+/*! @brief Gives the goal posts found in this frame to the goal post tracker
+    @param searched true if the full goal search was run in this frame, false if only the tracked posts' windows were checked
+ */
+void Vision::updateGoalPostTracker(bool searched)
+{
+    std::vector<GoalPostTracker::Post> seen;
+    std::vector<const Object*> objects;
+    std::vector<unsigned char> colours;
+    for(int id = FieldObjects::FO_BLUE_LEFT_GOALPOST; id <= FieldObjects::FO_YELLOW_RIGHT_GOALPOST; id++)
+    {
+        objects.push_back(&AllFieldObjects->stationaryFieldObjects[id]);
+        colours.push_back(id <= FieldObjects::FO_BLUE_RIGHT_GOALPOST ? ClassIndex::blue : ClassIndex::yellow);
+    }
+    for(unsigned int i = 0; i < AllFieldObjects->ambiguousFieldObjects.size(); i++)
+    {
+        const AmbiguousObject& object = AllFieldObjects->ambiguousFieldObjects[i];
+        if(object.getID() == FieldObjects::FO_BLUE_GOALPOST_UNKNOWN or object.getID() == FieldObjects::FO_YELLOW_GOALPOST_UNKNOWN)
+        {
+            objects.push_back(&object);
+            colours.push_back(object.getID() == FieldObjects::FO_BLUE_GOALPOST_UNKNOWN ? ClassIndex::blue : ClassIndex::yellow);
+        }
+    }
+
+    for(unsigned int i = 0; i < objects.size(); i++)
+    {
+        const Object* object = objects[i];
+        if(not object->isObjectVisible())
+            continue;
+        GoalPostTracker::Post post;
+        post.Colour = colours[i];
+        int x = object->ScreenX();
+        int top = object->ScreenY() - object->getObjectHeight()/2;
+        int bottom = object->ScreenY() + object->getObjectHeight()/2;
+        if(not m_projection.robotDirection(x, top, post.Top) or not m_projection.robotDirection(x, bottom, post.Bottom))
+            continue;
+        post.Width = object->getObjectWidth();
+        post.Misses = 0;
+        post.InView = true;
+        post.WindowTopLeft = Vector2<int>(x - object->getObjectWidth()/2, top);
+        post.WindowBottomRight = Vector2<int>(x + object->getObjectWidth()/2, bottom);
+        seen.push_back(post);
+    }
+
+    if(searched)
+        m_goal_tracker.searched(seen);
+    else
+        m_goal_tracker.tracked(seen);
+}
+
 void Vision::DetectRobots(std::vector < ObjectCandidate > &RobotCandidates)
 {
     int MaxPercentageOfColour = 50;
@@ -2706,15 +3316,10 @@ void Vision::DetectRobots(std::vector < ObjectCandidate > &RobotCandidates)
             float elevation = CalculateElevation(cy);
             float distance = 0;
             //qDebug() << i <<": Blue Robot: get transform";
-            vector<float> ctgvector;
             Vector3<float> measured(distance,bearing,elevation);
             Vector2<float> screenPositionAngle(bearing,elevation);
-            bool isOK = getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector); 
-            if(isOK == true)
+            if(m_projection.groundPosition(cx, cy, measured))
             {
-                Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-                measured = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
-
                 #if DEBUG_VISION_VERBOSITY > 6
                     debug << "\t\tCalculated Distance to Point: " << distance<<endl;
                 #endif
@@ -2741,15 +3346,10 @@ void Vision::DetectRobots(std::vector < ObjectCandidate > &RobotCandidates)
             float elevation = CalculateElevation(cy);
             float distance = 0;
             //qDebug() << i <<": pink Robot: get transform";
-            vector<float> ctgvector;
             Vector3<float> measured(distance,bearing,elevation);
             Vector2<float> screenPositionAngle(bearing,elevation);
-            bool isOK = getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector); 
-            if(isOK == true)
+            if(m_projection.groundPosition(cx, cy, measured))
             {
-                Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-                measured = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
-
                 #if DEBUG_VISION_VERBOSITY > 6
                     debug << "\t\tCalculated Distance to Point: " << distance<<endl;
                 #endif
@@ -2768,14 +3368,22 @@ void Vision::DetectRobots(std::vector < ObjectCandidate > &RobotCandidates)
 }
 
 double Vision::CalculateBearing(double cx){
-    double FOVx = deg2rad(45.0f); //Taken from Old Globals
-    return atan( (currentImage->getWidth()/2-cx) / ( (currentImage->getWidth()/2) / (tan(FOVx/2.0)) ) );
+    return m_projection.bearing(cx);
 }
 
 
 double Vision::CalculateElevation(double cy){
-    double FOVy = deg2rad(34.80f); //Taken from DOCUMENTATION OF NAO
-    return atan( (currentImage->getHeight()/2-cy) / ( (currentImage->getHeight()/2) / (tan(FOVy/2.0)) ) );
+    return m_projection.elevation(cy);
+}
+
+//! @brief The inverse of CalculateBearing; returns the x position in the image at a bearing from the camera
+double Vision::CalculateScreenX(double bearing){
+    return m_projection.screenX(bearing);
+}
+
+//! @brief The inverse of CalculateElevation; returns the y position in the image at an elevation from the camera
+double Vision::CalculateScreenY(double elevation){
+    return m_projection.screenY(elevation);
 }
 
 double Vision::EFFECTIVE_CAMERA_DISTANCE_IN_PIXELS()
@@ -2804,65 +3412,62 @@ int Vision::getNumFramesProcessed()
     return framesprocessed;
 }
 
-/*
-QImage Vision::getEdgeFilter()
+/*! @brief Calculates the gradients of a region of the current image, for refineEdge() to search
+    @param x the left of the region
+    @param y the top of the region
+    @param width the width of the region
+    @param height the height of the region
+    @return false if the region is outside of the image
+ */
+bool Vision::filterEdgeRegion(int x, int y, int width, int height)
 {
-    return getEdgeFilter(0,0,currentImage->getWidth(), currentImage->getHeight());
+    return m_edge_detection.filterRegion(currentImage, x, y, width, height);
 }
 
-QImage Vision::getEdgeFilter(int x, int y, int width, int height)
+/*! @brief Moves a colour transition to the nearest strong edge in the region last given to filterEdgeRegion(), to sub-pixel accuracy
+    @param x the x position of the transition
+    @param y the y position of the transition
+    @param horizontal true to search along the row, false to search along the column
+    @param radius the number of pixels either side of the transition to search
+    @param position the sub-pixel position of the edge, if one is found, otherwise it is unchanged
+    @return true if an edge is found
+ */
+bool Vision::refineEdge(int x, int y, bool horizontal, int radius, float& position)
 {
-    return getEdgeFilter(currentImage->getSubImage(x,y,width, height, 1));
+    return m_edge_detection.refineEdge(x, y, horizontal, radius, position);
 }
 
-QImage Vision::getEdgeFilter(int x, int y, int width, int height, int decimation_spacing)
+/*! @brief Returns the mid point of a segment, with each end moved to the nearest strong edge in the current image
+    @param segment the segment, along a row or along a column
+    @param radius the number of pixels either side of each end to search
+ */
+Vector2<float> Vision::refineSegmentMidPoint(const TransitionSegment& segment, int radius)
 {
-    return getEdgeFilter(currentImage->getSubImage(x,y,width, height, decimation_spacing));
+    Vector2<int> start = segment.getStartPoint();
+    Vector2<int> end = segment.getEndPoint();
+    Vector2<float> midpoint(0.5f*(start.x + end.x), 0.5f*(start.y + end.y));
+    bool horizontal = start.y == end.y;
+    if (horizontal == (start.x == end.x))
+        return midpoint;        // a single pixel, or not along a row or column
+
+    // the segment and the search either side of it are filtered once, for both ends
+    int left = std::min(start.x, end.x);
+    int top = std::min(start.y, end.y);
+    if (horizontal)
+        filterEdgeRegion(left - radius - 1, top, abs(end.x - start.x) + 2*radius + 3, 1);
+    else
+        filterEdgeRegion(left, top - radius - 1, 1, abs(end.y - start.y) + 2*radius + 3);
+    float startposition, endposition;
+    if (refineEdge(start.x, start.y, horizontal, radius, startposition) and refineEdge(end.x, end.y, horizontal, radius, endposition))
+    {
+        if (horizontal)
+            midpoint.x = 0.5f*(startposition + endposition);
+        else
+            midpoint.y = 0.5f*(startposition + endposition);
+    }
+    return midpoint;
 }
 
-QImage Vision::getEdgeFilter(QImage image)
-{
-    QImage* resultant = new QImage(image.width(), image.height(), QImage::Format_ARGB32);
-    QImage* grayscale = new QImage(image.width(), image.height(), QImage::Format_ARGB32);
-    float c = 0;
-    unsigned char cP = 0;
-    unsigned char cR = 0;
-    unsigned int rgb = 0, gray = 0;
-
-    //Precalculate Grayscale image
-    for (int x = 1; x < image.width() - 1; x++)
-        for (int y = 1; y < image.height() - 1; y++)
-        {
-            rgb = image.pixel(x,y);
-            ColorModelConversions::rgb2gray(rgb, gray);
-            grayscale->setPixel(x,y,gray);
-        }
-
-     //filter with edge detecting filter
-     for (int x = 1; x < image.width() - 1; x++)
-     {
-         for (int y = 1; y < image.height() - 1; y++)
-         {
-             c = 0; cP = 0; cR = 0;
-
-             c += 2*(grayscale->pixel(x-1,y-1) % 256); //a
-             c += 2*(grayscale->pixel(x  ,y-1) % 256); //b
-             c += 2*(grayscale->pixel(x-1,y  ) % 256); //d
-
-             c -= 2*(grayscale->pixel(x+1,y  ) % 256); //f
-             c -= 2*(grayscale->pixel(x  ,y+1) % 256); //h
-             c -= 2*(grayscale->pixel(x+1,y+1) % 256); //i
-
-             if      (c > 255) cR = 255;
-             else if (c <   0) cR = 0;
-             else                    cR = (unsigned char)(c);
-             resultant->setPixel(x,y, (cR * 0x01010101));
-         }
-     }
-
-    return *resultant;
-}
-*/
 /*!
   @brief perform an fft to extract prominent features for further analysis
   */
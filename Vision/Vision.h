@@ -16,6 +16,11 @@
 #include "RobotCandidate.h"
 #include "LineDetection.h"
 #include "ObjectCandidate.h"
+#include "EdgeDetection.h"
+#include "ScanInterestMap.h"
+#include "BallTracker.h"
+#include "GoalPostTracker.h"
+#include "CameraProjection.h"
 #include "NUPlatform/NUCamera.h"
 #include "Tools/Math/Vector2.h"
 #include "Tools/FileFormats/LUTTools.h"
@@ -50,8 +55,12 @@ class Vision
     
     NUSensorsData* m_sensor_data;               //!< pointer to shared sensor data object
     NUActionatorsData* m_actions;               //!< pointer to shared actionators data object
-    friend class SaveImagesThread;
     SaveImagesThread* m_saveimages_thread;      //!< an external thread to do saving images in parallel with vision processing
+    EdgeDetection m_edge_detection;             //!< the edge detector run on regions of interest in the current image
+    ScanInterestMap m_scan_interest;            //!< decides where the fine vertical scan lines go in the coarse to fine scan
+    BallTracker m_ball_tracker;                 //!< keeps track of the ball, so that it is searched for in a window about where it should be
+    GoalPostTracker m_goal_tracker;             //!< keeps track of the goal posts, so that they are checked in windows instead of searched for
+    CameraProjection m_projection;              //!< the bearing and elevation tables, and camera transforms, for the current frame
     
     int findYFromX(const std::vector<Vector2<int> >&points, int x);
     bool checkIfBufferSame(boost::circular_buffer<unsigned char> cb);
@@ -60,14 +69,16 @@ class Vision
     bool isSavingImages;
     bool isSavingImagesWithVaryingSettings;
     int numSavedImages;
-    ofstream imagefile;
-    ofstream sensorfile;
+    bool wasFalling;                    //!< true if the robot was falling in the previous frame, used to trigger saving images
+    int previousTotalScore;             //!< the sum of the scores in the previous frame, used to trigger saving images
     int ImageFrameNumber;
     int numFramesDropped;               //!< the number of frames dropped since the last call to getNumFramesDropped()
     int numFramesProcessed;             //!< the number of frames processed since the last call to getNumFramesProcessed()
     CameraSettings currentSettings;
 
     void SaveAnImage();
+    void checkSaveImagesTriggers();
+    void varyCameraSettings();
 
     public:
     //! FieldObjects Container
@@ -83,9 +94,13 @@ class Vision
 
     double CalculateBearing(double cx);
     double CalculateElevation(double cy);
+    double CalculateScreenX(double bearing);
+    double CalculateScreenY(double elevation);
 
     double EFFECTIVE_CAMERA_DISTANCE_IN_PIXELS();
 
+    const CameraProjection& getCameraProjection() const {return m_projection;}
+
 
     void process (JobList* jobs);
 
@@ -99,6 +114,7 @@ class Vision
 
     void setLUT(unsigned char* newLUT);
     void loadLUTFromFile(const std::string& fileName);
+    const unsigned char* getLUT() const {return currentLookupTable;};
 
     void setImage(const NUImage* sourceImage);
     int getNumFramesDropped();
@@ -106,12 +122,11 @@ class Vision
 
     
     /*!
-      @brief perform an edge filter to extract prominent features for further analysis
+      @brief find sub-pixel edges in the Y channel of regions of interest in the current image
       */
-    /*QImage getEdgeFilter();
-    QImage getEdgeFilter(int x, int y, int width, int height);
-    QImage getEdgeFilter(int x, int y, int width, int height, int decimation_spacing);
-    QImage getEdgeFilter(QImage image);*/
+    bool filterEdgeRegion(int x, int y, int width, int height);
+    bool refineEdge(int x, int y, bool horizontal, int radius, float& position);
+    Vector2<float> refineSegmentMidPoint(const TransitionSegment& segment, int radius);
 
     /*!
       @brief perform an fft to extract prominent features for further analysis
@@ -152,6 +167,12 @@ class Vision
         DBSCAN
     };
 
+    enum tSCAN_METHOD
+    {
+        UNIFORM,            //!< the same pattern of vertical scan lines at every field border point (the default)
+        COARSE_TO_FINE      //!< a coarse scan, then fine scan lines where it is interesting, within a pixel budget (opt-in with setScanMethod)
+    };
+
     /*!
       @brief Joins segments to create a joined segment clusters that represent candidate robots
       @param segList The segList is a vector of TransitionSegments after field lines have been rejected
@@ -210,6 +231,7 @@ class Vision
 
     ClassifiedSection horizontalScan(const std::vector<Vector2<int> >&fieldBoarders, int scanSpacing);
     ClassifiedSection verticalScan(const std::vector<Vector2<int> >&fieldBoarders, int scanSpacing);
+    ClassifiedSection verticalScanCoarseToFine(const std::vector<Vector2<int> >&fieldBorders, int scanSpacing, Horizon* horizonLine);
     void ClassifyScanArea(ClassifiedSection* scanArea);
     void CloselyClassifyScanline(ScanLine* tempLine, TransitionSegment* tempSeg, int spacing, int direction, const std::vector<unsigned char> &colourList,int bufferSize);
 
@@ -228,12 +250,22 @@ class Vision
                                                                       std::vector< TransitionSegment > &leftover);
 
     Circle DetectBall(const std::vector<ObjectCandidate> &FO_Candidates);
+    std::vector<ObjectCandidate> classifyBallCandidates(std::vector< TransitionSegment > &segments,
+                                                        const std::vector<Vector2<int> >&fieldBorders,
+                                                        int spacing, tCLASSIFY_METHOD method);
+    bool predictBallWindow(Vector2<int>& topLeft, Vector2<int>& bottomRight);
+    std::vector<ObjectCandidate> classifyBallWindow(const Vector2<int>& topLeft, const Vector2<int>& bottomRight,
+                                                    const std::vector<Vector2<int> >&fieldBorders,
+                                                    tCLASSIFY_METHOD method);
 
     void DetectGoals(std::vector<ObjectCandidate>& FO_Candidates,
                      std::vector<ObjectCandidate>& FO_AboveHorizonCandidates,
                      const std::vector< TransitionSegment > horizontalSegments);
 
     void PostProcessGoals();
+    bool predictGoalPostWindows();
+    std::vector<ObjectCandidate> classifyGoalPostWindows(unsigned char colour);
+    void updateGoalPostTracker(bool searched);
 
     void DetectRobots(std::vector<ObjectCandidate> &RobotCandidates);
 
@@ -243,10 +275,20 @@ class Vision
 
     int getScanSpacings(){return spacings;}
 
+    void setScanMethod(tSCAN_METHOD method) {m_scan_method = method;}
+    tSCAN_METHOD getScanMethod() {return m_scan_method;}
+    void setScanPixelBudget(int pixels) {m_scan_interest.setPixelBudget(pixels);}
+    const ScanInterestMap& getScanInterestMap() {return m_scan_interest;}
+    void setBallTrackingMaxMisses(int misses) {m_ball_tracker.setMaxMisses(misses);}
+    void setGoalTrackingSearchPeriod(int frames) {m_goal_tracker.setSearchPeriod(frames);}
+    const GoalPostTracker& getGoalPostTracker() {return m_goal_tracker;}
+
     NUSensorsData* getSensorsData() {return m_sensor_data;}
     bool checkIfBufferContains(boost::circular_buffer<unsigned char> cb, const std::vector<unsigned char> &colourList);
 
     int CalculateSkipSpacing(int currentPosition, int lineLength, bool greenSeen);
 
+    private:
+    tSCAN_METHOD m_scan_method;                 //!< the way the image below the field border is scanned
 };
 #endif // VISION_H
@@ -31,6 +31,11 @@ TransitionSegment.cpp
 Vision.cpp
 Ball.cpp
 CircleFitting.cpp
+EdgeDetection.cpp
+ScanInterestMap.cpp
+BallTracker.cpp
+GoalPostTracker.cpp
+CameraProjection.cpp
 EllipseFit.cpp
 fitellipsethroughcircle.cpp
 )
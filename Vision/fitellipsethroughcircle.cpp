@@ -6,8 +6,6 @@ class Vision;
 #include "../Tools/Math/Vector2.h"
 #include "CircleFitting.h"
 #include "Tools/Math/General.h"
-#include "Infrastructure/NUSensorsData/NUSensorsData.h"
-#include "Kinematics/Kinematics.h"
 #include "Vision.h"
 
 #if TARGET_OS_IS_WINDOWS
@@ -37,24 +35,27 @@ bool FitEllipseThroughCircle::Fit_Ellipse_Through_Circle(std::vector<LinePoint*>
     std::vector < Vector2<int> > points;
     points.reserve(centreCirclePoints.size());
 
+    std::vector < Vector2<float> > screenPoints;
+    screenPoints.reserve(centreCirclePoints.size());
     for(unsigned int i = 0; i < centreCirclePoints.size() ; i++ )
+        screenPoints.push_back(Vector2<float>(centreCirclePoints[i]->x, centreCirclePoints[i]->y));
+
+    std::vector < Vector3<float> > relativePoints;
+    std::vector < bool > isOnGround;
+    if(vision->getCameraProjection().groundPositions(screenPoints, relativePoints, isOnGround) < (int)screenPoints.size())
     {
-        Vector3<float> relativePoint = DistanceToPoint(centreCirclePoints[i], vision);
-        if(relativePoint.x == 100000)
-        {
-            //Fit_Ellipse(centreCirclePoints);
-            return false;
-        }
-        else
-        {
-            Vector2<int> tempLinePoint;
-            tempLinePoint.x = relativePoint.x * cos(relativePoint.y) * cos (relativePoint.z);
-            tempLinePoint.y = relativePoint.x * sin(relativePoint.y) * cos (relativePoint.z);
-            points.push_back(tempLinePoint);
-            //qDebug() << "CenterCircle through Circle: Point Found: " << tempLinePoint.x << "," <<tempLinePoint.y;
-        }
+        //Fit_Ellipse(centreCirclePoints);
+        return false;
     }
-    
+    for(unsigned int i = 0; i < relativePoints.size() ; i++ )
+    {
+        Vector2<int> tempLinePoint;
+        tempLinePoint.x = relativePoints[i].x * cos(relativePoints[i].y) * cos (relativePoints[i].z);
+        tempLinePoint.y = relativePoints[i].x * sin(relativePoints[i].y) * cos (relativePoints[i].z);
+        points.push_back(tempLinePoint);
+        //qDebug() << "CenterCircle through Circle: Point Found: " << tempLinePoint.x << "," <<tempLinePoint.y;
+    }
+
     //Perform Circle Fit on Transformed Points:
     Circle circ = circleFitter.FitCircleLMA(points);
     LinePoint relativeCentrePoint;
@@ -113,30 +114,16 @@ Vector3<float> FitEllipseThroughCircle::DistanceToPoint(LinePoint* point, Vision
     Vector3<float> relativePoint;
 
     relativePoint.x = D2Pdistance;
-    float bearing = vision->CalculateBearing(point->x);
-    float elevation = vision->CalculateElevation(point->y);
-
-    vector<float> ctgvector;
-    bool isOK = vision->getSensorsData()->get(NUSensorsData::CameraToGroundTransform, ctgvector);
-    if(isOK == true)
+    Vector3<float> result;
+    if(vision->getCameraProjection().groundPosition(point->x, point->y, result))
     {
-        Matrix camera2groundTransform = Matrix4x4fromVector(ctgvector);
-        Vector3<float> result;
-
-        result = Kinematics::DistanceToPoint(camera2groundTransform, bearing, elevation);
         relativePoint.x = result[0]; //DISTANCE
         relativePoint.y = result[1]; //BEARING
         relativePoint.z = result[2]; //ELEVATION
 
-
         #if DEBUG_VISION_VERBOSITY > 6
         debug << "\t\tELLIPISE::Calculated Distance to Point: " << relativePoint.x <<endl;
         #endif
-
-        //#if TARGET_OS_IS_WINDOWS
-        //qDebug() << "\t\t Point On Screen: " << point->x << point->y <<endl;
-        //#endif
-        //CalculateScreenPosition(relativePoint.x, relativePoint.y, vision);
     }
     return relativePoint;
 }